@@ -284,6 +284,7 @@ extern edict_t *players[MAX_CLIENTS];		// pointers to all players in the game
 
 // extern decs
 extern node_t nodes[MAX_NODES]; 
+extern short int path_table[MAX_NODES][MAX_NODES];
 extern item_table_t item_table[MAX_NODES]; // was MAX_EDICTS
 extern qboolean debug_mode;
 extern int numnodes;
@@ -346,8 +347,12 @@ void     ACEND_UpdateNodeEdge(int from, int to);
 void     ACEND_RemoveNodeEdge(edict_t *self, int from, int to);
 void     ACEND_ResolveAllPaths();
 void     ACEND_SaveNodes();
+void     ACEND_WriteNodes();
 void     ACEND_LoadNodes();
 
+// acebot_navgen.c protos
+void     ACEND_GenerateNodes(void);
+
 // acebot_spawn.c protos
 //void	 ACESP_SaveBots(); // Knightmare- removed this
 //void	 ACESP_LoadBots(); // Knightmare- removed this
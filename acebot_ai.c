@@ -150,7 +150,7 @@ void ACEAI_Think(edict_t *self)
 	// send command through id's code
 	ClientThink (self, &ucmd);
 	
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 //=====================================================================
@@ -304,7 +304,26 @@ void ACEAI_PickShortRangeGoal(edict_t *self)
 	float weight,best_weight=0.0;
 	edict_t *best;
 	int index;
-	
+	edict_t *danger[DANGER_LIST_MAX];
+	int i, num;
+	vec3_t v;
+
+	// Missle avoidance code
+	// Set our movetarget to be the rocket or grenade fired at us. 
+	num = Danger_Find(self->s.origin, 200, DANGER_ROCKET | DANGER_GRENADE, danger, DANGER_LIST_MAX);
+	for (i = 0; i < num; i++)
+	{
+		VectorSubtract(danger[i]->s.origin, self->s.origin, v);
+		if (VectorLength(v) > 200)
+			continue;
+
+		if (debug_mode) 
+			debug_printf("ROCKET ALERT!\n");
+
+		self->movetarget = danger[i];
+		return;
+	}
+
 	// look for a target (should make more efficent later)
 	target = findradius(NULL, self->s.origin, 200);
 	
@@ -312,18 +331,6 @@ void ACEAI_PickShortRangeGoal(edict_t *self)
 	{
 		if (target->classname == NULL)
 			return;
-		
-		// Missle avoidance code
-		// Set our movetarget to be the rocket or grenade fired at us. 
-		if (strcmp(target->classname,"rocket")==0 || strcmp(target->classname,"grenade")==0
-			|| strcmp(target->classname,"homing rocket")==0)
-		{
-			if (debug_mode) 
-				debug_printf("ROCKET ALERT!\n");
-
-			self->movetarget = target;
-			return;
-		}
 	
 		if (ACEIT_IsReachable(self,target->s.origin))
 		{
@@ -132,6 +132,9 @@ qboolean ACEIT_IsReachable(edict_t *self, vec3_t goal)
 	VectorCopy(self->mins,v);
 	v[2] += 18; // Stepsize
 
+	if (CModel_Blocked(self->s.origin, v, self->maxs, goal, MASK_OPAQUE, NULL))
+		return false;
+
 	trace = gi.trace(self->s.origin, v, self->maxs, goal, self, MASK_OPAQUE);
 	
 	// Yes we can see it
@@ -148,6 +151,9 @@ qboolean ACEIT_IsReachable(edict_t *self, vec3_t goal)
 qboolean ACEIT_IsVisible(edict_t *self, vec3_t goal)
 {
 	trace_t trace;
+
+	if (CModel_Blocked(self->s.origin, vec3_origin, vec3_origin, goal, MASK_OPAQUE, NULL))
+		return false;
 	
 	trace = gi.trace(self->s.origin, vec3_origin, vec3_origin, goal, self, MASK_OPAQUE);
 	
@@ -666,7 +672,8 @@ void ACEIT_BuildItemNodeTable (qboolean rebuild)
 			continue;
 		if (!items->classname)
 			continue;
-		if (items->solid == SOLID_NOT)
+		// Items aren't solid until they've dropped to the floor, which is after the node table is loaded
+		if (items->solid == SOLID_NOT && items->think != droptofloor)
 			continue;
 		
 		
@@ -0,0 +1,730 @@
+/*
+Copyright (C) 1998 Steve Yeager
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+///////////////////////////////////////////////////////////////////////
+//
+//  ACE - Quake II Bot Base Code
+//
+//  Version 1.0
+//
+//  This file is Copyright(c), Steve Yeager 1998, All Rights Reserved
+//
+//
+//	All other files are Copyright(c) Id Software, Inc.
+//
+//	Please see liscense.txt in the source directory for the copyright
+//	information regarding those files belonging to Id Software, Inc.
+//	
+//	Should you decide to release a modified version of ACE, you MUST
+//	include the following text (minus the BEGIN and END lines) in the 
+//	documentation for your modification.
+//
+//	--- BEGIN ---
+//
+//	The ACE Bot is a product of Steve Yeager, and is available from
+//	the ACE Bot homepage, at http://www.axionfx.com/ace.
+//
+//	This program is a modification of the ACE Bot, and is therefore
+//	in NO WAY supported by Steve Yeager.
+//
+//	--- END ---
+//
+//	I, Steve Yeager, hold no responsibility for any harm caused by the
+//	use of this source code, especially to small children and animals.
+//  It is provided as-is with no implied warranty or support.
+//
+//  I also wish to thank and acknowledge the great work of others
+//  that has helped me to develop this code.
+//
+//  John Cricket    - For ideas and swapping code.
+//  Ryan Feltrin    - For ideas and swapping code.
+//  SABIN           - For showing how to do true client based movement.
+//  BotEpidemic     - For keeping us up to date.
+//  Telefragged.com - For giving ACE a home.
+//  Microsoft       - For giving us such a wonderful crash free OS.
+//  id              - Need I say more.
+//  
+//  And to all the other testers, pathers, and players and people
+//  who I can't remember who the heck they were, but helped out.
+//
+///////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////
+//
+//  acebot_navgen.c - Builds a complete node table for the current
+//                    map from its collision model, so bots don't
+//                    have to learn it from players first.
+//
+//  "sv acegen [spacing]" drops a player sized box down a grid of
+//  columns to find floors, adds nodes for water and ladders, links
+//  nodes a bot can walk, fall, swim, climb or jump between, and
+//  writes nav/<mapname>.nod. Run it on a dedicated server, e.g.
+//  +set deathmatch 1 +map q2dm1 +sv acegen +quit
+//
+///////////////////////////////////////////////////////////////////////
+
+#include "g_local.h"
+#include "acebot.h"
+
+#define GEN_MAX_LINKS	16		// per node
+#define GEN_MAX_LADDERS	128
+#define GEN_MAX_FLOORS	16		// per column
+#define GEN_STEPSIZE	18		// same as pmove
+#define GEN_JUMPHEIGHT	44		// a bit under what a standing jump clears
+#define GEN_MAXFALL		192		// don't drop further than this, it hurts
+#define GEN_MOVESTEP	16		// walking simulation step
+#define GEN_LADDERSTEP	64
+
+typedef struct
+{
+	short	links[GEN_MAX_LINKS];
+	int		numlinks;
+} genlinks_t;
+
+static genlinks_t	*gen_links;
+static int			gen_numlinks;
+static int			gen_traces;
+static qboolean		gen_full;	// ran out of nodes
+
+static vec3_t gen_mins = { -16, -16, -24 };
+static vec3_t gen_maxs = { 16, 16, 32 };
+
+static trace_t ACEND_GenTrace(vec3_t start, vec3_t mins, vec3_t maxs, vec3_t end)
+{
+	trace_t tr;
+
+	CModel_Trace(start, mins, maxs, end, MASK_PLAYERSOLID, &tr);
+	gen_traces++;
+
+	return tr;
+}
+
+static int ACEND_GenAddNode(vec3_t origin, int type)
+{
+	if (numnodes >= MAX_NODES)
+	{
+		gen_full = true;
+		return INVALID;
+	}
+
+	VectorCopy(origin, nodes[numnodes].origin);
+	nodes[numnodes].type = type;
+
+	return numnodes++;
+}
+
+static void ACEND_GenLink(int from, int to)
+{
+	genlinks_t *l = &gen_links[from];
+
+	if (from == to || l->numlinks == GEN_MAX_LINKS)
+		return;
+
+	for (int i = 0; i < l->numlinks; i++)
+		if (l->links[i] == to)
+			return;
+
+	l->links[l->numlinks++] = to;
+	gen_numlinks++;
+}
+
+// True if there's a node within dist of origin (and about the same height)
+static qboolean ACEND_GenNodeNear(vec3_t origin, float dist)
+{
+	for (int i = 1; i < numnodes; i++)
+	{
+		if (fabsf(nodes[i].origin[2] - origin[2]) < 32 &&
+			fabsf(nodes[i].origin[0] - origin[0]) < dist && fabsf(nodes[i].origin[1] - origin[1]) < dist)
+			return true;
+	}
+
+	return false;
+}
+
+static qboolean ACEND_GenHurts(vec3_t origin)
+{
+	vec3_t feet;
+
+	VectorCopy(origin, feet);
+	feet[2] -= 18;
+
+	return ((CModel_PointContents(origin) | CModel_PointContents(feet)) & (CONTENTS_LAVA|CONTENTS_SLIME)) != 0;
+}
+
+// Moves a player box at origin down to the floor below it, no further than dist
+static qboolean ACEND_GenDropToFloor(vec3_t origin, vec3_t out, float dist)
+{
+	vec3_t end;
+
+	VectorCopy(origin, end);
+	end[2] -= dist;
+
+	const trace_t tr = ACEND_GenTrace(origin, gen_mins, gen_maxs, end);
+	if (tr.startsolid || tr.fraction == 1 || tr.plane.normal[2] < 0.7f)
+		return false;
+
+	VectorCopy(tr.endpos, out);
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Floors and water
+///////////////////////////////////////////////////////////////////////
+static void ACEND_GenAddFloor(vec3_t origin, float spacing)
+{
+	vec3_t surface;
+
+	if (ACEND_GenHurts(origin) || ACEND_GenNodeNear(origin, spacing / 2))
+		return;
+
+	if (!(CModel_PointContents(origin) & MASK_WATER))
+	{
+		ACEND_GenAddNode(origin, NODE_MOVE);
+		return;
+	}
+
+	ACEND_GenAddNode(origin, NODE_WATER);
+
+	// Deep water gets another node where you'd swim
+	VectorCopy(origin, surface);
+	while (CModel_PointContents(surface) & MASK_WATER && surface[2] < origin[2] + 1024)
+		surface[2] += 8;
+
+	surface[2] -= 24;
+	if (surface[2] - origin[2] > 64)
+		ACEND_GenAddNode(surface, NODE_WATER);
+}
+
+// Drops a player box down the column at x, y and adds a node on every floor it lands on
+static void ACEND_GenColumn(float x, float y, vec3_t wmins, vec3_t wmaxs, float spacing)
+{
+	vec3_t start, end;
+	float z = wmaxs[2] - gen_maxs[2];
+
+	for (int floors = 0; floors < GEN_MAX_FLOORS && !gen_full; floors++)
+	{
+		// Find open space, inside the map
+		VectorSet(start, x, y, z);
+		trace_t tr = ACEND_GenTrace(start, gen_mins, gen_maxs, start);
+		while (tr.startsolid && start[2] > wmins[2])
+		{
+			start[2] -= 16;
+			tr = ACEND_GenTrace(start, gen_mins, gen_maxs, start);
+		}
+
+		if (tr.startsolid)
+			return;
+
+		VectorSet(end, x, y, wmins[2]);
+		tr = ACEND_GenTrace(start, gen_mins, gen_maxs, end);
+		if (tr.fraction == 1 || tr.allsolid)
+			return;
+
+		if (tr.plane.normal[2] >= 0.7f)
+			ACEND_GenAddFloor(tr.endpos, spacing);
+
+		// Carry on under this floor
+		z = tr.endpos[2] + gen_mins[2] - gen_maxs[2] - 1;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// Ladders: a column of nodes up the open side of every ladder brush
+///////////////////////////////////////////////////////////////////////
+static void ACEND_GenLadders(void)
+{
+	vec3_t mins[GEN_MAX_LADDERS], maxs[GEN_MAX_LADDERS];
+	const int count = CModel_BrushBounds(CONTENTS_LADDER, mins, maxs, GEN_MAX_LADDERS);
+
+	for (int i = 0; i < count && !gen_full; i++)
+	{
+		vec3_t center, pos;
+		int side;
+
+		VectorAdd(mins[i], maxs[i], center);
+		VectorScale(center, 0.5f, center);
+
+		// Try the wide faces first, the other side is usually a wall
+		const int axis = (maxs[i][0] - mins[i][0] < maxs[i][1] - mins[i][1] ? 0 : 1);
+		for (side = 0; side < 4; side++)
+		{
+			const int a = (side < 2 ? axis : !axis);
+
+			VectorCopy(center, pos);
+			pos[a] = ((side & 1) ? mins[i][a] + gen_mins[a] - 1 : maxs[i][a] + gen_maxs[a] + 1);
+
+			if (!ACEND_GenTrace(pos, gen_mins, gen_maxs, pos).startsolid)
+				break;
+		}
+
+		if (side == 4)
+			continue;
+
+		// From standing at the bottom to standing at the top
+		const float top = maxs[i][2] - gen_mins[2] + 1;
+		int last = INVALID;
+
+		for (float z = mins[i][2] - gen_mins[2] + 1; z < top + GEN_LADDERSTEP && !gen_full; z += GEN_LADDERSTEP)
+		{
+			pos[2] = min(z, top);
+			if (ACEND_GenTrace(pos, gen_mins, gen_maxs, pos).startsolid)
+				continue;
+
+			const int node = ACEND_GenAddNode(pos, NODE_LADDER);
+			if (node != INVALID && last != INVALID)
+			{
+				ACEND_GenLink(last, node);
+				ACEND_GenLink(node, last);
+			}
+
+			last = node;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// Walks a player box from a to b, stepping up stairs and falling off
+// ledges on the way. True if it gets there.
+///////////////////////////////////////////////////////////////////////
+static qboolean ACEND_GenWalk(vec3_t a, vec3_t b)
+{
+	vec3_t pos, goal, dir, next, up;
+
+	if (!ACEND_GenDropToFloor(a, pos, 64) || !ACEND_GenDropToFloor(b, goal, 64))
+		return false;
+
+	for (int i = 0; i < 64; i++)
+	{
+		VectorSubtract(goal, pos, dir);
+		dir[2] = 0;
+
+		if (VectorNormalize(dir) < GEN_MOVESTEP)
+			return (fabsf(goal[2] - pos[2]) <= GEN_STEPSIZE);
+
+		VectorMA(pos, GEN_MOVESTEP, dir, next);
+		trace_t tr = ACEND_GenTrace(pos, gen_mins, gen_maxs, next);
+
+		if (tr.fraction < 1)
+		{
+			// Step up
+			VectorCopy(pos, up);
+			up[2] += GEN_STEPSIZE;
+			if (ACEND_GenTrace(pos, gen_mins, gen_maxs, up).fraction < 1)
+				return false;
+
+			next[2] = up[2];
+			tr = ACEND_GenTrace(up, gen_mins, gen_maxs, next);
+			if (tr.fraction < 1)
+				return false;
+		}
+
+		// Back down to the floor, or fall
+		VectorCopy(tr.endpos, pos);
+		VectorCopy(pos, next);
+		next[2] -= GEN_STEPSIZE + GEN_MAXFALL;
+
+		tr = ACEND_GenTrace(pos, gen_mins, gen_maxs, next);
+		if (tr.fraction == 1 || tr.plane.normal[2] < 0.7f || ACEND_GenHurts(tr.endpos))
+			return false;
+
+		VectorCopy(tr.endpos, pos);
+	}
+
+	return false;
+}
+
+// Jump from a up onto b
+static qboolean ACEND_GenJump(vec3_t a, vec3_t b)
+{
+	vec3_t pos, goal, up, over;
+
+	if (!ACEND_GenDropToFloor(a, pos, 64) || !ACEND_GenDropToFloor(b, goal, 64))
+		return false;
+
+	const float height = goal[2] - pos[2];
+	if (height <= GEN_STEPSIZE || height > GEN_JUMPHEIGHT)
+		return false;
+
+	VectorCopy(pos, up);
+	up[2] += GEN_JUMPHEIGHT;
+	if (ACEND_GenTrace(pos, gen_mins, gen_maxs, up).fraction < 1)
+		return false;
+
+	VectorSet(over, goal[0], goal[1], up[2]);
+	if (ACEND_GenTrace(up, gen_mins, gen_maxs, over).fraction < 1)
+		return false;
+
+	const trace_t tr = ACEND_GenTrace(over, gen_mins, gen_maxs, goal);
+
+	return (tr.fraction == 1 || fabsf(tr.endpos[2] - goal[2]) < 1);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Links every pair of nodes a bot can get between
+///////////////////////////////////////////////////////////////////////
+static void ACEND_GenLinks(float spacing)
+{
+	const float range = spacing * 1.6f;
+	trace_t tr;
+	vec3_t d;
+
+	for (int a = 1; a < numnodes; a++)
+	{
+		const int ta = nodes[a].type;
+
+		for (int b = 1; b < numnodes; b++)
+		{
+			const int tb = nodes[b].type;
+
+			if (a == b || gen_links[a].numlinks == GEN_MAX_LINKS)
+				continue;
+
+			VectorSubtract(nodes[b].origin, nodes[a].origin, d);
+			if (fabsf(d[0]) > range || fabsf(d[1]) > range || fabsf(d[2]) > GEN_MAXFALL + GEN_STEPSIZE)
+				continue;
+
+			// Ladder columns are already linked, ladders don't link to each other otherwise
+			if (ta == NODE_LADDER && tb == NODE_LADDER)
+				continue;
+
+			if (ta == NODE_LADDER || tb == NODE_LADDER)
+			{
+				// Getting on and off, same test the learning code uses
+				CModel_Trace(nodes[a].origin, vec3_origin, vec3_origin, nodes[b].origin, MASK_OPAQUE, &tr);
+				gen_traces++;
+
+				if (tr.fraction == 1 && VectorLength(d) < spacing)
+					ACEND_GenLink(a, b);
+
+				continue;
+			}
+
+			if (ta == NODE_WATER || tb == NODE_WATER)
+			{
+				// Swimming goes any way, but you can't climb out of water onto something too high
+				if (VectorLength(d) > range || (tb != NODE_WATER && d[2] > 48))
+					continue;
+
+				tr = ACEND_GenTrace(nodes[a].origin, gen_mins, gen_maxs, nodes[b].origin);
+				if (tr.fraction == 1)
+					ACEND_GenLink(a, b);
+
+				continue;
+			}
+
+			if (ACEND_GenWalk(nodes[a].origin, nodes[b].origin))
+			{
+				ACEND_GenLink(a, b);
+			}
+			else if (d[0] * d[0] + d[1] * d[1] <= spacing * spacing && ACEND_GenJump(nodes[a].origin, nodes[b].origin))
+			{
+				ACEND_GenLink(a, b);
+				if (tb == NODE_MOVE)
+					nodes[b].type = NODE_JUMP;
+			}
+		}
+	}
+}
+
+// Teleporter to destination links
+static void ACEND_GenTeleporters(void)
+{
+	edict_t *ent = NULL;
+
+	while ((ent = G_Find(ent, FOFS(classname), "misc_teleporter")) != NULL)
+	{
+		edict_t *dest = G_PickTarget(ent->target);
+		int from = INVALID, to = INVALID;
+
+		if (!dest)
+			continue;
+
+		for (int i = 1; i < numnodes; i++)
+		{
+			if (nodes[i].type != NODE_TELEPORTER)
+				continue;
+
+			if (VectorCompare(nodes[i].origin, tv(ent->s.origin[0], ent->s.origin[1], ent->s.origin[2] + 32)))
+				from = i;
+			else if (VectorCompare(nodes[i].origin, tv(dest->s.origin[0], dest->s.origin[1], dest->s.origin[2] + 32)))
+				to = i;
+		}
+
+		if (from != INVALID && to != INVALID)
+			ACEND_GenLink(from, to);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// Keeps the item, platform and teleporter nodes from the current table.
+// They were made when the map spawned, before items dropped to the
+// floor, and that's where ACEIT_BuildItemNodeTable looks for them when
+// the file is loaded. Everything else is thrown away.
+///////////////////////////////////////////////////////////////////////
+static void ACEND_GenKeepItemNodes(void)
+{
+	static short remap[MAX_NODES];
+	int count = 1;
+
+	for (int i = 1; i < numnodes; i++)
+	{
+		const int type = nodes[i].type;
+		remap[i] = (type == NODE_ITEM || type == NODE_PLATFORM || type == NODE_TELEPORTER ? count++ : INVALID);
+	}
+
+	// The link from the bottom of a platform to its top
+	for (int i = 1; i < numnodes; i++)
+		if (nodes[i].type == NODE_PLATFORM)
+			for (int j = 1; j < numnodes; j++)
+				if (nodes[j].type == NODE_PLATFORM && path_table[i][j] == j)
+					ACEND_GenLink(remap[i], remap[j]);
+
+	for (int i = 0; i < num_items; i++)
+		if (item_table[i].node > 0 && item_table[i].node < numnodes)
+			item_table[i].node = remap[item_table[i].node];
+
+	for (int i = 1; i < numnodes; i++)
+		if (remap[i] != INVALID)
+			nodes[remap[i]] = nodes[i];
+
+	numnodes = count;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Removes generated nodes nobody can get to from a spawn point or an
+// item. Item, platform and teleporter nodes are kept, they come first
+// so item_table doesn't change.
+///////////////////////////////////////////////////////////////////////
+static int ACEND_GenPrune(int firstgen)
+{
+	static short queue[MAX_NODES];
+	static short remap[MAX_NODES];
+	static byte reached[MAX_NODES];
+	static char *spawns[] = { "info_player_deathmatch", "info_player_start", "info_player_team1", "info_player_team2", "info_player_team3", NULL };
+	int head = 0, tail = 0;
+
+	memset(reached, 0, sizeof(reached));
+
+	for (int i = 1; i < firstgen; i++)
+	{
+		reached[i] = true;
+		queue[tail++] = i;
+	}
+
+	for (int s = 0; spawns[s]; s++)
+	{
+		edict_t *ent = NULL;
+		while ((ent = G_Find(ent, FOFS(classname), spawns[s])) != NULL)
+		{
+			vec3_t floor;
+			if (!ACEND_GenDropToFloor(ent->s.origin, floor, 128))
+				continue;
+
+			for (int i = firstgen; i < numnodes; i++)
+			{
+				if (!reached[i] && fabsf(nodes[i].origin[2] - floor[2]) <= GEN_STEPSIZE && ACEND_GenWalk(floor, nodes[i].origin))
+				{
+					reached[i] = true;
+					queue[tail++] = i;
+				}
+			}
+		}
+	}
+
+	while (head < tail)
+	{
+		const genlinks_t *l = &gen_links[queue[head++]];
+		for (int i = 0; i < l->numlinks; i++)
+		{
+			if (!reached[l->links[i]])
+			{
+				reached[l->links[i]] = true;
+				queue[tail++] = l->links[i];
+			}
+		}
+	}
+
+	// Close up the gaps
+	int count = 1;
+	for (int i = 1; i < numnodes; i++)
+	{
+		remap[i] = (reached[i] ? count++ : INVALID);
+		if (remap[i] != INVALID)
+		{
+			nodes[remap[i]] = nodes[i];
+			gen_links[remap[i]] = gen_links[i];
+		}
+	}
+
+	const int removed = numnodes - count;
+	numnodes = count;
+	gen_numlinks = 0;
+
+	for (int i = 1; i < numnodes; i++)
+	{
+		genlinks_t *l = &gen_links[i];
+		int n = 0;
+
+		for (int j = 0; j < l->numlinks; j++)
+			if (remap[l->links[j]] != INVALID)
+				l->links[n++] = remap[l->links[j]];
+
+		l->numlinks = n;
+		gen_numlinks += n;
+	}
+
+	return removed;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Fills path_table with the first hop of the shortest path between
+// every two nodes: a breadth first search back from each goal.
+///////////////////////////////////////////////////////////////////////
+static void ACEND_GenPaths(void)
+{
+	static short queue[MAX_NODES];
+	static int firstback[MAX_NODES + 1];
+	static int fill[MAX_NODES];
+	short *back = malloc(sizeof(short) * max(gen_numlinks, 1));
+
+	if (!back)
+		gi.error("ACEND_GenPaths: out of memory");
+
+	// Reverse links, grouped by destination
+	memset(firstback, 0, sizeof(firstback));
+	for (int i = 1; i < numnodes; i++)
+		for (int j = 0; j < gen_links[i].numlinks; j++)
+			firstback[gen_links[i].links[j] + 1]++;
+
+	for (int i = 1; i <= numnodes; i++)
+		firstback[i] += firstback[i - 1];
+
+	memcpy(fill, firstback, sizeof(int) * numnodes);
+	for (int i = 1; i < numnodes; i++)
+		for (int j = 0; j < gen_links[i].numlinks; j++)
+			back[fill[gen_links[i].links[j]]++] = i;
+
+	memset(path_table, INVALID, sizeof(short int) * MAX_NODES * MAX_NODES);
+
+	for (int goal = 1; goal < numnodes; goal++)
+	{
+		int head = 0, tail = 0;
+
+		queue[tail++] = goal;
+		while (head < tail)
+		{
+			const int node = queue[head++];
+
+			for (int k = firstback[node]; k < firstback[node + 1]; k++)
+			{
+				const int from = back[k];
+				if (from == goal || path_table[from][goal] != INVALID)
+					continue;
+
+				path_table[from][goal] = node;
+				queue[tail++] = from;
+			}
+		}
+	}
+
+	free(back);
+}
+
+///////////////////////////////////////////////////////////////////////
+// sv acegen [spacing]
+///////////////////////////////////////////////////////////////////////
+void ACEND_GenerateNodes(void)
+{
+	vec3_t wmins, wmaxs;
+	int count[NODE_JUMP + 1] = { 0 };
+
+	// Bots, and their node table, only run in deathmatch
+	if (!deathmatch->value)
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "ACE: can only generate nodes in deathmatch mode.\n");
+		return;
+	}
+
+	if (!CModel_WorldBounds(wmins, wmaxs))
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "ACE: no collision model for %s, can't generate nodes\n", level.mapname);
+		return;
+	}
+
+	float spacing = atof(gi.argv(2));
+	if (spacing < 32)
+		spacing = NODE_DENSITY;
+
+	const clock_t start = clock();
+
+	gen_links = malloc(sizeof(genlinks_t) * MAX_NODES);
+	if (!gen_links)
+		return;
+
+	memset(gen_links, 0, sizeof(genlinks_t) * MAX_NODES);
+	gen_numlinks = 0;
+	gen_traces = 0;
+	gen_full = false;
+
+	ACEND_GenKeepItemNodes();
+
+	const int firstgen = numnodes;
+
+	ACEND_GenLadders();
+
+	for (float x = wmins[0] + spacing / 2; x < wmaxs[0] && !gen_full; x += spacing)
+		for (float y = wmins[1] + spacing / 2; y < wmaxs[1] && !gen_full; y += spacing)
+			ACEND_GenColumn(x, y, wmins, wmaxs, spacing);
+
+	if (gen_full)
+		safe_cprintf(NULL, PRINT_HIGH, "ACE: more than %d nodes, try a bigger spacing than %g\n", MAX_NODES, spacing);
+
+	ACEND_GenLinks(spacing);
+	ACEND_GenTeleporters();
+
+	const int removed = ACEND_GenPrune(firstgen);
+	ACEND_GenPaths();
+
+	free(gen_links);
+	gen_links = NULL;
+
+	for (int i = 1; i < numnodes; i++)
+		if (nodes[i].type <= NODE_JUMP)
+			count[nodes[i].type]++;
+
+	safe_cprintf(NULL, PRINT_HIGH, "ACE: %d nodes (%d move, %d jump, %d water, %d ladder, %d item), %d links, %d unreachable removed\n",
+		numnodes - 1, count[NODE_MOVE], count[NODE_JUMP], count[NODE_WATER], count[NODE_LADDER], count[NODE_ITEM], gen_numlinks, removed);
+	safe_cprintf(NULL, PRINT_HIGH, "ACE: %d traces, %.2f seconds\n", gen_traces, (float)(clock() - start) / CLOCKS_PER_SEC);
+
+	ACEND_WriteNodes();
+
+	// Node numbers have all changed
+	for (int i = 1; i <= game.maxclients; i++)
+	{
+		edict_t *ent = &g_edicts[i];
+		if (!ent->inuse)
+			continue;
+
+		ent->current_node = ent->goal_node = ent->next_node = ent->last_node = INVALID;
+		if (ent->is_bot)
+			ent->state = STATE_WANDER;
+	}
+}
@@ -132,23 +132,20 @@ int ACEND_FindCost(int from, int to)
 ///////////////////////////////////////////////////////////////////////
 int ACEND_FindCloseReachableNode(edict_t *self, int range, int type)
 {
-	vec3_t v;
 	int i;
 	trace_t tr;
-	float dist;
+	static float dist[MAX_NODES];
 
 	range *= range;
 
+	// distances to all nodes in one go
+	VectorDistSquaredBatch(self->s.origin, nodes[0].origin, sizeof(node_t), numnodes, dist);
+
 	for (i=0;i<numnodes;i++)
 	{
 		if (type == NODE_ALL || type == nodes[i].type) // check node type
 		{
-		
-			VectorSubtract(nodes[i].origin,self->s.origin,v); // subtract first
-
-			dist = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
-
-			if (dist < range) // square range instead of sqrt
+			if (dist[i] < range) // square range instead of sqrt
 			{
 				// make sure it is visible
 				//trace = gi.trace(self->s.origin, vec3_origin, vec3_origin, nodes[i].origin, self, MASK_OPAQUE);
@@ -170,9 +167,8 @@ int ACEND_FindClosestReachableNode(edict_t *self, int range, int type)
 {
 	int i;
 	float closest = 99999;
-	float dist;
+	static float dist[MAX_NODES];
 	int node=-1;
-	vec3_t v;
 	trace_t tr;
 	float rng;
 	vec3_t maxs,mins;
@@ -190,23 +186,22 @@ int ACEND_FindClosestReachableNode(edict_t *self, int range, int type)
 		mins[2] += 18; // Stepsize
 
 	rng = (float)(range * range); // square range for distance comparison (eliminate sqrt)	
+
+	// distances to all nodes in one go
+	VectorDistSquaredBatch(self->s.origin, nodes[0].origin, sizeof(node_t), numnodes, dist);
 	
 	for (i=0;i<numnodes;i++)
 	{		
 		if (type == NODE_ALL || type == nodes[i].type) // check node type
 		{
-			VectorSubtract(nodes[i].origin, self->s.origin,v); // subtract first
-
-			dist = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
-		
-			if (dist < closest && dist < rng) 
+			if (dist[i] < closest && dist[i] < rng) 
 			{
 				// make sure it is visible
 				tr = gi.trace(self->s.origin, mins, maxs, nodes[i].origin, self, MASK_OPAQUE);
 				if (tr.fraction == 1.0)
 				{
 					node = i;
-					closest = dist;
+					closest = dist[i];
 				}
 			}
 		}
@@ -506,7 +501,7 @@ void ACEND_ShowNode(int node)
 
 	ent->s.modelindex = gi.modelindex("models/items/ammo/grenades/medium/tris.md2");
 	ent->owner = ent;
-	ent->nextthink = level.time + 200000.0;
+	G_SetNextThink(ent, level.time + 200000.0);
 	ent->think = G_FreeEdict;                
 	ent->dmg = 0;
 
@@ -530,11 +525,11 @@ void ACEND_DrawPath()
 	// Now set up and display the path
 	while (current_node != goal_node && current_node != -1)
 	{
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_BFG_LASER);
-		gi.WritePosition(nodes[current_node].origin);
-		gi.WritePosition(nodes[next_node].origin);
-		gi.multicast(nodes[current_node].origin, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_BFG_LASER);
+		TempEnt_WritePosition(nodes[current_node].origin);
+		TempEnt_WritePosition(nodes[next_node].origin);
+		TempEnt_Multicast(nodes[current_node].origin, MULTICAST_PVS);
 		current_node = next_node;
 		next_node = path_table[current_node][goal_node];
 	}
@@ -748,6 +743,17 @@ void ACEND_ResolveAllPaths()
 // a big deal.
 ///////////////////////////////////////////////////////////////////////
 void ACEND_SaveNodes()
+{
+	// Resolve paths
+	ACEND_ResolveAllPaths();
+
+	ACEND_WriteNodes();
+}
+
+///////////////////////////////////////////////////////////////////////
+// Write the node table as it is, paths already resolved
+///////////////////////////////////////////////////////////////////////
+void ACEND_WriteNodes()
 {
 	FILE *pOut;
 	char tempname[MAX_QPATH] = "";
@@ -755,9 +761,6 @@ void ACEND_SaveNodes()
 //	char filename[60];
 	int i,j;
 	int version = 1;
-	
-	// Resolve paths
-	ACEND_ResolveAllPaths();
 
 	safe_bprintf(PRINT_MEDIUM,"Saving node table...");
 
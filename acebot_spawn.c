@@ -156,7 +156,7 @@ void ACESP_HoldSpawn(edict_t *self)
 	gi.linkentity(self);
 
 	self->think = ACEAI_Think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	// send effect
 	gi.WriteByte(svc_muzzleflash);
@@ -318,7 +318,7 @@ void ACESP_PutClientInServer(edict_t *bot, qboolean respawn, int team)
 	{
 		bot->think = ACESP_HoldSpawn;
 		//bot->nextthink = level.time + 0.1; //mxd
-		bot->nextthink = level.time + random()*3.0f; // up to three seconds
+		G_SetNextThink(bot, level.time + random()*3.0f); // up to three seconds
 	}
 	else
 	{
@@ -329,7 +329,7 @@ void ACESP_PutClientInServer(edict_t *bot, qboolean respawn, int team)
 		gi.linkentity(bot);
 
 		bot->think = ACEAI_Think;
-		bot->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(bot, level.time + FRAMETIME);
 
 		// send effect
 		gi.WriteByte(svc_muzzleflash);
@@ -0,0 +1,126 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#ifndef BSP_H
+#define BSP_H
+
+// .bsp file format (version 38), the lumps the collision code needs
+
+#define BSP_IDENT		(('P'<<24)+('S'<<16)+('B'<<8)+'I') // "IBSP"
+#define BSP_VERSION		38
+
+#define LUMP_ENTITIES		0
+#define LUMP_PLANES			1
+#define LUMP_VERTEXES		2
+#define LUMP_VISIBILITY		3
+#define LUMP_NODES			4
+#define LUMP_TEXINFO		5
+#define LUMP_FACES			6
+#define LUMP_LIGHTING		7
+#define LUMP_LEAFS			8
+#define LUMP_LEAFFACES		9
+#define LUMP_LEAFBRUSHES	10
+#define LUMP_EDGES			11
+#define LUMP_SURFEDGES		12
+#define LUMP_MODELS			13
+#define LUMP_BRUSHES		14
+#define LUMP_BRUSHSIDES		15
+#define LUMP_POP			16
+#define LUMP_AREAS			17
+#define LUMP_AREAPORTALS	18
+#define HEADER_LUMPS		19
+
+typedef struct
+{
+	int fileofs;
+	int filelen;
+} lump_t;
+
+typedef struct
+{
+	int ident;
+	int version;
+	lump_t lumps[HEADER_LUMPS];
+} dheader_t;
+
+typedef struct
+{
+	float mins[3];
+	float maxs[3];
+	float origin[3]; // for sounds or lights
+	int headnode;
+	int firstface;
+	int numfaces;
+} dmodel_t;
+
+typedef struct
+{
+	float normal[3];
+	float dist;
+	int type; // PLANE_X - PLANE_ANYZ
+} dplane_t;
+
+typedef struct
+{
+	int planenum;
+	int children[2]; // negative numbers are -(leafs+1), not nodes
+	short mins[3]; // for frustom culling
+	short maxs[3];
+	unsigned short firstface;
+	unsigned short numfaces; // counting both sides
+} dnode_t;
+
+typedef struct
+{
+	float vecs[2][4]; // [s/t][xyz offset]
+	int flags; // miptex flags + overrides
+	int value; // light emission, etc
+	char texture[32]; // texture name (textures/*.wal)
+	int nexttexinfo; // for animations, -1 = end of chain
+} texinfo_t;
+
+typedef struct
+{
+	int contents; // OR of all brushes (not needed?)
+	short cluster;
+	short area;
+	short mins[3]; // for frustum culling
+	short maxs[3];
+	unsigned short firstleafface;
+	unsigned short numleaffaces;
+	unsigned short firstleafbrush;
+	unsigned short numleafbrushes;
+} dleaf_t;
+
+typedef struct
+{
+	unsigned short planenum; // facing out of the leaf
+	short texinfo;
+} dbrushside_t;
+
+typedef struct
+{
+	int firstside;
+	int numsides;
+	int contents;
+} dbrush_t;
+
+#endif // BSP_H
@@ -412,14 +412,19 @@ qboolean visible(edict_t *self, edict_t *other)
 	spot1[2] += self->viewheight;
 	VectorCopy(other->s.origin, spot2);
 	spot2[2] += other->viewheight;
+
+	// A wall in the way is the usual answer, and doesn't need the engine
+	if (CModel_Blocked(spot1, vec3_origin, vec3_origin, spot2, MASK_OPAQUE, other))
+		return false;
+
 	const trace_t trace = gi.trace(spot1, vec3_origin, vec3_origin, spot2, self, MASK_OPAQUE);
 
 	// Lazarus: Take fog into account for monsters
 	if (trace.fraction == 1.0f || trace.ent == other)
 	{
-		if (level.active_fog && (self->svflags & SVF_MONSTER))
+		fog_t *pfog = Fog_At(other);
+		if (pfog && (self->svflags & SVF_MONSTER))
 		{
-			fog_t *pfog = &level.fog;
 
 			vec3_t v;
 			VectorSubtract(spot2, spot1, v);
@@ -91,7 +91,7 @@ void faker_animate(edict_t *self)
 			self->s.frame = 0;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -124,7 +124,7 @@ void camera_on(edict_t *ent)
 	faker->s = ent->s;
 	faker->takedamage   = DAMAGE_AIM;
 	faker->movetype     = MOVETYPE_WALK;
-	faker->groundentity = ent->groundentity;
+	G_SetGroundEntity(faker, ent->groundentity);
 	faker->viewheight   = ent->viewheight;
 	faker->inuse        = true;
 	faker->classname    = "camplayer";
@@ -135,12 +135,12 @@ void camera_on(edict_t *ent)
 	faker->health       = ent->health;
 	faker->light_level  = ent->light_level;
 	faker->think        = faker_animate;
-	faker->nextthink    = level.time + FRAMETIME;
+	G_SetNextThink(faker, level.time + FRAMETIME);
 	VectorCopy(ent->mins, faker->mins);
 	VectorCopy(ent->maxs, faker->maxs);
 	
 	// create a client so you can pick up items/be shot/etc while in camera
-	gclient_t *cl = (gclient_t *)gi.TagMalloc(sizeof(gclient_t), TAG_LEVEL);
+	gclient_t *cl = (gclient_t *)G_TagMalloc(sizeof(gclient_t), TAG_LEVEL, MEM_FAKECLIENT);
 	memset(cl, 0, sizeof(gclient_t));
 	ent->client->camplayer->client = cl; 
 	ent->client->camplayer->target_ent = ent;
@@ -464,7 +464,7 @@ void SP_func_monitor(edict_t *self)
 	self->solid = SOLID_BSP;
 	self->use = use_camera;
 	self->think = func_monitor_init;
-	self->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(self, level.time + 2 * FRAMETIME);
 
 	gi.linkentity(self);
 }
\ No newline at end of file
@@ -0,0 +1,327 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_cmdlimit.c -- client command rate limiting.
+// CheckFlood only stops chat, so a client could have the server build player lists and
+// scoreboards for it as fast as it could send the commands. Each client gets a token bucket
+// per command class (general, queries, chat) that fills at sv_cmdrate tokens a second up to
+// sv_cmdburst. A command costs the tokens in its cmdcost_t, 1 for anything not listed, and is
+// dropped without a word when its class bucket can't pay. The buckets fill by real time, so
+// they keep filling while level.time is frozen.
+
+#include "g_local.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#define CMDCLASS_GENERAL	0
+#define CMDCLASS_QUERY		1	// the server builds a reply for the client
+#define CMDCLASS_CHAT		2	// goes out to other clients
+#define CMDCLASS_NUM		3
+
+#define CMDLIMIT_MAX_COSTS	64
+#define CMDLIMIT_TOP		10	// offenders "sv cmdlimit" lists
+
+typedef struct
+{
+	char	name[32];
+	int		cmdclass;	// CMDCLASS_*
+	float	cost;		// tokens
+} cmdcost_t;
+
+typedef struct
+{
+	float	tokens[CMDCLASS_NUM];
+	int		refilled;	// real time in milliseconds
+	int		allowed;
+	int		dropped[CMDCLASS_NUM];
+	char	netname[16];	// when it last had a command dropped
+	char	lastdropped[32];
+} cmdbucket_t;
+
+static cmdcost_t cmd_costs[CMDLIMIT_MAX_COSTS] =
+{
+	{"say",			CMDCLASS_CHAT,	1},
+	{"say_team",	CMDCLASS_CHAT,	1},
+	{"wave",		CMDCLASS_CHAT,	2},
+	{"players",		CMDCLASS_QUERY,	4},
+	{"playerlist",	CMDCLASS_QUERY,	8},
+	{"score",		CMDCLASS_QUERY,	4},
+	{"help",		CMDCLASS_QUERY,	2},
+	{"inven",		CMDCLASS_QUERY,	2},
+	{"stats",		CMDCLASS_QUERY,	8},
+	{"techcount",	CMDCLASS_QUERY,	4},
+	{"ctfmenu",		CMDCLASS_QUERY,	2},
+	{"whereis",		CMDCLASS_QUERY,	8},
+	{"properties",	CMDCLASS_QUERY,	8},
+	{"entlist",		CMDCLASS_QUERY,	20},
+	{"team",		CMDCLASS_GENERAL,	4},
+	{"kill",		CMDCLASS_GENERAL,	4},
+	{"observer",	CMDCLASS_GENERAL,	4},
+	{"ghost",		CMDCLASS_GENERAL,	4},
+	{"yes",			CMDCLASS_GENERAL,	2},
+	{"no",			CMDCLASS_GENERAL,	2},
+	{"ready",		CMDCLASS_GENERAL,	2},
+	{"notready",	CMDCLASS_GENERAL,	2}
+};
+static int num_cmd_costs = 22;
+
+static char *cmd_class_names[CMDCLASS_NUM] = { "general", "query", "chat" };
+
+static cmdbucket_t	cmd_buckets[MAX_CLIENTS];
+
+static int CmdLimit_Milliseconds(void)
+{
+#ifdef _WIN32
+	return (int)GetTickCount();
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (int)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+#endif
+}
+
+static cmdcost_t *CmdLimit_FindCost(char *cmd)
+{
+	for (int i = 0; i < num_cmd_costs; i++)
+		if (!Q_stricmp(cmd_costs[i].name, cmd))
+			return &cmd_costs[i];
+
+	return NULL;
+}
+
+static void CmdLimit_Fill(cmdbucket_t *b, float burst)
+{
+	for (int i = 0; i < CMDCLASS_NUM; i++)
+		b->tokens[i] = burst;
+
+	b->refilled = CmdLimit_Milliseconds();
+}
+
+/*
+=================
+CmdLimit_Connect
+
+Gives a newly connected client full buckets and clean counts. Called from ClientConnect.
+=================
+*/
+void CmdLimit_Connect(edict_t *ent)
+{
+	const int index = ent - g_edicts - 1;
+	if (index < 0 || index >= MAX_CLIENTS)
+		return;
+
+	cmdbucket_t *b = &cmd_buckets[index];
+	memset(b, 0, sizeof(*b));
+	CmdLimit_Fill(b, (sv_cmdburst ? sv_cmdburst->value : 0));
+}
+
+/*
+=================
+CmdLimit_Drop
+
+Called by ClientCommand before it looks at the command. Takes cmd's cost from ent's bucket for
+its class and returns true if there wasn't enough, in which case the command should be ignored.
+=================
+*/
+qboolean CmdLimit_Drop(edict_t *ent, char *cmd)
+{
+	const int index = ent - g_edicts - 1;
+	if (index < 0 || index >= MAX_CLIENTS || ent->is_bot)
+		return false;
+
+	// Off, and never in single player
+	if (!sv_cmdrate || sv_cmdrate->value <= 0 || game.maxclients == 1)
+		return false;
+
+	const float burst = max(sv_cmdburst->value, 1);
+	cmdbucket_t *b = &cmd_buckets[index];
+
+	const int now = CmdLimit_Milliseconds();
+	const int elapsed = now - b->refilled;
+	if (elapsed < 0 || elapsed > 3600000)
+	{
+		CmdLimit_Fill(b, burst); // Clock went backwards or wrapped
+	}
+	else if (elapsed > 0)
+	{
+		const float add = elapsed * 0.001f * sv_cmdrate->value;
+		for (int i = 0; i < CMDCLASS_NUM; i++)
+			b->tokens[i] = min(b->tokens[i] + add, burst);
+
+		b->refilled = now;
+	}
+
+	const cmdcost_t *c = CmdLimit_FindCost(cmd);
+	const int cmdclass = (c ? c->cmdclass : CMDCLASS_GENERAL);
+	const float cost = min((c ? c->cost : 1), burst); // Anything can be afforded with full buckets
+
+	if (b->tokens[cmdclass] < cost)
+	{
+		b->dropped[cmdclass]++;
+		Q_strncpyz(b->netname, ent->client->pers.netname, sizeof(b->netname));
+		Q_strncpyz(b->lastdropped, cmd, sizeof(b->lastdropped));
+		return true;
+	}
+
+	b->tokens[cmdclass] -= cost;
+	b->allowed++;
+
+	return false;
+}
+
+static int CmdLimit_Dropped(const cmdbucket_t *b)
+{
+	int dropped = 0;
+	for (int i = 0; i < CMDCLASS_NUM; i++)
+		dropped += b->dropped[i];
+
+	return dropped;
+}
+
+/*
+=================
+CmdLimit_Stats_f
+
+"sv cmdlimit [reset]": the clients that have had the most commands dropped
+=================
+*/
+void CmdLimit_Stats_f(void)
+{
+	int order[CMDLIMIT_TOP];
+	int count = 0, total = 0, allowed = 0;
+
+	for (int i = 0; i < min(game.maxclients, MAX_CLIENTS); i++)
+	{
+		const cmdbucket_t *b = &cmd_buckets[i];
+		const int dropped = CmdLimit_Dropped(b);
+
+		allowed += b->allowed;
+		total += dropped;
+		if (!dropped)
+			continue;
+
+		// Insertion sort, keeping the top CMDLIMIT_TOP
+		int n = min(count, CMDLIMIT_TOP - 1);
+		if (count < CMDLIMIT_TOP)
+			count++;
+		else if (CmdLimit_Dropped(&cmd_buckets[order[n]]) >= dropped)
+			continue;
+
+		while (n > 0 && CmdLimit_Dropped(&cmd_buckets[order[n - 1]]) < dropped)
+		{
+			order[n] = order[n - 1];
+			n--;
+		}
+
+		order[n] = i;
+	}
+
+	if (sv_cmdrate->value <= 0 || game.maxclients == 1)
+		safe_cprintf(NULL, PRINT_HIGH, "Command rate limit: off\n");
+	else
+		safe_cprintf(NULL, PRINT_HIGH, "Command rate limit: %g a second, bursts of %g\n", sv_cmdrate->value, sv_cmdburst->value);
+
+	safe_cprintf(NULL, PRINT_HIGH, "  %d commands allowed, %d dropped\n", allowed, total);
+
+	if (count)
+		safe_cprintf(NULL, PRINT_HIGH, "  %-4s %-15s %7s %7s %7s %7s  %s\n", "slot", "name", "dropped", cmd_class_names[0], cmd_class_names[1], cmd_class_names[2], "last");
+
+	for (int i = 0; i < count; i++)
+	{
+		const cmdbucket_t *b = &cmd_buckets[order[i]];
+		safe_cprintf(NULL, PRINT_HIGH, "  %-4d %-15s %7d %7d %7d %7d  %s\n", order[i], b->netname, CmdLimit_Dropped(b),
+			b->dropped[CMDCLASS_GENERAL], b->dropped[CMDCLASS_QUERY], b->dropped[CMDCLASS_CHAT], b->lastdropped);
+	}
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+	{
+		for (int i = 0; i < MAX_CLIENTS; i++)
+		{
+			cmd_buckets[i].allowed = 0;
+			memset(cmd_buckets[i].dropped, 0, sizeof(cmd_buckets[i].dropped));
+		}
+	}
+}
+
+/*
+=================
+CmdLimit_Cost_f
+
+"sv cmdcost [<command> [<cost> [general|query|chat]]]": lists or sets what commands cost
+=================
+*/
+void CmdLimit_Cost_f(void)
+{
+	if (gi.argc() < 3)
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "Command costs (anything else is general, 1):\n");
+		for (int i = 0; i < num_cmd_costs; i++)
+			safe_cprintf(NULL, PRINT_HIGH, "  %-15s %-8s %g\n", cmd_costs[i].name, cmd_class_names[cmd_costs[i].cmdclass], cmd_costs[i].cost);
+
+		return;
+	}
+
+	char *cmd = gi.argv(2);
+	cmdcost_t *c = CmdLimit_FindCost(cmd);
+
+	if (gi.argc() < 4)
+	{
+		if (c)
+			safe_cprintf(NULL, PRINT_HIGH, "%s: %s, %g\n", c->name, cmd_class_names[c->cmdclass], c->cost);
+		else
+			safe_cprintf(NULL, PRINT_HIGH, "%s: general, 1\n", cmd);
+
+		return;
+	}
+
+	int cmdclass = (c ? c->cmdclass : CMDCLASS_GENERAL);
+	if (gi.argc() > 4)
+	{
+		for (cmdclass = 0; cmdclass < CMDCLASS_NUM; cmdclass++)
+			if (!Q_stricmp(gi.argv(4), cmd_class_names[cmdclass]))
+				break;
+
+		if (cmdclass == CMDCLASS_NUM)
+		{
+			safe_cprintf(NULL, PRINT_HIGH, "Unknown command class %s, use general, query or chat\n", gi.argv(4));
+			return;
+		}
+	}
+
+	if (!c)
+	{
+		if (num_cmd_costs == CMDLIMIT_MAX_COSTS)
+		{
+			safe_cprintf(NULL, PRINT_HIGH, "Too many command costs\n");
+			return;
+		}
+
+		c = &cmd_costs[num_cmd_costs++];
+		Q_strncpyz(c->name, cmd, sizeof(c->name));
+	}
+
+	c->cmdclass = cmdclass;
+	c->cost = max(atof(gi.argv(3)), 0);
+}
@@ -194,7 +194,7 @@ void laser_sight_think(edict_t *laser)
 	const trace_t tr = gi.trace(laser->s.origin, laser->mins, laser->maxs, end, player, MASK_SHOT);
 	VectorCopy(tr.endpos, laser->s.origin);
 	gi.linkentity(laser);
-	laser->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(laser, level.time + FRAMETIME);
 }
 
 void SaveEntProps(edict_t *e, FILE *f)
@@ -1578,94 +1578,94 @@ void DrawBBox(edict_t *ent)
 	VectorCopy(ent->s.origin, origin);
 	VectorSet(p1, origin[0] + ent->mins[0], origin[1] + ent->mins[1], origin[2] + ent->mins[2]);
 	VectorSet(p2, origin[0] + ent->mins[0], origin[1] + ent->mins[1], origin[2] + ent->maxs[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 	VectorSet(p2, origin[0] + ent->mins[0], origin[1] + ent->maxs[1], origin[2] + ent->mins[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 	VectorSet(p2, origin[0] + ent->maxs[0], origin[1] + ent->mins[1], origin[2] + ent->mins[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 
 	VectorSet(p1, origin[0] + ent->maxs[0], origin[1] + ent->maxs[1], origin[2] + ent->mins[2]);
 	VectorSet(p2, origin[0] + ent->maxs[0], origin[1] + ent->maxs[1], origin[2] + ent->maxs[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 	VectorSet(p2, origin[0] + ent->maxs[0], origin[1] + ent->mins[1], origin[2] + ent->mins[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 	VectorSet(p2, origin[0] + ent->mins[0], origin[1] + ent->maxs[1], origin[2] + ent->mins[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 
 	VectorSet(p1, origin[0] + ent->maxs[0], origin[1] + ent->mins[1], origin[2] + ent->maxs[2]);
 	VectorSet(p2, origin[0] + ent->maxs[0], origin[1] + ent->mins[1], origin[2] + ent->mins[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 	VectorSet(p2, origin[0] + ent->maxs[0], origin[1] + ent->maxs[1], origin[2] + ent->maxs[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 	VectorSet(p2, origin[0] + ent->mins[0], origin[1] + ent->mins[1], origin[2] + ent->maxs[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 
 	VectorSet(p1, origin[0] + ent->mins[0], origin[1] + ent->maxs[1], origin[2] + ent->maxs[2]);
 	VectorSet(p2, origin[0] + ent->mins[0], origin[1] + ent->maxs[1], origin[2] + ent->mins[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 	VectorSet(p2, origin[0] + ent->mins[0], origin[1] + ent->mins[1], origin[2] + ent->maxs[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 
 	VectorSet(p2, origin[0] + ent->maxs[0], origin[1] + ent->maxs[1], origin[2] + ent->maxs[2]);
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(p1);
-	gi.WritePosition(p2);
-	gi.multicast(p1, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(p1);
+	TempEnt_WritePosition(p2);
+	TempEnt_Multicast(p1, MULTICAST_ALL);
 }
 
 void Cmd_Bbox_f(edict_t *ent)
@@ -1798,19 +1798,19 @@ void decoy_think(edict_t *self)
 		}
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
 void forcewall_think(edict_t *self)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_FORCEWALL);
-	gi.WritePosition(self->pos1);
-	gi.WritePosition(self->pos2);
-	gi.WriteByte(self->style);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
-	self->nextthink = level.time + FRAMETIME;
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_FORCEWALL);
+	TempEnt_WritePosition(self->pos1);
+	TempEnt_WritePosition(self->pos2);
+	TempEnt_WriteByte(self->style);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SpawnForcewall(edict_t	*player)
@@ -1873,7 +1873,7 @@ void SpawnForcewall(edict_t	*player)
 	wall->solid = SOLID_BBOX;
 	wall->clipmask = MASK_PLAYERSOLID | MASK_MONSTERSOLID;
 	wall->think = forcewall_think;
-	wall->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(wall, level.time + FRAMETIME);
 	wall->svflags = SVF_NOCLIENT;
 	wall->classname = "forcewall";
 	wall->activator = player;
@@ -1920,6 +1920,9 @@ void ClientCommand(edict_t *ent)
 	if (!ent->client)
 		return; // not fully in game yet
 
+	if (CmdLimit_Drop(ent, gi.argv(0)))
+		return; // over its command rate
+
 // ACEBOT_ADD
 	if (ACECM_Commands(ent))
 		return;
@@ -2569,7 +2572,7 @@ void ClientCommand(edict_t *ent)
 			}
 
 			edict_t *e = G_Spawn();
-			e->classname = gi.TagMalloc(strlen(parm) + 1, TAG_LEVEL);
+			e->classname = G_TagMalloc(strlen(parm) + 1, TAG_LEVEL, MEM_STRINGS);
 			strcpy(e->classname, parm);
 			
 			vec3_t forward;
@@ -2587,7 +2590,7 @@ void ClientCommand(edict_t *ent)
 			}
 
 			edict_t *e = G_Spawn();
-			e->classname = gi.TagMalloc(12, TAG_LEVEL);
+			e->classname = G_TagMalloc(12, TAG_LEVEL, MEM_STRINGS);
 			strcpy(e->classname, "misc_actor");
 			e->usermodel = gi.argv(1);
 			e->sounds = atoi(gi.argv(2));
@@ -2627,7 +2630,7 @@ void ClientCommand(edict_t *ent)
 			decoy->think        = decoy_think;
 			decoy->monsterinfo.aiflags = AI_GOOD_GUY;
 			decoy->die          = decoy_die;
-			decoy->nextthink    = level.time + FRAMETIME;
+			G_SetNextThink(decoy, level.time + FRAMETIME);
 			VectorCopy(ent->mins, decoy->mins);
 			VectorCopy(ent->maxs, decoy->maxs);
 			gi.linkentity(decoy); 
@@ -0,0 +1,1030 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_cmodel.c -- the game's own copy of the world collision model.
+// The planes, nodes, leafs and brushes of the current map are read from its .bsp when the
+// level spawns, and CModel_Trace traces boxes against them the same way the engine does.
+// The map data is never changed after loading, and a trace keeps all its state on the stack,
+// so CModel_Trace can be called from any number of threads at once.
+// Only world geometry is in here. Anything that can also be blocked by entities (brush models
+// included) still needs gi.trace, so the perception checks use CModel_Blocked to skip gi.trace
+// when the world alone already answers the question.
+// The data is kept across level changes while the map stays the same, in malloc'd memory like
+// the file index, since TAG_GAME is freed when a savegame is loaded.
+
+#include "g_local.h"
+#include "bsp.h"
+
+#define CM_MAX_BRUSHES	8192	// brushes past this aren't remembered as checked, just tested again
+#define DIST_EPSILON	0.03125f	// 1/32 epsilon to keep floating point happy
+#define CM_MAX_COORD	65536		// bigger than any map
+
+typedef struct
+{
+	cplane_t	*plane;
+	int			children[2];	// negative numbers are leafs
+} cnode_t;
+
+typedef struct
+{
+	cplane_t	*plane;
+	csurface_t	*surface;
+} cbrushside_t;
+
+typedef struct
+{
+	int				contents;
+	unsigned short	firstleafbrush;
+	unsigned short	numleafbrushes;
+} cleaf_t;
+
+typedef struct
+{
+	int			contents;
+	int			numsides;
+	int			firstbrushside;
+} cbrush_t;
+
+typedef struct
+{
+	char			name[MAX_QPATH];
+	int				size;			// of the .bsp
+
+	int				numplanes;
+	cplane_t		*planes;
+
+	int				numnodes;
+	cnode_t			*nodes;
+
+	int				numleafs;
+	cleaf_t			*leafs;
+
+	int				numleafbrushes;
+	unsigned short	*leafbrushes;
+
+	int				numbrushes;
+	cbrush_t		*brushes;
+
+	int				numbrushsides;
+	cbrushside_t	*brushsides;
+
+	int				numsurfaces;
+	csurface_t		*surfaces;
+
+	int				headnode;		// of the world model
+	vec3_t			mins, maxs;		// world model bounds
+} cworld_t;
+
+static cworld_t		cm_world;
+static csurface_t	cm_nullsurface;
+
+// Everything one trace needs. Lives on the caller's stack.
+typedef struct
+{
+	vec3_t		start, end;
+	vec3_t		mins, maxs;
+	vec3_t		extents;
+	int			contents;
+	qboolean	ispoint;
+	trace_t		trace;
+	byte		checked[CM_MAX_BRUSHES / 8];
+} cmtrace_t;
+
+static struct
+{
+	int		loads;
+	int		queries;	// CModel_Blocked calls
+	int		blocked;	// answered without gi.trace
+} cm_stats;
+
+/*
+===============================================================================
+
+MAP LOADING
+
+===============================================================================
+*/
+
+static void *CM_Alloc(int count, int size)
+{
+	void *p = malloc(max(count, 1) * size);
+	if (p)
+		memset(p, 0, max(count, 1) * size);
+
+	return p;
+}
+
+// Returns number of size sized items in the lump, or -1 if the lump is broken
+static int CM_LumpCount(const dheader_t *header, int filesize, int lump, int size)
+{
+	const lump_t *l = &header->lumps[lump];
+
+	if (l->fileofs < 0 || l->filelen < 0 || l->fileofs + l->filelen > filesize || l->filelen % size)
+		return -1;
+
+	return l->filelen / size;
+}
+
+static qboolean CM_LoadPlanes(cworld_t *w, const byte *base, const dheader_t *header, int filesize)
+{
+	w->numplanes = CM_LumpCount(header, filesize, LUMP_PLANES, sizeof(dplane_t));
+	if (w->numplanes < 1)
+		return false;
+
+	w->planes = CM_Alloc(w->numplanes, sizeof(cplane_t));
+	if (!w->planes)
+		return false;
+
+	const dplane_t *in = (const dplane_t *)(base + header->lumps[LUMP_PLANES].fileofs);
+	for (int i = 0; i < w->numplanes; i++, in++)
+	{
+		cplane_t *out = &w->planes[i];
+		int bits = 0;
+
+		for (int j = 0; j < 3; j++)
+		{
+			out->normal[j] = in->normal[j];
+			if (out->normal[j] < 0)
+				bits |= 1 << j;
+		}
+
+		out->dist = in->dist;
+		out->type = in->type;
+		out->signbits = bits;
+	}
+
+	return true;
+}
+
+static qboolean CM_LoadSurfaces(cworld_t *w, const byte *base, const dheader_t *header, int filesize)
+{
+	w->numsurfaces = CM_LumpCount(header, filesize, LUMP_TEXINFO, sizeof(texinfo_t));
+	if (w->numsurfaces < 0)
+		return false;
+
+	w->surfaces = CM_Alloc(w->numsurfaces, sizeof(csurface_t));
+	if (!w->surfaces)
+		return false;
+
+	const texinfo_t *in = (const texinfo_t *)(base + header->lumps[LUMP_TEXINFO].fileofs);
+	for (int i = 0; i < w->numsurfaces; i++, in++)
+	{
+		csurface_t *out = &w->surfaces[i];
+		memcpy(out->name, in->texture, sizeof(out->name) - 1);
+		out->flags = in->flags;
+		out->value = in->value;
+	}
+
+	return true;
+}
+
+static qboolean CM_LoadNodes(cworld_t *w, const byte *base, const dheader_t *header, int filesize)
+{
+	w->numnodes = CM_LumpCount(header, filesize, LUMP_NODES, sizeof(dnode_t));
+	if (w->numnodes < 1)
+		return false;
+
+	w->nodes = CM_Alloc(w->numnodes, sizeof(cnode_t));
+	if (!w->nodes)
+		return false;
+
+	const dnode_t *in = (const dnode_t *)(base + header->lumps[LUMP_NODES].fileofs);
+	for (int i = 0; i < w->numnodes; i++, in++)
+	{
+		cnode_t *out = &w->nodes[i];
+
+		if (in->planenum < 0 || in->planenum >= w->numplanes)
+			return false;
+
+		out->plane = &w->planes[in->planenum];
+
+		for (int j = 0; j < 2; j++)
+		{
+			const int child = in->children[j];
+			if (child >= w->numnodes || (child < 0 && -1 - child >= w->numleafs))
+				return false;
+
+			out->children[j] = child;
+		}
+	}
+
+	return true;
+}
+
+static qboolean CM_LoadLeafs(cworld_t *w, const byte *base, const dheader_t *header, int filesize)
+{
+	w->numleafs = CM_LumpCount(header, filesize, LUMP_LEAFS, sizeof(dleaf_t));
+	if (w->numleafs < 1)
+		return false;
+
+	w->leafs = CM_Alloc(w->numleafs, sizeof(cleaf_t));
+	if (!w->leafs)
+		return false;
+
+	const dleaf_t *in = (const dleaf_t *)(base + header->lumps[LUMP_LEAFS].fileofs);
+	for (int i = 0; i < w->numleafs; i++, in++)
+	{
+		cleaf_t *out = &w->leafs[i];
+
+		if (in->firstleafbrush + in->numleafbrushes > w->numleafbrushes)
+			return false;
+
+		out->contents = in->contents;
+		out->firstleafbrush = in->firstleafbrush;
+		out->numleafbrushes = in->numleafbrushes;
+	}
+
+	return true;
+}
+
+static qboolean CM_LoadLeafBrushes(cworld_t *w, const byte *base, const dheader_t *header, int filesize)
+{
+	w->numleafbrushes = CM_LumpCount(header, filesize, LUMP_LEAFBRUSHES, sizeof(unsigned short));
+	if (w->numleafbrushes < 0)
+		return false;
+
+	w->leafbrushes = CM_Alloc(w->numleafbrushes, sizeof(unsigned short));
+	if (!w->leafbrushes)
+		return false;
+
+	memcpy(w->leafbrushes, base + header->lumps[LUMP_LEAFBRUSHES].fileofs, w->numleafbrushes * sizeof(unsigned short));
+
+	for (int i = 0; i < w->numleafbrushes; i++)
+		if (w->leafbrushes[i] >= w->numbrushes)
+			return false;
+
+	return true;
+}
+
+static qboolean CM_LoadBrushes(cworld_t *w, const byte *base, const dheader_t *header, int filesize)
+{
+	w->numbrushes = CM_LumpCount(header, filesize, LUMP_BRUSHES, sizeof(dbrush_t));
+	if (w->numbrushes < 0)
+		return false;
+
+	w->brushes = CM_Alloc(w->numbrushes, sizeof(cbrush_t));
+	if (!w->brushes)
+		return false;
+
+	const dbrush_t *in = (const dbrush_t *)(base + header->lumps[LUMP_BRUSHES].fileofs);
+	for (int i = 0; i < w->numbrushes; i++, in++)
+	{
+		cbrush_t *out = &w->brushes[i];
+
+		if (in->firstside < 0 || in->numsides < 0 || in->firstside + in->numsides > w->numbrushsides)
+			return false;
+
+		out->contents = in->contents;
+		out->firstbrushside = in->firstside;
+		out->numsides = in->numsides;
+	}
+
+	return true;
+}
+
+static qboolean CM_LoadBrushSides(cworld_t *w, const byte *base, const dheader_t *header, int filesize)
+{
+	w->numbrushsides = CM_LumpCount(header, filesize, LUMP_BRUSHSIDES, sizeof(dbrushside_t));
+	if (w->numbrushsides < 0)
+		return false;
+
+	w->brushsides = CM_Alloc(w->numbrushsides, sizeof(cbrushside_t));
+	if (!w->brushsides)
+		return false;
+
+	const dbrushside_t *in = (const dbrushside_t *)(base + header->lumps[LUMP_BRUSHSIDES].fileofs);
+	for (int i = 0; i < w->numbrushsides; i++, in++)
+	{
+		cbrushside_t *out = &w->brushsides[i];
+
+		if (in->planenum >= w->numplanes || in->texinfo >= w->numsurfaces)
+			return false;
+
+		out->plane = &w->planes[in->planenum];
+		out->surface = (in->texinfo < 0 ? &cm_nullsurface : &w->surfaces[in->texinfo]);
+	}
+
+	return true;
+}
+
+static qboolean CM_LoadWorldModel(cworld_t *w, const byte *base, const dheader_t *header, int filesize)
+{
+	if (CM_LumpCount(header, filesize, LUMP_MODELS, sizeof(dmodel_t)) < 1)
+		return false;
+
+	const dmodel_t *in = (const dmodel_t *)(base + header->lumps[LUMP_MODELS].fileofs);
+	if (in->headnode < 0 || in->headnode >= w->numnodes)
+		return false;
+
+	w->headnode = in->headnode;
+	VectorCopy(in->mins, w->mins);
+	VectorCopy(in->maxs, w->maxs);
+
+	return true;
+}
+
+// Reads filename from basedir/gamedir, loose or from a pak. Returns malloc'd data.
+static byte *CM_ReadFile(const char *basedir, const char *gamedir, const char *filename, int *size)
+{
+	FILE *f = NULL;
+	int length = 0;
+
+	if (FS_FindFile(basedir, gamedir, filename, FS_LOOSE))
+	{
+		if (*basedir)
+			f = fopen(va("%s/%s/%s", basedir, gamedir, filename), "rb");
+		else
+			f = fopen(va("%s/%s", gamedir, filename), "rb");
+
+		if (f)
+		{
+			fseek(f, 0, SEEK_END);
+			length = ftell(f);
+			fseek(f, 0, SEEK_SET);
+		}
+	}
+
+	if (!f)
+	{
+		const fsfile_t *pakitem = FS_FindFile(basedir, gamedir, filename, FS_PAK);
+		if (!pakitem)
+			return NULL;
+
+		f = fopen(pakitem->pakfile, "rb");
+		if (!f)
+			return NULL;
+
+		fseek(f, pakitem->start, SEEK_SET);
+		length = pakitem->size;
+	}
+
+	byte *data = (length > 0 ? malloc(length) : NULL);
+	if (data && (int)fread(data, 1, length, f) != length)
+	{
+		free(data);
+		data = NULL;
+	}
+
+	fclose(f);
+	*size = length;
+
+	return data;
+}
+
+// Same search order as the actor files: game folder, baseq2, then cddir
+static byte *CM_LoadMapFile(const char *filename, int *size)
+{
+#ifdef KMQUAKE2_ENGINE_MOD // *.pak/pk3 support
+	void *buf;
+	const int length = gi.LoadFile((char *)filename, &buf);
+	if (length > 0 && buf)
+	{
+		byte *data = malloc(length);
+		if (data)
+			memcpy(data, buf, length);
+
+		gi.FreeFile(buf);
+		*size = length;
+
+		return data;
+	}
+#endif
+
+	cvar_t *basedir = gi.cvar("basedir", "", 0);
+	cvar_t *cddir = gi.cvar("cddir", "", 0);
+	cvar_t *gamedir = gi.cvar("gamedir", "", 0);
+	byte *data = NULL;
+
+	if (strlen(gamedir->string))
+		data = CM_ReadFile(basedir->string, gamedir->string, filename, size);
+
+	if (!data)
+		data = CM_ReadFile(basedir->string, "baseq2", filename, size);
+
+	if (!data && strlen(cddir->string))
+		data = CM_ReadFile(cddir->string, "baseq2", filename, size);
+
+	return data;
+}
+
+/*
+=================
+CModel_Free
+=================
+*/
+void CModel_Free(void)
+{
+	free(cm_world.planes);
+	free(cm_world.nodes);
+	free(cm_world.leafs);
+	free(cm_world.leafbrushes);
+	free(cm_world.brushes);
+	free(cm_world.brushsides);
+	free(cm_world.surfaces);
+
+	memset(&cm_world, 0, sizeof(cm_world));
+}
+
+/*
+=================
+CModel_LoadMap
+
+Loads the collision model of maps/<mapname>.bsp, unless it's already loaded.
+Called from SpawnEntities. Without it (no such file, or a format we don't know)
+CModel_Trace reports nothing and the callers use gi.trace.
+=================
+*/
+void CModel_LoadMap(char *mapname)
+{
+	char filename[MAX_QPATH];
+	int size = 0;
+
+	if (cm_world.numnodes && !Q_stricmp(cm_world.name, mapname))
+		return;
+
+	CModel_Free();
+
+	if (!mapname || !*mapname || strchr(mapname, '.'))	// cinematics and pictures
+		return;
+
+	Com_sprintf(filename, sizeof(filename), "maps/%s.bsp", mapname);
+
+	byte *data = CM_LoadMapFile(filename, &size);
+	if (!data)
+	{
+		if (developer && developer->value)
+			gi.dprintf("CModel_LoadMap: couldn't load %s, using engine traces only\n", filename);
+		return;
+	}
+
+	const dheader_t *header = (const dheader_t *)data;
+	qboolean ok = (size >= (int)sizeof(dheader_t) && header->ident == BSP_IDENT && header->version == BSP_VERSION);
+
+	// Order matters, each lump is checked against the ones before it
+	ok = ok && CM_LoadSurfaces(&cm_world, data, header, size);
+	ok = ok && CM_LoadPlanes(&cm_world, data, header, size);
+	ok = ok && CM_LoadBrushSides(&cm_world, data, header, size);
+	ok = ok && CM_LoadBrushes(&cm_world, data, header, size);
+	ok = ok && CM_LoadLeafBrushes(&cm_world, data, header, size);
+	ok = ok && CM_LoadLeafs(&cm_world, data, header, size);
+	ok = ok && CM_LoadNodes(&cm_world, data, header, size);
+	ok = ok && CM_LoadWorldModel(&cm_world, data, header, size);
+
+	free(data);
+
+	if (!ok)
+	{
+		gi.dprintf("CModel_LoadMap: %s isn't a version %i map or is damaged, using engine traces only\n", filename, BSP_VERSION);
+		CModel_Free();
+		return;
+	}
+
+	Q_strncpyz(cm_world.name, mapname, sizeof(cm_world.name));
+	cm_world.size = size;
+	cm_stats.loads++;
+
+	if (developer && developer->value)
+		gi.dprintf("CModel_LoadMap: %s, %i nodes, %i leafs, %i brushes\n", filename, cm_world.numnodes, cm_world.numleafs, cm_world.numbrushes);
+}
+
+/*
+===============================================================================
+
+BOX TRACING
+
+Same as the engine's CM_BoxTrace for the world model, with the trace state
+in a cmtrace_t instead of globals.
+
+===============================================================================
+*/
+
+static void CM_ClipBoxToBrush(cmtrace_t *tw, const cbrush_t *brush)
+{
+	const cplane_t *clipplane = NULL;
+	const cbrushside_t *leadside = NULL;
+	float enterfrac = -1;
+	float leavefrac = 1;
+	qboolean getout = false;
+	qboolean startout = false;
+
+	if (!brush->numsides)
+		return;
+
+	for (int i = 0; i < brush->numsides; i++)
+	{
+		const cbrushside_t *side = &cm_world.brushsides[brush->firstbrushside + i];
+		const cplane_t *plane = side->plane;
+		float dist;
+
+		if (!tw->ispoint)
+		{
+			// General box case: push the plane out appropriately for mins/maxs
+			vec3_t ofs;
+			for (int j = 0; j < 3; j++)
+				ofs[j] = (plane->normal[j] < 0 ? tw->maxs[j] : tw->mins[j]);
+
+			dist = plane->dist - DotProduct(ofs, plane->normal);
+		}
+		else
+		{
+			dist = plane->dist;
+		}
+
+		const float d1 = DotProduct(tw->start, plane->normal) - dist;
+		const float d2 = DotProduct(tw->end, plane->normal) - dist;
+
+		if (d2 > 0)
+			getout = true;	// endpoint is not in solid
+		if (d1 > 0)
+			startout = true;
+
+		// If completely in front of face, no intersection
+		if (d1 > 0 && d2 >= d1)
+			return;
+
+		if (d1 <= 0 && d2 <= 0)
+			continue;
+
+		// Crosses face
+		if (d1 > d2)
+		{
+			// Enter
+			const float f = (d1 - DIST_EPSILON) / (d1 - d2);
+			if (f > enterfrac)
+			{
+				enterfrac = f;
+				clipplane = plane;
+				leadside = side;
+			}
+		}
+		else
+		{
+			// Leave
+			const float f = (d1 + DIST_EPSILON) / (d1 - d2);
+			if (f < leavefrac)
+				leavefrac = f;
+		}
+	}
+
+	if (!startout)
+	{
+		// Original point was inside brush
+		tw->trace.startsolid = true;
+		if (!getout)
+			tw->trace.allsolid = true;
+
+		return;
+	}
+
+	if (enterfrac < leavefrac && enterfrac > -1 && enterfrac < tw->trace.fraction)
+	{
+		tw->trace.fraction = max(enterfrac, 0);
+		tw->trace.plane = *clipplane;
+		tw->trace.surface = leadside->surface;
+		tw->trace.contents = brush->contents;
+	}
+}
+
+static void CM_TestBoxInBrush(cmtrace_t *tw, const cbrush_t *brush)
+{
+	if (!brush->numsides)
+		return;
+
+	for (int i = 0; i < brush->numsides; i++)
+	{
+		const cplane_t *plane = cm_world.brushsides[brush->firstbrushside + i].plane;
+
+		vec3_t ofs;
+		for (int j = 0; j < 3; j++)
+			ofs[j] = (plane->normal[j] < 0 ? tw->maxs[j] : tw->mins[j]);
+
+		const float dist = plane->dist - DotProduct(ofs, plane->normal);
+
+		// If completely in front of face, no intersection
+		if (DotProduct(tw->start, plane->normal) - dist > 0)
+			return;
+	}
+
+	// Inside this brush
+	tw->trace.startsolid = tw->trace.allsolid = true;
+	tw->trace.fraction = 0;
+	tw->trace.contents = brush->contents;
+}
+
+// Returns false if the brush was already looked at by this trace (it's in more than one leaf)
+static qboolean CM_CheckBrush(cmtrace_t *tw, int brushnum)
+{
+	if (brushnum >= CM_MAX_BRUSHES)
+		return true;
+
+	const byte bit = 1 << (brushnum & 7);
+	if (tw->checked[brushnum >> 3] & bit)
+		return false;
+
+	tw->checked[brushnum >> 3] |= bit;
+
+	return true;
+}
+
+static void CM_TraceToLeaf(cmtrace_t *tw, int leafnum, qboolean test)
+{
+	const cleaf_t *leaf = &cm_world.leafs[leafnum];
+
+	if (!(leaf->contents & tw->contents))
+		return;
+
+	// Trace line against all brushes in the leaf
+	for (int k = 0; k < leaf->numleafbrushes; k++)
+	{
+		const int brushnum = cm_world.leafbrushes[leaf->firstleafbrush + k];
+		const cbrush_t *b = &cm_world.brushes[brushnum];
+
+		if (!CM_CheckBrush(tw, brushnum) || !(b->contents & tw->contents))
+			continue;
+
+		if (test)
+			CM_TestBoxInBrush(tw, b);
+		else
+			CM_ClipBoxToBrush(tw, b);
+
+		if (!tw->trace.fraction)
+			return;
+	}
+}
+
+// Position test: every leaf the box touches
+static void CM_TestInLeafs_r(cmtrace_t *tw, int num, const vec3_t absmins, const vec3_t absmaxs)
+{
+	while (num >= 0)
+	{
+		const cnode_t *node = &cm_world.nodes[num];
+		const int side = BOX_ON_PLANE_SIDE((float *)absmins, (float *)absmaxs, node->plane);
+
+		if (side == 1)
+		{
+			num = node->children[0];
+		}
+		else if (side == 2)
+		{
+			num = node->children[1];
+		}
+		else
+		{
+			// Go down both
+			CM_TestInLeafs_r(tw, node->children[0], absmins, absmaxs);
+			if (tw->trace.allsolid)
+				return;
+
+			num = node->children[1];
+		}
+	}
+
+	CM_TraceToLeaf(tw, -1 - num, true);
+}
+
+static void CM_RecursiveHullCheck(cmtrace_t *tw, int num, float p1f, float p2f, const vec3_t p1, const vec3_t p2)
+{
+	if (tw->trace.fraction <= p1f)
+		return; // Already hit something nearer
+
+	// If < 0, we are in a leaf node
+	if (num < 0)
+	{
+		CM_TraceToLeaf(tw, -1 - num, false);
+		return;
+	}
+
+	// Find the point distances to the separating plane and the offset for the size of the box
+	const cnode_t *node = &cm_world.nodes[num];
+	const cplane_t *plane = node->plane;
+	float t1, t2, offset;
+
+	if (plane->type < 3)
+	{
+		t1 = p1[plane->type] - plane->dist;
+		t2 = p2[plane->type] - plane->dist;
+		offset = tw->extents[plane->type];
+	}
+	else
+	{
+		t1 = DotProduct(plane->normal, p1) - plane->dist;
+		t2 = DotProduct(plane->normal, p2) - plane->dist;
+
+		if (tw->ispoint)
+			offset = 0;
+		else
+			offset = fabsf(tw->extents[0] * plane->normal[0]) + fabsf(tw->extents[1] * plane->normal[1]) + fabsf(tw->extents[2] * plane->normal[2]);
+	}
+
+	// See which sides we need to consider
+	if (t1 >= offset && t2 >= offset)
+	{
+		CM_RecursiveHullCheck(tw, node->children[0], p1f, p2f, p1, p2);
+		return;
+	}
+
+	if (t1 < -offset && t2 < -offset)
+	{
+		CM_RecursiveHullCheck(tw, node->children[1], p1f, p2f, p1, p2);
+		return;
+	}
+
+	// Put the crosspoint DIST_EPSILON pixels on the near side
+	int side;
+	float frac, frac2;
+
+	if (t1 < t2)
+	{
+		const float idist = 1.0f / (t1 - t2);
+		side = 1;
+		frac2 = (t1 + offset + DIST_EPSILON) * idist;
+		frac = (t1 - offset + DIST_EPSILON) * idist;
+	}
+	else if (t1 > t2)
+	{
+		const float idist = 1.0f / (t1 - t2);
+		side = 0;
+		frac2 = (t1 - offset - DIST_EPSILON) * idist;
+		frac = (t1 + offset + DIST_EPSILON) * idist;
+	}
+	else
+	{
+		side = 0;
+		frac = 1;
+		frac2 = 0;
+	}
+
+	// Move up to the node
+	vec3_t mid;
+	frac = max(0, min(frac, 1));
+	float midf = p1f + (p2f - p1f) * frac;
+	for (int i = 0; i < 3; i++)
+		mid[i] = p1[i] + frac * (p2[i] - p1[i]);
+
+	CM_RecursiveHullCheck(tw, node->children[side], p1f, midf, p1, mid);
+
+	// Go past the node
+	frac2 = max(0, min(frac2, 1));
+	midf = p1f + (p2f - p1f) * frac2;
+	for (int i = 0; i < 3; i++)
+		mid[i] = p1[i] + frac2 * (p2[i] - p1[i]);
+
+	CM_RecursiveHullCheck(tw, node->children[side ^ 1], midf, p2f, mid, p2);
+}
+
+/*
+=================
+CModel_Trace
+
+Traces a box from start to end against world geometry only. Safe to call from several threads
+at once. Returns false, and a trace that hit nothing, when there's no collision model for this map.
+=================
+*/
+qboolean CModel_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int contentmask, trace_t *trace)
+{
+	cmtrace_t tw;
+
+	memset(&tw.trace, 0, sizeof(tw.trace));
+	tw.trace.fraction = 1;
+	tw.trace.surface = &cm_nullsurface;
+
+	if (!cm_world.numnodes)
+	{
+		VectorCopy(end, tw.trace.endpos);
+		*trace = tw.trace;
+		return false;
+	}
+
+	memset(tw.checked, 0, min(sizeof(tw.checked), (size_t)(cm_world.numbrushes + 7) / 8));
+	tw.contents = contentmask;
+	VectorCopy(start, tw.start);
+	VectorCopy(end, tw.end);
+	VectorCopy(mins, tw.mins);
+	VectorCopy(maxs, tw.maxs);
+
+	if (VectorCompare((float *)start, (float *)end))
+	{
+		// Position test special case
+		vec3_t absmins, absmaxs;
+		for (int i = 0; i < 3; i++)
+		{
+			absmins[i] = start[i] + mins[i] - 1;
+			absmaxs[i] = start[i] + maxs[i] + 1;
+		}
+
+		CM_TestInLeafs_r(&tw, cm_world.headnode, absmins, absmaxs);
+		VectorCopy(start, tw.trace.endpos);
+	}
+	else
+	{
+		tw.ispoint = (VectorCompare((float *)mins, vec3_origin) && VectorCompare((float *)maxs, vec3_origin));
+		for (int i = 0; i < 3; i++)
+			tw.extents[i] = max(-mins[i], maxs[i]);
+
+		// General sweeping through world
+		CM_RecursiveHullCheck(&tw, cm_world.headnode, 0, 1, start, end);
+
+		if (tw.trace.fraction == 1)
+		{
+			VectorCopy(end, tw.trace.endpos);
+		}
+		else
+		{
+			for (int i = 0; i < 3; i++)
+				tw.trace.endpos[i] = start[i] + tw.trace.fraction * (end[i] - start[i]);
+		}
+	}
+
+	tw.trace.ent = world;	// same as the engine, even if nothing was hit
+	*trace = tw.trace;
+
+	return true;
+}
+
+/*
+=================
+CModel_PointContents
+
+Contents of the world at p, like gi.pointcontents without the entities. 0 with no collision model.
+=================
+*/
+int CModel_PointContents(const vec3_t p)
+{
+	if (!cm_world.numnodes)
+		return 0;
+
+	int num = cm_world.headnode;
+	while (num >= 0)
+	{
+		const cplane_t *plane = cm_world.nodes[num].plane;
+		const float d = (plane->type < 3 ? p[plane->type] : DotProduct(plane->normal, p)) - plane->dist;
+
+		num = cm_world.nodes[num].children[d < 0];
+	}
+
+	return cm_world.leafs[-1 - num].contents;
+}
+
+/*
+=================
+CModel_WorldBounds
+
+Bounds of the world model. False with no collision model.
+=================
+*/
+qboolean CModel_WorldBounds(vec3_t mins, vec3_t maxs)
+{
+	if (!cm_world.numnodes)
+		return false;
+
+	VectorCopy(cm_world.mins, mins);
+	VectorCopy(cm_world.maxs, maxs);
+
+	return true;
+}
+
+/*
+=================
+CModel_BrushBounds
+
+Fills mins/maxs with the bounds of up to maxbrushes world brushes that have any of contents.
+Returns the number found.
+=================
+*/
+int CModel_BrushBounds(int contents, vec3_t *mins, vec3_t *maxs, int maxbrushes)
+{
+	int count = 0;
+
+	for (int i = 0; i < cm_world.numbrushes && count < maxbrushes; i++)
+	{
+		const cbrush_t *b = &cm_world.brushes[i];
+		if (!(b->contents & contents))
+			continue;
+
+		VectorSet(mins[count], -CM_MAX_COORD, -CM_MAX_COORD, -CM_MAX_COORD);
+		VectorSet(maxs[count], CM_MAX_COORD, CM_MAX_COORD, CM_MAX_COORD);
+
+		// The bsp tools always give brushes their axial sides
+		for (int j = 0; j < b->numsides; j++)
+		{
+			const cplane_t *plane = cm_world.brushsides[b->firstbrushside + j].plane;
+
+			for (int k = 0; k < 3; k++)
+			{
+				if (plane->normal[k] == 1)
+					maxs[count][k] = min(maxs[count][k], plane->dist);
+				else if (plane->normal[k] == -1)
+					mins[count][k] = max(mins[count][k], -plane->dist);
+			}
+		}
+
+		count++;
+	}
+
+	return count;
+}
+
+// Fraction along start->end where a box of mins/maxs first touches target's bounding box, or 2 if it doesn't
+static float CM_TargetFraction(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, const edict_t *target)
+{
+	float enter = 0, leave = 1;
+
+	for (int i = 0; i < 3; i++)
+	{
+		// absmin/absmax are already a unit bigger than what the engine clips against, add another for safety
+		const float lo = target->absmin[i] - maxs[i] - 1;
+		const float hi = target->absmax[i] - mins[i] + 1;
+		const float d = end[i] - start[i];
+
+		if (d == 0)
+		{
+			if (start[i] < lo || start[i] > hi)
+				return 2;
+
+			continue;
+		}
+
+		float t1 = (lo - start[i]) / d;
+		float t2 = (hi - start[i]) / d;
+		if (t1 > t2)
+		{
+			const float t = t1;
+			t1 = t2;
+			t2 = t;
+		}
+
+		enter = max(enter, t1);
+		leave = min(leave, t2);
+		if (enter > leave)
+			return 2;
+	}
+
+	return enter;
+}
+
+/*
+=================
+CModel_Blocked
+
+True when world geometry stops a trace from start to end, so gi.trace with the same arguments
+can't come back clear. If the caller would also accept the trace ending on target (can be NULL),
+it's only true when the world is hit before the trace gets anywhere near target.
+=================
+*/
+qboolean CModel_Blocked(vec3_t start, vec3_t mins, vec3_t maxs, vec3_t end, int contentmask, edict_t *target)
+{
+	trace_t tr;
+
+	if (!cm_world.numnodes)
+		return false;
+
+	cm_stats.queries++;
+
+	if (!CModel_Trace(start, mins, maxs, end, contentmask, &tr) || tr.fraction == 1)
+		return false;
+
+	if (target && target->inuse && CM_TargetFraction(start, mins, maxs, end, target) <= tr.fraction)
+		return false;
+
+	cm_stats.blocked++;
+
+	return true;
+}
+
+void CModel_Stats_f(void)
+{
+	if (!cm_world.numnodes)
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "No world collision model loaded, perception checks use engine traces only\n");
+		return;
+	}
+
+	safe_cprintf(NULL, PRINT_HIGH, "World collision model: maps/%s.bsp, %d bytes\n", cm_world.name, cm_world.size);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d planes, %d nodes, %d leafs, %d brushes, %d brush sides\n", cm_world.numplanes, cm_world.numnodes, cm_world.numleafs, cm_world.numbrushes, cm_world.numbrushsides);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d maps loaded\n", cm_stats.loads);
+	safe_cprintf(NULL, PRINT_HIGH, "  visibility checks: %d, answered without gi.trace: %d\n", cm_stats.queries, cm_stats.blocked);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+	{
+		cm_stats.queries = 0;
+		cm_stats.blocked = 0;
+	}
+}
@@ -40,6 +40,17 @@ void cleanupHealTarget(edict_t *self)
 	M_SetEffects(self);
 }
 
+// One CanDamage line of fire. Most blocked ones are answered by the world collision model, without gi.trace.
+static qboolean CanDamageTrace(edict_t *targ, edict_t *inflictor, vec3_t dest)
+{
+	if (CModel_Blocked(inflictor->s.origin, vec3_origin, vec3_origin, dest, MASK_SOLID, targ))
+		return false;
+
+	const trace_t trace = gi.trace(inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
+
+	return (trace.fraction == 1.0 || trace.ent == targ);
+}
+
 /*
 ============
 CanDamage
@@ -50,19 +61,17 @@ Returns true if the inflictor can directly damage the target. Used for explosion
 qboolean CanDamage(edict_t *targ, edict_t *inflictor)
 {
 	vec3_t	dest;
-	trace_t	trace;
 
 	// bmodels need special checking because their origin is 0,0,0
 	if (targ->movetype == MOVETYPE_PUSH)
 	{
 		VectorAdd(targ->absmin, targ->absmax, dest);
 		VectorScale(dest, 0.5, dest);
-		trace = gi.trace(inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
 
-		return (trace.fraction == 1.0 || trace.ent == targ);
+		return CanDamageTrace(targ, inflictor, dest);
 	}
 	
-	trace = gi.trace(inflictor->s.origin, vec3_origin, vec3_origin, targ->s.origin, inflictor, MASK_SOLID);
+	const trace_t trace = gi.trace(inflictor->s.origin, vec3_origin, vec3_origin, targ->s.origin, inflictor, MASK_SOLID);
 	if (trace.fraction == 1.0 || trace.ent == targ)
 		return true;
 
@@ -76,29 +85,25 @@ qboolean CanDamage(edict_t *targ, edict_t *inflictor)
 	VectorCopy(targ->s.origin, dest);
 	dest[0] += 15.0;
 	dest[1] += 15.0;
-	trace = gi.trace(inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
-	if (trace.fraction == 1.0 || trace.ent == targ)
+	if (CanDamageTrace(targ, inflictor, dest))
 		return true;
 
 	VectorCopy(targ->s.origin, dest);
 	dest[0] += 15.0;
 	dest[1] -= 15.0;
-	trace = gi.trace(inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
-	if (trace.fraction == 1.0 || trace.ent == targ)
+	if (CanDamageTrace(targ, inflictor, dest))
 		return true;
 
 	VectorCopy(targ->s.origin, dest);
 	dest[0] -= 15.0;
 	dest[1] += 15.0;
-	trace = gi.trace(inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
-	if (trace.fraction == 1.0 || trace.ent == targ)
+	if (CanDamageTrace(targ, inflictor, dest))
 		return true;
 
 	VectorCopy(targ->s.origin, dest);
 	dest[0] -= 15.0;
 	dest[1] -= 15.0;
-	trace = gi.trace(inflictor->s.origin, vec3_origin, vec3_origin, dest, inflictor, MASK_SOLID);
-	if (trace.fraction == 1.0 || trace.ent == targ)
+	if (CanDamageTrace(targ, inflictor, dest))
 		return true;
 
 	return false;
@@ -180,6 +185,8 @@ void Killed(edict_t *targ, edict_t *inflictor, edict_t *attacker, int damage, ve
 		targ->die(targ, inflictor, attacker, damage, point);
 	else
 		BecomeExplosion1(targ);
+
+	G_UpdateRoles(targ); // Dead monsters leave the monster registry
 }
 
 
@@ -193,11 +200,11 @@ added color for monster blood
 */
 void SpawnDamage(int type, vec3_t origin, vec3_t normal)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(type);
-	gi.WritePosition(origin);
-	gi.WriteDir(normal);
-	gi.multicast(origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(type);
+	TempEnt_WritePosition(origin);
+	TempEnt_WriteDir(normal);
+	TempEnt_Multicast(origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectSparks(type, origin, normal);
@@ -435,13 +442,13 @@ void CallMyFriends(edict_t *targ, edict_t *attacker, int damage) //mxd. Added "d
 										if (tr.fraction == 1.0f)
 										{
 											// Spawn lightning SFX...
-											gi.WriteByte(svc_temp_entity);
-											gi.WriteByte(TE_LIGHTNING);
-											gi.WriteShort(teammate - g_edicts);	// destination entity
-											gi.WriteShort(targ - g_edicts);		// source entity
-											gi.WritePosition(teammate->s.origin);
-											gi.WritePosition(targ->s.origin);
-											gi.multicast(targ->s.origin, MULTICAST_PVS);
+											TempEnt_Begin();
+											TempEnt_WriteByte(TE_LIGHTNING);
+											TempEnt_WriteShort(teammate - g_edicts);	// destination entity
+											TempEnt_WriteShort(targ - g_edicts);		// source entity
+											TempEnt_WritePosition(teammate->s.origin);
+											TempEnt_WritePosition(targ->s.origin);
+											TempEnt_Multicast(targ->s.origin, MULTICAST_PVS);
 
 											// Play sound
 											gi.sound(targ, CHAN_BODY, gi.soundindex("world/x_light.wav"), 1, ATTN_NORM, 0);
@@ -816,7 +823,7 @@ void T_Damage(edict_t *in_targ, edict_t *inflictor, edict_t *in_attacker, vec3_t
 	if (targ->think == target_animate && (targ->svflags & SVF_MONSTER))
 	{
 		targ->think = monster_think;
-		targ->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(targ, level.time + FRAMETIME);
 	}
 
 	if (!in_attacker)
@@ -965,6 +972,7 @@ void T_Damage(edict_t *in_targ, edict_t *inflictor, edict_t *in_attacker, vec3_t
 				VectorScale(dir, 500.0 * (float)knockback / mass, kvel);
 
 			VectorAdd(targ->velocity, kvel, targ->velocity);
+			Think_Wake(targ); // Debris resting on the world may have been asleep
 		}
 	}
 
@@ -0,0 +1,168 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_cosmetic.c -- a level wide budget for gibs, heads, debris, shell casings, target_rocks chunks and leaves.
+// sv_maxgibs only limits how many are thrown in one frame, so a long fight used to pile up hundreds of them.
+// They're in the ROLE_COSMETIC registry; when a new one takes the count over sv_maxcosmetics, the one furthest
+// from every client, counting age as distance, goes first. Once they come to rest on the world they only wait
+// on their fade think, so the think scheduler takes them out of the frame loop (see g_think.c).
+
+#include "g_local.h"
+
+#define COSMETIC_AGE_SCALE	64	// map units of distance a second of age is worth
+
+static float	cosmetic_born[MAX_EDICTS];	// level.time it was thrown
+
+static struct
+{
+	int		added;
+	int		evicted;
+	int		peak;
+} cosmetic_stats;
+
+// Where every player is, for Cosmetic_Score
+static int Cosmetic_ClientOrigins(vec3_t *origins)
+{
+	int count = 0;
+
+	for (edict_t *ent = G_NextRole(NULL, ROLE_CLIENT); ent; ent = G_NextRole(ent, ROLE_CLIENT))
+		VectorCopy(ent->s.origin, origins[count++]);
+
+	return count;
+}
+
+// Higher goes first: far from every client, or old
+static float Cosmetic_Score(edict_t *ent, vec3_t *origins, int numorigins)
+{
+	float nearest = 0;
+
+	for (int i = 0; i < numorigins; i++)
+	{
+		vec3_t v;
+		VectorSubtract(ent->s.origin, origins[i], v);
+
+		const float dist = VectorLength(v);
+		if (!i || dist < nearest)
+			nearest = dist;
+	}
+
+	return nearest + (level.time - cosmetic_born[ent - g_edicts]) * COSMETIC_AGE_SCALE;
+}
+
+static void Cosmetic_Evict(edict_t *ent)
+{
+	cosmetic_stats.evicted++;
+
+	// Leaves go back to their target_precipitation to be used again, whatever they were doing
+	if (ent->class_id == ENTITY_LEAF)
+		drop_add_to_chain(ent);
+	else
+		G_FreeEdict(ent);
+}
+
+/*
+=================
+Cosmetic_Add
+
+Call when ent has been thrown and linked. Makes room for it if there are too many.
+=================
+*/
+void Cosmetic_Add(edict_t *ent)
+{
+	const int index = ent - g_edicts;
+	if (index < 0 || index >= MAX_EDICTS)
+		return;
+
+	cosmetic_born[index] = level.time;
+	cosmetic_stats.added++;
+
+	const int cap = (sv_maxcosmetics ? (int)sv_maxcosmetics->value : 0);
+	if (cap > 0)
+	{
+		vec3_t origins[MAX_CLIENTS];
+		const int numorigins = Cosmetic_ClientOrigins(origins);
+
+		while (G_RoleCount(ROLE_COSMETIC) > cap)
+		{
+			edict_t *worst = NULL;
+			float worstscore = 0;
+
+			for (edict_t *e = G_NextRole(NULL, ROLE_COSMETIC); e; e = G_NextRole(e, ROLE_COSMETIC))
+			{
+				if (e == ent)
+					continue;
+
+				const float score = Cosmetic_Score(e, origins, numorigins);
+				if (!worst || score > worstscore)
+				{
+					worst = e;
+					worstscore = score;
+				}
+			}
+
+			if (!worst)
+				break;
+
+			Cosmetic_Evict(worst);
+		}
+	}
+
+	cosmetic_stats.peak = max(cosmetic_stats.peak, G_RoleCount(ROLE_COSMETIC));
+}
+
+/*
+=================
+Cosmetic_Clear
+
+Forgets when things were thrown. Called when the edicts are replaced (level change, savegame load).
+Ones that come back with the level count as oldest.
+=================
+*/
+void Cosmetic_Clear(void)
+{
+	memset(cosmetic_born, 0, sizeof(cosmetic_born));
+}
+
+void Cosmetic_Stats_f(void)
+{
+	int gibs = 0, heads = 0, debris = 0, leaves = 0, resting = 0;
+
+	for (edict_t *ent = G_NextRole(NULL, ROLE_COSMETIC); ent; ent = G_NextRole(ent, ROLE_COSMETIC))
+	{
+		switch (ent->class_id)
+		{
+		case ENTITY_GIB:		gibs++;		break;
+		case ENTITY_GIBHEAD:	heads++;	break;
+		case ENTITY_LEAF:		leaves++;	break;
+		default:				debris++;	break;
+		}
+
+		if (ent->groundentity)
+			resting++;
+	}
+
+	safe_cprintf(NULL, PRINT_HIGH, "Cosmetics: %d live of %d allowed, %d at rest\n", G_RoleCount(ROLE_COSMETIC), (sv_maxcosmetics ? (int)sv_maxcosmetics->value : 0), resting);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d gibs and casings, %d heads, %d debris, %d leaves\n", gibs, heads, debris, leaves);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d thrown, %d evicted, peak %d\n", cosmetic_stats.added, cosmetic_stats.evicted, cosmetic_stats.peak);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&cosmetic_stats, 0, sizeof(cosmetic_stats));
+}
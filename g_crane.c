@@ -97,7 +97,7 @@ void Moving_Speaker_Think(edict_t *speaker)
 	}
 
 	VectorAdd(owner->s.origin, speaker->offset, speaker->s.origin);
-	speaker->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(speaker, level.time + FRAMETIME);
 	gi.linkentity(speaker);
 }
 
@@ -135,7 +135,7 @@ void Cargo_Stop(edict_t *ent)
 	// Sanity check: force cargo to correct elevation
 	ent->s.origin[2] += ent->crane_hook->absmin[2] - CARGO_BUFFER - ent->absmax[2];
 	ent->think = NULL;
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 	ent->gravity = 0.0;
 
 	vec3_t v;
@@ -161,7 +161,7 @@ void cargo_blocked(edict_t *cargo, edict_t *obstacle )
 	cargo->crane_hook->crane_cargo = NULL;
 	cargo->blocked = NULL;
 	cargo->touch = box_touch;
-	cargo->nextthink = 0;
+	G_SetNextThink(cargo, 0);
 
 	gi.linkentity(cargo);
 }
@@ -177,7 +177,7 @@ void Cargo_Float_Up(edict_t *cargo)
 		cargo->think = Cargo_Stop;
 	}
 
-	cargo->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(cargo, level.time + FRAMETIME);
 	gi.linkentity(cargo);
 }
 
@@ -211,7 +211,7 @@ void SetSpotlightLength(edict_t *hook)
 void Cable_Think(edict_t *cable)
 {
 	SetCableLength(cable);
-	cable->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(cable, level.time + FRAMETIME);
 	gi.linkentity(cable);
 }
 
@@ -248,7 +248,7 @@ void Crane_Move_Done(edict_t *ent)
 		{
 			VectorClear(light->velocity);
 			light->think = crane_light_off;
-			light->nextthink = level.time + 1.0f;
+			G_SetNextThink(light, level.time + 1.0f);
 			gi.linkentity(light);
 		}
 	}
@@ -272,7 +272,7 @@ void Crane_Move_Done(edict_t *ent)
 	VectorClear(ent->velocity);
 	ent->busy = false;
 	ent->think = NULL;
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 	gi.linkentity(ent);
 }
 
@@ -478,7 +478,7 @@ void Crane_Move_Final(edict_t *ent)
 	}
 
 	ent->think = Crane_Move_Done;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -514,7 +514,7 @@ void Crane_Move_Begin(edict_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + (frames * FRAMETIME);
+	G_SetNextThink(ent, level.time + (frames * FRAMETIME));
 	ent->think = Crane_Move_Final;
 	ent->blocked = Crane_blocked;
 	gi.linkentity(ent);
@@ -1350,7 +1350,7 @@ void crane_control_action(edict_t *control, edict_t *activator, const vec3_t poi
 		}
 
 		cable->think = Cable_Think;
-		cable->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(cable, level.time + FRAMETIME);
 
 		Crane_Move_Begin(hook);
 		if (cargo)
@@ -1446,7 +1446,7 @@ void crane_control_action(edict_t *control, edict_t *activator, const vec3_t poi
 					cargo->think = Cargo_Float_Up;
 					cargo->blocked = cargo_blocked;
 					cargo->goal_frame = level.framenum;
-					cargo->nextthink = level.time + FRAMETIME;
+					G_SetNextThink(cargo, level.time + FRAMETIME);
 					gi.linkentity(cargo);
 				}
 				else
@@ -1516,7 +1516,7 @@ void SpawnSpeaker(edict_t *self)
 		speaker->attenuation = self->attenuation; // was 1
 		speaker->owner = self;
 		speaker->think = Moving_Speaker_Think;
-		speaker->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(speaker, level.time + 2 * FRAMETIME);
 		speaker->spawnflags = 7;
 		self->speaker = speaker;
 		VectorAdd(self->absmin, self->absmax, speaker->s.origin);
@@ -1823,14 +1823,14 @@ void crane_reset_use(edict_t *self, edict_t *other, edict_t *activator)
 	edict_t *delay = G_Spawn();
 	delay->owner = control;
 	delay->think = crane_reset_go;
-	delay->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(delay, level.time + FRAMETIME);
 	gi.linkentity(delay);
 
 	self->count--;
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
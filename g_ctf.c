@@ -468,6 +468,9 @@ qboolean loc_CanSee(edict_t *targ, edict_t *inflictor)
 
 	for (int i = 0; i < 8; i++)
 	{
+		if (CModel_Blocked(viewpoint, vec3_origin, vec3_origin, targpoints[i], MASK_SOLID, NULL))
+			continue;
+
 		const trace_t trace = gi.trace(viewpoint, vec3_origin, vec3_origin, targpoints[i], inflictor, MASK_SOLID);
 		if (trace.fraction == 1.0)
 			return true;
@@ -650,7 +653,6 @@ int CTFOtherTeam2(int team)
 
 edict_t *SelectRandomDeathmatchSpawnPoint(void);
 edict_t *SelectFarthestDeathmatchSpawnPoint(void);
-float	PlayersRangeFromSpot(edict_t *spot);
 
 void CTFAssignSkin(edict_t *ent, char *s)
 {
@@ -785,48 +787,10 @@ edict_t *SelectCTFSpawnPoint(edict_t *ent)
 		return SelectRandomDeathmatchSpawnPoint();
 	}
 
-	edict_t *spot = NULL;
-	float range1 = 99999;
-	float range2 = 99999;
-	edict_t *spot1 = NULL;
-	edict_t *spot2 = NULL;
-
-	int count = 0;
-	while ((spot = G_Find(spot, FOFS(classname), cname)) != NULL)
-	{
-		count++;
-
-		const float range = PlayersRangeFromSpot(spot);
-		if (range < range1)
-		{
-			range1 = range;
-			spot1 = spot;
-		}
-		else if (range < range2)
-		{
-			range2 = range;
-			spot2 = spot;
-		}
-	}
-
-	if (!count)
+	edict_t *spot = SpawnSpot_Random(cname);
+	if (!spot)
 		return SelectRandomDeathmatchSpawnPoint();
 
-	if (count <= 2)
-		spot1 = spot2 = NULL;
-	else
-		count -= 2;
-
-	int selection = rand() % count;
-
-	spot = NULL;
-	do
-	{
-		spot = G_Find(spot, FOFS(classname), cname);
-		if (spot == spot1 || spot == spot2)
-			selection++;
-	} while (selection--);
-
 	return spot;
 }
 
@@ -1411,7 +1375,7 @@ void CTFDeadDropFlag(edict_t *self)
 		if (dropped)
 		{
 			dropped->think = CTFDropFlagThink;
-			dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+			G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
 			dropped->touch = CTFDropFlagTouch;
 		}
 	}
@@ -1425,7 +1389,7 @@ void CTFDeadDropFlag(edict_t *self)
 		if (dropped)
 		{
 			dropped->think = CTFDropFlagThink;
-			dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+			G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
 			dropped->touch = CTFDropFlagTouch;
 		}
 	}
@@ -1440,7 +1404,7 @@ void CTFDeadDropFlag(edict_t *self)
 		if (dropped)
 		{
 			dropped->think = CTFDropFlagThink;
-			dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+			G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
 			dropped->touch = CTFDropFlagTouch;
 		}
 	}
@@ -1471,7 +1435,7 @@ qboolean CTFDrop_Flag(edict_t *ent, gitem_t *item)
 			dropped->velocity[0] = (rand() % 600) - 300;
 			dropped->velocity[1] = (rand() % 600) - 300;
 			dropped->think = CTFDropFlagThink;
-			dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+			G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
 			dropped->touch = CTFDropFlagTouch;
 			dropped->timestamp = level.time;
 			dropped->touch_debounce_time = level.time + 1.0;
@@ -1491,7 +1455,7 @@ qboolean CTFDrop_Flag(edict_t *ent, gitem_t *item)
 			dropped->velocity[0] = (rand() % 600) - 300;
 			dropped->velocity[1] = (rand() % 600) - 300;
 			dropped->think = CTFDropFlagThink;
-			dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+			G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
 			dropped->touch = CTFDropFlagTouch;
 			dropped->timestamp = level.time;
 			dropped->touch_debounce_time = level.time + 1.0;
@@ -1511,7 +1475,7 @@ qboolean CTFDrop_Flag(edict_t *ent, gitem_t *item)
 			dropped->velocity[0] = (rand() % 600) - 300;
 			dropped->velocity[1] = (rand() % 600) - 300;
 			dropped->think = CTFDropFlagThink;
-			dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+			G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
 			dropped->touch = CTFDropFlagTouch;
 			dropped->timestamp = level.time;
 			dropped->touch_debounce_time = level.time + 1.0;
@@ -1527,7 +1491,7 @@ void CTFFlagThink(edict_t *ent)
 	if (ent->solid != SOLID_NOT)
 		ent->s.frame = 173 + (((ent->s.frame - 173) + 1) % 16);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 
@@ -1576,7 +1540,7 @@ void CTFFlagSetup(edict_t *ent)
 
 	gi.linkentity(ent);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->think = CTFFlagThink;
 }
 
@@ -2111,16 +2075,16 @@ void CTFGrappleTouch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t
 	gi.sound(self->owner, CHAN_RELIABLE + CHAN_WEAPON, gi.soundindex("weapons/grapple/grpull.wav"), volume, ATTN_NORM, 0);
 	gi.sound(self, CHAN_WEAPON, gi.soundindex("weapons/grapple/grhit.wav"), volume, ATTN_NORM, 0);
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_SPARKS);
-	gi.WritePosition(self->s.origin);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_SPARKS);
+	TempEnt_WritePosition(self->s.origin);
 
 	if (!plane)
-		gi.WriteDir(vec3_origin);
+		TempEnt_WriteDir(vec3_origin);
 	else
-		gi.WriteDir(plane->normal);
+		TempEnt_WriteDir(plane->normal);
 
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 }
 
 // draw beam between grapple and self
@@ -2144,13 +2108,13 @@ void CTFGrappleDrawCable(edict_t *self)
 
 	VectorCopy(self->s.origin, end);
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_GRAPPLE_CABLE);
-	gi.WriteShort(self->owner - g_edicts);
-	gi.WritePosition(self->owner->s.origin);
-	gi.WritePosition(end);
-	gi.WritePosition(offset);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_GRAPPLE_CABLE);
+	TempEnt_WriteShort(self->owner - g_edicts);
+	TempEnt_WritePosition(self->owner->s.origin);
+	TempEnt_WritePosition(end);
+	TempEnt_WritePosition(offset);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 }
 
 // pull the player toward the grapple
@@ -2916,7 +2880,7 @@ void TechThink(edict_t *tech)
 	}
 	else
 	{
-		tech->nextthink = level.time + CTF_TECH_TIMEOUT;
+		G_SetNextThink(tech, level.time + CTF_TECH_TIMEOUT);
 		tech->think = TechThink;
 	}
 }
@@ -2927,7 +2891,7 @@ void CTFDrop_Tech(edict_t *ent, gitem_t *item)
 		return;
 
 	edict_t *tech = Drop_Item(ent, item);
-	tech->nextthink = level.time + tech_life->value; // was CTF_TECH_TIMEOUT
+	G_SetNextThink(tech, level.time + tech_life->value); // was CTF_TECH_TIMEOUT
 	tech->think = TechThink;
 
 	if (allow_techpickup->value)
@@ -2954,7 +2918,7 @@ void CTFDeadDropTech(edict_t *ent)
 			// hack the velocity to make it bounce random
 			dropped->velocity[0] = (rand() % 600) - 300;
 			dropped->velocity[1] = (rand() % 600) - 300;
-			dropped->nextthink = level.time + tech_life->value; //was CTF_TECH_TIMEOUT
+			G_SetNextThink(dropped, level.time + tech_life->value); //was CTF_TECH_TIMEOUT
 			dropped->think = TechThink;
 			dropped->owner = NULL;
 
@@ -2971,10 +2935,9 @@ int TechCount(void)
 {
 	gitem_t	*tech;
 	int count = 0;
-	edict_t *mapent = g_edicts + 1; // skip the worldspawn
 	
-	// cycle through all ents to find techs
-	for (int i = 1; i < globals.num_edicts; i++, mapent++)
+	// cycle through all items to find techs
+	for (edict_t *mapent = G_NextRole(NULL, ROLE_ITEM); mapent; mapent = G_NextRole(mapent, ROLE_ITEM))
 		if (mapent->classname && !strncmp(mapent->classname, "item_tech", 9))
 			count++;
 
@@ -3003,18 +2966,13 @@ int NumOfTech(int index)
 	gitem_t	*tech;
 	int count = 0;
 	char techname[80];
-	edict_t *mapent = g_edicts + 1; // skip the worldspawn
-	
-	// cycle through all ents to find techs
-	for (int i = 1; i < globals.num_edicts; i++, mapent++)
-	{
-		if (!mapent->classname)
-			continue;
 
-		Com_sprintf(techname, sizeof(techname), "item_tech%d", index + 1);
-		if (!strcmp(mapent->classname, techname))
+	Com_sprintf(techname, sizeof(techname), "item_tech%d", index + 1);
+	
+	// cycle through all items to find techs
+	for (edict_t *mapent = G_NextRole(NULL, ROLE_ITEM); mapent; mapent = G_NextRole(mapent, ROLE_ITEM))
+		if (mapent->classname && !strcmp(mapent->classname, techname))
 			count++;
-	}
 
 	// cycle through all players to find techs
 	for (int i = 0; i < game.maxclients; i++)
@@ -3084,9 +3042,8 @@ void RemoveTechs(int oldtechcount, int newtechcount, int numtechtypes)
 	while (tnames[i] && j > newtechcount) // leave at least 1 of each tech
 	{
 		int removed = 0; // flag to remove only one tech per pass
-		edict_t *mapent = g_edicts + 1; // skip the worldspawn
 
-		for (int k = 1; k < globals.num_edicts; k++, mapent++)
+		for (edict_t *mapent = G_NextRole(NULL, ROLE_ITEM); mapent; mapent = G_NextRole(mapent, ROLE_ITEM))
 		{
 			if (!mapent->classname)
 				continue;
@@ -3189,7 +3146,7 @@ void SpawnTech(gitem_t *item, edict_t *spot)
 	VectorScale(forward, 100, ent->velocity);
 	ent->velocity[2] = 300;
 
-	ent->nextthink = level.time + tech_life->value;
+	G_SetNextThink(ent, level.time + tech_life->value);
 	ent->think = TechThink;
 
 	gi.linkentity(ent);
@@ -3238,18 +3195,15 @@ void CTFSetupTechSpawn(void)
 		return;
 
 	edict_t *ent = G_Spawn();
-	ent->nextthink = level.time + 2;
+	G_SetNextThink(ent, level.time + 2);
 	ent->think = SpawnTechs;
 }
 
 void CTFResetTech(void)
 {
-	edict_t *ent;
-	int i;
-
-	for (ent = g_edicts + 1, i = 1; i < globals.num_edicts; i++, ent++)
+	for (edict_t *ent = G_NextRole(NULL, ROLE_ITEM); ent; ent = G_NextRole(ent, ROLE_ITEM))
 	{
-		if (ent->inuse && ent->item && (ent->item->flags & IT_TECH))
+		if (ent->item->flags & IT_TECH)
 			G_FreeEdict(ent);
 	}
 
@@ -3877,7 +3831,7 @@ The banner is 248 tall.
 void misc_ctf_banner_think(edict_t *ent)
 {
 	ent->s.frame = (ent->s.frame + 1) % 16;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void SP_misc_ctf_banner(edict_t *ent)
@@ -3897,7 +3851,7 @@ void SP_misc_ctf_banner(edict_t *ent)
 	gi.linkentity(ent);
 
 	ent->think = misc_ctf_banner_think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*QUAKED misc_ctf_small_banner (1 .5 0) (-4 -32 0) (4 32 124) TEAM2 TEAM3
@@ -3921,7 +3875,7 @@ void SP_misc_ctf_small_banner(edict_t *ent)
 	gi.linkentity(ent);
 
 	ent->think = misc_ctf_banner_think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*-----------------------------------------------------------------------*/
@@ -4020,12 +3974,11 @@ void CTFResetAllPlayers(void)
 	CTFResetTech();
 	CTFResetFlags();
 
-	for (int i = 1; i < globals.num_edicts; i++)
+	for (edict_t *ent = G_NextRole(NULL, ROLE_ITEM); ent; ent = G_NextRole(ent, ROLE_ITEM))
 	{
-		edict_t *ent = g_edicts + i;
-		if (ent->inuse && !ent->client && ent->solid == SOLID_NOT && ent->think == DoRespawn && ent->nextthink >= level.time)
+		if (ent->solid == SOLID_NOT && ent->think == DoRespawn && ent->nextthink >= level.time)
 		{
-			ent->nextthink = 0;
+			G_SetNextThink(ent, 0);
 			DoRespawn(ent);
 		}
 	}
@@ -0,0 +1,293 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_danger.c -- where live grenades, rockets, BFG blasts and trigger_hurts can hurt you.
+// These entities are in the ROLE_DANGER registry, so nothing registers or unregisters them here:
+// they're in it while they exist (trigger_hurts while they're on). The first query of a frame, and
+// the first one after a danger appears or goes away, files each one's danger volume, a sphere of
+// dmg_radius or the trigger's box, in a hashed XY grid. Queries then only look at the volumes filed
+// in the cells they cover. Every danger gets at least one link: when the links run short, volumes
+// go on the list every query checks instead.
+
+#include "g_local.h"
+
+#define DANGER_CELL			256		// map units
+#define DANGER_HASH			64		// buckets, cells that hash together just share a list
+#define DANGER_MAX			512
+#define DANGER_MAX_CELLS	16		// bigger volumes go on the list every query checks
+#define DANGER_MAX_LINKS	(DANGER_MAX * 4)
+
+typedef struct
+{
+	edict_t	*ent;
+	int		type;		// DANGER_*
+	vec3_t	mins, maxs;	// where it can hurt, grown by a frame of movement
+	int		query;		// last query that looked at it
+} danger_t;
+
+typedef struct
+{
+	int		danger;
+	int		next;
+} dangerlink_t;
+
+static danger_t		dangers[DANGER_MAX];
+static int			num_dangers;
+static int			danger_buckets[DANGER_HASH];	// first link, -1 for none
+static dangerlink_t	danger_links[DANGER_MAX_LINKS];
+static int			num_danger_links;
+static int			danger_large;	// first link of the volumes that cover too many cells
+static int			danger_framenum = -1;	// frame the grid was built for
+static int			danger_rolechanges;		// G_RoleChanges(ROLE_DANGER) when it was built
+static int			danger_query;
+
+static struct
+{
+	int		builds;
+	int		volumes;
+	int		overflowed;	// filed on the large list because the links ran short
+	int		dropped;	// past DANGER_MAX, not filed at all
+	int		queries;
+	int		tested;		// volumes looked at by queries
+	int		found;
+} danger_stats;
+
+static int Danger_Type(edict_t *ent)
+{
+	switch (ent->class_id)
+	{
+	case ENTITY_GRENADE:
+	case ENTITY_HANDGRENADE:
+		return DANGER_GRENADE;
+	case ENTITY_ROCKET:
+		return DANGER_ROCKET;
+	case ENTITY_BFG:
+		return DANGER_BFG;
+	case ENTITY_TRIGGER_HURT:
+		return DANGER_HURT;
+	default:
+		return 0;
+	}
+}
+
+static int Danger_Bucket(int x, int y)
+{
+	return (int)(((unsigned)x * 73856093u ^ (unsigned)y * 19349663u) & (DANGER_HASH - 1));
+}
+
+static int Danger_CellCoord(float v)
+{
+	return (int)floorf(v / DANGER_CELL);
+}
+
+// Danger_Build keeps a link back for every danger still to be filed, so there's always room
+static void Danger_AddLink(int *head, int danger)
+{
+	dangerlink_t *link = &danger_links[num_danger_links];
+	link->danger = danger;
+	link->next = *head;
+	*head = num_danger_links++;
+}
+
+// Files every ROLE_DANGER entity by where it is now
+static void Danger_Build(void)
+{
+	danger_framenum = level.framenum;
+	danger_rolechanges = G_RoleChanges(ROLE_DANGER);
+	danger_stats.builds++;
+
+	num_dangers = 0;
+	num_danger_links = 0;
+	danger_large = -1;
+	for (int i = 0; i < DANGER_HASH; i++)
+		danger_buckets[i] = -1;
+
+	for (edict_t *ent = G_NextRole(NULL, ROLE_DANGER); ent; ent = G_NextRole(ent, ROLE_DANGER))
+	{
+		if (num_dangers == DANGER_MAX)
+		{
+			danger_stats.dropped++;
+			continue;
+		}
+
+		danger_t *d = &dangers[num_dangers];
+		d->ent = ent;
+		d->type = Danger_Type(ent);
+		d->query = 0;
+
+		if (d->type == DANGER_HURT)
+		{
+			VectorCopy(ent->absmin, d->mins);
+			VectorCopy(ent->absmax, d->maxs);
+		}
+		else
+		{
+			// Queries later this frame see it up to a frame further on
+			const float move = VectorLength(ent->velocity) * FRAMETIME;
+			for (int j = 0; j < 3; j++)
+			{
+				d->mins[j] = ent->s.origin[j] - ent->dmg_radius - move;
+				d->maxs[j] = ent->s.origin[j] + ent->dmg_radius + move;
+			}
+		}
+
+		const int x1 = Danger_CellCoord(d->mins[0]);
+		const int x2 = Danger_CellCoord(d->maxs[0]);
+		const int y1 = Danger_CellCoord(d->mins[1]);
+		const int y2 = Danger_CellCoord(d->maxs[1]);
+
+		const int cells = (x2 - x1 + 1) * (y2 - y1 + 1);
+		const int spare = DANGER_MAX_LINKS - num_danger_links - (DANGER_MAX - num_dangers - 1);
+
+		if (cells > DANGER_MAX_CELLS || cells > spare)
+		{
+			if (cells <= DANGER_MAX_CELLS)
+				danger_stats.overflowed++;
+
+			Danger_AddLink(&danger_large, num_dangers);
+		}
+		else
+		{
+			for (int y = y1; y <= y2; y++)
+				for (int x = x1; x <= x2; x++)
+					Danger_AddLink(&danger_buckets[Danger_Bucket(x, y)], num_dangers);
+		}
+
+		num_dangers++;
+	}
+
+	danger_stats.volumes += num_dangers;
+}
+
+// Does the danger reach within radius of point?
+static qboolean Danger_Reaches(const danger_t *d, const vec3_t point, float radius)
+{
+	const edict_t *ent = d->ent;
+	vec3_t v;
+
+	if (d->type == DANGER_HURT)
+	{
+		// Distance from point to the box
+		for (int i = 0; i < 3; i++)
+			v[i] = (point[i] < ent->absmin[i] ? ent->absmin[i] - point[i] : (point[i] > ent->absmax[i] ? point[i] - ent->absmax[i] : 0));
+
+		return (VectorLength(v) <= radius);
+	}
+
+	VectorSubtract(ent->s.origin, point, v);
+	return (VectorLength(v) <= radius + ent->dmg_radius);
+}
+
+static int Danger_Check(int link, const vec3_t point, float radius, int types, edict_t **list, int count, int maxlist)
+{
+	for (; link >= 0 && count < maxlist; link = danger_links[link].next)
+	{
+		danger_t *d = &dangers[danger_links[link].danger];
+		if (d->query == danger_query || !(d->type & types))
+			continue;
+
+		d->query = danger_query;
+		danger_stats.tested++;
+
+		if (!d->ent->inuse || Danger_Type(d->ent) != d->type)
+			continue; // Gone since the grid was built
+
+		if (Danger_Reaches(d, point, radius))
+			list[count++] = d->ent;
+	}
+
+	return count;
+}
+
+/*
+=================
+Danger_Find
+
+Fills list with up to maxlist entities of types (DANGER_*) that can hurt something within radius of point,
+in edict order. Returns how many were found.
+=================
+*/
+int Danger_Find(const vec3_t point, float radius, int types, edict_t **list, int maxlist)
+{
+	if (!G_RoleCount(ROLE_DANGER))
+		return 0;
+
+	// Projectiles fired since the last build have to be seen straight away
+	if (danger_framenum != level.framenum || danger_rolechanges != G_RoleChanges(ROLE_DANGER))
+		Danger_Build();
+
+	danger_stats.queries++;
+	danger_query++;
+
+	int count = Danger_Check(danger_large, point, radius, types, list, 0, maxlist);
+
+	const int x1 = Danger_CellCoord(point[0] - radius);
+	const int x2 = Danger_CellCoord(point[0] + radius);
+	const int y1 = Danger_CellCoord(point[1] - radius);
+	const int y2 = Danger_CellCoord(point[1] + radius);
+
+	for (int y = y1; y <= y2; y++)
+		for (int x = x1; x <= x2; x++)
+			count = Danger_Check(danger_buckets[Danger_Bucket(x, y)], point, radius, types, list, count, maxlist);
+
+	// Insertion sort, there are never many
+	for (int i = 1; i < count; i++)
+	{
+		edict_t *ent = list[i];
+		int j = i;
+		while (j > 0 && list[j - 1] > ent)
+		{
+			list[j] = list[j - 1];
+			j--;
+		}
+
+		list[j] = ent;
+	}
+
+	danger_stats.found += count;
+
+	return count;
+}
+
+/*
+=================
+Danger_Clear
+
+Forgets the grid. Called when the edicts are replaced (level change, savegame load).
+=================
+*/
+void Danger_Clear(void)
+{
+	danger_framenum = -1;
+	num_dangers = 0;
+}
+
+void Danger_Stats_f(void)
+{
+	safe_cprintf(NULL, PRINT_HIGH, "Danger registry: %d live\n", G_RoleCount(ROLE_DANGER));
+	safe_cprintf(NULL, PRINT_HIGH, "  %d grids built, %d volumes filed\n", danger_stats.builds, danger_stats.volumes);
+	if (danger_stats.overflowed || danger_stats.dropped)
+		safe_cprintf(NULL, PRINT_HIGH, "  %d volumes on the large list for lack of links, %d past the limit of %d not filed\n", danger_stats.overflowed, danger_stats.dropped, DANGER_MAX);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d queries, %d volumes tested, %d found\n", danger_stats.queries, danger_stats.tested, danger_stats.found);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&danger_stats, 0, sizeof(danger_stats));
+}
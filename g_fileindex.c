@@ -0,0 +1,423 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_fileindex.c -- cached file existence index for actor_files and the model patchers.
+// Every search folder (basedir/gamedir) gets its pak directories read once, and loose
+// file folders are listed the first time a file inside them is asked for. After that,
+// "does this file exist and where" is answered from memory.
+
+#include "g_local.h"
+#include "pak.h"
+#include <ctype.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
+
+#define FS_HASH_SIZE	4096
+#define FS_MAX_ROOTS	16
+#define FS_MAX_PAKS		10
+#define FS_LISTED		-1	// marks a loose file folder that's been listed
+
+typedef struct fsentry_s
+{
+	char		*name;
+	int			root;
+	fsfile_t	file;
+	struct fsentry_s *next;
+} fsentry_t;
+
+typedef struct
+{
+	char		path[MAX_OSPATH];
+	qboolean	paks_indexed;
+	char		*pakfiles[FS_MAX_PAKS];
+} fsroot_t;
+
+static fsentry_t	*fs_hash[FS_HASH_SIZE];
+static fsroot_t		fs_roots[FS_MAX_ROOTS];
+static int			fs_numroots;
+
+static unsigned FS_HashName(const char *name)
+{
+	unsigned hash = 0;
+
+	for (; *name; name++)
+		hash = hash * 31 + tolower((unsigned char)*name);
+
+	return hash & (FS_HASH_SIZE - 1);
+}
+
+// Pak files and Windows file names are case insensitive, loose files elsewhere aren't
+static qboolean FS_NameMatch(const fsentry_t *e, const char *name)
+{
+#ifndef _WIN32
+	if (e->file.where == FS_LOOSE)
+		return !strcmp(e->name, name);
+#endif
+
+	return !Q_stricmp(e->name, (char *)name);
+}
+
+static fsentry_t *FS_Lookup(int root, const char *name, int where)
+{
+	for (fsentry_t *e = fs_hash[FS_HashName(name)]; e; e = e->next)
+		if (e->root == root && e->file.where == where && FS_NameMatch(e, name))
+			return e;
+
+	return NULL;
+}
+
+static fsentry_t *FS_AddEntry(int root, const char *name, int where)
+{
+	fsentry_t *e = FS_Lookup(root, name, where);
+	if (e)
+		return e;
+
+	e = malloc(sizeof(fsentry_t));
+	if (!e)
+		return NULL;
+
+	memset(e, 0, sizeof(fsentry_t));
+	e->name = strdup(name);
+	e->root = root;
+	e->file.where = where;
+
+	const unsigned hash = FS_HashName(name);
+	e->next = fs_hash[hash];
+	fs_hash[hash] = e;
+
+	return e;
+}
+
+// Returns index of basedir/gamedir in fs_roots[], adding it if needed
+static int FS_GetRoot(const char *basedir, const char *gamedir)
+{
+	char path[MAX_OSPATH];
+
+	if (*basedir && *gamedir)
+		Com_sprintf(path, sizeof(path), "%s/%s", basedir, gamedir);
+	else
+		Q_strncpyz(path, (*gamedir ? gamedir : basedir), sizeof(path));
+
+	for (int i = 0; i < fs_numroots; i++)
+		if (!strcmp(fs_roots[i].path, path))
+			return i;
+
+	if (fs_numroots == FS_MAX_ROOTS)
+	{
+		gi.dprintf("FS_GetRoot: too many search folders\n");
+		return -1;
+	}
+
+	Q_strncpyz(fs_roots[fs_numroots].path, path, sizeof(fs_roots[fs_numroots].path));
+	return fs_numroots++;
+}
+
+// Reads pak directories of a search folder. Later paks override earlier ones, same as the engine.
+static void FS_IndexPaks(int root)
+{
+	fsroot_t *r = &fs_roots[root];
+	pak_header_t pakheader;
+	char pakfile[MAX_OSPATH];
+	char name[sizeof(((pak_item_t *)0)->name) + 1];
+
+	r->paks_indexed = true;
+
+	for (int k = 0; k < FS_MAX_PAKS; k++)
+	{
+		Com_sprintf(pakfile, sizeof(pakfile), "%s/pak%d.pak", r->path, k);
+
+		FILE *f = fopen(pakfile, "rb");
+		if (!f)
+			continue;
+
+		if (fread(&pakheader, 1, sizeof(pak_header_t), f) < sizeof(pak_header_t) || strncmp(pakheader.id, "PACK", 4))
+		{
+			fclose(f);
+			continue;
+		}
+
+		const int numitems = pakheader.dsize / sizeof(pak_item_t);
+		pak_item_t *items = malloc(numitems * sizeof(pak_item_t));
+		if (!items)
+		{
+			fclose(f);
+			continue;
+		}
+
+		fseek(f, pakheader.dstart, SEEK_SET);
+		const int numread = fread(items, sizeof(pak_item_t), numitems, f);
+		fclose(f);
+
+		r->pakfiles[k] = strdup(pakfile);
+
+		for (int i = 0; i < numread; i++)
+		{
+			Q_strncpyz(name, items[i].name, sizeof(name));
+
+			fsentry_t *e = FS_AddEntry(root, name, FS_PAK);
+			if (!e)
+				break;
+
+			e->file.pakfile = r->pakfiles[k];
+			e->file.start = items[i].start;
+			e->file.size = items[i].size;
+		}
+
+		free(items);
+	}
+}
+
+// Adds all files in a loose file folder to the index
+static void FS_ListFolder(int root, const char *folder)
+{
+	char path[MAX_OSPATH];
+	char name[MAX_OSPATH];
+
+	if (!FS_AddEntry(root, folder, FS_LISTED))
+		return;
+
+	Com_sprintf(path, sizeof(path), "%s/%s", fs_roots[root].path, folder);
+
+#ifdef _WIN32
+	struct _finddata_t findinfo;
+	const intptr_t handle = _findfirst(va("%s/*", path), &findinfo);
+	if (handle == -1)
+		return;
+
+	do
+	{
+		if (findinfo.attrib & _A_SUBDIR)
+			continue;
+
+		Com_sprintf(name, sizeof(name), "%s%s", folder, findinfo.name);
+		FS_AddEntry(root, name, FS_LOOSE);
+	} while (_findnext(handle, &findinfo) == 0);
+
+	_findclose(handle);
+#else
+	DIR *dir = opendir(path);
+	if (!dir)
+		return;
+
+	struct dirent *d;
+	while ((d = readdir(dir)) != NULL)
+	{
+		if (d->d_name[0] == '.')
+			continue;
+
+		Com_sprintf(name, sizeof(name), "%s%s", folder, d->d_name);
+		FS_AddEntry(root, name, FS_LOOSE);
+	}
+
+	closedir(dir);
+#endif
+}
+
+// Resolves "." and ".." path components, the same way the OS does for loose files.
+// Returns false if the path leaves the search folder.
+static qboolean FS_CleanPath(const char *filename, char *out, int size)
+{
+	char	*parts[64];
+	char	buf[MAX_OSPATH];
+	int		numparts = 0;
+
+	Q_strncpyz(buf, filename, sizeof(buf));
+
+	for (char *s = buf; *s; s++)
+		if (*s == '\\')
+			*s = '/';
+
+	for (char *s = strtok(buf, "/"); s; s = strtok(NULL, "/"))
+	{
+		if (!strcmp(s, "."))
+			continue;
+
+		if (!strcmp(s, ".."))
+		{
+			if (!numparts)
+				return false;
+
+			numparts--;
+			continue;
+		}
+
+		if (numparts == 64)
+			return false;
+
+		parts[numparts++] = s;
+	}
+
+	out[0] = 0;
+	for (int i = 0; i < numparts; i++)
+	{
+		if (i)
+			Q_strncatz(out, "/", size);
+		Q_strncatz(out, parts[i], size);
+	}
+
+	return (out[0] != 0);
+}
+
+/*
+=================
+FS_FindFile
+
+Returns location of filename in basedir/gamedir, or NULL if it isn't there.
+where is FS_LOOSE, FS_PAK, or both.
+=================
+*/
+const fsfile_t *FS_FindFile(const char *basedir, const char *gamedir, const char *filename, int where)
+{
+	static fsfile_t outside;
+	char name[MAX_OSPATH];
+
+	const int root = FS_GetRoot(basedir, gamedir);
+	if (root < 0)
+		return NULL;
+
+	if (where & FS_PAK)
+	{
+		if (!fs_roots[root].paks_indexed)
+			FS_IndexPaks(root);
+
+		const fsentry_t *e = FS_Lookup(root, filename, FS_PAK);
+		if (e)
+			return &e->file;
+	}
+
+	if (where & FS_LOOSE)
+	{
+		if (!FS_CleanPath(filename, name, sizeof(name)))
+		{
+			// Somewhere outside of this folder, can't use the index
+			FILE *f = fopen(va("%s/%s", fs_roots[root].path, filename), "rb");
+			if (!f)
+				return NULL;
+
+			fclose(f);
+			outside.where = FS_LOOSE;
+			return &outside;
+		}
+
+		char *p = strrchr(name, '/');
+		if (p)
+		{
+			char folder[MAX_OSPATH];
+			const char c = p[1];
+
+			p[1] = 0;
+			Q_strncpyz(folder, name, sizeof(folder));
+			p[1] = c;
+
+			if (!FS_Lookup(root, folder, FS_LISTED))
+				FS_ListFolder(root, folder);
+		}
+		else if (!FS_Lookup(root, "", FS_LISTED))
+		{
+			FS_ListFolder(root, "");
+		}
+
+		const fsentry_t *e = FS_Lookup(root, name, FS_LOOSE);
+		if (e)
+			return &e->file;
+	}
+
+	return NULL;
+}
+
+/*
+=================
+FS_AddFile
+
+Adds a file that's just been written to the index
+=================
+*/
+void FS_AddFile(const char *basedir, const char *gamedir, const char *filename)
+{
+	char name[MAX_OSPATH];
+
+	const int root = FS_GetRoot(basedir, gamedir);
+	if (root >= 0 && FS_CleanPath(filename, name, sizeof(name)))
+		FS_AddEntry(root, name, FS_LOOSE);
+}
+
+#ifdef KMQUAKE2_ENGINE_MOD
+/*
+=================
+FS_EngineFileExists
+
+Asks the engine filesystem (which also knows about .pk3 files) whether filename exists.
+Answers are remembered per game folder.
+=================
+*/
+qboolean FS_EngineFileExists(char *filename)
+{
+	cvar_t *game = gi.cvar("game", "", 0);
+
+	const int root = FS_GetRoot("*engine*", game->string);
+	if (root < 0)
+		return (gi.LoadFile(filename, NULL) > 2);
+
+	fsentry_t *e = FS_Lookup(root, filename, FS_ENGINE);
+	if (!e)
+	{
+		e = FS_AddEntry(root, filename, FS_ENGINE);
+		if (!e)
+			return (gi.LoadFile(filename, NULL) > 2);
+
+		e->file.size = gi.LoadFile(filename, NULL);
+	}
+
+	return (e->file.size > 2);
+}
+#endif
+
+/*
+=================
+FS_ClearIndex
+=================
+*/
+void FS_ClearIndex(void)
+{
+	for (int i = 0; i < FS_HASH_SIZE; i++)
+	{
+		fsentry_t *next;
+		for (fsentry_t *e = fs_hash[i]; e; e = next)
+		{
+			next = e->next;
+			free(e->name);
+			free(e);
+		}
+
+		fs_hash[i] = NULL;
+	}
+
+	for (int i = 0; i < fs_numroots; i++)
+		for (int k = 0; k < FS_MAX_PAKS; k++)
+			free(fs_roots[i].pakfiles[k]);
+
+	memset(fs_roots, 0, sizeof(fs_roots));
+	fs_numroots = 0;
+}
@@ -40,22 +40,22 @@ Fog is sent to engine like this:
 #define GL_EXP2		0x0801
 
 fog_t		gfogs[MAX_FOGS];
-fog_t		trig_fade_fog;
 fog_t		fade_fog;
 fog_t		*pfog;
 
-qboolean	InTriggerFog;
 float		last_software_frame;
 float		last_opengl_frame;
 
 int GLModels[3] = { GL_LINEAR, GL_EXP, GL_EXP2 };
 
-// engine fog
-int last_fog_model;
-int last_fog_density;
-int last_fog_near;
-int last_fog_far;
-int last_fog_color[3];
+// Fog state is tracked per client (client->resp.fog*). A client is only sent svc_fog when its own
+// quantized fog parameters change, and gradual changes (fades) are held to sv_fog_bandwidth bytes/sec.
+#define FOG_MESSAGE_SIZE	11		// svc_fog message size, in bytes
+#define FOG_MAX_BURST		(FOG_MESSAGE_SIZE * 2)
+
+// trigger_fog volumes, indexed by gfogs[] index
+static boxgrid_t	fog_grid;
+static qboolean		fog_index_dirty;
 
 #define FOG_ON       1
 #define FOG_TOGGLE   2
@@ -66,6 +66,133 @@ int last_fog_color[3];
 
 void fog_fade(edict_t *self);
 
+/*
+=================
+Fog_ClearIndex
+
+Must be called whenever TAG_LEVEL memory is freed
+=================
+*/
+void Fog_ClearIndex(void)
+{
+	memset(&fog_grid, 0, sizeof(fog_grid));
+	fog_index_dirty = true;
+}
+
+static void Fog_BuildIndex(void)
+{
+	vec3_t	mins[MAX_FOGS], maxs[MAX_FOGS];
+
+	fog_index_dirty = false;
+
+	for (int i = 0; i < level.fogs; i++)
+	{
+		if (gfogs[i].Trigger && gfogs[i].ent)
+		{
+			VectorCopy(gfogs[i].ent->absmin, mins[i]);
+			VectorCopy(gfogs[i].ent->absmax, maxs[i]);
+		}
+		else
+		{
+			// Not a trigger_fog, keep it out of the grid
+			VectorSet(mins[i], 1, 0, 0);
+			VectorSet(maxs[i], -1, 0, 0);
+		}
+	}
+
+	BoxGrid_Build(&fog_grid, level.fogs, mins, maxs, TAG_LEVEL);
+}
+
+// Returns gfogs[] index of the active trigger_fog containing viewpoint, or 0 if there's none
+static int Fog_FindTrigger(const vec3_t viewpoint)
+{
+	int *list;
+
+	if (!level.trigger_fogs)
+		return 0;
+
+	if (fog_index_dirty)
+		Fog_BuildIndex();
+
+	const int count = BoxGrid_Query(&fog_grid, viewpoint, &list);
+
+	for (int c = 0; c < count; c++)
+	{
+		const int i = list[c];
+		edict_t *trigger = gfogs[i].ent;
+
+		if (!trigger->inuse) continue;
+		if (!(trigger->spawnflags & FOG_ON)) continue;
+		if (viewpoint[0] < trigger->absmin[0]) continue;
+		if (viewpoint[0] > trigger->absmax[0]) continue;
+		if (viewpoint[1] < trigger->absmin[1]) continue;
+		if (viewpoint[1] > trigger->absmax[1]) continue;
+		if (viewpoint[2] < trigger->absmin[2]) continue;
+		if (viewpoint[2] > trigger->absmax[2]) continue;
+
+		return i;
+	}
+
+	return 0;
+}
+
+// Moves fog parameters 1/frames of the way towards goal
+static void Fog_FadeStep(fog_t *fog, const fog_t *goal, float frames)
+{
+	if (fog->Model == 0)
+	{
+		fog->Near += (goal->Near - fog->Near) / frames;
+		fog->Far  += (goal->Far  - fog->Far ) / frames;
+	}
+	else
+	{
+		fog->Density  += (goal->Density  - fog->Density)  / frames;
+		fog->Density1 += (goal->Density1 - fog->Density1) / frames;
+		fog->Density2 += (goal->Density2 - fog->Density2) / frames;
+	}
+
+	for (int i = 0; i < 3; i++)
+		fog->Color[i] += (goal->Color[i] - fog->Color[i]) / frames;
+
+	fog->GL_Model = GLModels[fog->Model];
+}
+
+/*
+=================
+Fog_At
+
+Returns the fog ent is seen through, or NULL if there is none
+=================
+*/
+fog_t *Fog_At(edict_t *ent)
+{
+	if (ent->client && ent->client->resp.fog_active)
+		return &ent->client->resp.fog;
+
+	if (level.active_fog)
+		return &level.fog;
+
+	return NULL;
+}
+
+static void Fog_Send(edict_t *ent, const fog_sent_t *state)
+{
+	gi.WriteByte(svc_fog);					// svc_fog = 21
+	gi.WriteByte(state->enable);			// 1 = on, 0 = off
+	gi.WriteByte(state->model);				// model 0, 1, or 2
+	gi.WriteByte(state->density);			// density 1 - 100
+	gi.WriteShort(state->near_dist);		// near >0, <fog_far
+	gi.WriteShort(state->far_dist);			// far >fog_near-64, < 5000
+	gi.WriteByte(state->color[0]);			// red	 0-255
+	gi.WriteByte(state->color[1]);			// green 0-255
+	gi.WriteByte(state->color[2]);			// blue	 0-255
+	gi.unicast(ent, true);
+
+	ent->client->resp.fog_sent = *state;
+	ent->client->resp.fog_sent.valid = true;
+	ent->client->resp.fog_budget -= FOG_MESSAGE_SIZE;
+}
+
 void Fog_ConsoleFog(void)
 {
 	// This routine is ONLY called for console fog commands
@@ -144,7 +271,7 @@ void Cmd_Fog_f(edict_t *ent)
 	}
 	else if (Q_stricmp(cmd, "fog_stuff") == 0)
 	{
-		gi.dprintf("active_fog=%d, last_active_fog=%d\n", level.active_fog, level.last_active_fog);
+		gi.dprintf("active_fog=%d, active_target_fog=%d, client fog=%d\n", level.active_fog, level.active_target_fog, (ent && ent->client ? ent->client->resp.fog_active : 0));
 	}
 	else if (Q_stricmp(cmd, "fog") == 0)
 	{
@@ -274,264 +401,152 @@ void Cmd_Fog_f(edict_t *ent)
 	}
 }
 
-void GLFog(void)
+void GLFog(edict_t *ent)
 {
 	// engine fog
-	edict_t	*player_ent = &g_edicts[1];
-	int fog_model, fog_color[3];
-	
-	if (!player_ent->client || player_ent->is_bot)
-		return;
+	client_respawn_t *resp = &ent->client->resp;
+	fog_sent_t state;
+
+	memset(&state, 0, sizeof(state));
+	state.enable = 1;
 
-	if (pfog->GL_Model == GL_EXP)
-		fog_model = 1;
-	else if (pfog->GL_Model == GL_EXP2)
-		fog_model = 2;
+	if (resp->fog.GL_Model == GL_EXP)
+		state.model = 1;
+	else if (resp->fog.GL_Model == GL_EXP2)
+		state.model = 2;
 	else // GL_LINEAR
-		fog_model = 0;
+		state.model = 0;
 
-	const auto fog_density = (int)pfog->Density;
-	const auto fog_near = (int)pfog->Near;
-	const auto fog_far = (int)pfog->Far;
+	state.density = (int)resp->fog.Density;
+	state.near_dist = (int)resp->fog.Near;
+	state.far_dist = (int)resp->fog.Far;
 
 	for (int i = 0; i < 3; i++)
-		fog_color[i] = (int)(pfog->Color[i] * 255);
+		state.color[i] = (int)(resp->fog.Color[i] * 255);
 
 	// check for change in fog state before updating
-	if (fog_model == last_fog_model
-		&& fog_density == last_fog_density
-		&& fog_near == last_fog_near
-		&& fog_far == last_fog_far
-		&& fog_color[0] == last_fog_color[0]
-		&& fog_color[1] == last_fog_color[1]
-		&& fog_color[2] == last_fog_color[2])
+	state.valid = true;
+	if (!memcmp(&state, &resp->fog_sent, sizeof(state)))
 		return;
 
-	gi.WriteByte(svc_fog);		// svc_fog = 21
-	gi.WriteByte(1);			// enable message
-	gi.WriteByte(fog_model);	// model 0, 1, or 2
-	gi.WriteByte(fog_density);	// density 1 - 100
-	gi.WriteShort(fog_near);	// near >0, <fog_far
-	gi.WriteShort(fog_far);		// far >fog_near-64, < 5000
-	gi.WriteByte(fog_color[0]);	// red	 0-255
-	gi.WriteByte(fog_color[1]);	// green 0-255
-	gi.WriteByte(fog_color[2]);	// blue	 0-255
-	gi.unicast(player_ent, true); 
-
-	// write to last fog state
-	last_fog_model = fog_model;
-	last_fog_density = fog_density;
-	last_fog_near = fog_near;
-	last_fog_far = fog_far;
-	VectorCopy(fog_color, last_fog_color);
-	last_opengl_frame = level.framenum;
-}
-
-void trig_fog_fade(edict_t *self)
-{
-	if (!InTriggerFog)
-	{
-		self->nextthink = 0;
+	// Gradual changes wait for bandwidth. Switching fog on or changing its model can't wait.
+	if (resp->fog_budget < FOG_MESSAGE_SIZE && resp->fog_sent.valid && resp->fog_sent.enable && resp->fog_sent.model == state.model)
 		return;
-	}
 
-	if (level.framenum <= self->goal_frame)
-	{
-		const int index = self->fog_index - 1;
-		const float frames = self->goal_frame - level.framenum + 1;
-
-		if (trig_fade_fog.Model == 0)
-		{
-			trig_fade_fog.Near += (gfogs[index].Near - trig_fade_fog.Near) / frames;
-			trig_fade_fog.Far  += (gfogs[index].Far  - trig_fade_fog.Far ) / frames;
-		}
-		else
-		{
-			trig_fade_fog.Density  += (gfogs[index].Density  - trig_fade_fog.Density)  / frames;
-			trig_fade_fog.Density1 += (gfogs[index].Density1 - trig_fade_fog.Density1) / frames;
-			trig_fade_fog.Density2 += (gfogs[index].Density2 - trig_fade_fog.Density2) / frames;
-		}
-
-		for (int i = 0; i < 3; i++)
-			trig_fade_fog.Color[i] += (gfogs[index].Color[i] - trig_fade_fog.Color[i]) / frames;
-
-		trig_fade_fog.GL_Model = GLModels[trig_fade_fog.Model];
-		self->nextthink = level.time + FRAMETIME;
-
-		gi.linkentity(self);
-	}
-}
-
-void init_trigger_fog_delay(edict_t *self)
-{
-	// scan for other trigger_fog's that are currently "thinking", iow the trigger_fog has a delay and is ramping. If found, stop the ramp for those fogs
-	for (int i = 1; i < globals.num_edicts; i++)
-	{
-		edict_t *e = g_edicts + i;
-		
-		if (!e->inuse || e == self)
-			continue;
-
-		if (e->think == trig_fog_fade || e->think == fog_fade)
-		{
-			e->think = NULL;
-			e->nextthink = 0;
-			gi.linkentity(e);
-		}
-	}
-
-	self->spawnflags |= FOG_ON;
-
-	const int index = self->fog_index - 1;
-	if (!level.active_fog)
-	{
-		// Fog isn't currently on
-		memcpy(&level.fog, &gfogs[index], sizeof(fog_t));
-		level.fog.Near = 4999.0;
-		level.fog.Far =  5000.0;
-		level.fog.Density =  0.0;
-		level.fog.Density1 = 0.0;
-		level.fog.Density2 = 0.0;
-	}
-
-	VectorCopy(self->fog_color, gfogs[index].Color);
-	gfogs[index].Near = self->fog_near;
-	gfogs[index].Far =  self->fog_far;
-	gfogs[index].Density =  self->fog_density;
-	gfogs[index].Density1 = self->fog_density;
-	gfogs[index].Density2 = self->density;
-
-	self->goal_frame = level.framenum + self->delay * 10 + 1;
-	self->think = trig_fog_fade;
-	self->nextthink = level.time + FRAMETIME;
-	memcpy(&trig_fade_fog, &level.fog, sizeof(fog_t));
-	level.active_fog = self->fog_index;
+	Fog_Send(ent, &state);
+	last_opengl_frame = level.framenum;
 }
 
 void Fog(edict_t *ent)
 {
-	edict_t	*player = ent;
+	gclient_t *client = ent->client;
 	vec3_t	viewpoint;
 
-	if (!gl_driver || !vid_ref || deathmatch->value || coop->value || !player->client || player->is_bot)
+	if (!gl_driver || !vid_ref || !client || ent->is_bot)
 		return;
 
-	VectorCopy(player->s.origin, viewpoint);
-	viewpoint[2] += ent->viewheight;
+	client_respawn_t *resp = &client->resp;
+
+	// svc_fog is reliable, so there's no point in doing this more than once per server frame
+	if (resp->fog_framenum == level.framenum)
+		return;
+
+	resp->fog_framenum = level.framenum;
+
+	// Refill bandwidth allowance. Single player games are not limited.
+	if (game.maxclients == 1 || sv_fog_bandwidth->value <= 0)
+		resp->fog_budget = FOG_MAX_BURST;
+	else
+		resp->fog_budget = min(resp->fog_budget + sv_fog_bandwidth->value * FRAMETIME, FOG_MAX_BURST);
 
-	if (Q_stricmp(vid_ref->string, "gl"))
+	// vid_ref only tells us about the local client
+	if (game.maxclients == 1 && Q_stricmp(vid_ref->string, "gl"))
 	{
 		last_software_frame = level.framenum;
 		level.active_fog = 0;
 		return;
 	}
 
-	InTriggerFog = false;
-	if (level.trigger_fogs)
+	VectorCopy(ent->s.origin, viewpoint);
+	viewpoint[2] += ent->viewheight;
+
+	const int trigger = Fog_FindTrigger(viewpoint);
+	if (trigger)
 	{
-		int trigger = 0;
-		for (int i = 1; i < level.fogs; i++)
-		{
-			if (!gfogs[i].Trigger) continue;
-			if (!gfogs[i].ent->inuse) continue;
-			if (!(gfogs[i].ent->spawnflags & FOG_ON)) continue;
-			if (viewpoint[0] < gfogs[i].ent->absmin[0]) continue;
-			if (viewpoint[0] > gfogs[i].ent->absmax[0]) continue;
-			if (viewpoint[1] < gfogs[i].ent->absmin[1]) continue;
-			if (viewpoint[1] > gfogs[i].ent->absmax[1]) continue;
-			if (viewpoint[2] < gfogs[i].ent->absmin[2]) continue;
-			if (viewpoint[2] > gfogs[i].ent->absmax[2]) continue;
-
-			trigger = i;
-			break;
-		}
+		edict_t *triggerfog = gfogs[trigger].ent;
 
-		if (trigger)
+		if (resp->fog_active != trigger + 1)
 		{
-			InTriggerFog = true;
-			edict_t *triggerfog = gfogs[trigger].ent;
-
-			if (level.last_active_fog != trigger + 1)
+			// Just entered this trigger_fog
+			if (triggerfog->delay)
 			{
-				if (triggerfog->delay)
-					init_trigger_fog_delay(triggerfog);
-				else
-					memcpy(&level.fog, &gfogs[trigger], sizeof(fog_t));
-
-				level.active_fog = trigger+1;
+				if (!resp->fog_active)
+				{
+					// Fog isn't currently on
+					memcpy(&resp->fog, &gfogs[trigger], sizeof(fog_t));
+					resp->fog.Near = 4999.0;
+					resp->fog.Far =  5000.0;
+					resp->fog.Density =  0.0;
+					resp->fog.Density1 = 0.0;
+					resp->fog.Density2 = 0.0;
+				}
+
+				resp->fog_goal_frame = level.framenum + triggerfog->delay * 10 + 1;
 			}
-			else if (triggerfog->delay)
+			else
 			{
-				memcpy(&level.fog, &trig_fade_fog, sizeof(fog_t));
+				memcpy(&resp->fog, &gfogs[trigger], sizeof(fog_t));
+				resp->fog_goal_frame = 0;
 			}
-		}
-		else
-		{
-			InTriggerFog = false;
-			level.active_fog = level.active_target_fog;
-
-			// if we are just coming out of a trigger_fog, force level.fog to last active target_fog values
-			if (level.active_fog && level.last_active_fog && gfogs[level.last_active_fog - 1].Trigger)
-			{
-				edict_t	*fogent = gfogs[level.active_fog - 1].ent;
 
-				if (fogent && fogent->think == fog_fade)
-					fogent->think(fogent);
-				else
-					memcpy(&level.fog, &gfogs[level.active_fog - 1], sizeof(fog_t));
-			}
+			resp->fog_active = trigger + 1;
 		}
+
+		// Ramp towards trigger_fog values
+		if (level.framenum <= resp->fog_goal_frame)
+			Fog_FadeStep(&resp->fog, &gfogs[trigger], resp->fog_goal_frame - level.framenum + 1);
+	}
+	else
+	{
+		// Outside of trigger_fogs, clients see the level-wide target_fog
+		resp->fog_active = level.active_fog;
+		if (level.active_fog)
+			memcpy(&resp->fog, &level.fog, sizeof(fog_t));
 	}
 	
-	if (!level.active_fog)
+	if (!resp->fog_active)
 	{
-		if (level.last_active_fog)
-			Fog_Off();
+		if (!resp->fog_sent.valid || resp->fog_sent.enable)
+			Fog_Off(ent);
 
-		level.last_active_fog = 0;
 		return;
 	}
 	
-	pfog = &level.fog;
-	if (pfog->Density1 != pfog->Density2 && game.maxclients == 1 && pfog->Model)
+	pfog = &resp->fog;
+	if (pfog->Density1 != pfog->Density2 && pfog->Model)
 	{
 		vec3_t vp;
 
-		AngleVectors(player->client->ps.viewangles, vp, 0, 0);
+		AngleVectors(client->ps.viewangles, vp, 0, 0);
 		const float dp = DotProduct(pfog->Dir, vp) + 1.0f;
 		const float density = ((pfog->Density1 * dp) + (pfog->Density2 * (2.0 - dp))) / 2.0f;
 
 		pfog->Density = density;
 	}
 
-	GLFog();
-	level.last_active_fog = level.active_fog;
+	GLFog(ent);
 }
 
-void Fog_Off(void)
+void Fog_Off(edict_t *ent)
 {
-	if (deathmatch->value || coop->value)
-		return;
-
-	edict_t	*player_ent = &g_edicts[1];
+	fog_sent_t state;
 
-	if (!player_ent->client || player_ent->is_bot)
+	if (!ent->client || ent->is_bot)
 		return;
 
-	gi.WriteByte(svc_fog); // svc_fog = 21
-	gi.WriteByte(0); // disable message, remaining paramaters are ignored
-	gi.WriteByte(0); // 0, 1, or 2
-	gi.WriteByte(0); // 1-100
-	gi.WriteShort(0); // >0, <fog_far
-	gi.WriteShort(0); // >fog_near-64, < 5000
-	gi.WriteByte(0); // 0-255
-	gi.WriteByte(0); // 0-255
-	gi.WriteByte(0); // 0-255
-	gi.unicast(player_ent, true);
-
-	// write to last fog state
-	last_fog_model = last_fog_density = last_fog_near = last_fog_far = 0;
-	VectorSet(last_fog_color, 255, 255, 255);
+	// disable message, remaining paramaters are ignored
+	memset(&state, 0, sizeof(state));
+	Fog_Send(ent, &state);
 }
 
 void Fog_Init(void)
@@ -541,10 +556,6 @@ void Fog_Init(void)
 	gfogs[0].GL_Model = GLModels[1];
 	gfogs[0].Density  = 20.;
 	gfogs[0].Trigger  = false;
-
-	// write to last fog state
-	last_fog_model = last_fog_density = last_fog_near = last_fog_far = 0;
-	VectorSet(last_fog_color, 255, 255, 255);
 }
 
 
@@ -555,26 +566,10 @@ void fog_fade(edict_t *self)
 		const int index = self->fog_index - 1;
 		const float frames = self->goal_frame - level.framenum + 1;
 
-		if (fade_fog.Model == 0)
-		{
-			fade_fog.Near += (gfogs[index].Near - fade_fog.Near) / frames;
-			fade_fog.Far  += (gfogs[index].Far  - fade_fog.Far ) / frames;
-		}
-		else
-		{
-			fade_fog.Density  += (gfogs[index].Density  - fade_fog.Density)  / frames;
-			fade_fog.Density1 += (gfogs[index].Density1 - fade_fog.Density1) / frames;
-			fade_fog.Density2 += (gfogs[index].Density2 - fade_fog.Density2) / frames;
-		}
-
-		for (int i = 0; i < 3; i++)
-			fade_fog.Color[i] += (gfogs[index].Color[i] - fade_fog.Color[i]) / frames;
+		Fog_FadeStep(&fade_fog, &gfogs[index], frames);
+		G_SetNextThink(self, level.time + FRAMETIME);
 
-		fade_fog.GL_Model = GLModels[fade_fog.Model];
-		self->nextthink = level.time + FRAMETIME;
-
-		if (!InTriggerFog)
-			memcpy(&level.fog, &fade_fog, sizeof(fog_t));
+		memcpy(&level.fog, &fade_fog, sizeof(fog_t));
 
 		gi.linkentity(self);
 	}
@@ -609,7 +604,7 @@ void target_fog_use(edict_t *self, edict_t *other, edict_t *activator)
 	if (self->count == 0)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + self->delay + 1;
+		G_SetNextThink(self, level.time + self->delay + 1);
 	}
 
 	if ((self->spawnflags & FOG_ON) && (self->spawnflags & FOG_TOGGLE))
@@ -622,8 +617,6 @@ void target_fog_use(edict_t *self, edict_t *other, edict_t *activator)
 
 	const int index = self->fog_index - 1;
 
-	InTriggerFog = false;
-
 	// scan for other target_fog's that are currently "thinking", iow
 	// the target_fog has a delay and is ramping. If found, stop the ramp for those fogs
 	for (int i = 1; i < globals.num_edicts; i++)
@@ -634,7 +627,7 @@ void target_fog_use(edict_t *self, edict_t *other, edict_t *activator)
 
 		if (e->think == fog_fade)
 		{
-			e->nextthink = 0;
+			G_SetNextThink(e, 0);
 			gi.linkentity(e);
 		}
 	}
@@ -653,7 +646,7 @@ void target_fog_use(edict_t *self, edict_t *other, edict_t *activator)
 			VectorCopy(level.fog.Color, gfogs[index].Color);
 			self->goal_frame = level.framenum + self->delay * 10 + 1;
 			self->think = fog_fade;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 			level.active_fog = level.active_target_fog = self->fog_index;
 			memcpy(&fade_fog, &level.fog, sizeof(fog_t));
 		}
@@ -685,7 +678,7 @@ void target_fog_use(edict_t *self, edict_t *other, edict_t *activator)
 			gfogs[index].Density2 = self->density;
 			self->goal_frame = level.framenum + self->delay * 10 + 1;
 			self->think = fog_fade;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 			memcpy(&fade_fog, &level.fog, sizeof(fog_t));
 		}
 		else
@@ -699,7 +692,7 @@ void target_fog_use(edict_t *self, edict_t *other, edict_t *activator)
 
 void SP_target_fog(edict_t *self)
 {
-	if (!allow_fog->value || deathmatch->value || coop->value)
+	if (!allow_fog->value)
 	{
 		G_FreeEdict(self);
 		return;
@@ -794,7 +787,7 @@ void trigger_fog_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (self->count == 0)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 	}
 	else
@@ -805,7 +798,7 @@ void trigger_fog_use(edict_t *self, edict_t *other, edict_t *activator)
 
 void SP_trigger_fog(edict_t *self)
 {
-	if (!allow_fog->value || deathmatch->value || coop->value)
+	if (!allow_fog->value)
 	{
 		G_FreeEdict(self);
 		return;
@@ -866,6 +859,7 @@ void SP_trigger_fog(edict_t *self)
 	fog->ent = self;
 	level.fogs++;
 	level.trigger_fogs++;
+	fog_index_dirty = true;
 	self->movetype = MOVETYPE_NONE;
 	self->svflags |= SVF_NOCLIENT;
 	self->solid = SOLID_NOT;
@@ -895,7 +889,7 @@ tright Max b-box coords XYZ. Default = 16 16 16
 
 void SP_trigger_fog_bbox(edict_t *self)
 {
-	if (!allow_fog->value || deathmatch->value || coop->value)
+	if (!allow_fog->value)
 	{
 		G_FreeEdict(self);
 		return;
@@ -955,6 +949,7 @@ void SP_trigger_fog_bbox(edict_t *self)
 	fog->ent = self;
 	level.fogs++;
 	level.trigger_fogs++;
+	fog_index_dirty = true;
 	self->movetype = MOVETYPE_NONE;
 	self->svflags |= SVF_NOCLIENT;
 	self->solid = SOLID_NOT;
@@ -52,33 +52,34 @@ void set_child_movement(edict_t *self)
 	vec3_t	angles, amove;
 	vec3_t	offset;
 	vec3_t	delta_angles;
+	vec3_t	vector_angles;
 
-	if (!self->inuse)
+	if (!self->inuse || !self->movewith_child)
 		return;
 
-	edict_t *e = self->movewith_next;
-	edict_t *parent = self;
+	// Point entities are turned by the angle it moved through, which mustn't happen twice in a frame
+	const qboolean turn = Movewith_Updated(self);
 
-	while (e != NULL)
+	edict_t *next;
+	for (edict_t *e = self->movewith_child; e; e = next)
 	{
-restart:
-		if (!e->inuse)
-			break;
+		next = e->movewith_next;
 
+		// Children attached at the same time have the same attach angles, so only work the vectors out when those change
 		VectorSubtract(self->s.angles, e->parent_attach_angles, delta_angles);
-		AngleVectors(delta_angles, forward, right, up);
-		VectorNegate(right, right);
+		if (e == self->movewith_child || !VectorCompare(delta_angles, vector_angles))
+		{
+			AngleVectors(delta_angles, forward, right, up);
+			VectorNegate(right, right);
+			VectorCopy(delta_angles, vector_angles);
+		}
 
-		// remove gibbed monsters from the chain
+		// gibbed monsters stop moving with it
 		const qboolean is_monster = (e->svflags & SVF_MONSTER); //mxd
 		if (is_monster && e->health <= e->gib_health)
 		{
-			parent->movewith_next = e->movewith_next;
-			e = e->movewith_next;
-			if (e)
-				goto restart;
-
-			break;
+			Movewith_Detach(e);
+			continue;
 		}
 
 		// For all but func_button and func_door, move origin and match velocities
@@ -125,7 +126,8 @@ restart:
 				}
 				else if (e->movedir[1] > 0)
 				{
-					e->s.angles[1] += amove[1];
+					if (turn)
+						e->s.angles[1] += amove[1];
 					e->s.angles[2] =  delta_angles[2] * cy;
 					e->s.angles[0] = -delta_angles[2] * sy;
 				}
@@ -173,7 +175,8 @@ restart:
 					else
 					{
 						// For point entities, best we can do is apply a delta to the angles. This may result in foulups if anything gets blocked
-						VectorAdd(e->s.angles, amove, e->s.angles);
+						if (turn)
+							VectorAdd(e->s.angles, amove, e->s.angles);
 					}
 				}
 			}
@@ -250,8 +253,9 @@ restart:
 
 		e->s.event = self->s.event;
 		gi.linkentity(e);
-		parent = e;
-		e = e->movewith_next;
+
+		// And whatever is moving with it
+		set_child_movement(e);
 	}
 }
 
@@ -355,14 +359,12 @@ void train_spline(edict_t *self)
 		{
 			VectorClear(self->avelocity);
 			VectorClear(self->velocity);
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 
 			return;
 		}
 
-		spline_calc(train, train->from->s.origin, train->to->s.origin, 
-						   train->from->s.angles, train->to->s.angles,
-						   train->moveinfo.ratio, p, a);
+		Path_SplinePoint(train, train->from, train->to, train->moveinfo.ratio, p, a);
 
 		if (!(train->spawnflags & TRAIN_ORIGIN)) // Knightmare- func_train_origin support
 			VectorSubtract(p, train->mins, p);
@@ -381,18 +383,18 @@ void train_spline(edict_t *self)
 		gi.linkentity(train);
 		train->moveinfo.ratio += train->moveinfo.speed * FRAMETIME / train->moveinfo.distance;
 
-		if (train->movewith_next && (train->movewith_next->movewith_ent == train))
+		if (train->movewith_child)
 			set_child_movement(train);
 
 		if (train->moveinfo.ratio >= 1.0f)
 		{
 			train->moveinfo.endfunc = NULL;
 			train->think = train_wait;
-			train->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(train, level.time + FRAMETIME);
 		}
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void check_reverse_rotation(edict_t *self, const vec3_t point)
@@ -491,7 +493,7 @@ void Move_Done(edict_t *ent)
 	if (ent->moveinfo.endfunc)
 		ent->moveinfo.endfunc(ent);
 
-	if (ent->movewith_next && ent->movewith_next->movewith_ent == ent)
+	if (ent->movewith_child)
 		set_child_movement(ent);
 }
 
@@ -509,9 +511,9 @@ void Move_Final(edict_t *ent)
 		VectorAdd(ent->movewith_ent->velocity,ent->velocity,ent->velocity);
 
 	ent->think = Move_Done;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
-	if (ent->movewith_next && ent->movewith_next->movewith_ent == ent)
+	if (ent->movewith_child)
 		set_child_movement(ent);
 }
 
@@ -529,7 +531,7 @@ void Move_Begin(edict_t *ent)
 	{
 		VectorAdd(ent->movewith_ent->velocity, ent->velocity, ent->velocity);
 		ent->moveinfo.remaining_distance -= ent->moveinfo.speed * FRAMETIME;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 		ent->think = Move_Begin;
 	}
 	else
@@ -573,19 +575,19 @@ void Move_Begin(edict_t *ent)
 			VectorSubtract(dest, ent->s.origin, ent->moveinfo.dir);
 			ent->moveinfo.remaining_distance = VectorNormalize(ent->moveinfo.dir);
 			VectorScale(ent->moveinfo.dir, ent->moveinfo.speed, ent->velocity);
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(ent, level.time + FRAMETIME);
 			ent->think = Move_Begin;
 		}
 		else
 		{
 			const float frames = floor(ent->moveinfo.remaining_distance / ent->moveinfo.speed / FRAMETIME);
 			ent->moveinfo.remaining_distance -= frames * ent->moveinfo.speed * FRAMETIME;
-			ent->nextthink = level.time + (frames * FRAMETIME);
+			G_SetNextThink(ent, level.time + (frames * FRAMETIME));
 			ent->think = Move_Final;
 		}
 	}
 
-	if (ent->movewith_next && ent->movewith_next->movewith_ent == ent)
+	if (ent->movewith_child)
 		set_child_movement(ent);
 }
 
@@ -607,7 +609,7 @@ void Move_Calc(edict_t *ent, const vec3_t dest, void(*func)(edict_t*))
 		}
 		else
 		{
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(ent, level.time + FRAMETIME);
 			ent->think = Move_Begin;
 		}
 	}
@@ -616,7 +618,7 @@ void Move_Calc(edict_t *ent, const vec3_t dest, void(*func)(edict_t*))
 		// accelerative
 		ent->moveinfo.current_speed = 0;
 		ent->think = Think_AccelMove;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 }
 
@@ -649,7 +651,7 @@ void AngleMove_Final(edict_t *ent)
 
 	VectorScale(move, 1.0 / FRAMETIME, ent->avelocity);
 	ent->think = AngleMove_Done;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void AngleMove_Begin(edict_t *ent)
@@ -680,7 +682,7 @@ void AngleMove_Begin(edict_t *ent)
 	VectorScale(destdelta, 1.0 / traveltime, ent->avelocity);
 	
 	// set nextthink to trigger a think when dest is reached
-	ent->nextthink = level.time + frames * FRAMETIME;
+	G_SetNextThink(ent, level.time + frames * FRAMETIME);
 	ent->think = AngleMove_Final;
 }
 
@@ -694,7 +696,7 @@ void AngleMove_Calc(edict_t *ent, void(*func)(edict_t*))
 	}
 	else
 	{
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 		ent->think = AngleMove_Begin;
 	}
 }
@@ -819,10 +821,10 @@ void Think_AccelMove(edict_t *ent)
 	if (ent->movewith)
 		VectorAdd(ent->movewith_ent->velocity, ent->velocity, ent->velocity);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->think = Think_AccelMove;
 
-	if (ent->movewith_next && ent->movewith_next->movewith_ent == ent)
+	if (ent->movewith_child)
 		set_child_movement(ent);
 }
 
@@ -841,7 +843,7 @@ void plat_hit_top(edict_t *ent)
 
 	ent->moveinfo.state = STATE_TOP;
 	ent->think = plat_go_down;
-	ent->nextthink = level.time + (ent->moveinfo.wait ? ent->moveinfo.wait : (ent->wait ? ent->wait : 3)); //mxd. Use movement reset delay if provided, or wait delay, or default delay
+	G_SetNextThink(ent, level.time + (ent->moveinfo.wait ? ent->moveinfo.wait : (ent->wait ? ent->wait : 3))); //mxd. Use movement reset delay if provided, or wait delay, or default delay
 }
 
 void plat_hit_bottom(edict_t *ent)
@@ -937,7 +939,7 @@ void Touch_Plat_Center(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t
 		{
 			if (ent->nextthink < level.time)
 			{
-				ent->nextthink = level.time + ent->wait;
+				G_SetNextThink(ent, level.time + ent->wait);
 				ent->think = plat_go_up;
 			}
 
@@ -953,14 +955,14 @@ void Touch_Plat_Center(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t
 		{
 			if (ent->nextthink < level.time)
 			{
-				ent->nextthink = level.time + ent->wait;
+				G_SetNextThink(ent, level.time + ent->wait);
 				ent->think = plat_go_down;
 			}
 
 			return;
 		}
 
-		ent->nextthink = level.time + 1; // the player is still on the plat, so delay going down
+		G_SetNextThink(ent, level.time + 1); // the player is still on the plat, so delay going down
 	}
 	else
 	{
@@ -1144,7 +1146,7 @@ void rotating_accel(edict_t *self)
 		current_speed += self->accel;
 		VectorScale(self->movedir, current_speed, self->avelocity);
 		self->think = rotating_accel;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1162,7 +1164,7 @@ void rotating_decel(edict_t *self)
 		current_speed -= self->decel;
 		VectorScale(self->movedir, current_speed, self->avelocity);
 		self->think = rotating_decel;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1322,7 +1324,7 @@ void SP_func_rotating_dh(edict_t *ent)
 
 	// Wait a few frames so that we're sure pathtarget has been parsed.
 	ent->think = func_rotating_dh_init;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -1382,7 +1384,7 @@ void button_wait(edict_t *self)
 
 	if (self->moveinfo.wait >= 0)
 	{
-		self->nextthink = level.time + self->moveinfo.wait;
+		G_SetNextThink(self, level.time + self->moveinfo.wait);
 		self->think = button_return;
 	}
 }
@@ -1548,7 +1550,7 @@ void trainbutton_wait(edict_t *self)
 
 	if (self->moveinfo.wait >= 0)
 	{
-		self->nextthink = level.time + self->moveinfo.wait;
+		G_SetNextThink(self, level.time + self->moveinfo.wait);
 		self->think = trainbutton_return;
 	}
 }
@@ -1595,11 +1597,11 @@ void movewith_init(edict_t *self)
 	if (!self->targetname)
 		return;
 
-	edict_t *child = G_Find(NULL, FOFS(movewith), self->targetname);
-	edict_t *e = self;
-	while (child)
+	for (edict_t *child = G_Find(NULL, FOFS(movewith), self->targetname); child; child = G_Find(child, FOFS(movewith), self->targetname))
 	{
-		child->movewith_ent = self;
+		Movewith_Attach(child, self);
+		if (child->movewith_ent != self)
+			continue; // self is moving with it
 
 		// Copy parent's current angles to the child. They SHOULD be 0,0,0 at this point for all currently supported parents, but ya never know.
 		VectorCopy(self->s.angles, child->parent_attach_angles);
@@ -1612,9 +1614,6 @@ void movewith_init(edict_t *self)
 		VectorCopy(child->mins, child->org_mins);
 		VectorCopy(child->maxs, child->org_maxs);
 		VectorSubtract(child->s.origin, self->s.origin, child->movewith_offset);
-		e->movewith_next = child;
-		e = child;
-		child = G_Find(child, FOFS(movewith), self->targetname);
 	}
 }
 
@@ -1736,7 +1735,7 @@ void door_hit_top(edict_t *self)
 	{
 		self->think = swinging_door_reset;
 		if (self->moveinfo.wait > 0)
-			self->nextthink = level.time + self->moveinfo.wait;
+			G_SetNextThink(self, level.time + self->moveinfo.wait);
 		else
 			self->think(self);
 
@@ -1748,7 +1747,7 @@ void door_hit_top(edict_t *self)
 		if (self->flags & FL_BOB)
 		{
 			self->think = bob_init;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 
 		return;
@@ -1757,12 +1756,12 @@ void door_hit_top(edict_t *self)
 	if (self->moveinfo.wait >= 0)
 	{
 		self->think = door_go_down;
-		self->nextthink = level.time + self->moveinfo.wait;
+		G_SetNextThink(self, level.time + self->moveinfo.wait);
 	}
 	else if (self->flags & FL_BOB)
 	{
 		self->think = bob_init;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1784,7 +1783,7 @@ void door_hit_bottom(edict_t *self)
 	if (self->flags & FL_BOB)
 	{
 		self->think = bob_init;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1833,7 +1832,7 @@ void door_go_up(edict_t *self, edict_t *activator)
 	{	
 		// reset top wait time
 		if (self->moveinfo.wait >= 0)
-			self->nextthink = level.time + self->moveinfo.wait;
+			G_SetNextThink(self, level.time + self->moveinfo.wait);
 
 		return;
 	}
@@ -2205,7 +2204,7 @@ void SP_func_door(edict_t *ent)
 
 	gi.linkentity(ent);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	if (ent->health || ent->targetname )
 		ent->think = Think_CalcMoveSpeed;
 	else
@@ -2263,7 +2262,7 @@ void SP_func_door_dh(edict_t *ent)
 
 	// Wait a few frames so that we're sure pathtarget has been parsed.
 	ent->think = func_door_dh_init;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -2418,7 +2417,7 @@ void SP_func_door_rotating(edict_t *ent)
 
 	gi.linkentity(ent);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	if (ent->health || ent->targetname)
 		ent->think = Think_CalcMoveSpeed;
 	else
@@ -2441,7 +2440,7 @@ void func_door_rot_dh_init(edict_t *ent)
 		gi.linkentity(ent);
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	if (ent->health || ent->targetname)
 		ent->think = Think_CalcMoveSpeed;
 	else
@@ -2455,7 +2454,7 @@ void SP_func_door_rot_dh(edict_t *ent)
 
 	// Wait a few frames so that we're sure pathtarget has been parsed.
 	ent->think = func_door_rot_dh_init;
-	ent->nextthink = level.time + 2*FRAMETIME;
+	G_SetNextThink(ent, level.time + 2*FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -2568,11 +2567,11 @@ void train_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage,
 		G_UseTargets(self, attacker);
 	}
 
-	edict_t *e = self->movewith_next;
+	edict_t *e = self->movewith_child;
 	while (e)
 	{
 		edict_t *next = e->movewith_next;
-		e->nextthink = 0;
+		G_SetNextThink(e, 0);
 
 		if (e->takedamage)
 			T_Damage(e, self, self, vec3_origin, e->s.origin, vec3_origin, 100000, 1, DAMAGE_NO_PROTECTION, MOD_CRUSH);
@@ -2672,7 +2671,7 @@ void train_wait(edict_t *self)
 			VectorClear(self->avelocity);
 			VectorClear(self->velocity);
 
-			if (self->movewith_next && self->movewith_next->movewith_ent == self)
+			if (self->movewith_child)
 				set_child_movement(self);
 		}
 
@@ -2682,7 +2681,7 @@ void train_wait(edict_t *self)
 			if (!strcmp(self->classname, "func_train"))
 				self->s.effects &= ~(EF_ANIM_ALL | EF_ANIM_ALLFAST);
 
-			self->nextthink = level.time + self->moveinfo.wait;
+			G_SetNextThink(self, level.time + self->moveinfo.wait);
 			self->think = train_next;
 		}
 		else if (self->spawnflags & TRAIN_TOGGLE)  // && wait < 0
@@ -2698,7 +2697,7 @@ void train_wait(edict_t *self)
 			if (!strcmp(self->classname, "func_train"))
 				self->s.effects &= ~(EF_ANIM_ALL | EF_ANIM_ALLFAST);
 
-			self->nextthink = 0;
+			G_SetNextThink(self, 0);
 		}
 
 		if (!(self->flags & FL_TEAMSLAVE))
@@ -2734,15 +2733,9 @@ void train_children_think(edict_t *self)
 		return;
 	}
 
-	if (self->enemy->movewith_next && self->enemy->movewith_next->movewith_ent == self->enemy)
-	{
-		set_child_movement(self->enemy);
-		self->nextthink = level.time + FRAMETIME;
-	}
-	else if (level.time < 2)
-	{
-		self->nextthink = level.time + FRAMETIME;
-	}
+	// Its children are brought along by Movewith_Update, this only watches for a switch to TRAIN_ROTATE
+	if (self->enemy->movewith_child || level.time < 2)
+		G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 //mxd
@@ -2799,8 +2792,8 @@ void train_yaw(edict_t *self)
 	self->enemy->avelocity[PITCH] = GetAngularVelocity(self->enemy->pitch_speed, self->enemy->s.angles[PITCH], self->enemy->ideal_pitch);
 	self->enemy->avelocity[ROLL] =  GetAngularVelocity(self->enemy->roll_speed, self->enemy->s.angles[ROLL], self->enemy->ideal_roll);
 
-	self->nextthink = level.time + FRAMETIME;
-	if (self->enemy->movewith_next && self->enemy->movewith_next->movewith_ent == self->enemy)
+	G_SetNextThink(self, level.time + FRAMETIME);
+	if (self->enemy->movewith_child)
 		set_child_movement(self->enemy);
 }
 
@@ -2863,7 +2856,7 @@ again:
 		self->s.event = EV_OTHER_TELEPORT;
 		gi.linkentity(self);
 
-		if (self->movewith_next && self->movewith_next->movewith_ent == self)
+		if (self->movewith_child)
 			set_child_movement(self);
 
 		goto again;
@@ -3036,7 +3029,7 @@ void func_train_find(edict_t *self)
 		ent->think = train_children_think;
 
 	ent->enemy = self;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (self->spawnflags & TRAIN_ORIGIN)	// Knightmare- func_train_origin support
 		VectorCopy(ent->s.origin, self->s.origin);
@@ -3060,7 +3053,7 @@ void func_train_find(edict_t *self)
 				self->s.effects |= EF_ANIM_ALLFAST;
 		}
 
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = train_next;
 		self->activator = self;
 	}
@@ -3082,7 +3075,7 @@ void train_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (!strcmp(self->classname, "func_train"))
 			self->s.effects &= ~(EF_ANIM_ALL | EF_ANIM_ALLFAST);
 
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 	else
 	{
@@ -3175,12 +3168,12 @@ void SP_func_train(edict_t *self)
 	if (self->target)
 	{
 		// start trains on the second frame, to make sure their targets have had a chance to spawn
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = func_train_find;
 	}
 	else if (self->spawnflags & TRAIN_ROTATE_CONSTANT) //mxd. Let's not require pathtargets when all we want is constant rotation... 
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = train_resume;
 	}
 	else
@@ -3209,7 +3202,7 @@ void SP_func_train(edict_t *self)
 		speaker->attenuation = self->attenuation; // was 3
 		speaker->owner = self;
 		speaker->think = Moving_Speaker_Think;
-		speaker->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(speaker, level.time + 2 * FRAMETIME);
 		speaker->spawnflags = 7; // owner must be moving to play
 		self->speaker = speaker;
 
@@ -3289,7 +3282,7 @@ void SP_trigger_elevator(edict_t *self)
 {
 	self->class_id = ENTITY_TRIGGER_ELEVATOR;
 	self->think = trigger_elevator_init;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 
@@ -3310,7 +3303,7 @@ These can be used, but not touched.
 void func_timer_think(edict_t *self)
 {
 	G_UseTargets(self, self->activator);
-	self->nextthink = level.time + self->wait + crandom() * self->random;
+	G_SetNextThink(self, level.time + self->wait + crandom() * self->random);
 }
 
 void func_timer_use(edict_t *self, edict_t *other, edict_t *activator)
@@ -3324,11 +3317,11 @@ void func_timer_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 		}
 		else
 		{
-			self->nextthink = 0;
+			G_SetNextThink(self, 0);
 		}
 
 		return;
@@ -3336,7 +3329,7 @@ void func_timer_use(edict_t *self, edict_t *other, edict_t *activator)
 
 	// turn it on
 	if (self->delay)
-		self->nextthink = level.time + self->delay;
+		G_SetNextThink(self, level.time + self->delay);
 	else
 		func_timer_think(self);
 }
@@ -3359,7 +3352,7 @@ void SP_func_timer(edict_t *self)
 
 	if (self->spawnflags & 1)
 	{
-		self->nextthink = level.time + 1.0 + st.pausetime + self->delay + self->wait + crandom() * self->random;
+		G_SetNextThink(self, level.time + 1.0 + st.pausetime + self->delay + self->wait + crandom() * self->random);
 		self->activator = self;
 	}
 
@@ -3477,7 +3470,7 @@ void door_secret_use(edict_t *self, edict_t *other, edict_t *activator)
 
 void door_secret_move1(edict_t *self)
 {
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 	self->think = door_secret_move2;
 
 	//added sound
@@ -3513,7 +3506,7 @@ void door_secret_move3(edict_t *self)
 	if (self->wait == -1)
 		return;
 
-	self->nextthink = level.time + self->wait;
+	G_SetNextThink(self, level.time + self->wait);
 	self->think = door_secret_move4;
 }
 
@@ -3536,7 +3529,7 @@ void door_secret_move4(edict_t *self)
 
 void door_secret_move5(edict_t *self)
 {
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 	self->think = door_secret_move6;
 
 	//added sound
@@ -3710,7 +3703,7 @@ void use_killbox(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -3821,7 +3814,7 @@ qboolean box_movestep(edict_t *ent, const vec3_t move, qboolean relink)
 	VectorCopy(trace.endpos, origin);
 	VectorSubtract(origin, ent->origin_offset, ent->s.origin);
 
-	ent->groundentity = trace.ent;
+	G_SetGroundEntity(ent, trace.ent);
 	ent->groundentity_linkcount = trace.ent->linkcount;
 
 	// the move is ok
@@ -3889,7 +3882,7 @@ void box_water_friction(edict_t *ent)
 	
 	if (ent->velocity[0] == 0 && ent->velocity[1] == 0)
 	{
-		ent->nextthink = 0;
+		G_SetNextThink(ent, 0);
 		return;
 	}
 
@@ -3905,7 +3898,7 @@ void box_water_friction(edict_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -4009,17 +4002,17 @@ void box_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *surf)
 			top->velocity[1] = -bottom->velocity[1] / 2;
 
 			other->think = box_water_friction;
-			other->nextthink = level.time + 0.2;
+			G_SetNextThink(other, level.time + 0.2);
 			gi.linkentity(other);
 
 			self->think = box_water_friction;
-			self->nextthink = level.time + 0.2;
+			G_SetNextThink(self, level.time + 0.2);
 		}
 		else
 		{
 			// Frictionless horizontal motion for 1 second
 			self->think = box_water_friction;
-			self->nextthink = level.time + 1.0;
+			G_SetNextThink(self, level.time + 1.0);
 		}
 
 		// Override oldvelocity
@@ -4235,7 +4228,7 @@ void SP_func_pushable(edict_t *self)
 		self->clipmask = MASK_PLAYERSOLID | MASK_MONSTERSOLID;
 		self->touch = box_touch;
 		self->think = M_droptofloor;
-		self->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(self, level.time + 2 * FRAMETIME);
 	}
 
 	if (self->spawnflags & 4)
@@ -4257,7 +4250,7 @@ void SP_func_pushable(edict_t *self)
 		speaker->attenuation = ATTN_STATIC; // was 1
 		speaker->owner = self;
 		speaker->think = Moving_Speaker_Think;
-		speaker->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(speaker, level.time + 2 * FRAMETIME);
 		speaker->spawnflags = 11;       // owner must be moving and on ground to play
 		self->speaker = speaker;
 		VectorAdd(self->absmin, self->absmax, speaker->s.origin);
@@ -4286,7 +4279,7 @@ void bob_think(edict_t *self)
 	const float delta = self->bob / 2 * (z1 - z0);
 
 	self->velocity[2] = delta / FRAMETIME;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->bobframe = (self->bobframe + 1) % time;
 
 	gi.linkentity(self);
@@ -4296,7 +4289,7 @@ void bob_init(edict_t *self)
 {
 	self->bobframe = 0;
 	self->think = bob_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_func_bobbingwater(edict_t *self)
@@ -4377,7 +4370,7 @@ void SP_func_bobbingwater(edict_t *self)
 		self->duration = 8;
 
 	self->think = bob_init;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	gi.linkentity(self);
 }
@@ -4442,13 +4435,13 @@ void pivot_touch(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *surf
 	{
 		VectorCopy(avelocity,ent->avelocity);
 		ent->think = pivot_stop;
-		ent->nextthink = level.time + time;
+		G_SetNextThink(ent, level.time + time);
 		gi.linkentity(ent);
 	}
 	else
 	{
 		VectorClear(ent->avelocity);
-		ent->nextthink = 0;
+		G_SetNextThink(ent, 0);
 	}
 }
 
@@ -4523,7 +4516,7 @@ void SP_func_pivot(edict_t *ent)
 	ent->blocked = pivot_blocked;
 	ent->gravity = 0;
 	ent->think = pivot_init;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	gi.setmodel(ent, ent->model);
 
 	gi.linkentity(ent);
@@ -4537,16 +4530,16 @@ void force_wall_think(edict_t *self)
 {
 	if (!self->wait)
 	{
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_FORCEWALL);
-		gi.WritePosition(self->pos1);
-		gi.WritePosition(self->pos2);
-		gi.WriteByte(self->style);
-		gi.multicast(self->offset, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_FORCEWALL);
+		TempEnt_WritePosition(self->pos1);
+		TempEnt_WritePosition(self->pos2);
+		TempEnt_WriteByte(self->style);
+		TempEnt_Multicast(self->offset, MULTICAST_PVS);
 	}
 
 	self->think = force_wall_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void func_force_wall_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *surf)
@@ -4564,7 +4557,7 @@ void force_wall_use(edict_t *self, edict_t *other, edict_t *activator)
 	{
 		self->wait = 1;
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 		self->solid = SOLID_NOT;
 		self->touch = NULL;
 		gi.linkentity(self);
@@ -4573,7 +4566,7 @@ void force_wall_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 		}
 
 	}
@@ -4581,7 +4574,7 @@ void force_wall_use(edict_t *self, edict_t *other, edict_t *activator)
 	{
 		self->wait = 0;
 		self->think = force_wall_think;
-		self->nextthink = level.time + 0.1;
+		G_SetNextThink(self, level.time + 0.1);
 		self->solid = SOLID_BSP;
 
 		if (self->dmg)
@@ -4640,7 +4633,7 @@ void SP_func_force_wall(edict_t *ent)
 			ent->touch = func_force_wall_touch;
 
 		ent->think = force_wall_think;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 		ent->wait = 0;
 	}
 	else
@@ -4697,7 +4690,7 @@ void swinging_door_killed(edict_t *self, edict_t *inflictor, edict_t *attacker,
 		{
 			// reset top wait time
 			if (ent->moveinfo.wait >= 0)
-				ent->nextthink = level.time + ent->moveinfo.wait;
+				G_SetNextThink(ent, level.time + ent->moveinfo.wait);
 
 			return;
 		}
@@ -4747,7 +4740,7 @@ void func_door_swinging_init(edict_t *self)
 		}
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	if (self->health || self->targetname)
 		self->think = Think_CalcMoveSpeed;
 	else
@@ -4784,6 +4777,6 @@ void SP_func_door_swinging(edict_t *self)
 
 	// Wait a few frames so that we're sure pathtarget has been parsed.
 	self->think = func_door_swinging_init;
-	self->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(self, level.time + 2 * FRAMETIME);
 	gi.linkentity(self);
 }
\ No newline at end of file
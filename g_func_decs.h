@@ -47,6 +47,9 @@ extern void AxisCopy ( const vec3_t in [ 3 ] , vec3_t out [ 3 ] ) ;
 extern void AxisClear ( vec3_t axis [ 3 ] ) ;
 extern void AnglesToAxis ( const vec3_t angles , vec3_t axis [ 3 ] ) ;
 extern void VectorRotate ( const vec3_t v , const vec3_t matrix [ 3 ] , vec3_t out ) ;
+extern void VectorNormalizeBatch ( vec3_t * v , int count , float * lengths ) ;
+extern void VectorDistSquaredBatch ( const vec3_t point , const float * origins , int stride , int count , float * out ) ;
+extern void AngleVectorsBatch ( const vec3_t * angles , int count , vec3_t * forward , vec3_t * right , vec3_t * up ) ;
 extern int Q_log2 ( int val ) ;
 extern float Q_rsqrt ( float in ) ;
 extern void VectorScale ( const vec3_t in , vec_t scale , vec3_t out ) ;
@@ -191,7 +194,6 @@ extern edict_t * SelectCoopSpawnPoint ( edict_t * ent ) ;
 extern edict_t * SelectDeathmatchSpawnPoint ( void ) ;
 extern edict_t * SelectFarthestDeathmatchSpawnPoint ( void ) ;
 extern edict_t * SelectRandomDeathmatchSpawnPoint ( void ) ;
-extern float PlayersRangeFromSpot ( edict_t * spot ) ;
 extern void FetchClientEntData ( edict_t * ent ) ;
 extern void SaveClientData ( void ) ;
 extern void InitClientResp ( gclient_t * client ) ;
@@ -735,8 +737,6 @@ extern void fire_grenade ( edict_t * self , vec3_t start , vec3_t aimdir , int d
 extern void ContactGrenade_Touch ( edict_t * ent , edict_t * other , cplane_t * plane , csurface_t * surf ) ;
 extern void Grenade_Touch ( edict_t * ent , edict_t * other , cplane_t * plane , csurface_t * surf ) ;
 extern void Grenade_Explode ( edict_t * ent ) ;
-extern void Grenade_Remove_From_Chain ( edict_t * grenade ) ;
-extern void Grenade_Add_To_Chain ( edict_t * grenade ) ;
 extern void Grenade_Evade ( edict_t * monster ) ;
 extern void SP_bolt ( edict_t * bolt ) ;
 extern void bolt_delayed_start ( edict_t * bolt ) ;
@@ -756,6 +756,19 @@ extern void vehicle_disengage ( edict_t * vehicle ) ;
 extern void vehicle_touch ( edict_t * self , edict_t * other , cplane_t * plane , csurface_t * surf ) ;
 extern void vehicle_blocked ( edict_t * self , edict_t * other ) ;
 extern void func_vehicle_explode ( edict_t * self , edict_t * inflictor , edict_t * attacker , int damage , vec3_t point ) ;
+extern void G_StringStats_f ( void ) ;
+extern void G_ClearStrings ( void ) ;
+extern char * G_InternString ( const char * string ) ;
+extern void G_CheckRoles ( void ) ;
+extern int G_RoleChanges ( int role ) ;
+extern int G_RoleCount ( int role ) ;
+extern edict_t * G_NextRole ( edict_t * from , int roles ) ;
+extern void G_RebuildRoles ( void ) ;
+extern void G_ClearRoles ( void ) ;
+extern void G_UpdateRoles ( edict_t * ent ) ;
+extern int BoxGrid_Query ( boxgrid_t * grid , const vec3_t point , int * * list ) ;
+extern void BoxGrid_Free ( boxgrid_t * grid ) ;
+extern void BoxGrid_Build ( boxgrid_t * grid , int count , vec3_t * mins , vec3_t * maxs , int tag ) ;
 extern void my_bprintf ( int printlevel , char * fmt , ... ) ;
 extern qboolean IsIdMap ( void ) ;
 extern void G_UseTarget ( edict_t * ent , edict_t * activator , edict_t * target ) ;
@@ -895,6 +908,14 @@ extern void trackchange_use ( edict_t * self , edict_t * other , edict_t * activ
 extern void trackchange_done ( edict_t * self ) ;
 extern void SP_path_track ( edict_t * self ) ;
 extern void path_track_use ( edict_t * self , edict_t * other , edict_t * activator ) ;
+extern void Think_Stats_f ( void ) ;
+extern void Think_Check ( void ) ;
+extern void Think_Clear ( void ) ;
+extern edict_t * Think_NextAwake ( edict_t * from ) ;
+extern void Think_Advance ( void ) ;
+extern void Think_Sleep ( edict_t * ent ) ;
+extern void G_SetNextThink ( edict_t * ent , float nextthink ) ;
+extern void Think_Wake ( edict_t * ent ) ;
 extern void SP_thing ( edict_t * self ) ;
 extern void thing_touch ( edict_t * self , edict_t * other , cplane_t * plane , csurface_t * surf ) ;
 extern void thing_grenade_boom ( edict_t * self ) ;
@@ -902,6 +923,22 @@ extern void thing_think_pause ( edict_t * self ) ;
 extern void thing_think ( edict_t * self ) ;
 extern void thing_restore_leader ( edict_t * self ) ;
 extern edict_t * SpawnThing ( ) ;
+extern void Template_Stats_f ( void ) ;
+extern void Template_Clear ( void ) ;
+extern void Template_CallSpawn ( const enttemplate_t * t , edict_t * ent ) ;
+extern const enttemplate_t * Template_FindSpawner ( char * classname ) ;
+extern edict_t * Template_SpawnClone ( const enttemplate_t * t ) ;
+extern const enttemplate_t * Template_FindClone ( char * source ) ;
+extern void TempEnt_Stats_f ( void ) ;
+extern void TempEnt_Clear ( void ) ;
+extern void TempEnt_Flush ( void ) ;
+extern void TempEnt_Multicast ( vec3_t origin , multicast_t to ) ;
+extern void TempEnt_WriteDir ( vec3_t dir ) ;
+extern void TempEnt_WritePosition ( vec3_t pos ) ;
+extern void TempEnt_WriteLong ( int c ) ;
+extern void TempEnt_WriteShort ( int c ) ;
+extern void TempEnt_WriteByte ( int c ) ;
+extern void TempEnt_Begin ( void ) ;
 extern void SP_target_skill ( edict_t * self ) ;
 extern void use_target_skill ( edict_t * self , edict_t * other , edict_t * activator ) ;
 extern void SP_target_clone ( edict_t * self ) ;
@@ -1009,12 +1046,21 @@ extern void Use_Target_Speaker ( edict_t * ent , edict_t * other , edict_t * act
 extern void SP_target_temp_entity ( edict_t * ent ) ;
 extern void Use_Target_Tent ( edict_t * self , edict_t * other , edict_t * activator ) ;
 extern void ServerCommand ( void ) ;
+extern void SVCmd_VecBench_f ( void ) ;
+extern void SVCmd_IPBench_f ( void ) ;
+extern void SVCmd_ReadIP_f ( void ) ;
 extern void SVCmd_WriteIP_f ( void ) ;
 extern void SVCmd_ListIP_f ( void ) ;
 extern void SVCmd_RemoveIP_f ( void ) ;
 extern void SVCmd_AddIP_f ( void ) ;
 extern qboolean SV_FilterPacket ( char * from ) ;
 extern void Svcmd_Test_f ( void ) ;
+extern void SpawnSpot_Stats_f ( void ) ;
+extern void SpawnSpot_Clear ( void ) ;
+extern void SpawnSpot_Update ( void ) ;
+extern void SpawnSpot_ClientMoved ( edict_t * ent ) ;
+extern edict_t * SpawnSpot_Farthest ( char * classname ) ;
+extern edict_t * SpawnSpot_Random ( char * classname ) ;
 extern void Cmd_ToggleHud ( ) ;
 extern void Hud_Off ( ) ;
 extern void Hud_On ( ) ;
@@ -1028,24 +1074,46 @@ extern void LoadAliasData ( void ) ;
 extern void ED_ParseField ( char * key , char * value , edict_t * ent ) ;
 extern char * ED_NewString ( char * string ) ;
 extern void ED_CallSpawn ( edict_t * ent ) ;
+extern void ED_CallSpawnFunc ( edict_t * ent , gitem_t * item , void ( * spawn ) ( edict_t * ent ) ) ;
+extern qboolean ED_FindSpawn ( char * classname , gitem_t * * item , void ( * * spawn ) ( edict_t * ent ) ) ;
+extern void Solid_Stats_f ( void ) ;
+extern void Solid_Clear ( void ) ;
+extern int Solid_PointContents ( const vec3_t p ) ;
+extern trace_t Solid_FreeTrace ( const vec3_t end ) ;
+extern qboolean Solid_FreeMove ( edict_t * ent , const vec3_t start , const vec3_t end , int mask , qboolean * triggers ) ;
+extern int Solid_BoxEdicts ( const vec3_t mins , const vec3_t maxs , edict_t * * list , int maxcount ) ;
+extern void Solid_Link ( edict_t * ent , qboolean linked ) ;
+extern void Save_Stats_f ( void ) ;
+extern void Save_WaitForWrites ( void ) ;
+extern void Save_CheckWrites ( void ) ;
+extern void Save_StartWrites ( void ) ;
+extern void Save_QueueFile ( char * filename , savebuffer_t * buf ) ;
+extern void Save_Write ( savebuffer_t * buf , const void * data , int size ) ;
 extern void ReadLevel ( char * filename ) ;
 extern void WriteLevel ( char * filename ) ;
+extern void Save_ClearBaseline ( void ) ;
 extern void ReadLevelLocals ( FILE * f ) ;
 extern void ReadEdict ( FILE * f , edict_t * ent ) ;
-extern void WriteLevelLocals ( FILE * f ) ;
-extern void WriteEdict ( FILE * f , edict_t * ent ) ;
+extern void WriteLevelLocals ( savebuffer_t * f ) ;
+extern void WriteEdict ( savebuffer_t * f , edict_t * ent ) ;
 extern void ReadGame ( char * filename ) ;
 extern void WriteGame ( char * filename , qboolean autosave ) ;
 extern void ReadClient ( FILE * f , gclient_t * client ) ;
-extern void WriteClient ( FILE * f , gclient_t * client ) ;
+extern void WriteClient ( savebuffer_t * f , gclient_t * client ) ;
 extern void ReadField ( FILE * f , field_t * field , byte * base ) ;
-extern void WriteField2 ( FILE * f , field_t * field , byte * base ) ;
-extern void WriteField1 ( FILE * f , field_t * field , byte * base ) ;
+extern void WriteField2 ( savebuffer_t * f , field_t * field , byte * base ) ;
+extern void WriteField1 ( savebuffer_t * f , field_t * field , byte * base ) ;
 extern mmove_t * FindMmoveByName ( char * name ) ;
 extern mmoveList_t * GetMmoveByAddress ( mmove_t * adr ) ;
 extern byte * FindFunctionByName ( char * name ) ;
 extern functionList_t * GetFunctionByAddress ( const byte * adr ) ;
 extern void InitGame ( void ) ;
+extern void Rider_Stats_f ( void ) ;
+extern void Rider_Check ( void ) ;
+extern void Rider_Clear ( void ) ;
+extern void Rider_Rebuild ( void ) ;
+extern edict_t * Rider_Next ( edict_t * ground , edict_t * from ) ;
+extern void G_SetGroundEntity ( edict_t * ent , edict_t * ground ) ;
 extern void SP_func_reflect ( edict_t * self ) ;
 extern void use_func_reflect ( edict_t * self , edict_t * other , edict_t * activator ) ;
 extern void AddReflection ( edict_t * ent ) ;
@@ -1054,6 +1122,8 @@ extern void ReflectSparks ( int type , const vec3_t origin , const vec3_t movedi
 extern void ReflectSteam ( const vec3_t origin , const vec3_t movedir , int count , int sounds , int speed , int wait , int nextid ) ;
 extern void ReflectTrail ( int type , const vec3_t start , const vec3_t end ) ;
 extern void ReflectExplosion ( int type , const vec3_t origin ) ;
+extern void Reflect_FindMirrors ( void ) ;
+extern void Reflect_ClearMirrors ( void ) ;
 extern qboolean WithinBBox ( vec3_t p , edict_t * mirror ) ;
 extern void G_RunEntity ( edict_t * ent ) ;
 extern void SV_Physics_Conveyor ( edict_t * ent ) ;
@@ -1086,10 +1156,25 @@ extern void pendulum_die ( edict_t * self , edict_t * inflictor , edict_t * atta
 extern void pendulum_use ( edict_t * self , edict_t * other , edict_t * activator ) ;
 extern void pendulum_rotate ( edict_t * self ) ;
 extern void pendulum_blocked ( edict_t * self , edict_t * other ) ;
+extern void Path_SplinePoint ( edict_t * train , edict_t * from , edict_t * to , float frac , vec3_t p , vec3_t a ) ;
+extern int Path_Previous ( edict_t * path , edict_t * * * list ) ;
+extern edict_t * Path_Target ( edict_t * path , qboolean alt ) ;
+extern void Path_ClearGraph ( void ) ;
+extern void Path_Invalidate ( void ) ;
 extern int PatchPlayerModels ( char * modelname ) ;
+extern void Nav_Stats_f ( void ) ;
+extern qboolean Nav_ChaseYaw ( edict_t * ent , edict_t * goal , float dist , float * yaw ) ;
+extern void Nav_ClearGraph ( void ) ;
 extern void SP_model_train_origin ( edict_t * self ) ;
 extern void SP_model_train ( edict_t * self ) ;
 extern void model_train_animator ( edict_t * animator ) ;
+extern void Movewith_Stats_f ( void ) ;
+extern void Movewith_Update ( void ) ;
+extern void Movewith_Moved ( edict_t * ent ) ;
+extern qboolean Movewith_Updated ( edict_t * parent ) ;
+extern void Movewith_Free ( edict_t * ent ) ;
+extern void Movewith_Detach ( edict_t * child ) ;
+extern void Movewith_Attach ( edict_t * child , edict_t * parent ) ;
 extern qboolean has_valid_enemy ( edict_t * monster ) ;
 extern qboolean face_wall ( edict_t * monster ) ;
 extern float realrange ( edict_t * this , edict_t * that ) ;
@@ -1292,6 +1377,13 @@ extern void VelocityForDamageDirectional ( int damage , vec3_t dir , vec3_t v )
 extern void VelocityForDamage ( int damage , vec3_t v ) ;
 extern void SP_func_areaportal ( edict_t * ent ) ;
 extern void Use_Areaportal ( edict_t * ent , edict_t * other , edict_t * activator ) ;
+extern void G_MemStats_f ( void ) ;
+extern void Mem_FreeTags ( int tag ) ;
+extern int G_TagOverhead ( void ) ;
+extern int G_TagSize ( void * block ) ;
+extern void Mem_TagFree ( void * block ) ;
+extern void * Mem_TagMalloc ( int size , int tag ) ;
+extern void * G_TagMalloc ( int size , int tag , int subsystem ) ;
 extern void G_RunFrame ( void ) ;
 extern void ExitLevel ( void ) ;
 extern void CheckDMRules ( void ) ;
@@ -1302,6 +1394,8 @@ extern void ClientEndServerFrames ( void ) ;
 extern void Com_Printf ( char * msg , ... ) ;
 extern void Sys_Error ( char * error , ... ) ;
 extern game_export_t * GetGameAPI ( game_import_t * import ) ;
+extern void Registry_UnlinkEntity ( edict_t * ent ) ;
+extern void Registry_LinkEntity ( edict_t * ent ) ;
 extern int Debug_Soundindex ( char * name ) ;
 extern int Debug_Modelindex ( char * name ) ;
 extern void ShutdownGame ( void ) ;
@@ -1512,13 +1606,20 @@ extern void SP_target_fog ( edict_t * self ) ;
 extern void target_fog_use ( edict_t * self , edict_t * other , edict_t * activator ) ;
 extern void fog_fade ( edict_t * self ) ;
 extern void Fog_Init ( void ) ;
-extern void Fog_Off ( void ) ;
+extern void Fog_Off ( edict_t * ent ) ;
 extern void Fog ( edict_t * ent ) ;
-extern void init_trigger_fog_delay ( edict_t * self ) ;
-extern void trig_fog_fade ( edict_t * self ) ;
-extern void GLFog ( void ) ;
+extern void GLFog ( edict_t * ent ) ;
 extern void Cmd_Fog_f ( edict_t * ent ) ;
 extern void Fog_ConsoleFog ( void ) ;
+extern fog_t * Fog_At ( edict_t * ent ) ;
+extern void Fog_ClearIndex ( void ) ;
+extern void FS_ClearIndex ( void ) ;
+extern qboolean FS_EngineFileExists ( char * filename ) ;
+extern void FS_AddFile ( const char * basedir , const char * gamedir , const char * filename ) ;
+extern const fsfile_t * FS_FindFile ( const char * basedir , const char * gamedir , const char * filename , int where ) ;
+extern void Danger_Stats_f ( void ) ;
+extern void Danger_Clear ( void ) ;
+extern int Danger_Find ( const vec3_t point , float radius , int types , edict_t * * list , int maxlist ) ;
 extern void CTFSetPowerUpEffect ( edict_t * ent , int def ) ;
 extern void CTFBoot ( edict_t * ent ) ;
 extern void CTFWarp ( edict_t * ent ) ;
@@ -1689,6 +1790,9 @@ extern void cargo_blocked ( edict_t * cargo , edict_t * obstacle ) ;
 extern void Cargo_Stop ( edict_t * ent ) ;
 extern edict_t * CrateOnTop ( edict_t * from , edict_t * ent ) ;
 extern void Moving_Speaker_Think ( edict_t * speaker ) ;
+extern void Cosmetic_Stats_f ( void ) ;
+extern void Cosmetic_Clear ( void ) ;
+extern void Cosmetic_Add ( edict_t * ent ) ;
 extern void T_RadiusDamage ( edict_t * inflictor , edict_t * attacker , float damage , edict_t * ignore , float radius , int mod , double dmg_slope ) ;
 extern void T_Damage ( edict_t * in_targ , edict_t * inflictor , edict_t * in_attacker , vec3_t dir , vec3_t point , vec3_t normal , int damage , int knockback , int dflags , int mod ) ;
 extern qboolean CheckTeamDamage ( edict_t * targ , edict_t * attacker ) ;
@@ -1700,6 +1804,14 @@ extern void SpawnDamage ( int type , vec3_t origin , vec3_t normal ) ;
 extern void Killed ( edict_t * targ , edict_t * inflictor , edict_t * attacker , int damage , vec3_t point ) ;
 extern qboolean CanDamage ( edict_t * targ , edict_t * inflictor ) ;
 extern void cleanupHealTarget ( edict_t * self ) ;
+extern void CModel_Stats_f ( void ) ;
+extern qboolean CModel_Blocked ( vec3_t start , vec3_t mins , vec3_t maxs , vec3_t end , int contentmask , edict_t * target ) ;
+extern int CModel_BrushBounds ( int contents , vec3_t * mins , vec3_t * maxs , int maxbrushes ) ;
+extern qboolean CModel_WorldBounds ( vec3_t mins , vec3_t maxs ) ;
+extern int CModel_PointContents ( const vec3_t p ) ;
+extern qboolean CModel_Trace ( const vec3_t start , const vec3_t mins , const vec3_t maxs , const vec3_t end , int contentmask , trace_t * trace ) ;
+extern void CModel_LoadMap ( char * mapname ) ;
+extern void CModel_Free ( void ) ;
 extern void ClientCommand ( edict_t * ent ) ;
 extern void ForcewallOff ( edict_t * player ) ;
 extern void SpawnForcewall ( edict_t * player ) ;
@@ -1739,6 +1851,10 @@ extern void ShiftItem ( edict_t * ent , int direction ) ;
 extern void SaveEntProps ( edict_t * e , FILE * f ) ;
 extern void laser_sight_think ( edict_t * laser ) ;
 extern void RotateAngles ( const vec3_t in , const vec3_t delta , vec3_t out ) ;
+extern void CmdLimit_Cost_f ( void ) ;
+extern void CmdLimit_Stats_f ( void ) ;
+extern qboolean CmdLimit_Drop ( edict_t * ent , char * cmd ) ;
+extern void CmdLimit_Connect ( edict_t * ent ) ;
 extern void GetChaseTarget ( edict_t * ent ) ;
 extern void ChasePrev ( edict_t * ent ) ;
 extern void ChaseNext ( edict_t * ent ) ;
@@ -1782,6 +1898,7 @@ extern void ACESP_Respawn ( edict_t * self ) ;
 extern void ACESP_PutClientInServer ( edict_t * bot , qboolean respawn , int team ) ;
 extern void ACESP_HoldSpawn ( edict_t * self ) ;
 extern void ACEND_LoadNodes ( void ) ;
+extern void ACEND_WriteNodes ( ) ;
 extern void ACEND_SaveNodes ( ) ;
 extern void ACEND_ResolveAllPaths ( ) ;
 extern void ACEND_RemoveNodeEdge ( edict_t * self , int from , int to ) ;
@@ -1799,6 +1916,7 @@ extern void ACEND_SetGoal ( edict_t * self , int goal_node ) ;
 extern int ACEND_FindClosestReachableNode ( edict_t * self , int range , int type ) ;
 extern int ACEND_FindCloseReachableNode ( edict_t * self , int range , int type ) ;
 extern int ACEND_FindCost ( int from , int to ) ;
+extern void ACEND_GenerateNodes ( void ) ;
 extern void ACEMV_Attack ( edict_t * self , usercmd_t * ucmd ) ;
 extern void ACEMV_Wander ( edict_t * self , usercmd_t * ucmd ) ;
 extern void ACEMV_Move ( edict_t * self , usercmd_t * ucmd ) ;
@@ -47,6 +47,9 @@
 {"AxisClear", (byte *)AxisClear},
 {"AnglesToAxis", (byte *)AnglesToAxis},
 {"VectorRotate", (byte *)VectorRotate},
+{"VectorNormalizeBatch", (byte *)VectorNormalizeBatch},
+{"VectorDistSquaredBatch", (byte *)VectorDistSquaredBatch},
+{"AngleVectorsBatch", (byte *)AngleVectorsBatch},
 {"Q_log2", (byte *)Q_log2},
 {"Q_rsqrt", (byte *)Q_rsqrt},
 {"VectorScale", (byte *)VectorScale},
@@ -191,7 +194,6 @@
 {"SelectDeathmatchSpawnPoint", (byte *)SelectDeathmatchSpawnPoint},
 {"SelectFarthestDeathmatchSpawnPoint", (byte *)SelectFarthestDeathmatchSpawnPoint},
 {"SelectRandomDeathmatchSpawnPoint", (byte *)SelectRandomDeathmatchSpawnPoint},
-{"PlayersRangeFromSpot", (byte *)PlayersRangeFromSpot},
 {"FetchClientEntData", (byte *)FetchClientEntData},
 {"SaveClientData", (byte *)SaveClientData},
 {"InitClientResp", (byte *)InitClientResp},
@@ -735,8 +737,6 @@
 {"ContactGrenade_Touch", (byte *)ContactGrenade_Touch},
 {"Grenade_Touch", (byte *)Grenade_Touch},
 {"Grenade_Explode", (byte *)Grenade_Explode},
-{"Grenade_Remove_From_Chain", (byte *)Grenade_Remove_From_Chain},
-{"Grenade_Add_To_Chain", (byte *)Grenade_Add_To_Chain},
 {"Grenade_Evade", (byte *)Grenade_Evade},
 {"SP_bolt", (byte *)SP_bolt},
 {"bolt_delayed_start", (byte *)bolt_delayed_start},
@@ -756,6 +756,19 @@
 {"vehicle_touch", (byte *)vehicle_touch},
 {"vehicle_blocked", (byte *)vehicle_blocked},
 {"func_vehicle_explode", (byte *)func_vehicle_explode},
+{"G_StringStats_f", (byte *)G_StringStats_f},
+{"G_ClearStrings", (byte *)G_ClearStrings},
+{"G_InternString", (byte *)G_InternString},
+{"G_CheckRoles", (byte *)G_CheckRoles},
+{"G_RoleChanges", (byte *)G_RoleChanges},
+{"G_RoleCount", (byte *)G_RoleCount},
+{"G_NextRole", (byte *)G_NextRole},
+{"G_RebuildRoles", (byte *)G_RebuildRoles},
+{"G_ClearRoles", (byte *)G_ClearRoles},
+{"G_UpdateRoles", (byte *)G_UpdateRoles},
+{"BoxGrid_Query", (byte *)BoxGrid_Query},
+{"BoxGrid_Free", (byte *)BoxGrid_Free},
+{"BoxGrid_Build", (byte *)BoxGrid_Build},
 {"my_bprintf", (byte *)my_bprintf},
 {"IsIdMap", (byte *)IsIdMap},
 {"G_UseTarget", (byte *)G_UseTarget},
@@ -895,6 +908,14 @@
 {"trackchange_done", (byte *)trackchange_done},
 {"SP_path_track", (byte *)SP_path_track},
 {"path_track_use", (byte *)path_track_use},
+{"Think_Stats_f", (byte *)Think_Stats_f},
+{"Think_Check", (byte *)Think_Check},
+{"Think_Clear", (byte *)Think_Clear},
+{"Think_NextAwake", (byte *)Think_NextAwake},
+{"Think_Advance", (byte *)Think_Advance},
+{"Think_Sleep", (byte *)Think_Sleep},
+{"G_SetNextThink", (byte *)G_SetNextThink},
+{"Think_Wake", (byte *)Think_Wake},
 {"SP_thing", (byte *)SP_thing},
 {"thing_touch", (byte *)thing_touch},
 {"thing_grenade_boom", (byte *)thing_grenade_boom},
@@ -902,6 +923,22 @@
 {"thing_think", (byte *)thing_think},
 {"thing_restore_leader", (byte *)thing_restore_leader},
 {"SpawnThing", (byte *)SpawnThing},
+{"Template_Stats_f", (byte *)Template_Stats_f},
+{"Template_Clear", (byte *)Template_Clear},
+{"Template_CallSpawn", (byte *)Template_CallSpawn},
+{"Template_FindSpawner", (byte *)Template_FindSpawner},
+{"Template_SpawnClone", (byte *)Template_SpawnClone},
+{"Template_FindClone", (byte *)Template_FindClone},
+{"TempEnt_Stats_f", (byte *)TempEnt_Stats_f},
+{"TempEnt_Clear", (byte *)TempEnt_Clear},
+{"TempEnt_Flush", (byte *)TempEnt_Flush},
+{"TempEnt_Multicast", (byte *)TempEnt_Multicast},
+{"TempEnt_WriteDir", (byte *)TempEnt_WriteDir},
+{"TempEnt_WritePosition", (byte *)TempEnt_WritePosition},
+{"TempEnt_WriteLong", (byte *)TempEnt_WriteLong},
+{"TempEnt_WriteShort", (byte *)TempEnt_WriteShort},
+{"TempEnt_WriteByte", (byte *)TempEnt_WriteByte},
+{"TempEnt_Begin", (byte *)TempEnt_Begin},
 {"SP_target_skill", (byte *)SP_target_skill},
 {"use_target_skill", (byte *)use_target_skill},
 {"SP_target_clone", (byte *)SP_target_clone},
@@ -1009,12 +1046,21 @@
 {"SP_target_temp_entity", (byte *)SP_target_temp_entity},
 {"Use_Target_Tent", (byte *)Use_Target_Tent},
 {"ServerCommand", (byte *)ServerCommand},
+{"SVCmd_VecBench_f", (byte *)SVCmd_VecBench_f},
+{"SVCmd_IPBench_f", (byte *)SVCmd_IPBench_f},
+{"SVCmd_ReadIP_f", (byte *)SVCmd_ReadIP_f},
 {"SVCmd_WriteIP_f", (byte *)SVCmd_WriteIP_f},
 {"SVCmd_ListIP_f", (byte *)SVCmd_ListIP_f},
 {"SVCmd_RemoveIP_f", (byte *)SVCmd_RemoveIP_f},
 {"SVCmd_AddIP_f", (byte *)SVCmd_AddIP_f},
 {"SV_FilterPacket", (byte *)SV_FilterPacket},
 {"Svcmd_Test_f", (byte *)Svcmd_Test_f},
+{"SpawnSpot_Stats_f", (byte *)SpawnSpot_Stats_f},
+{"SpawnSpot_Clear", (byte *)SpawnSpot_Clear},
+{"SpawnSpot_Update", (byte *)SpawnSpot_Update},
+{"SpawnSpot_ClientMoved", (byte *)SpawnSpot_ClientMoved},
+{"SpawnSpot_Farthest", (byte *)SpawnSpot_Farthest},
+{"SpawnSpot_Random", (byte *)SpawnSpot_Random},
 {"Cmd_ToggleHud", (byte *)Cmd_ToggleHud},
 {"Hud_Off", (byte *)Hud_Off},
 {"Hud_On", (byte *)Hud_On},
@@ -1028,8 +1074,24 @@
 {"ED_ParseField", (byte *)ED_ParseField},
 {"ED_NewString", (byte *)ED_NewString},
 {"ED_CallSpawn", (byte *)ED_CallSpawn},
+{"ED_CallSpawnFunc", (byte *)ED_CallSpawnFunc},
+{"ED_FindSpawn", (byte *)ED_FindSpawn},
+{"Solid_Stats_f", (byte *)Solid_Stats_f},
+{"Solid_Clear", (byte *)Solid_Clear},
+{"Solid_PointContents", (byte *)Solid_PointContents},
+{"Solid_FreeTrace", (byte *)Solid_FreeTrace},
+{"Solid_FreeMove", (byte *)Solid_FreeMove},
+{"Solid_BoxEdicts", (byte *)Solid_BoxEdicts},
+{"Solid_Link", (byte *)Solid_Link},
+{"Save_Stats_f", (byte *)Save_Stats_f},
+{"Save_WaitForWrites", (byte *)Save_WaitForWrites},
+{"Save_CheckWrites", (byte *)Save_CheckWrites},
+{"Save_StartWrites", (byte *)Save_StartWrites},
+{"Save_QueueFile", (byte *)Save_QueueFile},
+{"Save_Write", (byte *)Save_Write},
 {"ReadLevel", (byte *)ReadLevel},
 {"WriteLevel", (byte *)WriteLevel},
+{"Save_ClearBaseline", (byte *)Save_ClearBaseline},
 {"ReadLevelLocals", (byte *)ReadLevelLocals},
 {"ReadEdict", (byte *)ReadEdict},
 {"WriteLevelLocals", (byte *)WriteLevelLocals},
@@ -1046,6 +1108,12 @@
 {"FindFunctionByName", (byte *)FindFunctionByName},
 {"GetFunctionByAddress", (byte *)GetFunctionByAddress},
 {"InitGame", (byte *)InitGame},
+{"Rider_Stats_f", (byte *)Rider_Stats_f},
+{"Rider_Check", (byte *)Rider_Check},
+{"Rider_Clear", (byte *)Rider_Clear},
+{"Rider_Rebuild", (byte *)Rider_Rebuild},
+{"Rider_Next", (byte *)Rider_Next},
+{"G_SetGroundEntity", (byte *)G_SetGroundEntity},
 {"SP_func_reflect", (byte *)SP_func_reflect},
 {"use_func_reflect", (byte *)use_func_reflect},
 {"AddReflection", (byte *)AddReflection},
@@ -1054,6 +1122,8 @@
 {"ReflectSteam", (byte *)ReflectSteam},
 {"ReflectTrail", (byte *)ReflectTrail},
 {"ReflectExplosion", (byte *)ReflectExplosion},
+{"Reflect_FindMirrors", (byte *)Reflect_FindMirrors},
+{"Reflect_ClearMirrors", (byte *)Reflect_ClearMirrors},
 {"WithinBBox", (byte *)WithinBBox},
 {"G_RunEntity", (byte *)G_RunEntity},
 {"SV_Physics_Conveyor", (byte *)SV_Physics_Conveyor},
@@ -1086,10 +1156,25 @@
 {"pendulum_use", (byte *)pendulum_use},
 {"pendulum_rotate", (byte *)pendulum_rotate},
 {"pendulum_blocked", (byte *)pendulum_blocked},
+{"Path_SplinePoint", (byte *)Path_SplinePoint},
+{"Path_Previous", (byte *)Path_Previous},
+{"Path_Target", (byte *)Path_Target},
+{"Path_ClearGraph", (byte *)Path_ClearGraph},
+{"Path_Invalidate", (byte *)Path_Invalidate},
 {"PatchPlayerModels", (byte *)PatchPlayerModels},
+{"Nav_Stats_f", (byte *)Nav_Stats_f},
+{"Nav_ChaseYaw", (byte *)Nav_ChaseYaw},
+{"Nav_ClearGraph", (byte *)Nav_ClearGraph},
 {"SP_model_train_origin", (byte *)SP_model_train_origin},
 {"SP_model_train", (byte *)SP_model_train},
 {"model_train_animator", (byte *)model_train_animator},
+{"Movewith_Stats_f", (byte *)Movewith_Stats_f},
+{"Movewith_Update", (byte *)Movewith_Update},
+{"Movewith_Moved", (byte *)Movewith_Moved},
+{"Movewith_Updated", (byte *)Movewith_Updated},
+{"Movewith_Free", (byte *)Movewith_Free},
+{"Movewith_Detach", (byte *)Movewith_Detach},
+{"Movewith_Attach", (byte *)Movewith_Attach},
 {"has_valid_enemy", (byte *)has_valid_enemy},
 {"face_wall", (byte *)face_wall},
 {"realrange", (byte *)realrange},
@@ -1292,6 +1377,13 @@
 {"VelocityForDamage", (byte *)VelocityForDamage},
 {"SP_func_areaportal", (byte *)SP_func_areaportal},
 {"Use_Areaportal", (byte *)Use_Areaportal},
+{"G_MemStats_f", (byte *)G_MemStats_f},
+{"Mem_FreeTags", (byte *)Mem_FreeTags},
+{"G_TagOverhead", (byte *)G_TagOverhead},
+{"G_TagSize", (byte *)G_TagSize},
+{"Mem_TagFree", (byte *)Mem_TagFree},
+{"Mem_TagMalloc", (byte *)Mem_TagMalloc},
+{"G_TagMalloc", (byte *)G_TagMalloc},
 {"G_RunFrame", (byte *)G_RunFrame},
 {"ExitLevel", (byte *)ExitLevel},
 {"CheckDMRules", (byte *)CheckDMRules},
@@ -1302,6 +1394,8 @@
 {"Com_Printf", (byte *)Com_Printf},
 {"Sys_Error", (byte *)Sys_Error},
 {"GetGameAPI", (byte *)GetGameAPI},
+{"Registry_UnlinkEntity", (byte *)Registry_UnlinkEntity},
+{"Registry_LinkEntity", (byte *)Registry_LinkEntity},
 {"Debug_Soundindex", (byte *)Debug_Soundindex},
 {"Debug_Modelindex", (byte *)Debug_Modelindex},
 {"ShutdownGame", (byte *)ShutdownGame},
@@ -1514,11 +1608,18 @@
 {"Fog_Init", (byte *)Fog_Init},
 {"Fog_Off", (byte *)Fog_Off},
 {"Fog", (byte *)Fog},
-{"init_trigger_fog_delay", (byte *)init_trigger_fog_delay},
-{"trig_fog_fade", (byte *)trig_fog_fade},
 {"GLFog", (byte *)GLFog},
 {"Cmd_Fog_f", (byte *)Cmd_Fog_f},
 {"Fog_ConsoleFog", (byte *)Fog_ConsoleFog},
+{"Fog_At", (byte *)Fog_At},
+{"Fog_ClearIndex", (byte *)Fog_ClearIndex},
+{"FS_ClearIndex", (byte *)FS_ClearIndex},
+{"FS_EngineFileExists", (byte *)FS_EngineFileExists},
+{"FS_AddFile", (byte *)FS_AddFile},
+{"FS_FindFile", (byte *)FS_FindFile},
+{"Danger_Stats_f", (byte *)Danger_Stats_f},
+{"Danger_Clear", (byte *)Danger_Clear},
+{"Danger_Find", (byte *)Danger_Find},
 {"CTFSetPowerUpEffect", (byte *)CTFSetPowerUpEffect},
 {"CTFBoot", (byte *)CTFBoot},
 {"CTFWarp", (byte *)CTFWarp},
@@ -1689,6 +1790,9 @@
 {"Cargo_Stop", (byte *)Cargo_Stop},
 {"CrateOnTop", (byte *)CrateOnTop},
 {"Moving_Speaker_Think", (byte *)Moving_Speaker_Think},
+{"Cosmetic_Stats_f", (byte *)Cosmetic_Stats_f},
+{"Cosmetic_Clear", (byte *)Cosmetic_Clear},
+{"Cosmetic_Add", (byte *)Cosmetic_Add},
 {"T_RadiusDamage", (byte *)T_RadiusDamage},
 {"T_Damage", (byte *)T_Damage},
 {"CheckTeamDamage", (byte *)CheckTeamDamage},
@@ -1700,6 +1804,14 @@
 {"Killed", (byte *)Killed},
 {"CanDamage", (byte *)CanDamage},
 {"cleanupHealTarget", (byte *)cleanupHealTarget},
+{"CModel_Stats_f", (byte *)CModel_Stats_f},
+{"CModel_Blocked", (byte *)CModel_Blocked},
+{"CModel_BrushBounds", (byte *)CModel_BrushBounds},
+{"CModel_WorldBounds", (byte *)CModel_WorldBounds},
+{"CModel_PointContents", (byte *)CModel_PointContents},
+{"CModel_Trace", (byte *)CModel_Trace},
+{"CModel_LoadMap", (byte *)CModel_LoadMap},
+{"CModel_Free", (byte *)CModel_Free},
 {"ClientCommand", (byte *)ClientCommand},
 {"ForcewallOff", (byte *)ForcewallOff},
 {"SpawnForcewall", (byte *)SpawnForcewall},
@@ -1739,6 +1851,10 @@
 {"SaveEntProps", (byte *)SaveEntProps},
 {"laser_sight_think", (byte *)laser_sight_think},
 {"RotateAngles", (byte *)RotateAngles},
+{"CmdLimit_Cost_f", (byte *)CmdLimit_Cost_f},
+{"CmdLimit_Stats_f", (byte *)CmdLimit_Stats_f},
+{"CmdLimit_Drop", (byte *)CmdLimit_Drop},
+{"CmdLimit_Connect", (byte *)CmdLimit_Connect},
 {"GetChaseTarget", (byte *)GetChaseTarget},
 {"ChasePrev", (byte *)ChasePrev},
 {"ChaseNext", (byte *)ChaseNext},
@@ -1782,6 +1898,7 @@
 {"ACESP_PutClientInServer", (byte *)ACESP_PutClientInServer},
 {"ACESP_HoldSpawn", (byte *)ACESP_HoldSpawn},
 {"ACEND_LoadNodes", (byte *)ACEND_LoadNodes},
+{"ACEND_WriteNodes", (byte *)ACEND_WriteNodes},
 {"ACEND_SaveNodes", (byte *)ACEND_SaveNodes},
 {"ACEND_ResolveAllPaths", (byte *)ACEND_ResolveAllPaths},
 {"ACEND_RemoveNodeEdge", (byte *)ACEND_RemoveNodeEdge},
@@ -1799,6 +1916,7 @@
 {"ACEND_FindClosestReachableNode", (byte *)ACEND_FindClosestReachableNode},
 {"ACEND_FindCloseReachableNode", (byte *)ACEND_FindCloseReachableNode},
 {"ACEND_FindCost", (byte *)ACEND_FindCost},
+{"ACEND_GenerateNodes", (byte *)ACEND_GenerateNodes},
 {"ACEMV_Attack", (byte *)ACEMV_Attack},
 {"ACEMV_Wander", (byte *)ACEMV_Wander},
 {"ACEMV_Move", (byte *)ACEMV_Move},
@@ -102,10 +102,10 @@ void item_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage,
 	}
 //ZOID
 	
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_EXPLOSION1);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_EXPLOSION1);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(TE_EXPLOSION1, self->s.origin);
@@ -285,7 +285,7 @@ void SetRespawn(edict_t *ent, float delay)
 	ent->flags |= FL_RESPAWN;
 	ent->svflags |= SVF_NOCLIENT;
 	ent->solid = SOLID_NOT;
-	ent->nextthink = level.time + delay;
+	G_SetNextThink(ent, level.time + delay);
 	ent->think = DoRespawn;
 	gi.linkentity(ent);
 }
@@ -820,7 +820,7 @@ void MegaHealth_think(edict_t *self)
 		&& !CTFHasRegeneration(self->owner))
 //ZOID
 	{
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 		self->owner->health -= 1;
 		return;
 	}
@@ -857,7 +857,7 @@ qboolean Pickup_Health(edict_t *ent, edict_t *other)
 //ZOID
 	{
 		ent->think = MegaHealth_think;
-		ent->nextthink = level.time + 5;
+		G_SetNextThink(ent, level.time + 5);
 		ent->owner = other;
 		ent->flags |= FL_RESPAWN;
 		ent->svflags |= SVF_NOCLIENT;
@@ -1188,7 +1188,7 @@ void drop_make_touchable(edict_t *ent)
 	ent->touch = Touch_Item;
 	if (deathmatch->value)
 	{
-		ent->nextthink = level.time + 29;
+		G_SetNextThink(ent, level.time + 29);
 		ent->think = G_FreeEdict;
 	}
 }
@@ -1250,7 +1250,7 @@ edict_t *Drop_Item(edict_t *ent, gitem_t *item)
 	dropped->velocity[2] = 300;
 
 	dropped->think = drop_make_touchable;
-	dropped->nextthink = level.time + 1;
+	G_SetNextThink(dropped, level.time + 1);
 
 	gi.linkentity(dropped);
 
@@ -1368,7 +1368,7 @@ void droptofloor(edict_t *ent)
 
 		if (ent == ent->teammaster)
 		{
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(ent, level.time + FRAMETIME);
 			ent->think = DoRespawn;
 		}
 	}
@@ -1550,7 +1550,7 @@ void SpawnItem(edict_t *ent, gitem_t *item)
 	}
 
 	ent->item = item;
-	ent->nextthink = level.time + 2 * FRAMETIME;    // items start after other solids
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);    // items start after other solids
 	ent->think = droptofloor;
 	ent->s.skinnum = item->world_model_skinnum; //Knightmare- skinnum specified in item table
 	ent->s.effects = item->world_model_flags;
@@ -44,11 +44,11 @@ qboolean Jet_AvoidGround(edict_t *ent)
 // If a player dies with activated jetpack this function will be called and produces a little explosion
 void Jet_BecomeExplosion(edict_t *ent, int damage)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_EXPLOSION1);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_EXPLOSION1);
 	/*TE_EXPLOSION2 is possible too*/
-	gi.WritePosition(ent->s.origin);
-	gi.multicast(ent->s.origin, MULTICAST_PVS);
+	TempEnt_WritePosition(ent->s.origin);
+	TempEnt_Multicast(ent->s.origin, MULTICAST_PVS);
 	gi.sound(ent, CHAN_BODY, gi.soundindex("misc/udeath.wav"), 1, ATTN_NORM, 0);
 
 	if (level.num_reflectors)
@@ -98,11 +98,11 @@ void Jet_ApplySparks(edict_t *ent)
 	pack_pos[2] += 6;
 	VectorScale(forward, -50, jet_vector);
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_SPARKS);
-	gi.WritePosition(pack_pos);
-	gi.WriteDir(jet_vector);
-	gi.multicast(pack_pos, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_SPARKS);
+	TempEnt_WritePosition(pack_pos);
+	TempEnt_WriteDir(jet_vector);
+	TempEnt_Multicast(pack_pos, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectSparks(TE_SPARKS, pack_pos, jet_vector);
@@ -72,7 +72,7 @@ void target_lightswitch_toggle(edict_t *self)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -87,7 +87,7 @@ void use_target_lightswitch(edict_t *self, edict_t *other, edict_t *activator)
 	}
 
 	self->think = target_lightswitch_toggle;
-	self->nextthink = level.time + self->delay;
+	G_SetNextThink(self, level.time + self->delay);
 }
 
 void SP_target_lightswitch(edict_t *self)
@@ -119,7 +119,7 @@ void SP_target_lightswitch(edict_t *self)
 	if (self->spawnflags & 1)
 	{
 		self->think = target_lightswitch_toggle;
-		self->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(self, level.time + 2 * FRAMETIME);
 		gi.linkentity(self);
 	}
 }
\ No newline at end of file
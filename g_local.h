@@ -396,6 +396,18 @@ struct fog_s
 };
 typedef struct fog_s fog_t;
 
+// Last fog state sent to a client, as it appears in svc_fog
+typedef struct
+{
+	qboolean	valid;
+	int			enable;
+	int			model;
+	int			density;
+	int			near_dist;
+	int			far_dist;
+	int			color[3];
+} fog_sent_t;
+
 //
 // this structure is cleared as each map is entered
 // it is read/written to the level.sav file for savegames
@@ -450,7 +462,6 @@ typedef struct
 	int			trigger_fogs;
 	int			active_target_fog;
 	int			active_fog;
-	int			last_active_fog;
 	fog_t		fog;
 	int			flashlight_cost;	// cost/10 seconds for flashlight
 	int			mud_puddles;
@@ -803,6 +814,17 @@ extern	cvar_t	*rotate_distance;
 extern	cvar_t	*s_primary;
 extern	cvar_t	*shift_distance;
 extern	cvar_t	*sv_maxgibs;
+extern	cvar_t	*sv_fog_bandwidth;
+extern	cvar_t	*sv_tempent_budget;
+extern	cvar_t	*sv_savedelta;
+extern	cvar_t	*sv_savethread;
+extern	cvar_t	*sv_monsternav;
+extern	cvar_t	*sv_thinkwheel;
+extern	cvar_t	*sv_maxcosmetics;
+extern	cvar_t	*sv_cmdrate;
+extern	cvar_t	*sv_cmdburst;
+extern	cvar_t	*sv_spawnvis;
+extern	cvar_t	*sv_freemove;
 extern  cvar_t  *tpp;			  // third person perspective
 extern	cvar_t	*tpp_auto;
 extern	cvar_t	*turn_rider;
@@ -958,6 +980,33 @@ void SetLazarusCrosshair(edict_t *ent);
 void SetSensitivities(edict_t *ent,qboolean reset);
 void ShiftItem(edict_t *ent, int direction);
 
+//
+// g_cmdlimit.c
+//
+void CmdLimit_Connect(edict_t *ent);
+qboolean CmdLimit_Drop(edict_t *ent, char *cmd);
+void CmdLimit_Stats_f(void);
+void CmdLimit_Cost_f(void);
+
+//
+// g_cmodel.c
+//
+void CModel_LoadMap(char *mapname);
+void CModel_Free(void);
+qboolean CModel_Trace(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int contentmask, trace_t *trace);
+qboolean CModel_Blocked(vec3_t start, vec3_t mins, vec3_t maxs, vec3_t end, int contentmask, edict_t *target);
+int CModel_PointContents(const vec3_t p);
+qboolean CModel_WorldBounds(vec3_t mins, vec3_t maxs);
+int CModel_BrushBounds(int contents, vec3_t *mins, vec3_t *maxs, int maxbrushes);
+void CModel_Stats_f(void);
+
+//
+// g_cosmetic.c
+//
+void Cosmetic_Add(edict_t *ent);
+void Cosmetic_Clear(void);
+void Cosmetic_Stats_f(void);
+
 //
 // g_crane.c
 //
@@ -965,6 +1014,39 @@ void G_FindCraneParts();
 void crane_control_action(edict_t *crane, edict_t *activator, const vec3_t point);
 void Moving_Speaker_Think(edict_t *ent);
 
+//
+// g_danger.c
+//
+#define DANGER_GRENADE		1	// grenades and hand grenades
+#define DANGER_ROCKET		2	// rockets and homing rockets
+#define DANGER_BFG			4
+#define DANGER_HURT			8	// trigger_hurts that are on
+#define DANGER_LIST_MAX		32
+
+int Danger_Find(const vec3_t point, float radius, int types, edict_t **list, int maxlist);
+void Danger_Clear(void);
+void Danger_Stats_f(void);
+
+//
+// g_fileindex.c
+//
+#define FS_LOOSE	1	// file on disk
+#define FS_PAK		2	// inside a .pak
+#define FS_ENGINE	4	// found by engine filesystem
+
+typedef struct
+{
+	int			where;		// FS_LOOSE or FS_PAK
+	const char	*pakfile;	// path to .pak, for FS_PAK
+	int			start;		// offset in .pak
+	int			size;
+} fsfile_t;
+
+const fsfile_t *FS_FindFile(const char *basedir, const char *gamedir, const char *filename, int where);
+void FS_AddFile(const char *basedir, const char *gamedir, const char *filename);
+qboolean FS_EngineFileExists(char *filename);
+void FS_ClearIndex(void);
+
 //
 // g_fog.c
 //
@@ -973,7 +1055,9 @@ extern fog_t gfogs[MAX_FOGS];
 void Cmd_Fog_f(edict_t *ent);
 void Fog_Init();
 void Fog(edict_t *ent); //vec3_t viewpoint);
-void Fog_Off();
+void Fog_Off(edict_t *ent);
+fog_t *Fog_At(edict_t *ent);
+void Fog_ClearIndex(void);
 //void Fog_SetFogParms();
 
 //
@@ -996,6 +1080,7 @@ void button_use(edict_t *self, edict_t *other, edict_t *activator);
 void trainbutton_use(edict_t *self, edict_t *other, edict_t *activator);
 void movewith_init(edict_t *self);
 void set_child_movement(edict_t *self);
+void spline_calc(edict_t *train, vec3_t p1, vec3_t p2, vec3_t a1, vec3_t a2, float m, vec3_t p, vec3_t a);
 float GetAngularVelocity(float velocity, float angle, float idealangle); //mxd
 
 //
@@ -1012,6 +1097,7 @@ edict_t *Drop_Item(edict_t *ent, gitem_t *item);
 void SetRespawn(edict_t *ent, float delay);
 void ChangeWeapon(edict_t *ent);
 void SpawnItem(edict_t *ent, gitem_t *item);
+void droptofloor(edict_t *ent);
 void Think_Weapon(edict_t *ent);
 int ArmorIndex(edict_t *ent);
 int PowerArmorType(edict_t *ent);
@@ -1048,6 +1134,34 @@ void lock_digit_increment(edict_t *digit, edict_t *activator);
 void SaveClientData(void);
 void FetchClientEntData(edict_t *ent);
 void EndDMLevel(void);
+extern game_import_t RealFunc;	// engine functions replaced by wrappers in GetGameAPI
+
+//
+// g_mem.c
+//
+#define MEM_OTHER			0
+#define MEM_EDICTS			1	// g_edicts and game.clients
+#define MEM_STRINGS			2	// entity strings
+#define MEM_ENTFILE			3	// entity and alias files
+#define MEM_REFLECT			4	// mirrors and reflections
+#define MEM_TEXT			5	// p_text and p_menu
+#define MEM_PATH			6	// path_track graph and spline tables
+#define MEM_GRID			7	// BoxGrid cells
+#define MEM_ACTOR			8
+#define MEM_FAKECLIENT		9	// gclient_t for cameras and fake players
+#define MEM_TEMPLATES		10
+#define MEM_SAVE			11	// level save baseline
+#define MEM_NAV				12	// monster navigation graph
+#define MEM_SPAWNSPOTS		13
+#define MEM_NUM_SUBSYSTEMS	14
+
+void *G_TagMalloc(int size, int tag, int subsystem);
+void *Mem_TagMalloc(int size, int tag);
+void Mem_TagFree(void *block);
+int G_TagSize(void *block);
+int G_TagOverhead(void);
+void Mem_FreeTags(int tag);
+void G_MemStats_f(void);
 
 //
 // g_misc.c
@@ -1061,6 +1175,7 @@ void barrel_delay(edict_t *self, edict_t *inflictor, edict_t *attacker, int dama
 void barrel_explode(edict_t *self);
 void func_explosive_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, vec3_t point);
 void PrecacheDebris(int style);
+void drop_add_to_chain(edict_t *drop);
 
 //
 // g_monster.c
@@ -1111,11 +1226,38 @@ void PositionToWorld(edict_t *self, vec3_t localpos, vec3_t result); //mxd
 void NormalToWorld(edict_t *self, vec3_t localnormal, vec3_t result); //mxd
 void M_SpawnEffect(edict_t *self, int effect, vec3_t localpos, vec3_t localnormal); //mxd
 
+//
+// g_movewith.c
+//
+void Movewith_Attach(edict_t *child, edict_t *parent);
+void Movewith_Detach(edict_t *child);
+void Movewith_Free(edict_t *ent);
+qboolean Movewith_Updated(edict_t *parent);
+void Movewith_Moved(edict_t *ent);
+void Movewith_Update(void);
+void Movewith_Stats_f(void);
+
+//
+// g_nav.c
+//
+void Nav_ClearGraph(void);
+qboolean Nav_ChaseYaw(edict_t *ent, edict_t *goal, float dist, float *yaw);
+void Nav_Stats_f(void);
+
 //
 // g_patchplayermodels.c
 //
 int PatchPlayerModels(char *modelname);
 
+//
+// g_path.c
+//
+void Path_Invalidate(void);
+void Path_ClearGraph(void);
+edict_t *Path_Target(edict_t *path, qboolean alt);
+int Path_Previous(edict_t *path, edict_t ***list);
+void Path_SplinePoint(edict_t *train, edict_t *from, edict_t *to, float frac, vec3_t p, vec3_t a);
+
 //
 // g_phys.c
 //
@@ -1125,6 +1267,8 @@ void G_RunEntity(edict_t *ent);
 //
 // g_reflect.c
 //
+void Reflect_ClearMirrors(void);
+void Reflect_FindMirrors(void);
 void AddReflection(edict_t *ent);
 void DeleteReflection(edict_t *ent, int index);
 void ReflectExplosion(int type, const vec3_t origin);
@@ -1132,26 +1276,119 @@ void ReflectSparks(int type, const vec3_t origin, const vec3_t movedir);
 void ReflectSteam(const vec3_t origin, const vec3_t movedir, int count, int sounds, int speed, int wait, int nextid);
 void ReflectTrail(int type, const vec3_t start, const vec3_t end);
 
+//
+// g_rider.c
+//
+void G_SetGroundEntity(edict_t *ent, edict_t *ground);
+edict_t *Rider_Next(edict_t *ground, edict_t *from);
+void Rider_Rebuild(void);
+void Rider_Clear(void);
+void Rider_Check(void);
+void Rider_Stats_f(void);
+
+//
+// g_save.c
+//
+void Save_ClearBaseline(void);
+
+//
+// g_savewrite.c
+//
+typedef struct
+{
+	byte	*data;		// malloc'd, freed once the file is written
+	int		size;
+	int		maxsize;
+} savebuffer_t;
+
+void Save_Write(savebuffer_t *buf, const void *data, int size);
+void Save_QueueFile(char *filename, savebuffer_t *buf);
+void Save_StartWrites(void);
+void Save_CheckWrites(void);
+void Save_WaitForWrites(void);
+void Save_Stats_f(void);
+
+//
+// g_solid.c
+//
+void Solid_Link(edict_t *ent, qboolean linked);
+qboolean Solid_FreeMove(edict_t *ent, const vec3_t start, const vec3_t end, int mask, qboolean *triggers);
+int Solid_BoxEdicts(const vec3_t mins, const vec3_t maxs, edict_t **list, int maxcount);
+trace_t Solid_FreeTrace(const vec3_t end);
+int Solid_PointContents(const vec3_t p);
+void Solid_Clear(void);
+void Solid_Stats_f(void);
+
 //
 // g_spawn.c
 //
+qboolean ED_FindSpawn(char *classname, gitem_t **item, void (**spawn)(edict_t *ent));
+void ED_CallSpawnFunc(edict_t *ent, gitem_t *item, void (*spawn)(edict_t *ent));
 void ED_CallSpawn(edict_t *ent);
 void G_FindTeams();
 void Cmd_ToggleHud();
 void Hud_On();
 void Hud_Off();
 
+//
+// g_spawnspot.c
+//
+edict_t *SpawnSpot_Random(char *classname);
+edict_t *SpawnSpot_Farthest(char *classname);
+void SpawnSpot_ClientMoved(edict_t *ent);
+void SpawnSpot_Update(void);
+void SpawnSpot_Clear(void);
+void SpawnSpot_Stats_f(void);
+
 //
 // g_svcmds.c
 //
 void	ServerCommand(void);
 qboolean SV_FilterPacket(char *from);
 
+//
+// g_tempent.c
+//
+void TempEnt_Begin(void);
+void TempEnt_WriteByte(int c);
+void TempEnt_WriteShort(int c);
+void TempEnt_WriteLong(int c);
+void TempEnt_WritePosition(vec3_t pos);
+void TempEnt_WriteDir(vec3_t dir);
+void TempEnt_Multicast(vec3_t origin, multicast_t to);
+void TempEnt_Flush(void);
+void TempEnt_Clear(void);
+void TempEnt_Stats_f(void);
+
+//
+// g_template.c
+//
+typedef struct enttemplate_s enttemplate_t;
+
+const enttemplate_t *Template_FindClone(char *source);
+edict_t *Template_SpawnClone(const enttemplate_t *t);
+const enttemplate_t *Template_FindSpawner(char *classname);
+void Template_CallSpawn(const enttemplate_t *t, edict_t *ent);
+void Template_Clear(void);
+void Template_Stats_f(void);
+
 //
 // g_thing.c
 //
 edict_t *SpawnThing();
 
+//
+// g_think.c
+//
+void G_SetNextThink(edict_t *ent, float nextthink);
+void Think_Wake(edict_t *ent);
+void Think_Sleep(edict_t *ent);
+void Think_Advance(void);
+edict_t *Think_NextAwake(edict_t *from);
+void Think_Clear(void);
+void Think_Check(void);
+void Think_Stats_f(void);
+
 //
 // g_tracktrain.c
 //
@@ -1189,6 +1426,9 @@ void G_FreeEdict(edict_t *e);
 void G_TouchTriggers(edict_t *ent);
 void G_TouchSolids(edict_t *ent);
 char *G_CopyString(char *in);
+char *G_InternString(const char *string);
+void G_ClearStrings(void);
+void G_StringStats_f(void);
 void stuffcmd(edict_t *ent,char *command);
 float *tv(float x, float y, float z);
 char *vtos(vec3_t v);
@@ -1205,6 +1445,36 @@ void G_UseTarget(edict_t *ent, edict_t *activator, edict_t *target);
 qboolean IsIdMap(void); //Knightmare added
 void my_bprintf(int printlevel, char *fmt, ...);
 
+// Coarse XY grid over a set of static boxes, for point-in-box lookups
+typedef struct
+{
+	vec3_t	origin;
+	float	cellsize;
+	int		size[2];
+	int		*start;		// [cells + 1], offsets into list
+	int		*list;		// box indices
+} boxgrid_t;
+
+void BoxGrid_Build(boxgrid_t *grid, int count, vec3_t *mins, vec3_t *maxs, int tag);
+void BoxGrid_Free(boxgrid_t *grid);
+int BoxGrid_Query(boxgrid_t *grid, const vec3_t point, int **list);
+
+// entity role registries
+#define ROLE_CLIENT		1
+#define ROLE_MONSTER	2	// live monsters: SVF_MONSTER, not dead
+#define ROLE_PUSHER		4	// MOVETYPE_PUSH
+#define ROLE_ITEM		8	// pickups (monsters carrying an item don't count)
+#define ROLE_DANGER		16	// grenades, rockets, BFG blasts and active trigger_hurts (see g_danger.c)
+#define ROLE_COSMETIC	32	// gibs, heads, debris and visible leaves (see g_cosmetic.c)
+
+void G_UpdateRoles(edict_t *ent);
+void G_ClearRoles(void);
+void G_RebuildRoles(void);
+edict_t *G_NextRole(edict_t *from, int roles);
+int G_RoleCount(int role);
+int G_RoleChanges(int role);
+void G_CheckRoles(void);
+
 void G_ProjectSource2(const vec3_t point, const vec3_t distance, const vec3_t forward, const vec3_t right, const vec3_t up, vec3_t result);
 float vectoyaw2(vec3_t vec);
 void vectoangles2(vec3_t vec, vec3_t angles);
@@ -1463,6 +1733,14 @@ typedef struct
 	// tpp
 	int			chasetoggle;
 	// end tpp
+
+	// Lazarus fog, as seen by this client
+	fog_t		fog;
+	int			fog_active;			// gfogs index + 1, 0 = no fog
+	int			fog_goal_frame;		// end of trigger_fog fade-in
+	int			fog_framenum;		// last level.framenum Fog() ran
+	float		fog_budget;			// svc_fog bytes this client may still be sent
+	fog_sent_t	fog_sent;
 } client_respawn_t;
 
 // this structure is cleared on each PutClientInServer(),
@@ -1894,9 +2172,11 @@ struct edict_s
 	int			fogclip;		// only used by worldspawn to indicate whether gl_clear
 								// should be forced to a good value for fog obscuration of HOM
 
-	edict_t		*movewith_next;
 	char		*movewith;
-	edict_t		*movewith_ent;
+	edict_t		*movewith_ent;		// what it moves with, see g_movewith.c
+	edict_t		*movewith_child;	// first of the entities moving with it
+	edict_t		*movewith_next;		// others moving with the same movewith_ent
+	edict_t		*movewith_prev;
 	vec3_t		movewith_offset;
 	vec3_t		parent_attach_angles;
 	qboolean	do_not_rotate;
@@ -1964,8 +2244,7 @@ struct edict_s
 	edict_t		*from;
 	edict_t		*to;
 
-	edict_t		*next_grenade;				// Used to build a list of active grenades
-	edict_t		*prev_grenade;
+	edict_t		*next_grenade;				// grenade a monster is running from
 
 	// FMOD
 	int			*stream;	// Actually a FSOUND_STREAM * or FMUSIC_MODULE *
@@ -2013,6 +2292,32 @@ struct edict_s
 
 };
 
+// Entity template for target_clone and target_spawner (g_template.c)
+#define CLONE_OTHER			0
+#define CLONE_BUTTON		1
+#define CLONE_DOOR			2
+#define CLONE_DOOR_ROTATING	3
+#define CLONE_ROTATING		4
+#define CLONE_TRAIN			5
+
+struct enttemplate_s
+{
+	char		*name;		// source targetname (clones) or classname (spawners)
+	qboolean	spawner;
+	qboolean	ready;		// clones: source has been copied. Spawners: spawn function was found
+
+	// target_clone
+	int			type;		// CLONE_*
+	edict_t		source;		// copy of the source entity
+	edict_t		proto;		// what a new clone looks like before per-clone fixups
+
+	// target_spawner
+	gitem_t		*item;
+	void		(*spawn)(edict_t *ent);
+
+	struct enttemplate_s *next;
+};
+
 #define LOOKAT_NOBRUSHMODELS	1
 #define LOOKAT_NOWORLD			2
 #define LOOKAT_MD2				(LOOKAT_NOBRUSHMODELS | LOOKAT_NOWORLD)
@@ -135,12 +135,15 @@ void SP_target_lock(edict_t *self)
 	if (self->spawnflags & 2) 
 		game.lock_hud = true;
 
-	if (!self->key_message)
-		self->key_message = "00000000";
+	// lock_initialize writes the combination into key_message, so it needs a copy of its own
+	const char *key = (self->key_message ? self->key_message : "00000000");
+	const int size = max(strlen(key) + 1, 9);
+	self->key_message = G_TagMalloc(size, TAG_LEVEL, MEM_STRINGS);
+	Q_strncpyz(self->key_message, key, size);
 
 	self->use = target_lock_use;
 	self->think = lock_initialize;
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 
 	gi.linkentity(self);
 }
@@ -256,7 +259,7 @@ void lock_clue_think(edict_t *self)
 
 	if (unrevealed_count)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		gi.linkentity(self);
 	}
 }
@@ -272,7 +275,7 @@ void lock_clue_initialize(edict_t *self)
 	}
 
 	self->think = lock_clue_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -286,7 +289,7 @@ void SP_target_lock_clue(edict_t *self)
 
 	self->use = lock_clue_use;
 	self->think = lock_clue_initialize;
-	self->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(self, level.time + 2 * FRAMETIME);
 
 	gi.linkentity(self);
 }
\ No newline at end of file
@@ -125,6 +125,17 @@ cvar_t	*rotate_distance;
 cvar_t	*s_primary;
 cvar_t	*shift_distance;
 cvar_t	*sv_maxgibs;
+cvar_t	*sv_fog_bandwidth;	// bytes/sec of fog fade updates per client
+cvar_t	*sv_tempent_budget;	// temp entity bytes per client per frame, 0 = no limit
+cvar_t	*sv_savedelta;		// level files only hold edicts that changed since the level's baseline
+cvar_t	*sv_savethread;		// write savegame files on a background thread
+cvar_t	*sv_monsternav;		// walk monsters along hint_paths and bot nodes when they can't see their goal
+cvar_t	*sv_thinkwheel;		// entities waiting on a think drop out of the frame loop until it's due
+cvar_t	*sv_maxcosmetics;	// gibs, debris and leaves in the level at once, 0 = no limit
+cvar_t	*sv_cmdrate;		// client command tokens a second per command class, 0 = no limit
+cvar_t	*sv_cmdburst;		// most command tokens a client can save up
+cvar_t	*sv_spawnvis;		// deathmatch spawn spots in a player's PVS count as nearer to them
+cvar_t	*sv_freemove;		// toss physics skips traces through open space
 cvar_t	*turn_rider;
 cvar_t	*vid_ref;
 cvar_t	*zoomrate;
@@ -165,7 +176,11 @@ void ShutdownGame(void)
 
 	// Lazarus: Turn off fog if it's on
 	if (!dedicated->value)
-		Fog_Off();
+		Fog_Off(&g_edicts[1]);
+
+	Save_WaitForWrites();
+	FS_ClearIndex();
+	CModel_Free();
 
 	gi.FreeTags(TAG_LEVEL);
 	gi.FreeTags(TAG_GAME);
@@ -201,6 +216,23 @@ int Debug_Soundindex(char *name)
 	return soundnum;
 }
 
+// Keep the entity role registries and the solid index up to date (see G_UpdateRoles, Solid_Link), and wake the entity for the think scheduler
+void Registry_LinkEntity(edict_t *ent)
+{
+	RealFunc.linkentity(ent);
+	G_UpdateRoles(ent);
+	Solid_Link(ent, true);
+	Think_Wake(ent);
+}
+
+void Registry_UnlinkEntity(edict_t *ent)
+{
+	RealFunc.unlinkentity(ent);
+	G_UpdateRoles(ent);
+	Solid_Link(ent, false);
+	Think_Wake(ent);
+}
+
 /*
 =================
 GetGameAPI
@@ -241,6 +273,19 @@ game_export_t *GetGameAPI (game_import_t *import)
 
 	Fog_Init();
 
+	RealFunc.linkentity = gi.linkentity;
+	gi.linkentity = Registry_LinkEntity;
+	RealFunc.unlinkentity = gi.unlinkentity;
+	gi.unlinkentity = Registry_UnlinkEntity;
+
+	// Memory accounting (g_mem.c)
+	RealFunc.TagMalloc = gi.TagMalloc;
+	gi.TagMalloc = Mem_TagMalloc;
+	RealFunc.TagFree = gi.TagFree;
+	gi.TagFree = Mem_TagFree;
+	RealFunc.FreeTags = gi.FreeTags;
+	gi.FreeTags = Mem_FreeTags;
+
 	developer = gi.cvar("developer", "0", CVAR_SERVERINFO);
 	readout = gi.cvar("readout", "0", CVAR_SERVERINFO);
 
@@ -322,6 +367,9 @@ void ClientEndServerFrames(void)
 			AddReflection(ent);
 		}
 	}
+
+	// send this frame's temp entities
+	TempEnt_Flush();
 }
 
 /*
@@ -532,6 +580,16 @@ void G_RunFrame(void)
 
 	level.time = level.framenum*FRAMETIME;
 
+	if (developer->value)
+	{
+		G_CheckRoles();
+		Rider_Check();
+		Think_Check();
+	}
+
+	// Free the last savegame's buffers once they're on disk
+	Save_CheckWrites();
+
 	// choose a client for monsters to target this frame
 	AI_SetSightClient();
 
@@ -548,12 +606,19 @@ void G_RunFrame(void)
 	//
 	// treat each object in turn
 	// even the world gets a chance to think
+	// (entities that are only waiting on a think sit out until it's due, see g_think.c)
 	//
-	edict_t *ent = &g_edicts[0];
-	for (int i = 0; i < globals.num_edicts; i++, ent++)
+	Think_Advance();
+
+	for (edict_t *ent = Think_NextAwake(NULL); ent; ent = Think_NextAwake(ent))
 	{
+		const int i = ent - g_edicts;
+
 		if (!ent->inuse)
+		{
+			Think_Sleep(ent);
 			continue;
+		}
 
 		level.current_entity = ent;
 
@@ -577,8 +642,15 @@ void G_RunFrame(void)
 		}
 
 		G_RunEntity(ent);
+		Think_Sleep(ent);
 	}
 
+	// Lazarus: bring movewith children along with the parents that moved
+	Movewith_Update();
+
+	// keep track of how near players are to the deathmatch spawn spots
+	SpawnSpot_Update();
+
 	// see if it is time to end a deathmatch
 	CheckDMRules();
 
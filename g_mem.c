@@ -0,0 +1,283 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_mem.c -- TAG_LEVEL/TAG_GAME allocation accounting.
+// Every block gets a small header with its size and the subsystem (MEM_*) that asked for it.
+// gi.TagMalloc, gi.TagFree and gi.FreeTags are replaced in GetGameAPI, so allocations that don't
+// go through G_TagMalloc are still counted, as MEM_OTHER.
+// When TAG_LEVEL is freed on map change, developer mode prints what the level used and how much
+// TAG_GAME memory, which should stay about the same between levels, has grown.
+
+#include "g_local.h"
+
+typedef struct memblock_s
+{
+	struct memblock_s	*prev, *next;
+	int					size;
+	short				tag;
+	short				subsystem;
+} memblock_t;
+
+#define MEM_HEADER		((sizeof(memblock_t) + 15) & ~15)	// keeps returned memory 16 byte aligned
+
+#define MEM_LEVEL		0
+#define MEM_GAME		1
+
+typedef struct
+{
+	int		bytes;		// live
+	int		blocks;		// live
+	int		peak;		// most live bytes since the last map change
+	int		allocs;		// total since the last map change
+	int		game_start;	// TAG_GAME bytes when the level started
+} memstat_t;
+
+static memstat_t	mem_stats[MEM_NUM_SUBSYSTEMS][2];
+static memblock_t	mem_blocks[2];		// list heads, by MEM_LEVEL/MEM_GAME
+static qboolean		mem_have_game_start;	// game_start is valid
+
+static char *mem_names[MEM_NUM_SUBSYSTEMS] =
+{
+	"other",
+	"edicts",
+	"strings",
+	"entity file",
+	"reflections",
+	"text/menus",
+	"paths",
+	"grids",
+	"actors",
+	"fake clients",
+	"templates",
+	"save baseline",
+	"monster nav",
+	"spawn spots"
+};
+
+static int Mem_Index(int tag)
+{
+	return (tag == TAG_GAME ? MEM_GAME : MEM_LEVEL);
+}
+
+static memblock_t *Mem_Head(int index)
+{
+	memblock_t *head = &mem_blocks[index];
+	if (!head->next)
+		head->next = head->prev = head;
+
+	return head;
+}
+
+/*
+=================
+G_TagMalloc
+
+gi.TagMalloc, with the memory counted against subsystem (MEM_*)
+=================
+*/
+void *G_TagMalloc(int size, int tag, int subsystem)
+{
+	if (subsystem < 0 || subsystem >= MEM_NUM_SUBSYSTEMS)
+		subsystem = MEM_OTHER;
+
+	memblock_t *b = RealFunc.TagMalloc(size + MEM_HEADER, tag);
+	b->size = size;
+	b->tag = tag;
+	b->subsystem = subsystem;
+
+	const int index = Mem_Index(tag);
+	memblock_t *head = Mem_Head(index);
+	b->next = head->next;
+	b->prev = head;
+	head->next->prev = b;
+	head->next = b;
+
+	memstat_t *s = &mem_stats[subsystem][index];
+	s->bytes += size;
+	s->blocks++;
+	s->allocs++;
+	s->peak = max(s->peak, s->bytes);
+
+	return (byte *)b + MEM_HEADER;
+}
+
+static void Mem_Unlink(memblock_t *b)
+{
+	memstat_t *s = &mem_stats[b->subsystem][Mem_Index(b->tag)];
+	s->bytes -= b->size;
+	s->blocks--;
+
+	b->prev->next = b->next;
+	b->next->prev = b->prev;
+}
+
+// gi.TagMalloc replacement
+void *Mem_TagMalloc(int size, int tag)
+{
+	return G_TagMalloc(size, tag, MEM_OTHER);
+}
+
+// gi.TagFree replacement
+void Mem_TagFree(void *block)
+{
+	memblock_t *b = (memblock_t *)((byte *)block - MEM_HEADER);
+
+	if (b->subsystem < 0 || b->subsystem >= MEM_NUM_SUBSYSTEMS || b->next->prev != b)
+		gi.error("TagFree: bad memory block");
+
+	Mem_Unlink(b);
+	RealFunc.TagFree(b);
+}
+
+/*
+=================
+G_TagSize
+
+Size block was allocated with
+=================
+*/
+int G_TagSize(void *block)
+{
+	const memblock_t *b = (memblock_t *)((byte *)block - MEM_HEADER);
+	return b->size;
+}
+
+/*
+=================
+G_TagOverhead
+
+Bytes every G_TagMalloc block costs on top of its size: our header, and the engine zone header (zhead_t) under it
+=================
+*/
+int G_TagOverhead(void)
+{
+	return MEM_HEADER + 2 * sizeof(void *) + 2 * sizeof(short) + sizeof(int);
+}
+
+// Prints what the level used, and TAG_GAME growth, before TAG_LEVEL memory is freed
+static void Mem_LevelReport(void)
+{
+	int total = 0, allocs = 0;
+
+	for (int i = 0; i < MEM_NUM_SUBSYSTEMS; i++)
+	{
+		total += mem_stats[i][MEM_LEVEL].bytes;
+		allocs += mem_stats[i][MEM_LEVEL].allocs;
+	}
+
+	if (!total && !allocs)
+		return;
+
+	gi.dprintf("Level memory at map change: %d bytes\n", total);
+
+	for (int i = 0; i < MEM_NUM_SUBSYSTEMS; i++)
+	{
+		const memstat_t *s = &mem_stats[i][MEM_LEVEL];
+		if (s->allocs)
+			gi.dprintf("  %-14s %9d bytes in %5d blocks, peak %9d, %6d allocations\n", mem_names[i], s->bytes, s->blocks, s->peak, s->allocs);
+	}
+
+	if (!mem_have_game_start)
+		return;
+
+	for (int i = 0; i < MEM_NUM_SUBSYSTEMS; i++)
+	{
+		const memstat_t *s = &mem_stats[i][MEM_GAME];
+		if (s->bytes > s->game_start)
+			gi.dprintf("  %s game memory grew by %d bytes this level\n", mem_names[i], s->bytes - s->game_start);
+	}
+}
+
+// gi.FreeTags replacement
+void Mem_FreeTags(int tag)
+{
+	const int index = Mem_Index(tag);
+
+	if (tag == TAG_LEVEL && developer && developer->value)
+		Mem_LevelReport();
+
+	// The engine frees the blocks, just drop them from the counts
+	memblock_t *head = Mem_Head(index);
+	memblock_t *next;
+	for (memblock_t *b = head->next; b != head; b = next)
+	{
+		next = b->next;
+		if (b->tag == tag)
+			Mem_Unlink(b);
+	}
+
+	RealFunc.FreeTags(tag);
+
+	// New level (or game) starts here
+	for (int i = 0; i < MEM_NUM_SUBSYSTEMS; i++)
+	{
+		mem_stats[i][index].peak = mem_stats[i][index].bytes;
+		mem_stats[i][index].allocs = 0;
+
+		if (tag == TAG_LEVEL)
+			mem_stats[i][MEM_GAME].game_start = mem_stats[i][MEM_GAME].bytes;
+	}
+
+	// Game memory is allocated again after this, so there's nothing to compare with until the next level
+	mem_have_game_start = (tag == TAG_LEVEL);
+}
+
+/*
+=================
+G_MemStats_f
+
+"sv mem": memory use by subsystem, biggest first
+=================
+*/
+void G_MemStats_f(void)
+{
+	int order[MEM_NUM_SUBSYSTEMS * 2];
+	int total[2] = { 0, 0 };
+	int count = 0;
+
+	for (int i = 0; i < MEM_NUM_SUBSYSTEMS * 2; i++)
+	{
+		const memstat_t *s = &mem_stats[i / 2][i % 2];
+		total[i % 2] += s->bytes;
+
+		if (!s->bytes && !s->allocs)
+			continue;
+
+		// Insertion sort by live bytes
+		int n = count++;
+		while (n > 0 && mem_stats[order[n - 1] / 2][order[n - 1] % 2].bytes < s->bytes)
+		{
+			order[n] = order[n - 1];
+			n--;
+		}
+
+		order[n] = i;
+	}
+
+	safe_cprintf(NULL, PRINT_HIGH, "Memory: %d bytes level, %d bytes game\n", total[MEM_LEVEL], total[MEM_GAME]);
+	safe_cprintf(NULL, PRINT_HIGH, "  %-14s %-5s %9s %6s %9s %7s\n", "subsystem", "tag", "bytes", "blocks", "peak", "allocs");
+
+	for (int i = 0; i < count; i++)
+	{
+		const memstat_t *s = &mem_stats[order[i] / 2][order[i] % 2];
+		safe_cprintf(NULL, PRINT_HIGH, "  %-14s %-5s %9d %6d %9d %7d\n", mem_names[order[i] / 2], (order[i] % 2 == MEM_GAME ? "game" : "level"), s->bytes, s->blocks, s->peak, s->allocs);
+	}
+}
@@ -171,7 +171,7 @@ void gib_fade2(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + 0.2;
+	G_SetNextThink(self, level.time + 0.2);
 	self->think = gib_fade2;
 	gi.linkentity(self);
 }
@@ -184,7 +184,7 @@ void gib_fade(edict_t *self)
 	if (self->s.effects & EF_BLASTER)  //Remove glow from gekk gibs
 		self->s.effects &= ~EF_BLASTER;
 	self->s.renderfx = RF_TRANSLUCENT;
-	self->nextthink = level.time + 2;
+	G_SetNextThink(self, level.time + 2);
 	self->think = gib_fade2;
 	gi.linkentity(self);
 }
@@ -193,7 +193,7 @@ void gib_fade2(edict_t *self)
 {
 	self->s.effects |= EF_SPHERETRANS;
 	self->s.renderfx &= ~RF_TRANSLUCENT;
-	self->nextthink = level.time + 2;
+	G_SetNextThink(self, level.time + 2);
 	self->think = G_FreeEdict;
 	gi.linkentity(self);
 }
@@ -202,12 +202,12 @@ void gib_fade2(edict_t *self)
 void gib_think(edict_t *self)
 {
 	self->s.frame++;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (self->s.frame == 10)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 8 + random() * 10;
+		G_SetNextThink(self, level.time + 8 + random() * 10);
 	}
 }
 
@@ -232,7 +232,7 @@ void gib_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *surf)
 		{
 			self->s.frame++;
 			self->think = gib_think;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 	}*/
 
@@ -335,7 +335,7 @@ edict_t* ThrowGib(edict_t *self, char *gibname, int damage, int type) //mxd. voi
 	}
 
 	// Save gibname and type for level transition gibs
-	gib->key_message = gi.TagMalloc(strlen(modelname)+1,TAG_LEVEL);
+	gib->key_message = G_TagMalloc(strlen(modelname)+1, TAG_LEVEL, MEM_STRINGS);
 	strcpy(gib->key_message, modelname);
 	gib->style = type;
 
@@ -393,11 +393,12 @@ edict_t* ThrowGib(edict_t *self, char *gibname, int damage, int type) //mxd. voi
 
 	gib->think = gib_fade; //Knightmare- gib fade, was G_FreeEdict
 	const int timetofade = (is_shell ? 4 : 10); //mxd
-	gib->nextthink = level.time + timetofade + random() * timetofade;
+	G_SetNextThink(gib, level.time + timetofade + random() * timetofade);
 
 	gib->s.renderfx |= RF_IR_VISIBLE;
 
 	gi.linkentity(gib);
+	Cosmetic_Add(gib);
 
 	return gib; //mxd
 }
@@ -450,17 +451,17 @@ void gib_delayed_start(edict_t *gib)
 		if (gib->count > 0)
 		{
 			gib->think = gib_fade; // was FadeThink
-			gib->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(gib, level.time + FRAMETIME);
 		}
 		else
 		{
 			gib->think = gib_fade; // was FadeDieThink
-			gib->nextthink = level.time + 8 + random() * 10;
+			G_SetNextThink(gib, level.time + 8 + random() * 10);
 		}
 	}
 	else
 	{
-		gib->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(gib, level.time + FRAMETIME);
 	}
 }
 
@@ -475,7 +476,7 @@ void SP_gib(edict_t *gib)
 	gib->touch = gib_touch;
 	gib->think = gib_delayed_start;
 	gib->class_id = ENTITY_GIB; //mxd
-	gib->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(gib, level.time + FRAMETIME);
 
 	gi.linkentity(gib);
 }
@@ -502,7 +503,7 @@ void ThrowHead(edict_t *self, char *gibname, int damage, int type)
 	}
 
 	// Save gibname and type for level transition gibs
-	self->key_message = gi.TagMalloc(strlen(modelname) + 1, TAG_LEVEL);
+	self->key_message = G_TagMalloc(strlen(modelname) + 1, TAG_LEVEL, MEM_STRINGS);
 	strcpy(self->key_message, modelname);
 
 	self->style = type;
@@ -531,6 +532,7 @@ void ThrowHead(edict_t *self, char *gibname, int damage, int type)
 	self->flags |= FL_NO_KNOCKBACK;
 	self->svflags &= ~SVF_MONSTER;
 	self->svflags |= SVF_GIB; //Knightmare- gib flag
+	G_UpdateRoles(self);
 	self->takedamage = DAMAGE_YES;
 	// Lazarus: Disassociate this head with its monster
 	self->targetname = NULL;
@@ -557,27 +559,15 @@ void ThrowHead(edict_t *self, char *gibname, int damage, int type)
 	self->avelocity[YAW] = crandom() * 600;
 
 	self->think = gib_fade; //Knightmare- gib fade, was G_FreeEdict
-	self->nextthink = level.time + 10 + random() * 10;
+	G_SetNextThink(self, level.time + 10 + random() * 10);
 
-	// Lazarus: If head owner was part of a movewith chain, remove from the chain and repair the chain if necessary
-	if (self->movewith)
-	{
-		edict_t	*parent = NULL;
-		for (int i = 1; i < globals.num_edicts && !parent; i++)
-		{
-			edict_t *e = g_edicts + i;
-
-			if (e->movewith_next == self)
-				parent = e;
-		}
-
-		if (parent)
-			parent->movewith_next = self->movewith_next;
-	}
+	// Lazarus: If head owner was moving with something, it's not any more
+	Movewith_Detach(self);
 
 	self->s.renderfx |= RF_IR_VISIBLE;
 
 	gi.linkentity(self);
+	Cosmetic_Add(self);
 }
 
 void SP_gibhead(edict_t *gib)
@@ -590,7 +580,7 @@ void SP_gibhead(edict_t *gib)
 	gib->touch = gib_touch;
 	gib->class_id = ENTITY_GIBHEAD; //mxd
 	gib->think = gib_delayed_start;
-	gib->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(gib, level.time + FRAMETIME);
 
 	gi.linkentity(gib);
 }
@@ -636,7 +626,7 @@ void ThrowClientHead(edict_t *self, int damage)
 	else
 	{
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 
 	gi.linkentity(self);
@@ -685,10 +675,11 @@ void ThrowDebris(edict_t *self, char *modelname, float speed, const vec3_t origi
 	chunk->solid = SOLID_NOT;
 	VectorSetAll(chunk->avelocity, crandom() * 600); //mxd. random() -> crandom()
 	chunk->think = gib_fade; //Knightmare- gib fade, was G_FreeEdict
-	chunk->nextthink = level.time + 8 + random()*10;
+	G_SetNextThink(chunk, level.time + 8 + random()*10);
 	chunk->s.frame = 0;
 	chunk->flags = 0;
 	chunk->classname = "debris";
+	chunk->class_id = ENTITY_DEBRIS;
 	chunk->takedamage = DAMAGE_YES;
 	chunk->die = debris_die;
 
@@ -701,6 +692,7 @@ void ThrowDebris(edict_t *self, char *modelname, float speed, const vec3_t origi
 	chunk->s.effects |= effects;
 
 	gi.linkentity(chunk);
+	Cosmetic_Add(chunk);
 }
 
 // NOTE: SP_debris is ONLY intended to be used for debris chunks that change maps via trigger_transition. It should NOT be used for map entities
@@ -709,11 +701,11 @@ void debris_delayed_start(edict_t *debris)
 	if (g_edicts[1].linkcount)
 	{
 		debris->think = gib_fade;
-		debris->nextthink = level.time + 8 + random() * 5;
+		G_SetNextThink(debris, level.time + 8 + random() * 5);
 	}
 	else
 	{
-		debris->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(debris, level.time + FRAMETIME);
 	}
 }
 
@@ -725,8 +717,9 @@ void SP_debris(edict_t *debris)
 		gi.setmodel(debris, "models/objects/debris2/tris.md2");
 
 	debris->think = debris_delayed_start;
-	debris->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(debris, level.time + FRAMETIME);
 	debris->die = debris_die;
+	debris->class_id = ENTITY_DEBRIS;
 
 	gi.linkentity(debris);
 }
@@ -772,10 +765,10 @@ void BecomeExplosion1(edict_t *self)
 	}
 //ZOID
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_EXPLOSION1);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_EXPLOSION1);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(TE_EXPLOSION1, self->s.origin);
@@ -786,10 +779,10 @@ void BecomeExplosion1(edict_t *self)
 
 void BecomeExplosion2(edict_t *self)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_EXPLOSION2);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_EXPLOSION2);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(TE_EXPLOSION2, self->s.origin);
@@ -799,10 +792,10 @@ void BecomeExplosion2(edict_t *self)
 
 void BecomeExplosion3(edict_t *self)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_EXPLOSION1_BIG);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_EXPLOSION1_BIG);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(TE_EXPLOSION1_BIG, self->s.origin);
@@ -869,7 +862,7 @@ void path_corner_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -912,7 +905,7 @@ void point_combat_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + self->delay + 1;
+		G_SetNextThink(self, level.time + self->delay + 1);
 	}
 
 	if (self->target)
@@ -1000,7 +993,7 @@ Just for the debugging level.  Don't use
 void TH_viewthing(edict_t *ent)
 {
 	ent->s.frame = (ent->s.frame + 1) % 7;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void SP_viewthing(edict_t *ent)
@@ -1014,7 +1007,7 @@ void SP_viewthing(edict_t *ent)
 	VectorSet(ent->maxs, 16, 16, 32);
 	ent->s.modelindex = gi.modelindex("models/objects/banner/tris.md2");
 	gi.linkentity(ent);
-	ent->nextthink = level.time + 0.5;
+	G_SetNextThink(ent, level.time + 0.5);
 	ent->think = TH_viewthing;
 }
 
@@ -1064,7 +1057,7 @@ void light_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 		}
 	}
 
@@ -1122,7 +1115,7 @@ void func_wall_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 
 			return;
 		}
@@ -1228,7 +1221,7 @@ void SP_func_object(edict_t *self)
 		self->solid = SOLID_BSP;
 		self->movetype = MOVETYPE_PUSH;
 		self->think = func_object_release;
-		self->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(self, level.time + 2 * FRAMETIME);
 	}
 	else
 	{
@@ -1396,17 +1389,17 @@ void func_explosive_explode(edict_t *self)
 /*  with these:
     if (self->dmg)
     {
-        gi.WriteByte(svc_temp_entity);
-        gi.WriteByte(TE_EXPLOSION1);
-        gi.WritePosition(self->s.origin);
-        gi.multicast(self->s.origin, MULTICAST_PVS);
+        TempEnt_Begin();
+        TempEnt_WriteByte(TE_EXPLOSION1);
+        TempEnt_WritePosition(self->s.origin);
+        TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
     }
 	VectorClear(self->s.origin);
 	VectorClear(self->velocity);
     self->solid = SOLID_NOT;
     self->svflags |= SVF_NOCLIENT;
     self->think = func_explosive_respawn;
-    self->nextthink = level.time + 10; // substitute whatever value you want here
+    G_SetNextThink(self, level.time + 10); // substitute whatever value you want here
 	self->use = NULL;
 	gi.linkentity(self); */
 }
@@ -1419,7 +1412,7 @@ void func_explosive_die(edict_t *self, edict_t *inflictor, edict_t *attacker, in
 	if (self->delay > 0)
 	{
 		self->think = func_explosive_explode;
-		self->nextthink = level.time + self->delay;
+		G_SetNextThink(self, level.time + self->delay);
 	}
 	else
 	{
@@ -1676,7 +1669,7 @@ void func_breakaway_think(edict_t *self)
 		if (self->spawnflags & BREAKAWAY_FADE)
 		{
 			self->think = gib_fade;
-			self->nextthink = level.time + (int)self->fadeout;
+			G_SetNextThink(self, level.time + (int)self->fadeout);
 
 			return;
 		}
@@ -1686,13 +1679,13 @@ void func_breakaway_think(edict_t *self)
 		VectorClear(self->maxs);
 		gi.setmodel(self, self->model);
 		self->solid = SOLID_BSP;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 
 		gi.linkentity(self);
 	}
 	else
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1711,7 +1704,7 @@ void func_breakaway_makesolid(edict_t *self)
 	}
 
 	self->think = func_breakaway_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void func_breakaway_fall(edict_t *self)
@@ -1743,7 +1736,7 @@ void func_breakaway_fall(edict_t *self)
 	self->touch = func_breakaway_hit;
 
 	self->think = func_breakaway_makesolid; //make solid again after wait
-	self->nextthink = level.time + self->wait;
+	G_SetNextThink(self, level.time + self->wait);
 
 	G_UseTargets(self, self->activator);
 
@@ -1770,10 +1763,9 @@ void func_breakaway_die(edict_t *self, edict_t *inflictor, edict_t *attacker, in
 	{	
 		//Knightmare- clean up child movement stuff here
 		VectorClear(self->avelocity);
-		self->movewith = "";
-		self->movewith_ent = NULL;
+		Movewith_Detach(self);
 		self->think = func_breakaway_fall;
-		self->nextthink = level.time + self->delay;
+		G_SetNextThink(self, level.time + self->delay);
 	}
 	else
 	{
@@ -2037,7 +2029,7 @@ void barrel_explode(edict_t *self)
 void barrel_delay(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, vec3_t point)
 {
 	self->takedamage = DAMAGE_NO;
-	self->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(self, level.time + 2 * FRAMETIME);
 	self->think = barrel_explode;
 	self->activator = attacker;
 }
@@ -2117,10 +2109,10 @@ void SP_misc_explobox(edict_t *self)
 void misc_blackhole_use(edict_t *ent, edict_t *other, edict_t *activator)
 {
 	/*
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_BOSSTPORT);
-	gi.WritePosition(ent->s.origin);
-	gi.multicast(ent->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_BOSSTPORT);
+	TempEnt_WritePosition(ent->s.origin);
+	TempEnt_Multicast(ent->s.origin, MULTICAST_PVS);
 	*/
 	G_FreeEdict(ent);
 }
@@ -2129,12 +2121,12 @@ void misc_blackhole_think(edict_t *self)
 {
 	if (++self->s.frame < 19)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{		
 		self->s.frame = 0;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -2148,7 +2140,7 @@ void SP_misc_blackhole(edict_t *ent)
 	ent->s.renderfx = RF_TRANSLUCENT;
 	ent->use = misc_blackhole_use;
 	ent->think = misc_blackhole_think;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 
 	gi.linkentity(ent);
 }
@@ -2161,7 +2153,7 @@ void misc_eastertank_think(edict_t *self)
 	if (++self->s.frame > 292)
 		self->s.frame = 254;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_misc_eastertank(edict_t *ent)
@@ -2187,7 +2179,7 @@ void SP_misc_eastertank(edict_t *ent)
 		ent->s.skinnum = 2;
 
 	ent->think = misc_eastertank_think;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 
 	gi.linkentity(ent);
 }
@@ -2200,7 +2192,7 @@ void misc_easterchick_think(edict_t *self)
 	if (++self->s.frame > 246)
 		self->s.frame = 208;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_misc_easterchick(edict_t *ent)
@@ -2222,7 +2214,7 @@ void SP_misc_easterchick(edict_t *ent)
 	ent->s.modelindex = gi.modelindex("models/monsters/bitch/tris.md2");
 	ent->s.frame = 208;
 	ent->think = misc_easterchick_think;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 
 	gi.linkentity(ent);
 }
@@ -2235,7 +2227,7 @@ void misc_easterchick2_think(edict_t *self)
 	if (++self->s.frame > 286)
 		self->s.frame = 248;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_misc_easterchick2(edict_t *ent)
@@ -2257,7 +2249,7 @@ void SP_misc_easterchick2(edict_t *ent)
 	ent->s.modelindex = gi.modelindex("models/monsters/bitch/tris.md2");
 	ent->s.frame = 248;
 	ent->think = misc_easterchick2_think;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 
 	gi.linkentity(ent);
 }
@@ -2271,9 +2263,9 @@ There should be a item_commander_head that has this as it's target.
 void commander_body_think(edict_t *self)
 {
 	if (++self->s.frame < 24)
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	else
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 
 	if (self->s.frame == 22)
 		gi.sound(self, CHAN_BODY, gi.soundindex("tank/thud.wav"), 1, ATTN_NORM, 0);
@@ -2282,7 +2274,7 @@ void commander_body_think(edict_t *self)
 void commander_body_use(edict_t *self, edict_t *other, edict_t *activator)
 {
 	self->think = commander_body_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.sound(self, CHAN_BODY, gi.soundindex("tank/pain.wav"), 1, ATTN_NORM, 0);
 }
 
@@ -2316,7 +2308,7 @@ void SP_monster_commander_body(edict_t *self)
 	gi.soundindex("tank/pain.wav");
 
 	self->think = commander_body_drop;
-	self->nextthink = level.time + 5 * FRAMETIME;
+	G_SetNextThink(self, level.time + 5 * FRAMETIME);
 }
 
 
@@ -2327,7 +2319,7 @@ The banner is 128 tall.
 void misc_banner_think(edict_t *ent)
 {
 	ent->s.frame = (ent->s.frame + 1) % 16;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void SP_misc_banner(edict_t *ent)
@@ -2340,7 +2332,7 @@ void SP_misc_banner(edict_t *ent)
 	gi.linkentity(ent);
 
 	ent->think = misc_banner_think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*QUAKED misc_deadsoldier (1 .5 0) (-16 -16 0) (16 16 16) ON_BACK ON_STOMACH BACK_DECAP FETAL_POS SIT_DECAP IMPALED
@@ -2404,7 +2396,7 @@ void SP_misc_deadsoldier(edict_t *ent)
 	{
 		// postpone turning on flies till we figure out whether dude is submerged
 		ent->think = misc_deadsoldier_flieson;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 
 	VectorSet(ent->mins, -16, -16, 0);
@@ -2464,7 +2456,7 @@ void SP_misc_deadparasite(edict_t *ent)
 	{
 		// postpone turning on flies till we figure out whether dude is submerged
 		ent->think = misc_deadsoldier_flieson;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 
 	VectorSet(ent->mins, -16, -16, -0);
@@ -2498,13 +2490,13 @@ void viper_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage,
 		G_UseTargets(self, attacker);
 	}
 
-	edict_t *e = self->movewith_next;
+	edict_t *e = self->movewith_child;
 	while (e)
 	{
 		edict_t *next = e->movewith_next;
 		if (e->solid == SOLID_NOT)
 		{
-			e->nextthink = 0;
+			G_SetNextThink(e, 0);
 			G_FreeEdict(e);
 		}
 		else
@@ -2570,7 +2562,7 @@ void SP_misc_viper(edict_t *ent)
 	ent->smooth_movement = (ent->spawnflags & TRAIN_SMOOTH);
 
 	ent->think = func_train_find;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (ent->spawnflags & TRAIN_START_ON)
 	{
@@ -2635,10 +2627,10 @@ void misc_viper_bomb_touch(edict_t *self, edict_t *other, cplane_t *plane, csurf
 
 	if (self->spawnflags & 1)
 	{
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_EXPLOSION2);
-		gi.WritePosition(self->s.origin);
-		gi.multicast(self->s.origin, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_EXPLOSION2);
+		TempEnt_WritePosition(self->s.origin);
+		TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 		if (level.num_reflectors)
 			ReflectExplosion(TE_EXPLOSION2, self->s.origin);
@@ -2648,7 +2640,7 @@ void misc_viper_bomb_touch(edict_t *self, edict_t *other, cplane_t *plane, csurf
 		self->use = misc_viper_bomb_use;
 		self->s.effects = 0;
 		self->movetype = MOVETYPE_NONE;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 		self->think = NULL;
 		VectorCopy(self->pos1, self->s.origin);
 		VectorCopy(self->pos2, self->s.angles);
@@ -2684,7 +2676,7 @@ void viper_bomb_think(edict_t *self)
 		gi.dprintf("bomb position = %g, %g, %g\n", self->s.origin[0], self->s.origin[1], self->s.origin[2]);
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 void misc_viper_bomb_use(edict_t *self, edict_t *other, edict_t *activator)
 {
@@ -2735,7 +2727,7 @@ void misc_viper_bomb_use(edict_t *self, edict_t *other, edict_t *activator)
 	self->timestamp = level.time;
 
 	self->think = viper_bomb_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_misc_viper_bomb(edict_t *self)
@@ -2822,7 +2814,7 @@ void SP_misc_strogg_ship(edict_t *ent)
 	ent->smooth_movement = (ent->spawnflags & TRAIN_SMOOTH);
 
 	ent->think = func_train_find;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (ent->spawnflags & TRAIN_START_ON)
 	{
@@ -2860,14 +2852,14 @@ void misc_satellite_dish_think(edict_t *self)
 {
 	self->s.frame++;
 	if (self->s.frame < 38)
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void misc_satellite_dish_use(edict_t *self, edict_t *other, edict_t *activator)
 {
 	self->s.frame = 0;
 	self->think = misc_satellite_dish_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_misc_satellite_dish(edict_t *ent)
@@ -2922,7 +2914,7 @@ void SP_misc_gib_arm(edict_t *ent)
 	ent->deadflag = DEAD_DEAD;
 	VectorSetAll(ent->avelocity, crandom() * 200); //mxd. random() -> crandom()
 	ent->think = G_FreeEdict;
-	ent->nextthink = level.time + 30;
+	G_SetNextThink(ent, level.time + 30);
 	gi.linkentity(ent);
 }
 
@@ -2941,7 +2933,7 @@ void SP_misc_gib_leg(edict_t *ent)
 	ent->deadflag = DEAD_DEAD;
 	VectorSetAll(ent->avelocity, crandom() * 200); //mxd. random() -> crandom()
 	ent->think = G_FreeEdict;
-	ent->nextthink = level.time + 30;
+	G_SetNextThink(ent, level.time + 30);
 	gi.linkentity(ent);
 }
 
@@ -2960,7 +2952,7 @@ void SP_misc_gib_head(edict_t *ent)
 	ent->deadflag = DEAD_DEAD;
 	VectorSetAll(ent->avelocity, crandom() * 200); //mxd. random() -> crandom()
 	ent->think = G_FreeEdict;
-	ent->nextthink = level.time + 30;
+	G_SetNextThink(ent, level.time + 30);
 	gi.linkentity(ent);
 }
 
@@ -3057,7 +3049,7 @@ void misc_halo_think(edict_t *self)
 	if (self->spawnflags & 2)
 		self->s.angles[ROLL] = clamp(-dist / 16.0f, -45, 0);
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_misc_halo(edict_t *ent)
@@ -3110,7 +3102,7 @@ void SP_misc_halo(edict_t *ent)
 	ent->angle = st.lip; // Angular fade
 
 	ent->think = misc_halo_think;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	gi.linkentity(ent);
 }
@@ -3204,26 +3196,22 @@ void func_clock_reset(edict_t *self)
 	}
 }
 
-// Skuller's hack to fix crash on exiting biggun
-typedef struct zhead_s
+// Skuller's hack to fix crash on exiting biggun: a message restored from a savegame
+// is only as long as it was when saved, so make room for the longest one
+static void func_clock_check_message(edict_t *self)
 {
-	struct zhead_s	*prev, *next;
-	short			magic;
-	short			tag; // for group free
-	int				size;
-} zhead_t;
+	if (self->message && G_TagSize(self->message) >= CLOCK_MESSAGE_SIZE)
+		return;
+
+	if (self->message)
+		gi.TagFree(self->message);
+
+	self->message = G_TagMalloc(CLOCK_MESSAGE_SIZE, TAG_LEVEL, MEM_STRINGS);
+}
 
 void func_clock_format_countdown(edict_t *self)
 {
-	zhead_t *z = ( zhead_t * )self->message - 1;
-	const int size = z->size - sizeof(zhead_t);
-
-	if (size < CLOCK_MESSAGE_SIZE)
-	{
-		gi.TagFree(self->message);
-		self->message = gi.TagMalloc(CLOCK_MESSAGE_SIZE, TAG_LEVEL);
-	} 
-	// end Skuller's hack
+	func_clock_check_message(self);
 
 	if (self->style == 0)
 	{
@@ -3275,6 +3263,7 @@ void func_clock_think(edict_t *self)
 
 		time(&gmtime);
 		struct tm *ltime = localtime(&gmtime);
+		func_clock_check_message(self);
 		Com_sprintf(self->message, CLOCK_MESSAGE_SIZE, "%2i:%2i:%2i", ltime->tm_hour, ltime->tm_min, ltime->tm_sec);
 		if (self->message[3] == ' ')
 			self->message[3] = '0';
@@ -3303,7 +3292,7 @@ void func_clock_think(edict_t *self)
 		{
 			// Lazarus: Can't be used again, so get rid of it
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 
 			return;
 		}
@@ -3314,7 +3303,7 @@ void func_clock_think(edict_t *self)
 			return;
 	}
 
-	self->nextthink = level.time + 1;
+	G_SetNextThink(self, level.time + 1);
 }
 
 void func_clock_use(edict_t *self, edict_t *other, edict_t *activator)
@@ -3352,13 +3341,13 @@ void SP_func_clock(edict_t *self)
 
 	func_clock_reset(self);
 
-	self->message = gi.TagMalloc(CLOCK_MESSAGE_SIZE, TAG_LEVEL);
+	self->message = G_TagMalloc(CLOCK_MESSAGE_SIZE, TAG_LEVEL, MEM_STRINGS);
 	self->think = func_clock_think;
 
 	if (self->spawnflags & 4)
 		self->use = func_clock_use;
 	else
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 }
 
 /*==================================================================
@@ -3623,10 +3612,10 @@ void teleporter_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t
 
 		if (!(self->spawnflags & 16))
 		{
-			gi.WriteByte(svc_temp_entity);
-			gi.WriteByte(TE_TELEPORT_EFFECT);
-			gi.WritePosition(origin);
-			gi.multicast(origin, MULTICAST_PHS);
+			TempEnt_Begin();
+			TempEnt_WriteByte(TE_TELEPORT_EFFECT);
+			TempEnt_WritePosition(origin);
+			TempEnt_Multicast(origin, MULTICAST_PHS);
 		}
 
 		gi.positioned_sound(origin, self, CHAN_AUTO, self->noise_index, 1, 1, 0);
@@ -3847,12 +3836,12 @@ void misc_light_think(edict_t *self)
 	if (self->spawnflags & START_OFF)
 		return;
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_FLASHLIGHT);
-	gi.WritePosition(self->s.origin);
-	gi.WriteShort(self - g_edicts);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
-	self->nextthink = level.time + FRAMETIME;
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_FLASHLIGHT);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_WriteShort(self - g_edicts);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void misc_light_use(edict_t *self, edict_t *other, edict_t *activator)
@@ -3860,7 +3849,7 @@ void misc_light_use(edict_t *self, edict_t *other, edict_t *activator)
 	if (self->spawnflags & START_OFF)
 	{
 		self->spawnflags &= ~START_OFF;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
@@ -3875,7 +3864,7 @@ void SP_misc_light(edict_t *self)
 	self->think = misc_light_think;
 
 	if (!(self->spawnflags & START_OFF))
-		self->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(self, level.time + 2 * FRAMETIME);
 }
 
 /*=============================================================
@@ -3916,19 +3905,27 @@ void drop_add_to_chain(edict_t *drop)
 	drop->s.renderfx &= ~RF_TRANSLUCENT;
 	VectorClear(drop->velocity);
 	VectorClear(drop->avelocity);
+
+	// Nothing it was doing can carry on while it waits, or it could fade and be chained a second time.
+	// spawn_precipitation sets all of this up again.
+	drop->movetype = MOVETYPE_NONE;
+	drop->touch = NULL;
+	drop->think = NULL;
+	G_SetNextThink(drop, 0);
+
 	gi.linkentity(drop);
 }
 
 void drop_splash(edict_t *drop)
 {
 	vec3_t up = { 0, 0, 1 };
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_LASER_SPARKS);
-	gi.WriteByte(drop->owner->mass2);
-	gi.WritePosition(drop->s.origin);
-	gi.WriteDir(up);
-	gi.WriteByte(drop->owner->sounds);
-	gi.multicast(drop->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_LASER_SPARKS);
+	TempEnt_WriteByte(drop->owner->mass2);
+	TempEnt_WritePosition(drop->s.origin);
+	TempEnt_WriteDir(up);
+	TempEnt_WriteByte(drop->owner->sounds);
+	TempEnt_Multicast(drop->s.origin, MULTICAST_PVS);
 	drop_add_to_chain(drop);
 }
 
@@ -3938,7 +3935,7 @@ void leaf_fade2(edict_t *ent)
 	if (ent->count == 1)
 	{
 		ent->s.effects |= EF_SPHERETRANS;
-		ent->nextthink = level.time + 0.5f;
+		G_SetNextThink(ent, level.time + 0.5f);
 		gi.linkentity(ent);
 	}
 	else
@@ -3951,7 +3948,7 @@ void leaf_fade(edict_t *ent)
 {
 	ent->s.renderfx = RF_TRANSLUCENT;
 	ent->think = leaf_fade2;
-	ent->nextthink = level.time + 0.5f;
+	G_SetNextThink(ent, level.time + 0.5f);
 	ent->count = 0;
 	gi.linkentity(ent);
 }
@@ -3970,7 +3967,7 @@ void drop_touch(edict_t *drop, edict_t *other, cplane_t *plane, csurface_t *surf
 		}
 
 		drop->think = leaf_fade;
-		drop->nextthink = level.time + drop->fadeout;
+		G_SetNextThink(drop, level.time + drop->fadeout);
 	}
 	else if (drop->spawnflags & SF_WEATHER_SPLASH)
 	{
@@ -4019,6 +4016,7 @@ void spawn_precipitation(edict_t *self, const vec3_t org, vec3_t dir, float spee
 
 			VectorSet(drop->mins, -1, -1, -1);
 			VectorSet(drop->maxs, 1, 1, 1);
+			drop->class_id = ENTITY_LEAF;
 		}
 		else if (self->style == STYLE_WEATHER_USER)
 		{
@@ -4088,15 +4086,18 @@ void spawn_precipitation(edict_t *self, const vec3_t org, vec3_t dir, float spee
 	if (self->spawnflags & SF_WEATHER_START_FADE)
 	{
 		drop->think = leaf_fade;
-		drop->nextthink = level.time + self->fadeout;
+		G_SetNextThink(drop, level.time + self->fadeout);
 	}
 
 	gi.linkentity(drop);
+
+	if (drop->class_id == ENTITY_LEAF)
+		Cosmetic_Add(drop);
 }
 
 void target_precipitation_think(edict_t *self)
 {
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	// Don't start raining until player is in the game. The following takes care of both initial map load conditions and restored saved games.
 	// This is a gross abuse of groundentity_linkcount. Sue me.
@@ -4154,7 +4155,7 @@ void target_precipitation_use(edict_t *ent, edict_t *other, edict_t *activator)
 	if (ent->spawnflags & SF_WEATHER_STARTON)
 	{
 		// already on; turn it off
-		ent->nextthink = 0;
+		G_SetNextThink(ent, 0);
 		ent->spawnflags &= ~SF_WEATHER_STARTON;
 		
 		if (ent->child)
@@ -4189,7 +4190,7 @@ void target_precipitation_delayed_use(edict_t *self)
 	}
 	else
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -4208,7 +4209,7 @@ void SP_target_precipitation(edict_t *ent)
 	if (ent->spawnflags & SF_WEATHER_STARTON)
 	{
 		ent->think = target_precipitation_delayed_use;
-		ent->nextthink = level.time + 1;
+		G_SetNextThink(ent, level.time + 1);
 	}
 
 	if (ent->style == STYLE_WEATHER_USER)
@@ -4223,7 +4224,7 @@ void SP_target_precipitation(edict_t *ent)
 		// Knightmare- check for "models/" or "sprites/" already in path
 		if (strncmp(ent->usermodel, "models/", 7) && strncmp(ent->usermodel, "sprites/", 8))
 		{
-			char *buffer = gi.TagMalloc(strlen(ent->usermodel) + 10, TAG_LEVEL);
+			char *buffer = G_TagMalloc(strlen(ent->usermodel) + 10, TAG_LEVEL, MEM_STRINGS);
 			if (strstr(ent->usermodel,".sp2"))
 				sprintf(buffer, "sprites/%s", ent->usermodel);
 			else
@@ -4292,7 +4293,7 @@ void SP_target_precipitation(edict_t *ent)
 void target_fountain_think(edict_t *self)
 {
 	if (!(self->spawnflags & SF_WEATHER_FIRE_ONCE))
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 
 	// Don't start raining until player is in the game. The following takes care of both initial map load conditions and restored saved games.
 	// This is a gross abuse of groundentity_linkcount. Sue me.
@@ -4355,7 +4356,7 @@ void target_fountain_use(edict_t *ent, edict_t *other, edict_t *activator)
 	if ((ent->spawnflags & SF_WEATHER_STARTON) && !(ent->spawnflags & SF_WEATHER_FIRE_ONCE))
 	{
 		// already on; turn it off
-		ent->nextthink = 0;
+		G_SetNextThink(ent, 0);
 		ent->spawnflags &= ~SF_WEATHER_STARTON;
 
 		if (ent->child)
@@ -4390,7 +4391,7 @@ void target_fountain_delayed_use(edict_t *self)
 	}
 	else
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -4409,7 +4410,7 @@ void SP_target_fountain(edict_t *ent)
 	if (ent->spawnflags & SF_WEATHER_STARTON)
 	{
 		ent->think = target_fountain_delayed_use;
-		ent->nextthink = level.time + 1;
+		G_SetNextThink(ent, level.time + 1);
 	}
 
 	ent->style = STYLE_WEATHER_USER;
@@ -4424,7 +4425,7 @@ void SP_target_fountain(edict_t *ent)
 	// Knightmare- check for "models/" or "sprites/" already in path
 	if (strncmp(ent->usermodel, "models/", 7) && strncmp(ent->usermodel, "sprites/", 8))
 	{
-		char *buffer = gi.TagMalloc(strlen(ent->usermodel) + 10, TAG_LEVEL);
+		char *buffer = G_TagMalloc(strlen(ent->usermodel) + 10, TAG_LEVEL, MEM_STRINGS);
 
 		if (strstr(ent->usermodel,".sp2"))
 			sprintf(buffer, "sprites/%s", ent->usermodel);
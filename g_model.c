@@ -74,7 +74,7 @@ void modelspawn_think(edict_t *self)
 		}
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -88,7 +88,7 @@ void model_spawn_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (self->framenumbers > 1)
 		{
 			self->think = modelspawn_think;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 
 		self->s.sound = self->noise_index;
@@ -102,20 +102,20 @@ void model_spawn_use(edict_t *self, edict_t *other, edict_t *activator)
 		self->delay = 1;
 		self->use = model_spawn_use;
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 		self->s.sound = 0;
 	}
 }
 
 void model_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, vec3_t point)
 {
-	edict_t *e = self->movewith_next;
+	edict_t *e = self->movewith_child;
 	while (e)
 	{
 		edict_t *next = e->movewith_next;
 		if (e->solid == SOLID_NOT)
 		{
-			e->nextthink = 0;
+			G_SetNextThink(e, 0);
 			G_FreeEdict(e);
 		}
 		else
@@ -278,7 +278,7 @@ void SP_model_spawn(edict_t *ent)
 	if (!(ent->s.effects & ANIM_MASK) && ent->framenumbers > 1)
 	{
 		ent->think = modelspawn_think;
-		ent->nextthink = level.time + 2 * FRAMETIME;
+		G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 	}
 
 	gi.linkentity(ent);
@@ -41,7 +41,7 @@ void FadeSink(edict_t *ent)
 	if (ent->count == 10)
 		ent->think = G_FreeEdict;
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void FadeDieSink(edict_t *ent)
@@ -52,7 +52,7 @@ void FadeDieSink(edict_t *ent)
 	ent->s.origin[2] -= SINKAMT;
 	ent->s.renderfx = RF_TRANSLUCENT;
 	ent->think = FadeSink;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->count = 0;
 }
 
@@ -250,7 +250,7 @@ void M_FliesOn(edict_t *self)
 	self->s.effects |= EF_FLIES;
 	self->s.sound = gi.soundindex("infantry/inflies1.wav");
 	self->think = M_FliesOff;
-	self->nextthink = level.time + 60;
+	G_SetNextThink(self, level.time + 60);
 }
 
 void M_FlyCheck(edict_t *self)
@@ -262,7 +262,7 @@ void M_FlyCheck(edict_t *self)
 	{
 		// should ALREADY have flies
 		self->think = M_FliesOff;
-		self->nextthink = level.time + 60;
+		G_SetNextThink(self, level.time + 60);
 		return;
 	}
 
@@ -276,7 +276,7 @@ void M_FlyCheck(edict_t *self)
 		return;
 
 	self->think = M_FliesOn;
-	self->nextthink = level.time + 5 + 10 * random();
+	G_SetNextThink(self, level.time + 5 + 10 * random());
 }
 
 void AttackFinished(edict_t *self, float time)
@@ -344,7 +344,7 @@ void M_CheckGround(edict_t *ent)
 	//          dead monster to drop through the brush model. This change *may*
 	//          have other consequences, though, so watch out for this.
 
-	ent->groundentity = trace.ent;
+	G_SetGroundEntity(ent, trace.ent);
 	ent->groundentity_linkcount = trace.ent->linkcount;
 
 //	if (!trace.startsolid && !trace.allsolid)
@@ -557,7 +557,7 @@ void M_MoveFrame(edict_t *self)
 		Grenade_Evade(self);
 
 	mmove_t *move = self->monsterinfo.currentmove;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if ((self->monsterinfo.nextframe) && (self->monsterinfo.nextframe >= move->firstframe) && (self->monsterinfo.nextframe <= move->lastframe))
 	{
@@ -661,12 +661,12 @@ void M_SpawnEffect(edict_t *self, int effect, vec3_t localpos, vec3_t localnorma
 	NormalToWorld(self, localnormal, normal);
 
 	// Spawn blood
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(effect);
-	gi.WritePosition(pos);
+	TempEnt_Begin();
+	TempEnt_WriteByte(effect);
+	TempEnt_WritePosition(pos);
 	if (effect != TE_CHAINFIST_SMOKE)
-		gi.WriteDir(normal);
-	gi.multicast(pos, MULTICAST_PVS);
+		TempEnt_WriteDir(normal);
+	TempEnt_Multicast(pos, MULTICAST_PVS);
 }
 
 
@@ -736,7 +736,7 @@ void monster_triggered_spawn_use(edict_t *self, edict_t *other, edict_t *activat
 {
 	// we have a one frame delay here so we don't telefrag the guy who activated us
 	self->think = monster_triggered_spawn;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	// Knightmare- good guy monsters shouldn't have an enemy from this
 	if (activator->client && !(self->monsterinfo.aiflags & AI_GOOD_GUY))
 		self->enemy = activator;
@@ -751,7 +751,7 @@ void monster_triggered_start(edict_t *self)
 	self->solid = SOLID_NOT;
 	self->movetype = MOVETYPE_NONE;
 	self->svflags |= SVF_NOCLIENT;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	self->use = monster_triggered_spawn_use;
 	// Lazarus
 	self->spawnflags &= ~SF_MONSTER_TRIGGER_SPAWN;
@@ -820,7 +820,7 @@ qboolean monster_start(edict_t *self)
 	if (self->spawnflags & SF_MONSTER_GOODGUY) {
 		self->monsterinfo.aiflags |= AI_GOOD_GUY;
 		if (!self->dmgteam) {
-			self->dmgteam = gi.TagMalloc(8*sizeof(char), TAG_LEVEL);
+			self->dmgteam = G_TagMalloc(8*sizeof(char), TAG_LEVEL, MEM_STRINGS);
 		//	strncpy(self->dmgteam,"player");
 			Q_strncpyz(self->dmgteam,"player", 8);
 		}
@@ -849,7 +849,7 @@ qboolean monster_start(edict_t *self)
 	//mxd. Count them regardless of SF_MONSTER_TRIGGER_SPAWN / AI_GOOD_GUY flags, like in N64 version.
 	level.total_monsters++;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->svflags |= SVF_MONSTER;
 	self->s.renderfx |= RF_FRAMELERP;
 	self->air_finished = level.time + 12;
@@ -867,6 +867,7 @@ qboolean monster_start(edict_t *self)
 		self->s.skinnum = 0;
 	self->deadflag = DEAD_NO;
 	self->svflags &= ~SVF_DEADMONSTER;
+	G_UpdateRoles(self);
 
 	if (self->monsterinfo.flies > 1.0)
 	{
@@ -886,13 +887,13 @@ qboolean monster_start(edict_t *self)
 		{
 			// This must be a dead monster who changed levels
 			// via trigger_transition
-			self->nextthink = 0;
+			G_SetNextThink(self, 0);
 			self->deadflag = DEAD_DEAD;
 		}
 		if (self->s.effects & EF_FLIES && self->monsterinfo.flies <= 1.0)
 		{
 			self->think = M_FliesOff;
-			self->nextthink = level.time + 1 + random()*60;
+			G_SetNextThink(self, level.time + 1 + random()*60);
 		}
 		return true;
 	}
@@ -1018,7 +1019,7 @@ void monster_start_go(edict_t *self)
 	}
 
 	self->think = monster_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 
@@ -1123,7 +1124,7 @@ void InitiallyDead(edict_t *self)
 		{
 			self->svflags |= SVF_DEADMONSTER;
 			self->think = monster_think;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 	}
 
@@ -1133,8 +1134,6 @@ void InitiallyDead(edict_t *self)
 #define MAX_SKINS		24 //max is 32, but we only need 24
 #define MAX_SKINNAME	64
 
-#include "pak.h"
-
 int PatchMonsterModel(char *modelname)
 {
 	char		skins[MAX_SKINS][MAX_SKINNAME];	// skin entries
@@ -1152,14 +1151,9 @@ int PatchMonsterModel(char *modelname)
 	if (!*gamedir->string)
 		return 0;	// we're in baseq2
 
-	Com_sprintf(outfilename, sizeof(outfilename), "%s/%s", gamedir->string, modelname);
-	FILE *outfile = fopen(outfilename, "rb");
-	if (outfile)
-	{
-		// output file already exists, move along
-		fclose(outfile);
+	// output file already exists, move along
+	if (FS_FindFile("", gamedir->string, modelname, FS_LOOSE))
 		return 0;
-	}
 
 	int numskins = 8;
 
@@ -1182,7 +1176,6 @@ int PatchMonsterModel(char *modelname)
 		p = strstr(skins[j], "tris.md2");
 		if (!p)
 		{
-			fclose(outfile);
 			gi.dprintf("Error patching %s\n",modelname);
 			return 0;
 		}
@@ -1257,76 +1250,52 @@ int PatchMonsterModel(char *modelname)
 	}
 
 	// load original model
-	Com_sprintf(infilename, sizeof(infilename), "baseq2/%s", modelname);
-	FILE *infile = fopen(infilename, "rb");
-	if (!infile)
+	FILE *infile = NULL;
+	if (FS_FindFile("", "baseq2", modelname, FS_LOOSE))
 	{
-		// If file doesn't exist on user's hard disk, it must be in pak0.pak
-		pak_header_t	pakheader;
-		pak_item_t		pakitem;
+		Com_sprintf(infilename, sizeof(infilename), "baseq2/%s", modelname);
+		infile = fopen(infilename, "rb");
+	}
 
-		FILE *fpak = fopen("baseq2/pak0.pak","rb");
-		if (!fpak)
+	if (!infile)
+	{
+		// If file doesn't exist on user's hard disk, it must be in a pak
+		const fsfile_t *pakitem = FS_FindFile("", "baseq2", modelname, FS_PAK);
+		if (!pakitem)
 		{
-			char	pakfile[MAX_OSPATH];
 			cvar_t *cddir = gi.cvar("cddir", "", 0);
-			Com_sprintf(pakfile, sizeof(pakfile), "%s/baseq2/pak0.pak", cddir->string);
-			fpak = fopen(pakfile, "rb");
-
-			if (!fpak)
-			{
-				gi.dprintf("PatchMonsterModel: Cannot find pak0.pak\n");
-				return 0;
-			}
+			pakitem = FS_FindFile(cddir->string, "baseq2", modelname, FS_PAK);
 		}
 
-		fread(&pakheader, 1, sizeof(pak_header_t), fpak);
-		const int numitems = pakheader.dsize / sizeof(pak_item_t);
-		fseek(fpak, pakheader.dstart, SEEK_SET);
-		data = NULL;
-		for (int k = 0; k<numitems && !data; k++)
+		if (!pakitem)
 		{
-			fread(&pakitem, 1, sizeof(pak_item_t), fpak);
-			if (!Q_stricmp(pakitem.name,modelname))
-			{
-				fseek(fpak,pakitem.start,SEEK_SET);
-				fread(&model, sizeof(dmdl_t), 1, fpak);
-				datasize = model.ofs_end - model.ofs_skins;
-				data = malloc(datasize);
-
-				if (!data)	// make sure freed locally
-				{
-					fclose(fpak);
-					gi.dprintf("PatchMonsterModel: Could not allocate memory for model\n");
-					return 0;
-				}
-
-				fread(data, sizeof(byte), datasize, fpak);
-			}
+			gi.dprintf("PatchMonsterModel: Could not find %s in baseq2 paks\n", modelname);
+			return 0;
 		}
 
-		fclose(fpak);
-		if (!data)
+		infile = fopen(pakitem->pakfile, "rb");
+		if (!infile)
 		{
-			gi.dprintf("PatchMonsterModel: Could not find %s in baseq2/pak0.pak\n", modelname);
+			gi.dprintf("PatchMonsterModel: Cannot open %s\n", pakitem->pakfile);
 			return 0;
 		}
+
+		fseek(infile, pakitem->start, SEEK_SET);
 	}
-	else
-	{
-		fread(&model, sizeof(dmdl_t), 1, infile);
-	
-		datasize = model.ofs_end - model.ofs_skins;
-		data = malloc(datasize);
-		if (!data)	// make sure freed locally
-		{
-			gi.dprintf("PatchMonsterModel: Could not allocate memory for model\n");
-			return 0;
-		}
 
-		fread(data, sizeof(byte), datasize, infile);
+	fread(&model, sizeof(dmdl_t), 1, infile);
+
+	datasize = model.ofs_end - model.ofs_skins;
+	data = malloc(datasize);
+	if (!data)	// make sure freed locally
+	{
 		fclose(infile);
+		gi.dprintf("PatchMonsterModel: Could not allocate memory for model\n");
+		return 0;
 	}
+
+	fread(data, sizeof(byte), datasize, infile);
+	fclose(infile);
 	
 	// update model info
 	model.num_skins = numskins;
@@ -1349,7 +1318,7 @@ int PatchMonsterModel(char *modelname)
 	_mkdir(outfilename);
 
 	Com_sprintf(outfilename, sizeof(outfilename), "%s/%s", gamedir->string, modelname);
-	outfile = fopen(outfilename, "wb");
+	FILE *outfile = fopen(outfilename, "wb");
 	if (!outfile)
 	{
 		// file couldn't be created for some other reason
@@ -1363,6 +1332,7 @@ int PatchMonsterModel(char *modelname)
 	fwrite(data, sizeof(byte), datasize, outfile);
 	
 	fclose(outfile);
+	FS_AddFile("", gamedir->string, modelname);
 	gi.dprintf("PatchMonsterModel: Saved %s\n", outfilename);
 	free(data);
 	return 1;
@@ -511,7 +511,7 @@ void touch_hint_path(edict_t *hintpath, edict_t *monster, cplane_t *plane, csurf
 
 	// If this hint_path has a wait value set, pause here for set time.
 	if (hintpath->wait)
-		monster->nextthink = level.time + hintpath->wait;
+		G_SetNextThink(monster, level.time + hintpath->wait);
 }
 
 
@@ -0,0 +1,246 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_movewith.c -- Lazarus movewith hierarchy.
+// Children used to hang off their parent in a single movewith_next chain, so taking one out meant
+// finding whatever pointed at it by going through every edict. Now movewith_ent is the parent,
+// movewith_child its first child and movewith_next/movewith_prev the siblings, and attaching or
+// detaching only touches the neighbours. Every change has to go through Movewith_Attach and
+// Movewith_Detach.
+// G_RunEntity queues the top of the hierarchy of every parent that has run, and once everything has
+// moved Movewith_Update puts their children where they belong with set_child_movement. Parents whose
+// thinks change their velocity still call it themselves, so their children move with them that frame,
+// but children are only turned by their parent's angular velocity once a frame.
+
+#include "g_local.h"
+
+static edict_t	*movewith_queue[MAX_EDICTS];	// parents to update this frame
+static int		movewith_queued;
+static int		movewith_pass = 1;				// Movewith_Update count, never reset
+static int		movewith_queuedpass[MAX_EDICTS];	// pass a parent was queued for
+static int		movewith_updatedpass[MAX_EDICTS];	// pass a parent's children were last updated in
+static qboolean	movewith_updating;				// in Movewith_Update
+
+static struct
+{
+	int		passes;
+	int		updates;	// parents updated by Movewith_Update
+	int		early;		// by their own thinks, before moving
+	int		children;	// children moved
+} movewith_stats;
+
+static int Movewith_Index(const edict_t *ent)
+{
+	if (!g_edicts || ent < g_edicts || ent - g_edicts >= min(game.maxentities, MAX_EDICTS))
+		return -1;
+
+	return ent - g_edicts;
+}
+
+// Takes child out of its parent's list, leaving the rest of it alone
+static void Movewith_Unlink(edict_t *child)
+{
+	edict_t *parent = child->movewith_ent;
+	if (!parent)
+		return;
+
+	if (child->movewith_prev)
+		child->movewith_prev->movewith_next = child->movewith_next;
+	else if (parent->movewith_child == child)
+		parent->movewith_child = child->movewith_next;
+
+	if (child->movewith_next)
+		child->movewith_next->movewith_prev = child->movewith_prev;
+
+	child->movewith_ent = NULL;
+	child->movewith_next = NULL;
+	child->movewith_prev = NULL;
+}
+
+/*
+=================
+Movewith_Attach
+
+Makes child move with parent, after any children it already has. Does nothing if it already does.
+If parent is moving with child, child stays where it was, and loses its movewith key if that's nowhere.
+=================
+*/
+void Movewith_Attach(edict_t *child, edict_t *parent)
+{
+	if (child->movewith_ent == parent)
+		return;
+
+	// Not under one of its own children
+	for (edict_t *e = parent; e; e = e->movewith_ent)
+	{
+		if (e == child)
+		{
+			gi.dprintf("%s can't movewith %s, it's moving with it\n", child->classname, parent->classname);
+
+			// Code that sees a movewith key goes straight to movewith_ent
+			if (!child->movewith_ent)
+				child->movewith = NULL;
+
+			return;
+		}
+	}
+
+	Movewith_Unlink(child);
+
+	edict_t *last = parent->movewith_child;
+	while (last && last->movewith_next)
+		last = last->movewith_next;
+
+	if (last)
+		last->movewith_next = child;
+	else
+		parent->movewith_child = child;
+
+	child->movewith_prev = last;
+	child->movewith_ent = parent;
+}
+
+/*
+=================
+Movewith_Detach
+
+Stops child moving with its parent, movewith key and all. It keeps its own children.
+=================
+*/
+void Movewith_Detach(edict_t *child)
+{
+	Movewith_Unlink(child);
+	child->movewith = NULL;
+}
+
+/*
+=================
+Movewith_Free
+
+Detaches ent from its parent and its children from it. Called by G_FreeEdict.
+=================
+*/
+void Movewith_Free(edict_t *ent)
+{
+	Movewith_Detach(ent);
+
+	while (ent->movewith_child)
+		Movewith_Detach(ent->movewith_child);
+}
+
+/*
+=================
+Movewith_Updated
+
+Called by set_child_movement when it moves parent's children. Returns false if it already has this frame,
+in which case they've already been turned by parent's angular velocity.
+=================
+*/
+qboolean Movewith_Updated(edict_t *parent)
+{
+	for (edict_t *e = parent->movewith_child; e; e = e->movewith_next)
+		movewith_stats.children++;
+
+	if (movewith_updating)
+		movewith_stats.updates++;
+	else
+		movewith_stats.early++;
+
+	const int index = Movewith_Index(parent);
+	if (index < 0 || movewith_updatedpass[index] == movewith_pass)
+		return false;
+
+	movewith_updatedpass[index] = movewith_pass;
+	return true;
+}
+
+/*
+=================
+Movewith_Moved
+
+Queues the hierarchy ent is in for Movewith_Update. Called by G_RunEntity for entities with children.
+=================
+*/
+void Movewith_Moved(edict_t *ent)
+{
+	edict_t *root = ent;
+	while (root->movewith_ent)
+		root = root->movewith_ent;
+
+	const int index = Movewith_Index(root);
+	if (index < 0 || movewith_queuedpass[index] == movewith_pass)
+		return;
+
+	movewith_queuedpass[index] = movewith_pass;
+	movewith_queue[movewith_queued++] = root;
+}
+
+/*
+=================
+Movewith_Update
+
+Brings the children of every parent queued this frame along with it. Called by G_RunFrame once everything has run.
+=================
+*/
+void Movewith_Update(void)
+{
+	movewith_stats.passes++;
+
+	movewith_updating = true;
+
+	for (int i = 0; i < movewith_queued; i++)
+	{
+		edict_t *root = movewith_queue[i];
+		if (root->inuse)
+			set_child_movement(root);
+	}
+
+	movewith_updating = false;
+	movewith_queued = 0;
+	movewith_pass++;
+}
+
+void Movewith_Stats_f(void)
+{
+	int parents = 0, children = 0;
+
+	for (int i = 1; i < globals.num_edicts; i++)
+	{
+		const edict_t *ent = &g_edicts[i];
+		if (!ent->inuse)
+			continue;
+
+		if (ent->movewith_child)
+			parents++;
+
+		if (ent->movewith_ent)
+			children++;
+	}
+
+	safe_cprintf(NULL, PRINT_HIGH, "Movewith: %d entities moving with %d others\n", children, parents);
+
+	if (movewith_stats.passes)
+		safe_cprintf(NULL, PRINT_HIGH, "  %d frames, %.1f parents updated per frame, %.1f by their own thinks, %.1f children moved\n", movewith_stats.passes,
+			(float)movewith_stats.updates / movewith_stats.passes, (float)movewith_stats.early / movewith_stats.passes, (float)movewith_stats.children / movewith_stats.passes);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&movewith_stats, 0, sizeof(movewith_stats));
+}
@@ -52,7 +52,7 @@ void model_train_animator(edict_t *animator)
 		return;
 	}
 
-	animator->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(animator, level.time + FRAMETIME);
 	if (!VectorLengthSquared(train->velocity))
 		return;
 
@@ -79,7 +79,7 @@ void SP_model_train(edict_t *self)
 	// Reset some things from SP_model_spawn
 	self->delay = 0;
 	self->think = NULL;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 
 	if (self->health)
 	{
@@ -92,7 +92,7 @@ void SP_model_train(edict_t *self)
 		edict_t *animator = G_Spawn();
 		animator->owner = self;
 		animator->think = model_train_animator;
-		animator->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(animator, level.time + FRAMETIME);
 	}
 
 	self->s.frame = self->startframe;
@@ -147,12 +147,12 @@ void SP_model_train(edict_t *self)
 	if (self->target)
 	{
 		// start trains on the second frame, to make sure their targets have had a chance to spawn
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = func_train_find;
 	}
 	else if (self->spawnflags & TRAIN_ROTATE_CONSTANT) //mxd. Let's not require pathtargets when all we want is constant rotation... 
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = train_resume;
 	}
 	else
@@ -0,0 +1,800 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_nav.c -- navigation graph for walking monsters.
+// Nodes are the map's hint_paths and, in deathmatch, the ACE bot nodes. Hint chains are linked
+// both ways along their targets (branches and any number of chains are fine here), ACE links are
+// copied from path_table, and nodes that belong to different chains are linked when they are close
+// and can see each other.
+// When a monster can't see what it's going after, M_MoveToGoal walks it from node to node instead
+// of bumping into walls. Monsters after a player follow that player's flow field: the distance from
+// every node to the node nearest the player, computed once and shared by every monster chasing the
+// same player until the player reaches another node. Other goals get an A* path of their own.
+// The graph is built the first time a monster needs it and lives in TAG_LEVEL memory.
+
+#include "g_local.h"
+
+#define NAV_LINK_DIST		256		// nodes of different chains closer than this are linked if they can see each other
+#define NAV_LINK_HEIGHT		64		// ...and aren't further apart than this vertically
+#define NAV_MAX_CROSSLINKS	8		// per node
+#define NAV_MAX_CHAINLINKS	4		// hint_paths targeted by one hint_path
+#define NAV_NEAR_DIST		384		// furthest a monster or player can be from its nearest node
+#define NAV_NEAR_HEIGHT		128
+#define NAV_NEAR_TRACES		4		// visibility checks when looking for the nearest node
+#define NAV_REACHED_DIST	24		// waypoint reached, added to the monster's size
+#define NAV_CHECK_TIME		0.3		// how often a monster checks whether it can see its goal
+#define NAV_FIELD_TIME		0.5		// how often a flow field's target is looked up again
+#define NAV_RETRY_TIME		2.0		// wait before using the graph again after getting stuck
+#define NAV_MAX_FIELDS		8
+#define NAV_MAX_PATH		32
+#define NAV_UNREACHED		1e30f
+
+typedef struct
+{
+	vec3_t	origin;
+	int		firstlink, numlinks;	// into nav_links
+	int		firstback, numback;		// into nav_backlinks, links coming in
+	int		chain;					// connected hint chain, -1 for ACE nodes
+} navnode_t;
+
+typedef struct
+{
+	int		node;
+	float	cost;
+} navlink_t;
+
+typedef struct
+{
+	float	key;
+	int		node;
+} navheap_t;
+
+typedef struct
+{
+	edict_t	*target;
+	int		goal;		// node nearest the target when this was computed, -1 for none
+	float	findtime;	// when goal is looked up again
+	float	usetime;	// last use, the oldest field is the one replaced
+	float	*dist;		// per node, path length to goal
+	int		*next;		// per node, next node toward goal. -1 at the goal or if it can't be reached.
+} navfield_t;
+
+typedef struct
+{
+	float		time;			// last M_MoveToGoal that used this. Older state is thrown away.
+	int			node;			// waypoint being walked to, -1 for none
+	float		deadline;		// give up on node if it isn't reached by then
+	float		checktime;		// next goal visibility check
+	qboolean	goalvisible;
+	float		retrytime;		// don't use the graph before this
+	int			goalnode;		// A* goal
+	int			path[NAV_MAX_PATH];
+	int			pathlen, pathpos;
+} navmonster_t;
+
+static qboolean		nav_built;
+static navnode_t	*nav_nodes;
+static int			nav_numnodes;
+static int			nav_numhints;	// hint_paths come first, then ACE nodes
+static navlink_t	*nav_links;
+static navlink_t	*nav_backlinks;
+static int			nav_numlinks;
+static boxgrid_t	nav_grid;		// node boxes NAV_NEAR_DIST across, for nearest node lookups
+static navfield_t	nav_fields[NAV_MAX_FIELDS];
+static navmonster_t	*nav_monsters;	// by edict number
+
+// A* and Dijkstra scratch space
+static navheap_t	*nav_heap;
+static int			nav_heapsize;
+static float		*nav_cost;
+static int			*nav_parent;
+static int			*nav_search;	// nav_searchid when nav_cost and nav_parent are valid for the node
+static int			*nav_closed;	// nav_searchid once the node's links have been followed
+static int			nav_searchid;
+
+static struct
+{
+	int		fields;			// flow fields computed
+	int		fielduses;		// flow field lookups, shared between monsters
+	int		searches;		// A* searches
+	int		steps;			// moves toward a waypoint
+	int		waypoints;		// waypoints reached
+	int		stuck;
+	int		unreachable;
+} nav_stats;
+
+static void Nav_HeapPush(float key, int node)
+{
+	int i = nav_heapsize++;
+	while (i > 0)
+	{
+		const int parent = (i - 1) / 2;
+		if (nav_heap[parent].key <= key)
+			break;
+
+		nav_heap[i] = nav_heap[parent];
+		i = parent;
+	}
+
+	nav_heap[i].key = key;
+	nav_heap[i].node = node;
+}
+
+static navheap_t Nav_HeapPop(void)
+{
+	const navheap_t top = nav_heap[0];
+	const navheap_t last = nav_heap[--nav_heapsize];
+
+	int i = 0;
+	while (true)
+	{
+		int child = i * 2 + 1;
+		if (child >= nav_heapsize)
+			break;
+
+		if (child + 1 < nav_heapsize && nav_heap[child + 1].key < nav_heap[child].key)
+			child++;
+
+		if (last.key <= nav_heap[child].key)
+			break;
+
+		nav_heap[i] = nav_heap[child];
+		i = child;
+	}
+
+	if (nav_heapsize)
+		nav_heap[i] = last;
+
+	return top;
+}
+
+// Straight line between two points, not counting monsters and players
+static qboolean Nav_Visible(vec3_t start, vec3_t end, edict_t *ignore)
+{
+	if (CModel_Blocked(start, vec3_origin, vec3_origin, end, MASK_SOLID, NULL))
+		return false;
+
+	const trace_t tr = gi.trace(start, vec3_origin, vec3_origin, end, ignore, MASK_SOLID);
+	return (tr.fraction == 1.0f);
+}
+
+/*
+=================
+Nav_ClearGraph
+
+Forgets the graph (level change, the memory is in TAG_LEVEL)
+=================
+*/
+void Nav_ClearGraph(void)
+{
+	nav_built = false;
+	nav_nodes = NULL;
+	nav_numnodes = nav_numhints = nav_numlinks = 0;
+	nav_links = nav_backlinks = NULL;
+	nav_monsters = NULL;
+	nav_heap = NULL;
+	nav_cost = NULL;
+	nav_parent = NULL;
+	nav_search = NULL;
+	nav_closed = NULL;
+	memset(&nav_grid, 0, sizeof(nav_grid));
+	memset(nav_fields, 0, sizeof(nav_fields));
+}
+
+static int Nav_FindChain(int *chain, int i)
+{
+	while (chain[i] != i)
+		i = chain[i] = chain[chain[i]];
+
+	return i;
+}
+
+static void Nav_AddLink(int *from, int *to, int *count, int maxlinks, int a, int b)
+{
+	if (*count < maxlinks)
+	{
+		from[*count] = a;
+		to[*count] = b;
+		(*count)++;
+	}
+}
+
+// Builds the graph. Returns false if the map has no nodes.
+static qboolean Nav_Build(void)
+{
+	if (nav_built)
+		return (nav_numnodes > 0);
+
+	nav_built = true;
+
+	int numhints = 0;
+	for (edict_t *e = NULL; (e = G_Find(e, FOFS(classname), "hint_path")) != NULL; )
+		numhints++;
+
+	// ACE reserves node 0, so its nodes 1 to numnodes - 1 follow the hint_paths
+	const int numace = (deathmatch->value ? max(numnodes - 1, 0) : 0);
+	const int count = numhints + numace;
+	if (!count)
+		return false;
+
+	nav_numnodes = count;
+	nav_numhints = numhints;
+	nav_nodes = G_TagMalloc(count * sizeof(navnode_t), TAG_LEVEL, MEM_NAV);
+
+	// Scratch
+	int *nodeof = G_TagMalloc(game.maxentities * sizeof(int), TAG_LEVEL, MEM_NAV);
+	int *chain = G_TagMalloc(count * sizeof(int), TAG_LEVEL, MEM_NAV);
+	edict_t **hints = G_TagMalloc(max(numhints, 1) * sizeof(edict_t *), TAG_LEVEL, MEM_NAV);
+
+	int n = 0;
+	for (edict_t *e = NULL; (e = G_Find(e, FOFS(classname), "hint_path")) != NULL; n++)
+	{
+		hints[n] = e;
+		nodeof[e - g_edicts] = n;
+		VectorCopy(e->s.origin, nav_nodes[n].origin);
+	}
+
+	for (int i = 0; i < numace; i++)
+		VectorCopy(nodes[i + 1].origin, nav_nodes[numhints + i].origin);
+
+	int acelinks = 0;
+	for (int i = 1; i <= numace; i++)
+		for (int j = 1; j <= numace; j++)
+			if (i != j && path_table[i][j] == j)
+				acelinks++;
+
+	const int maxlinks = numhints * NAV_MAX_CHAINLINKS * 2 + acelinks + count * NAV_MAX_CROSSLINKS * 2;
+	int *from = G_TagMalloc(max(maxlinks, 1) * sizeof(int), TAG_LEVEL, MEM_NAV);
+	int *to = G_TagMalloc(max(maxlinks, 1) * sizeof(int), TAG_LEVEL, MEM_NAV);
+	int numlinks = 0;
+
+	// Hint chains, both ways. chain[] ends up as the connected chain for each hint_path.
+	for (int i = 0; i < count; i++)
+		chain[i] = i;
+
+	for (int i = 0; i < numhints; i++)
+	{
+		if (!hints[i]->target)
+			continue;
+
+		int targets = 0;
+		for (edict_t *e = NULL; targets < NAV_MAX_CHAINLINKS && (e = G_Find(e, FOFS(targetname), hints[i]->target)) != NULL; )
+		{
+			if (e == hints[i] || Q_stricmp(e->classname, "hint_path"))
+				continue;
+
+			const int j = nodeof[e - g_edicts];
+			Nav_AddLink(from, to, &numlinks, maxlinks, i, j);
+			Nav_AddLink(from, to, &numlinks, maxlinks, j, i);
+			chain[Nav_FindChain(chain, i)] = Nav_FindChain(chain, j);
+			targets++;
+		}
+	}
+
+	for (int i = 0; i < count; i++)
+		nav_nodes[i].chain = (i < numhints ? Nav_FindChain(chain, i) : -1);
+
+	// ACE links
+	for (int i = 1; i <= numace; i++)
+		for (int j = 1; j <= numace; j++)
+			if (i != j && path_table[i][j] == j)
+				Nav_AddLink(from, to, &numlinks, maxlinks, numhints + i - 1, numhints + j - 1);
+
+	// Nearest node grid
+	vec3_t *mins = G_TagMalloc(count * sizeof(vec3_t), TAG_LEVEL, MEM_NAV);
+	vec3_t *maxs = G_TagMalloc(count * sizeof(vec3_t), TAG_LEVEL, MEM_NAV);
+	for (int i = 0; i < count; i++)
+	{
+		const vec3_t size = { NAV_NEAR_DIST, NAV_NEAR_DIST, NAV_NEAR_HEIGHT };
+		VectorSubtract(nav_nodes[i].origin, size, mins[i]);
+		VectorAdd(nav_nodes[i].origin, size, maxs[i]);
+	}
+
+	BoxGrid_Build(&nav_grid, count, mins, maxs, TAG_LEVEL);
+	gi.TagFree(mins);
+	gi.TagFree(maxs);
+
+	// Cross links between chains, and between hint_paths and ACE nodes. Every node within
+	// NAV_LINK_DIST of node i has a box covering it, so is filed in its cell.
+	int *crosslinks = G_TagMalloc(count * sizeof(int), TAG_LEVEL, MEM_NAV);
+
+	for (int i = 0; i < count; i++)
+	{
+		int *list;
+		const int num = BoxGrid_Query(&nav_grid, nav_nodes[i].origin, &list);
+
+		for (int k = 0; k < num && crosslinks[i] < NAV_MAX_CROSSLINKS; k++)
+		{
+			const int j = list[k];
+			if (j <= i || crosslinks[j] >= NAV_MAX_CROSSLINKS)
+				continue;
+
+			if (nav_nodes[i].chain == nav_nodes[j].chain)
+				continue; // Same hint chain, or both ACE nodes
+
+			vec3_t v;
+			VectorSubtract(nav_nodes[j].origin, nav_nodes[i].origin, v);
+			if (fabsf(v[2]) > NAV_LINK_HEIGHT || VectorLength(v) > NAV_LINK_DIST)
+				continue;
+
+			if (!Nav_Visible(nav_nodes[i].origin, nav_nodes[j].origin, NULL))
+				continue;
+
+			Nav_AddLink(from, to, &numlinks, maxlinks, i, j);
+			Nav_AddLink(from, to, &numlinks, maxlinks, j, i);
+			crosslinks[i]++;
+			crosslinks[j]++;
+		}
+	}
+
+	// Outgoing and incoming link lists
+	nav_numlinks = numlinks;
+	nav_links = G_TagMalloc(max(numlinks, 1) * sizeof(navlink_t), TAG_LEVEL, MEM_NAV);
+	nav_backlinks = G_TagMalloc(max(numlinks, 1) * sizeof(navlink_t), TAG_LEVEL, MEM_NAV);
+
+	for (int i = 0; i < numlinks; i++)
+	{
+		nav_nodes[from[i]].numlinks++;
+		nav_nodes[to[i]].numback++;
+	}
+
+	int firstlink = 0, firstback = 0;
+	for (int i = 0; i < count; i++)
+	{
+		nav_nodes[i].firstlink = firstlink;
+		nav_nodes[i].firstback = firstback;
+		firstlink += nav_nodes[i].numlinks;
+		firstback += nav_nodes[i].numback;
+		nav_nodes[i].numlinks = nav_nodes[i].numback = 0;
+	}
+
+	for (int i = 0; i < numlinks; i++)
+	{
+		navnode_t *a = &nav_nodes[from[i]];
+		navnode_t *b = &nav_nodes[to[i]];
+
+		vec3_t v;
+		VectorSubtract(b->origin, a->origin, v);
+		const float cost = VectorLength(v);
+
+		navlink_t *out = &nav_links[a->firstlink + a->numlinks++];
+		out->node = to[i];
+		out->cost = cost;
+
+		navlink_t *in = &nav_backlinks[b->firstback + b->numback++];
+		in->node = from[i];
+		in->cost = cost;
+	}
+
+	gi.TagFree(from);
+	gi.TagFree(to);
+	gi.TagFree(chain);
+	gi.TagFree(crosslinks);
+	gi.TagFree(hints);
+	gi.TagFree(nodeof);
+
+	// Searches push a node at most once per link, plus the start
+	nav_heap = G_TagMalloc((numlinks + 1) * sizeof(navheap_t), TAG_LEVEL, MEM_NAV);
+	nav_cost = G_TagMalloc(count * sizeof(float), TAG_LEVEL, MEM_NAV);
+	nav_parent = G_TagMalloc(count * sizeof(int), TAG_LEVEL, MEM_NAV);
+	nav_search = G_TagMalloc(count * sizeof(int), TAG_LEVEL, MEM_NAV);
+	nav_closed = G_TagMalloc(count * sizeof(int), TAG_LEVEL, MEM_NAV);
+	nav_searchid = 0;
+
+	for (int i = 0; i < NAV_MAX_FIELDS; i++)
+	{
+		nav_fields[i].dist = G_TagMalloc(count * sizeof(float), TAG_LEVEL, MEM_NAV);
+		nav_fields[i].next = G_TagMalloc(count * sizeof(int), TAG_LEVEL, MEM_NAV);
+		nav_fields[i].goal = -1;
+	}
+
+	nav_monsters = G_TagMalloc(game.maxentities * sizeof(navmonster_t), TAG_LEVEL, MEM_NAV);
+
+	if (developer && developer->value)
+		gi.dprintf("Navigation graph: %d hint_paths, %d ACE nodes, %d links\n", numhints, numace, numlinks);
+
+	return true;
+}
+
+// Closest node that can be seen from point, -1 if there's none
+static int Nav_NearestNode(vec3_t point, edict_t *ignore)
+{
+	int		best[NAV_NEAR_TRACES];
+	float	bestdist[NAV_NEAR_TRACES];
+	int		numbest = 0;
+	int		*list;
+
+	const int num = BoxGrid_Query(&nav_grid, point, &list);
+	for (int k = 0; k < num; k++)
+	{
+		const navnode_t *node = &nav_nodes[list[k]];
+
+		vec3_t v;
+		VectorSubtract(node->origin, point, v);
+		if (fabsf(v[2]) > NAV_NEAR_HEIGHT)
+			continue;
+
+		const float dist = VectorLength(v);
+		if (dist > NAV_NEAR_DIST)
+			continue;
+
+		// Keep the closest few, nearest first
+		if (numbest == NAV_NEAR_TRACES && bestdist[numbest - 1] <= dist)
+			continue;
+
+		int n = min(numbest, NAV_NEAR_TRACES - 1);
+
+		while (n > 0 && bestdist[n - 1] > dist)
+		{
+			best[n] = best[n - 1];
+			bestdist[n] = bestdist[n - 1];
+			n--;
+		}
+
+		best[n] = list[k];
+		bestdist[n] = dist;
+		numbest = min(numbest + 1, NAV_NEAR_TRACES);
+	}
+
+	for (int i = 0; i < numbest; i++)
+		if (Nav_Visible(point, nav_nodes[best[i]].origin, ignore))
+			return best[i];
+
+	return -1;
+}
+
+// Dijkstra back from goal along incoming links
+static void Nav_ComputeField(navfield_t *field, int goal)
+{
+	for (int i = 0; i < nav_numnodes; i++)
+	{
+		field->dist[i] = NAV_UNREACHED;
+		field->next[i] = -1;
+	}
+
+	field->goal = goal;
+	field->dist[goal] = 0;
+	nav_heapsize = 0;
+	Nav_HeapPush(0, goal);
+
+	while (nav_heapsize)
+	{
+		const navheap_t top = Nav_HeapPop();
+		if (top.key > field->dist[top.node])
+			continue; // Already done by a shorter way
+
+		const navnode_t *node = &nav_nodes[top.node];
+		for (int i = 0; i < node->numback; i++)
+		{
+			const navlink_t *link = &nav_backlinks[node->firstback + i];
+			const float dist = top.key + link->cost;
+
+			if (dist < field->dist[link->node])
+			{
+				field->dist[link->node] = dist;
+				field->next[link->node] = top.node;
+				Nav_HeapPush(dist, link->node);
+			}
+		}
+	}
+
+	nav_stats.fields++;
+}
+
+// Flow field toward target, shared by every monster after it. NULL if target isn't near the graph.
+static navfield_t *Nav_Field(edict_t *target)
+{
+	navfield_t *field = NULL;
+	navfield_t *oldest = &nav_fields[0];
+
+	for (int i = 0; i < NAV_MAX_FIELDS; i++)
+	{
+		if (nav_fields[i].target == target)
+		{
+			field = &nav_fields[i];
+			break;
+		}
+
+		if (nav_fields[i].usetime < oldest->usetime)
+			oldest = &nav_fields[i];
+	}
+
+	if (!field)
+	{
+		field = oldest;
+		field->target = target;
+		field->goal = -1;
+		field->findtime = 0;
+	}
+
+	field->usetime = level.time;
+	nav_stats.fielduses++;
+
+	if (level.time >= field->findtime)
+	{
+		field->findtime = level.time + NAV_FIELD_TIME;
+
+		// Between nodes the old field still leads to where the target was
+		const int goal = Nav_NearestNode(target->s.origin, target);
+		if (goal >= 0 && goal != field->goal)
+			Nav_ComputeField(field, goal);
+	}
+
+	return (field->goal >= 0 ? field : NULL);
+}
+
+// A* from start to goal. Fills in the first NAV_MAX_PATH nodes of the path.
+static qboolean Nav_FindPath(navmonster_t *m, int start, int goal)
+{
+	nav_stats.searches++;
+
+	if (++nav_searchid <= 0)
+	{
+		memset(nav_search, 0, nav_numnodes * sizeof(int));
+		memset(nav_closed, 0, nav_numnodes * sizeof(int));
+		nav_searchid = 1;
+	}
+
+	nav_search[start] = nav_searchid;
+	nav_cost[start] = 0;
+	nav_parent[start] = -1;
+	nav_heapsize = 0;
+	Nav_HeapPush(0, start);
+
+	qboolean found = false;
+	while (nav_heapsize)
+	{
+		const int n = Nav_HeapPop().node;
+		if (n == goal)
+		{
+			found = true;
+			break;
+		}
+
+		// The heuristic is a straight line, so the first time a node comes off the heap is the shortest way to it
+		if (nav_closed[n] == nav_searchid)
+			continue;
+
+		nav_closed[n] = nav_searchid;
+
+		const navnode_t *node = &nav_nodes[n];
+		for (int i = 0; i < node->numlinks; i++)
+		{
+			const navlink_t *link = &nav_links[node->firstlink + i];
+			const float cost = nav_cost[n] + link->cost;
+
+			if (nav_closed[link->node] == nav_searchid)
+				continue;
+
+			if (nav_search[link->node] == nav_searchid && nav_cost[link->node] <= cost)
+				continue;
+
+			nav_search[link->node] = nav_searchid;
+			nav_cost[link->node] = cost;
+			nav_parent[link->node] = n;
+
+			vec3_t v;
+			VectorSubtract(nav_nodes[goal].origin, nav_nodes[link->node].origin, v);
+			Nav_HeapPush(cost + VectorLength(v), link->node);
+		}
+	}
+
+	if (!found)
+		return false;
+
+	// Walk back from the goal, keeping the start end of the path
+	int len = 0;
+	for (int n = goal; n >= 0; n = nav_parent[n])
+		len++;
+
+	m->pathlen = min(len, NAV_MAX_PATH);
+	m->pathpos = 0;
+	m->goalnode = goal;
+
+	int i = len;
+	for (int n = goal; n >= 0; n = nav_parent[n])
+		if (--i < NAV_MAX_PATH)
+			m->path[i] = n;
+
+	return true;
+}
+
+static void Nav_SetWaypoint(edict_t *ent, navmonster_t *m, int node, float dist)
+{
+	m->node = node;
+	if (node < 0)
+		return;
+
+	// Generous, a monster that's making progress shouldn't give up
+	vec3_t v;
+	VectorSubtract(nav_nodes[node].origin, ent->s.origin, v);
+	m->deadline = level.time + 1 + VectorLength(v) / max(dist * 10, 20);
+}
+
+static qboolean Nav_Reached(edict_t *ent, int node)
+{
+	vec3_t v;
+	VectorSubtract(nav_nodes[node].origin, ent->s.origin, v);
+	if (fabsf(v[2]) > NAV_NEAR_HEIGHT / 2)
+		return false;
+
+	v[2] = 0;
+	return (VectorLength(v) < ent->maxs[0] + NAV_REACHED_DIST);
+}
+
+// Node after the one just reached, -1 if there's nowhere further to go
+static int Nav_NextNode(navmonster_t *m, navfield_t *field, int node)
+{
+	if (field)
+		return field->next[node];
+
+	if (++m->pathpos < m->pathlen)
+		return m->path[m->pathpos];
+
+	// Only the first part of a long path is kept
+	if (node != m->goalnode && Nav_FindPath(m, node, m->goalnode) && m->pathlen > 1)
+	{
+		m->pathpos = 1;
+		return m->path[1];
+	}
+
+	return -1;
+}
+
+/*
+=================
+Nav_ChaseYaw
+
+Called by M_MoveToGoal. If ent can't see goal and the graph knows a way there, sets *yaw to the
+direction of the next waypoint and returns true. dist is how far ent moves this frame.
+=================
+*/
+qboolean Nav_ChaseYaw(edict_t *ent, edict_t *goal, float dist, float *yaw)
+{
+	if (!sv_monsternav || !sv_monsternav->value || !goal || !goal->inuse)
+		return false;
+
+	// Flying and swimming monsters don't follow floor nodes
+	if (ent->flags & (FL_FLY | FL_SWIM))
+		return false;
+
+	if (!Nav_Build())
+		return false;
+
+	navmonster_t *m = &nav_monsters[ent - g_edicts];
+	if (!m->time || m->time < level.time - 1)
+	{
+		// New monster in this slot, or it's been doing something else
+		memset(m, 0, sizeof(*m));
+		m->node = -1;
+		m->goalnode = -1;
+	}
+
+	m->time = level.time;
+
+	if (level.time < m->retrytime)
+		return false;
+
+	// Straight at the goal while it's in sight
+	if (level.time >= m->checktime)
+	{
+		m->checktime = level.time + NAV_CHECK_TIME;
+		m->goalvisible = Nav_Visible(ent->s.origin, goal->s.origin, ent);
+	}
+
+	if (m->goalvisible)
+	{
+		m->node = -1;
+		return false;
+	}
+
+	// Going after a player, directly or to where it was last seen: use the player's flow field
+	edict_t *target = NULL;
+	if (goal->client)
+		target = goal;
+	else if (ent->enemy && ent->enemy->inuse && ent->enemy->client && (ent->monsterinfo.aiflags & AI_LOST_SIGHT)
+			 && !(ent->monsterinfo.aiflags & (AI_COMBAT_POINT | AI_CHASE_THING | AI_HINT_TEST)))
+		target = ent->enemy;
+
+	navfield_t *field = NULL;
+	if (target)
+	{
+		field = Nav_Field(target);
+		if (!field)
+		{
+			m->retrytime = level.time + NAV_CHECK_TIME;
+			return false;
+		}
+	}
+
+	if (m->node >= 0 && level.time > m->deadline)
+	{
+		nav_stats.stuck++;
+		m->node = -1;
+		m->retrytime = level.time + NAV_RETRY_TIME;
+		return false;
+	}
+
+	if (m->node >= 0 && Nav_Reached(ent, m->node))
+	{
+		nav_stats.waypoints++;
+		Nav_SetWaypoint(ent, m, Nav_NextNode(m, field, m->node), dist);
+
+		if (m->node < 0)
+		{
+			// At the goal's node and still can't see it
+			m->retrytime = level.time + NAV_CHECK_TIME;
+			return false;
+		}
+	}
+
+	if (m->node < 0)
+	{
+		const int start = Nav_NearestNode(ent->s.origin, ent);
+		if (start < 0)
+		{
+			m->retrytime = level.time + NAV_CHECK_TIME;
+			return false;
+		}
+
+		if (field)
+		{
+			if (start != field->goal && field->next[start] < 0)
+			{
+				nav_stats.unreachable++;
+				m->retrytime = level.time + NAV_RETRY_TIME;
+				return false;
+			}
+		}
+		else
+		{
+			const int goalnode = Nav_NearestNode(goal->s.origin, goal);
+			if (goalnode < 0 || !Nav_FindPath(m, start, goalnode))
+			{
+				nav_stats.unreachable++;
+				m->retrytime = level.time + NAV_RETRY_TIME;
+				return false;
+			}
+		}
+
+		Nav_SetWaypoint(ent, m, start, dist);
+	}
+
+	vec3_t v;
+	VectorSubtract(nav_nodes[m->node].origin, ent->s.origin, v);
+	*yaw = vectoyaw(v);
+	nav_stats.steps++;
+
+	return true;
+}
+
+void Nav_Stats_f(void)
+{
+	Nav_Build();
+
+	safe_cprintf(NULL, PRINT_HIGH, "Navigation graph: %d nodes (%d hint_paths), %d links\n", nav_numnodes, nav_numhints, nav_numlinks);
+	safe_cprintf(NULL, PRINT_HIGH, "  flow fields: %d computed, %d lookups\n", nav_stats.fields, nav_stats.fielduses);
+	safe_cprintf(NULL, PRINT_HIGH, "  A* searches: %d\n", nav_stats.searches);
+	safe_cprintf(NULL, PRINT_HIGH, "  graph moves: %d, %d waypoints reached, %d stuck, %d unreachable\n", nav_stats.steps, nav_stats.waypoints, nav_stats.stuck, nav_stats.unreachable);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&nav_stats, 0, sizeof(nav_stats));
+}
@@ -52,14 +52,10 @@ int PatchPlayerModels(char *modelname)
 	if (!*game->string)
 		return 0;	// we're in baseq2
 
-	Com_sprintf(outfilename, sizeof(outfilename), "%s/players/%s/tris.md2", game->string, modelname);
-	FILE *outfile = fopen(outfilename, "rb");
-	if (outfile)
-	{
-		// output file already exists, move along
-		fclose(outfile);
+	// output file already exists, move along
+	Com_sprintf(infilename, sizeof(infilename), "players/%s/tris.md2", modelname);
+	if (FS_FindFile("", game->string, infilename, FS_LOOSE))
 		return 0;
-	}
 
 	// clear skin names (just in case)
 	for (int j = 0; j < MAX_MD2SKINS; j++)
@@ -117,6 +113,9 @@ int PatchPlayerModels(char *modelname)
 	numskins = 32;
 
 	// load original player model
+	if (!FS_FindFile("", "baseq2", infilename, FS_LOOSE))
+		return 0; // no player model (this shouldn't happen)
+
 	Com_sprintf(infilename, sizeof(infilename), "baseq2/players/%s/tris.md2", modelname);
 	FILE *infile = fopen(infilename, "rb");
 	if (!infile)
@@ -152,7 +151,7 @@ int PatchPlayerModels(char *modelname)
 	_mkdir(outfilename);
 	Com_sprintf(outfilename, sizeof(outfilename), "%s/players/%s/tris.md2", game->string, modelname);
 	
-	outfile = fopen(outfilename, "wb");
+	FILE *outfile = fopen(outfilename, "wb");
 	if (!outfile)
 	{
 		// file couldn't be created for some other reason
@@ -167,6 +166,7 @@ int PatchPlayerModels(char *modelname)
 	fwrite(data, sizeof(byte), datasize, outfile);
 	
 	fclose(outfile);
+	FS_AddFile("", game->string, va("players/%s/tris.md2", modelname));
 	gi.dprintf("PatchPlayerModels: Saved %s\n", outfilename);
 	free(data);
 
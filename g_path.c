@@ -0,0 +1,411 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_path.c -- compiled path_track graph and spline tables.
+// path_track target/target2 links and the "which path_tracks lead here" lists are
+// resolved once per level instead of on every func_tracktrain decision. The graph
+// is recompiled when a path_track's target strings change (path_track_use swaps them)
+// or path entities are spawned or removed.
+// Spline trains get a Bezier segment table per path_corner: control points plus
+// cumulative arc length, so position lookups are a binary search and travel speed
+// is constant along the curve.
+
+#include "g_local.h"
+
+#define SPLINE_STEPS	32
+
+typedef struct
+{
+	edict_t		*ent;
+	char		*targetname;	// strings the links were resolved from
+	char		*target;
+	char		*target2;
+	edict_t		*next;			// only set when the target is unique, otherwise G_PickTarget decides
+	edict_t		*next2;
+	int			firstprev;		// path_tracks targeting this one, in edict order
+	int			numprev;
+} pathnode_t;
+
+typedef struct
+{
+	edict_t		*to;
+	vec3_t		p1, p2, a1, a2;	// what the table was built from
+	vec3_t		c1, c2;			// Bezier control points
+	float		s;				// control point offset, scales the derivative
+	float		length[SPLINE_STEPS + 1];	// arc length from p1 at m = i / SPLINE_STEPS
+} pathspline_t;
+
+static pathnode_t	*path_nodes;
+static int			path_numnodes;
+static int			*path_nodeindex;	// game.maxentities, -1 for non-path entities
+static edict_t		**path_prevs;
+static qboolean		path_compiled;
+static int			path_checkframe = -1;
+
+static pathspline_t	**path_splines;		// game.maxentities, allocated on demand
+
+static qboolean Path_IsTrack(edict_t *ent)
+{
+	return (ent->inuse && ent->classname && !Q_stricmp(ent->classname, "path_track"));
+}
+
+// Returns the only entity called targetname, or NULL if there are none or several
+static edict_t *Path_UniqueTarget(char *targetname)
+{
+	if (!targetname)
+		return NULL;
+
+	edict_t *ent = G_Find(NULL, FOFS(targetname), targetname);
+	if (ent && G_Find(ent, FOFS(targetname), targetname))
+		return NULL;
+
+	return ent;
+}
+
+static void Path_Compile(void)
+{
+	if (!path_nodeindex)
+		path_nodeindex = G_TagMalloc(game.maxentities * sizeof(int), TAG_LEVEL, MEM_PATH);
+
+	if (path_nodes)
+		gi.TagFree(path_nodes);
+	if (path_prevs)
+		gi.TagFree(path_prevs);
+
+	path_nodes = NULL;
+	path_prevs = NULL;
+	path_numnodes = 0;
+
+	for (int i = 0; i < game.maxentities; i++)
+		path_nodeindex[i] = -1;
+
+	for (int i = 1; i < globals.num_edicts; i++)
+		if (Path_IsTrack(&g_edicts[i]))
+			path_numnodes++;
+
+	path_compiled = true;
+	path_checkframe = level.framenum;
+
+	if (!path_numnodes)
+		return;
+
+	path_nodes = G_TagMalloc(path_numnodes * sizeof(pathnode_t), TAG_LEVEL, MEM_PATH);
+
+	int n = 0;
+	for (int i = 1; i < globals.num_edicts; i++)
+	{
+		edict_t *e = &g_edicts[i];
+		if (!Path_IsTrack(e))
+			continue;
+
+		pathnode_t *node = &path_nodes[n];
+		node->ent = e;
+		node->targetname = e->targetname;
+		node->target = e->target;
+		node->target2 = e->target2;
+		node->next = Path_UniqueTarget(e->target);
+		node->next2 = Path_UniqueTarget(e->target2);
+		path_nodeindex[i] = n++;
+	}
+
+	// Count, then fill predecessor lists. Each path_track is listed at most once per target.
+	int numprevs = 0;
+	for (int i = 0; i < path_numnodes; i++)
+	{
+		pathnode_t *node = &path_nodes[i];
+		node->firstprev = numprevs;
+
+		for (int k = 0; k < path_numnodes; k++)
+		{
+			const edict_t *e = path_nodes[k].ent;
+			if (k == i || !node->targetname)
+				continue;
+
+			if ((e->target && !Q_stricmp(e->target, node->targetname)) || (e->target2 && !Q_stricmp(e->target2, node->targetname)))
+				node->numprev++;
+		}
+
+		numprevs += node->numprev;
+	}
+
+	if (!numprevs)
+		return;
+
+	path_prevs = G_TagMalloc(numprevs * sizeof(edict_t *), TAG_LEVEL, MEM_PATH);
+
+	for (int i = 0; i < path_numnodes; i++)
+	{
+		pathnode_t *node = &path_nodes[i];
+		edict_t **prev = &path_prevs[node->firstprev];
+
+		for (int k = 0; k < path_numnodes; k++)
+		{
+			edict_t *e = path_nodes[k].ent;
+			if (k == i || !node->targetname)
+				continue;
+
+			if ((e->target && !Q_stricmp(e->target, node->targetname)) || (e->target2 && !Q_stricmp(e->target2, node->targetname)))
+				*prev++ = e;
+		}
+	}
+}
+
+// Recompiles the graph if any path_track changed its links or went away. Checked once per frame.
+static void Path_Validate(void)
+{
+	if (!path_compiled)
+	{
+		Path_Compile();
+		return;
+	}
+
+	if (path_checkframe == level.framenum)
+		return;
+
+	path_checkframe = level.framenum;
+
+	for (int i = 0; i < path_numnodes; i++)
+	{
+		const pathnode_t *node = &path_nodes[i];
+		const edict_t *e = node->ent;
+
+		if (!Path_IsTrack(node->ent) || e->targetname != node->targetname || e->target != node->target || e->target2 != node->target2)
+		{
+			Path_Compile();
+			return;
+		}
+	}
+}
+
+static pathnode_t *Path_Node(edict_t *path)
+{
+	Path_Validate();
+
+	const int index = path - g_edicts;
+	if (index < 0 || index >= game.maxentities || path_nodeindex[index] < 0)
+		return NULL;
+
+	pathnode_t *node = &path_nodes[path_nodeindex[index]];
+
+	// Catch changes made since this frame's check
+	if (node->ent != path || path->target != node->target || path->target2 != node->target2 || path->targetname != node->targetname)
+	{
+		Path_Compile();
+		if (path_nodeindex[index] < 0)
+			return NULL;
+
+		node = &path_nodes[path_nodeindex[index]];
+	}
+
+	return node;
+}
+
+/*
+=================
+Path_Invalidate
+
+Call when path_tracks are spawned at run time
+=================
+*/
+void Path_Invalidate(void)
+{
+	path_compiled = false;
+}
+
+/*
+=================
+Path_ClearGraph
+
+Forgets the graph and spline tables. They live in TAG_LEVEL memory.
+=================
+*/
+void Path_ClearGraph(void)
+{
+	path_nodes = NULL;
+	path_numnodes = 0;
+	path_nodeindex = NULL;
+	path_prevs = NULL;
+	path_compiled = false;
+	path_checkframe = -1;
+	path_splines = NULL;
+}
+
+/*
+=================
+Path_Target
+
+Same as G_PickTarget(path->target) (or target2 when alt is set), without searching
+the edict list when the target is unique.
+=================
+*/
+edict_t *Path_Target(edict_t *path, qboolean alt)
+{
+	char *target = (alt ? path->target2 : path->target);
+	const pathnode_t *node = Path_Node(path);
+
+	if (node)
+	{
+		edict_t *next = (alt ? node->next2 : node->next);
+		if (next && next->inuse && next->targetname && !Q_stricmp(next->targetname, target))
+			return next;
+	}
+
+	return G_PickTarget(target);
+}
+
+/*
+=================
+Path_Previous
+
+Returns the number of path_tracks that target (or target2) path, and the list of them in edict order
+=================
+*/
+int Path_Previous(edict_t *path, edict_t ***list)
+{
+	const pathnode_t *node = Path_Node(path);
+	if (!node || !node->numprev)
+	{
+		*list = NULL;
+		return 0;
+	}
+
+	*list = &path_prevs[node->firstprev];
+	return node->numprev;
+}
+
+static void Path_BuildSpline(pathspline_t *sp, edict_t *from, edict_t *to)
+{
+	vec3_t v1, v2, d, p, last;
+
+	sp->to = to;
+	VectorCopy(from->s.origin, sp->p1);
+	VectorCopy(to->s.origin, sp->p2);
+	VectorCopy(from->s.angles, sp->a1);
+	VectorCopy(to->s.angles, sp->a2);
+
+	// Same control points as spline_calc
+	AngleVectors(sp->a1, v1, NULL, NULL);
+	AngleVectors(sp->a2, v2, NULL, NULL);
+
+	VectorSubtract(sp->p2, sp->p1, d);
+	sp->s = VectorLength(d) * 0.4f;
+
+	VectorMA(sp->p1,  sp->s, v1, sp->c1);
+	VectorMA(sp->p2, -sp->s, v2, sp->c2);
+
+	sp->length[0] = 0;
+	VectorCopy(sp->p1, last);
+
+	for (int i = 1; i <= SPLINE_STEPS; i++)
+	{
+		const float m = (float)i / SPLINE_STEPS;
+		const float n = 1.0f - m;
+
+		for (int k = 0; k < 3; k++)
+			p[k] = n * n * n * sp->p1[k] + 3 * m * n * n * sp->c1[k] + 3 * m * m * n * sp->c2[k] + m * m * m * sp->p2[k];
+
+		VectorSubtract(p, last, d);
+		sp->length[i] = sp->length[i - 1] + VectorLength(d);
+		VectorCopy(p, last);
+	}
+}
+
+// Returns the spline table for from -> to, building it if needed
+static pathspline_t *Path_Spline(edict_t *from, edict_t *to)
+{
+	const int index = from - g_edicts;
+	if (index < 0 || index >= game.maxentities)
+		return NULL;
+
+	if (!path_splines)
+		path_splines = G_TagMalloc(game.maxentities * sizeof(pathspline_t *), TAG_LEVEL, MEM_PATH);
+
+	pathspline_t *sp = path_splines[index];
+	if (!sp)
+	{
+		sp = G_TagMalloc(sizeof(pathspline_t), TAG_LEVEL, MEM_PATH);
+		path_splines[index] = sp;
+	}
+	else if (sp->to == to && VectorCompare(sp->p1, from->s.origin) && VectorCompare(sp->p2, to->s.origin)
+		&& VectorCompare(sp->a1, from->s.angles) && VectorCompare(sp->a2, to->s.angles))
+	{
+		return sp;
+	}
+
+	Path_BuildSpline(sp, from, to);
+	return sp;
+}
+
+/*
+=================
+Path_SplinePoint
+
+Position p and angles a at fraction frac of the curve's length. Same curve as
+spline_calc, but parameterized by distance travelled.
+=================
+*/
+void Path_SplinePoint(edict_t *train, edict_t *from, edict_t *to, float frac, vec3_t p, vec3_t a)
+{
+	vec3_t v;
+
+	const pathspline_t *sp = Path_Spline(from, to);
+	if (!sp || sp->length[SPLINE_STEPS] <= 0)
+	{
+		spline_calc(train, from->s.origin, to->s.origin, from->s.angles, to->s.angles, frac, p, a);
+		return;
+	}
+
+	// Find the table step that contains this distance
+	const float dist = sp->length[SPLINE_STEPS] * frac;
+	int lo = 0;
+	int hi = SPLINE_STEPS;
+
+	while (hi - lo > 1)
+	{
+		const int mid = (lo + hi) / 2;
+		if (sp->length[mid] < dist)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	const float steplen = sp->length[hi] - sp->length[lo];
+	const float t = (steplen > 0 ? (dist - sp->length[lo]) / steplen : 0);
+	const float m = (lo + t) / SPLINE_STEPS;
+
+	const float n     = 1.0f - m;
+	const float m2    = m * m;
+	const float n2    = n * n;
+	const float mn2_3 = m * n2 * 3;
+	const float m2n_3 = m2 * n * 3;
+	const float mn_2  = m * n * 2;
+
+	for (int k = 0; k < 3; k++)
+	{
+		p[k] = n2 * n * sp->p1[k] + mn2_3 * sp->c1[k] + m2n_3 * sp->c2[k] + m2 * m * sp->p2[k];
+		v[k] = (n2 * sp->p1[k] - (n2 - mn_2) * sp->c1[k] - (mn_2 - m2) * sp->c2[k] - m2 * sp->p2[k]) / -sp->s;
+	}
+
+	vectoangles2(v, a);
+
+	if (train->roll_speed > 0)	// Knightmare added
+		a[ROLL] = sp->a1[ROLL] + m * (sp->a2[ROLL] - sp->a1[ROLL]);
+}
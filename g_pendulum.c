@@ -375,7 +375,7 @@ void pendulum_rotate(edict_t *self)
 			}
 		}
 
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
@@ -396,7 +396,7 @@ void pendulum_rotate(edict_t *self)
 			{
 				self->spawnflags &= ~SF_PENDULUM_STARTON;
 				VectorClear(self->avelocity);
-				self->nextthink = 0;
+				G_SetNextThink(self, 0);
 				gi.linkentity(self);
 
 				return;
@@ -404,7 +404,7 @@ void pendulum_rotate(edict_t *self)
 		}
 
 		self->s.angles[ROLL] = this_angle;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 
 	gi.linkentity(self);
@@ -435,7 +435,7 @@ void pendulum_use(edict_t *self, edict_t *other, edict_t *activator)
 		{
 			float delay = self->delay * M_PI2 * sqrtf(self->radius / (float)sv_gravity->value);
 			delay = 0.1 * (int)(10 * delay);
-			self->nextthink  = level.time + delay;
+			G_SetNextThink(self, level.time + delay);
 			self->startframe = level.framenum + delay * 10;
 
 			if (!(self->spawnflags & SF_PENDULUM_STOP_AT_TOP))
@@ -601,7 +601,7 @@ void SP_func_pendulum(edict_t *ent)
 	if (ent->spawnflags & SF_PENDULUM_STARTON)
 	{
 		ent->think = pendulum_rotate;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 	else
 	{
@@ -167,7 +167,7 @@ qboolean SV_RunThink(edict_t *ent)
 	if (ent->nextthink <= 0 || ent->nextthink > level.time + 0.001)
 		return true;
 	
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 
 	if (!ent->think)
 		gi.error("NULL ent->think for %s", ent->classname);
@@ -345,7 +345,7 @@ retry:
 
 			if (hit->solid == SOLID_BSP)
 			{
-				ent->groundentity = hit;
+				G_SetGroundEntity(ent, hit);
 				ent->groundentity_linkcount = hit->linkcount;
 			}
 		}
@@ -545,7 +545,7 @@ retry:
 
 				if (hit->solid == SOLID_BSP)
 				{
-					ent->groundentity = hit;
+					G_SetGroundEntity(ent, hit);
 					ent->groundentity_linkcount = hit->linkcount;
 				}
 			}
@@ -589,7 +589,7 @@ retry:
 				// stop small oscillations
 				if (new_velocity[2] < 60)
 				{
-					ent->groundentity = trace.ent;
+					G_SetGroundEntity(ent, trace.ent);
 					ent->groundentity_linkcount = trace.ent->linkcount;
 					VectorCopy(vec3_origin, new_velocity);
 				}
@@ -700,6 +700,19 @@ trace_t SV_PushEntity(edict_t *ent, const vec3_t push)
 
 	while (true)
 	{
+		// Nothing in the way, don't bother the engine (see g_solid.c)
+		qboolean triggers;
+		if (Solid_FreeMove(ent, start, end, mask, &triggers))
+		{
+			VectorCopy(end, ent->s.origin);
+			gi.linkentity(ent);
+
+			if (triggers && ent->inuse)
+				G_TouchTriggers(ent);
+
+			return Solid_FreeTrace(end);
+		}
+
 		trace_t trace = gi.trace(start, ent->mins, ent->maxs, end, ent, mask);
 
 		if (trace.startsolid || trace.allsolid) // Harven fix
@@ -766,16 +779,54 @@ typedef struct
 	float	deltayaw;
 } pushed_t;
 
-pushed_t pushed[MAX_EDICTS], *pushed_p;
+pushed_t *pushed, *pushed_p;
+static int	 pushed_max;
 edict_t  *obstacle;
 
+// Makes room for one more entry on the pushed stack. A team of pushers can push the same entity more than once.
+static void SV_ReservePushed(void)
+{
+	const int used = pushed_p - pushed;
+	if (used < pushed_max)
+		return;
+
+	// Not tagged memory, it's only scratch space and outlives savegame loads
+	pushed_t *grown = realloc(pushed, max(pushed_max * 2, 64) * sizeof(pushed_t));
+	if (!grown)
+		gi.error("SV_ReservePushed: out of memory");
+
+	pushed_max = max(pushed_max * 2, 64);
+	pushed = grown;
+	pushed_p = pushed + used;
+}
+
+static edict_t	**push_touch;	// SV_Push candidates, stacked like pushed in case a callback pushes something else
+static int		push_touch_used;
+static int		push_touch_max;
+
+// Makes room for count more candidates on the push_touch stack and returns where they start
+static int SV_ReserveTouch(int count)
+{
+	const int base = push_touch_used;
+	if (base + count > push_touch_max)
+	{
+		const int size = max(push_touch_max * 2, base + count);
+		edict_t **grown = realloc(push_touch, size * sizeof(edict_t *));
+		if (!grown)
+			gi.error("SV_ReserveTouch: out of memory");
+
+		push_touch_max = size;
+		push_touch = grown;
+	}
+
+	return base;
+}
+
 void MoveRiders(edict_t *platform, edict_t *ignore, vec3_t move, vec3_t amove, qboolean turn)
 {
-	for (int i = 1; i <= globals.num_edicts; i++)
+	for (edict_t *rider = Rider_Next(platform, NULL); rider; rider = Rider_Next(platform, rider))
 	{
-		edict_t *rider = g_edicts + i;
-		
-		if (rider->groundentity == platform && rider != ignore)
+		if (rider != ignore)
 		{
 			VectorAdd(rider->s.origin, move, rider->s.origin);
 			if (turn && amove[YAW] != 0.0f)
@@ -929,6 +980,7 @@ qboolean SV_Push(edict_t *pusher, vec3_t move, vec3_t amove)
 	AngleVectors(org, forward, right, up);
 
 // save the pusher's original position
+	SV_ReservePushed();
 	pushed_p->ent = pusher;
 	VectorCopy(pusher->s.origin, pushed_p->origin);
 	VectorCopy(pusher->s.angles, pushed_p->angles);
@@ -951,9 +1003,27 @@ qboolean SV_Push(edict_t *pusher, vec3_t move, vec3_t amove)
 	RealBoundingBox(pusher, realmins, realmaxs);
 
 // see if any solid entities are inside the final position
-	edict_t *check = g_edicts + 1;
-	for (int e = 1; e < globals.num_edicts; e++, check++)
+	// Only what's linked in around there and what's riding the pusher needs looking at, in edict order
+	const int touchbase = SV_ReserveTouch(MAX_EDICTS);
+	const int numtouch = Solid_BoxEdicts(realmins, realmaxs, push_touch + touchbase, MAX_EDICTS);
+	push_touch_used = touchbase + numtouch;
+
+	edict_t *check = NULL;
+	int t = 0;
+
+	while (true)
 	{
+		edict_t *rider = Rider_Next(pusher, check);
+		while (t < numtouch && check && push_touch[touchbase + t] <= check)
+			t++;
+
+		if (t < numtouch && (!rider || push_touch[touchbase + t] <= rider))
+			check = push_touch[touchbase + t];
+		else if (rider)
+			check = rider;
+		else
+			break;
+
 		if (!check->inuse || check == pusher->owner) // Lazarus: owner can't block us
 			continue;
 
@@ -999,6 +1069,7 @@ qboolean SV_Push(edict_t *pusher, vec3_t move, vec3_t amove)
 		if (pusher->movetype == MOVETYPE_PUSH || pusher->movetype == MOVETYPE_PENDULUM || check->groundentity == pusher)
 		{
 			// move this entity
+			SV_ReservePushed();
 			pushed_p->ent = check;
 			VectorCopy(check->s.origin, pushed_p->origin);
 			VectorCopy(check->s.angles, pushed_p->angles);
@@ -1191,6 +1262,8 @@ qboolean SV_Push(edict_t *pusher, vec3_t move, vec3_t amove)
 				continue;
 			}
 		}
+
+		push_touch_used = touchbase;
 		
 		// save off the obstacle so we can call the block function
 		obstacle = check;
@@ -1210,6 +1283,8 @@ qboolean SV_Push(edict_t *pusher, vec3_t move, vec3_t amove)
 		return false;
 	}
 
+	push_touch_used = touchbase;
+
 //FIXME: is there a better way to handle this?
 	// see if anything we moved has touched a trigger
 	for (p = pushed_p - 1; p >= pushed; p--)
@@ -1260,16 +1335,13 @@ void SV_Physics_Pusher(edict_t *ent)
 		}
 	}
 
-	if (pushed_p > &pushed[MAX_EDICTS - 1]) //mxd. https://github.com/yquake2/xatrix/commit/5d8b2ae7013a4fc067914c6b7133ca1ca89571a4
-		gi.error(ERR_FATAL, "pushed_p > &pushed[MAX_EDICTS-1], memory corrupted");
-
 	if (part && !part->attracted)
 	{
 		// the move failed, bump all nextthink times and back out moves
 		for (edict_t *mv = ent; mv; mv = mv->teamchain)
 		{
 			if (mv->nextthink > 0)
-				mv->nextthink += FRAMETIME;
+				G_SetNextThink(mv, mv->nextthink + FRAMETIME);
 		}
 
 		// if the pusher has a "blocked" function, call it otherwise, just stay in place until the obstacle is gone
@@ -1473,7 +1545,7 @@ void SV_Physics_Toss(edict_t *ent)
 		{
 			if (ent->velocity[2] < bounce_minv->value || ent->movetype != MOVETYPE_BOUNCE)
 			{
-				ent->groundentity = trace.ent;
+				G_SetGroundEntity(ent, trace.ent);
 				ent->groundentity_linkcount = trace.ent->linkcount;
 				VectorCopy(vec3_origin, ent->velocity);
 				ent->velocity[2] = trace.ent->velocity[2]; //mxd. What if ground is moving?
@@ -1491,7 +1563,7 @@ void SV_Physics_Toss(edict_t *ent)
 	{
 		// check for water transition
 		const qboolean wasinwater = (ent->watertype & MASK_WATER);
-		ent->watertype = gi.pointcontents(ent->s.origin);
+		ent->watertype = Solid_PointContents(ent->s.origin);
 		const qboolean isinwater =  (ent->watertype & MASK_WATER);
 
 		ent->waterlevel = (isinwater ? 1 : 0);
@@ -2090,7 +2162,7 @@ not_allsolid:
 
 			if (hit->solid == SOLID_BSP)
 			{
-				ent->groundentity = hit;
+				G_SetGroundEntity(ent, hit);
 				ent->groundentity_linkcount = hit->linkcount;
 			}
 		}
@@ -2324,6 +2396,17 @@ trace_t SV_DebrisEntity(edict_t *ent, const vec3_t push)
 	VectorAdd(start, push, end);
 
 	const int mask = (ent->clipmask ? ent->clipmask : MASK_SHOT);
+
+	// Nothing in the way, don't bother the engine (see g_solid.c)
+	qboolean triggers;
+	if (Solid_FreeMove(ent, start, end, mask, &triggers))
+	{
+		VectorCopy(end, ent->s.origin);
+		gi.linkentity(ent);
+
+		return Solid_FreeTrace(end);
+	}
+
 	trace_t trace = gi.trace(start, ent->mins, ent->maxs, end, ent, mask);
 	VectorCopy(trace.endpos, ent->s.origin);
 	gi.linkentity(ent);
@@ -2455,7 +2538,7 @@ void SV_Physics_Debris(edict_t *ent)
 		// Stop if on ground
 		if (trace.plane.normal[2] > 0.3f && ent->velocity[2] < 60)
 		{
-			ent->groundentity = trace.ent;
+			G_SetGroundEntity(ent, trace.ent);
 			ent->groundentity_linkcount = trace.ent->linkcount;
 			VectorCopy(vec3_origin, ent->velocity);
 			VectorCopy(vec3_origin, ent->avelocity);
@@ -2464,7 +2547,7 @@ void SV_Physics_Debris(edict_t *ent)
 	
 	// Check for water transition
 	const qboolean wasinwater = ent->watertype & MASK_WATER;
-	ent->watertype = gi.pointcontents(ent->s.origin);
+	ent->watertype = Solid_PointContents(ent->s.origin);
 	const qboolean isinwater  = ent->watertype & MASK_WATER;
 
 	ent->waterlevel = isinwater;
@@ -2593,6 +2676,10 @@ void G_RunEntity(edict_t *ent)
 		gi.error("SV_Physics: bad movetype %i", (int)ent->movetype);			
 	}
 
+	// Lazarus: whatever moves with it is brought along once everything has run
+	if (ent->movewith_child)
+		Movewith_Moved(ent);
+
 	if (ent->postthink)	//Knightmare added
 		ent->postthink(ent);
 }
\ No newline at end of file
@@ -23,12 +23,39 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "g_local.h"
 
-#define MAX_MIRRORS 16
-edict_t	*g_mirror[MAX_MIRRORS];
+// Mirrors are kept in a growable TAG_LEVEL array, so there's no longer a hard cap on func_reflects
+edict_t	**g_mirror;
+static int	max_mirrors;
 
 #define SF_REFLECT_OFF    1
 #define SF_REFLECT_TOGGLE 2
 
+// Mirror index. Each mirror can only reflect entities whose origins lie inside its "catchment" box (the mirror's own
+// bbox flipped across the reflecting plane), so catchment boxes are binned into a grid and AddReflection
+// only tests the mirrors filed in the entity's cell.
+static boxgrid_t	mirror_grid;
+static qboolean		mirror_index_dirty;
+
+// Per-edict snapshot of the state AddReflection last mirrored. If nothing in it changed, neither did the reflections.
+typedef struct
+{
+	int		generation;		// mirror_generation at the time of the update, 0 if never reflected
+	vec3_t	origin;
+	vec3_t	old_origin;
+	vec3_t	angles;
+	int		modelindex[6];
+	int		skinnum;
+	int		frame;
+	int		effects;
+	int		renderfx;
+	int		event;
+	float	alpha;
+	int		hand;
+} reflect_cache_t;
+
+static reflect_cache_t	*reflect_cache;			// [game.maxentities]
+static int		mirror_generation = 1;			// bumped whenever a mirror is toggled, added or removed
+
 //mxd
 qboolean WithinBBox(vec3_t p, edict_t *mirror)
 {
@@ -40,6 +67,140 @@ qboolean WithinBBox(vec3_t p, edict_t *mirror)
 	return true;
 }
 
+// Axis perpendicular to the reflecting plane of given func_reflect style
+static int MirrorAxis(int style)
+{
+	if (style <= 1)
+		return 2;
+
+	return (style <= 3 ? 0 : 1);
+}
+
+// Reflected coordinate along MirrorAxis is MirrorPlane(mirror) - coordinate
+static float MirrorPlane(edict_t *mirror)
+{
+	const float dist = mirror->moveinfo.distance + 2;
+
+	switch(mirror->style)
+	{
+	case 0:  return 2 * mirror->absmax[2] - dist;
+	case 1:  return 2 * mirror->absmin[2] + dist;
+	case 2:  return 2 * mirror->absmin[0] + dist;
+	case 3:  return 2 * mirror->absmax[0] - dist;
+	case 4:  return 2 * mirror->absmin[1] + dist;
+	default: return 2 * mirror->absmax[1] - dist;
+	}
+}
+
+/*
+=================
+Reflect_BuildMirrorIndex
+
+Bins mirror catchment boxes into the grid used by AddReflection
+=================
+*/
+static void Reflect_BuildMirrorIndex(void)
+{
+	mirror_index_dirty = false;
+
+	BoxGrid_Free(&mirror_grid);
+
+	if (!level.num_reflectors)
+		return;
+
+	if (!reflect_cache)
+		reflect_cache = G_TagMalloc(game.maxentities * sizeof(reflect_cache_t), TAG_LEVEL, MEM_REFLECT);
+
+	vec3_t *mins = G_TagMalloc(level.num_reflectors * sizeof(vec3_t), TAG_LEVEL, MEM_REFLECT);
+	vec3_t *maxs = G_TagMalloc(level.num_reflectors * sizeof(vec3_t), TAG_LEVEL, MEM_REFLECT);
+
+	for (int m = 0; m < level.num_reflectors; m++)
+	{
+		edict_t *mirror = g_mirror[m];
+
+		VectorCopy(mirror->absmin, mins[m]);
+		VectorCopy(mirror->absmax, maxs[m]);
+
+		if (mirror->style < 0 || mirror->style > 5)
+		{
+			// Never reflects anything, keep it out of the grid
+			mins[m][0] = 1;
+			maxs[m][0] = -1;
+			continue;
+		}
+
+		const int axis = MirrorAxis(mirror->style);
+		const float plane = MirrorPlane(mirror);
+		mins[m][axis] = plane - mirror->absmax[axis];
+		maxs[m][axis] = plane - mirror->absmin[axis];
+	}
+
+	BoxGrid_Build(&mirror_grid, level.num_reflectors, mins, maxs, TAG_LEVEL);
+
+	gi.TagFree(mins);
+	gi.TagFree(maxs);
+
+	mirror_generation++;
+}
+
+/*
+=================
+Reflect_ClearMirrors
+
+Drops all mirror state. Must be called whenever TAG_LEVEL memory is freed.
+=================
+*/
+void Reflect_ClearMirrors(void)
+{
+	g_mirror = NULL;
+	max_mirrors = 0;
+	memset(&mirror_grid, 0, sizeof(mirror_grid));
+	reflect_cache = NULL;
+	mirror_index_dirty = false;
+	mirror_generation++;
+}
+
+static void Reflect_AddMirror(edict_t *mirror)
+{
+	if (level.num_reflectors >= max_mirrors)
+	{
+		const int newmax = max(16, max_mirrors * 2);
+		edict_t **list = G_TagMalloc(newmax * sizeof(edict_t *), TAG_LEVEL, MEM_REFLECT);
+
+		if (g_mirror)
+		{
+			memcpy(list, g_mirror, level.num_reflectors * sizeof(edict_t *));
+			gi.TagFree(g_mirror);
+		}
+
+		g_mirror = list;
+		max_mirrors = newmax;
+	}
+
+	g_mirror[level.num_reflectors++] = mirror;
+	mirror_index_dirty = true;
+}
+
+/*
+=================
+Reflect_FindMirrors
+
+Rebuilds the mirror list from the loaded entities after ReadLevel
+=================
+*/
+void Reflect_FindMirrors(void)
+{
+	Reflect_ClearMirrors();
+	level.num_reflectors = 0;
+
+	for (int i = 1; i < globals.num_edicts; i++)
+	{
+		edict_t *ent = &g_edicts[i];
+		if (ent->inuse && ent->class_id == ENTITY_FUNC_REFLECT)
+			Reflect_AddMirror(ent);
+	}
+}
+
 void ReflectExplosion(int type, const vec3_t origin)
 {
 	vec3_t org;
@@ -72,10 +233,10 @@ void ReflectExplosion(int type, const vec3_t origin)
 		if (!WithinBBox(org, mirror)) //mxd
 			continue;
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(type);
-		gi.WritePosition(org);
-		gi.multicast(org, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(type);
+		TempEnt_WritePosition(org);
+		TempEnt_Multicast(org, MULTICAST_PVS);
 	}
 }
 
@@ -128,11 +289,11 @@ void ReflectTrail(int type, const vec3_t start, const vec3_t end)
 		if (!WithinBBox(p1, mirror)) //mxd
 			continue;
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(type);
-		gi.WritePosition(p1);
-		gi.WritePosition(p2);
-		gi.multicast(p1, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(type);
+		TempEnt_WritePosition(p1);
+		TempEnt_WritePosition(p2);
+		TempEnt_Multicast(p1, MULTICAST_PVS);
 	}
 }
 
@@ -184,16 +345,16 @@ void ReflectSteam(const vec3_t origin, const vec3_t movedir, int count, int soun
 		if (!WithinBBox(org, mirror)) //mxd
 			continue;
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_STEAM);
-		gi.WriteShort(nextid);
-		gi.WriteByte(count);
-		gi.WritePosition(org);
-		gi.WriteDir(dir);
-		gi.WriteByte(sounds & 0xff);
-		gi.WriteShort(speed);
-		gi.WriteLong (wait);
-		gi.multicast(org, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_STEAM);
+		TempEnt_WriteShort(nextid);
+		TempEnt_WriteByte(count);
+		TempEnt_WritePosition(org);
+		TempEnt_WriteDir(dir);
+		TempEnt_WriteByte(sounds & 0xff);
+		TempEnt_WriteShort(speed);
+		TempEnt_WriteLong(wait);
+		TempEnt_Multicast(org, MULTICAST_PVS);
 	}
 }
 
@@ -249,14 +410,14 @@ void ReflectSparks(int type, const vec3_t origin, const vec3_t movedir)
 		if (!WithinBBox(org, mirror)) //mxd
 			continue;
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(type);
-		gi.WritePosition(org);
+		TempEnt_Begin();
+		TempEnt_WriteByte(type);
+		TempEnt_WritePosition(org);
 
 		if (type != TE_CHAINFIST_SMOKE) 
-			gi.WriteDir(dir);
+			TempEnt_WriteDir(dir);
 
-		gi.multicast(org, MULTICAST_PVS);
+		TempEnt_Multicast(org, MULTICAST_PVS);
 	}
 }
 
@@ -264,6 +425,14 @@ void DeleteReflection(edict_t *ent, int index)
 {
 	if (index < 0)
 	{
+		// Make AddReflection re-evaluate this entity from scratch
+		if (reflect_cache)
+			reflect_cache[ent - g_edicts].generation = 0;
+
+		// Freeing a mirror invalidates everything reflected in it
+		if (ent->class_id == ENTITY_FUNC_REFLECT)
+			mirror_generation++;
+
 		for (int i = 0; i < 6; i++)
 		{
 			edict_t	* r = ent->reflection[i];
@@ -298,42 +467,88 @@ void DeleteReflection(edict_t *ent, int index)
 	}
 }
 
+static void ReflectionKey(edict_t *ent, reflect_cache_t *key)
+{
+	memset(key, 0, sizeof(*key));
+
+	key->generation = mirror_generation;
+	VectorCopy(ent->s.origin, key->origin);
+	VectorCopy(ent->s.old_origin, key->old_origin);
+	VectorCopy(ent->s.angles, key->angles);
+	key->modelindex[0] = ent->s.modelindex;
+	key->modelindex[1] = ent->s.modelindex2;
+	key->modelindex[2] = ent->s.modelindex3;
+	key->modelindex[3] = ent->s.modelindex4;
+#ifdef KMQUAKE2_ENGINE_MOD
+	key->modelindex[4] = ent->s.modelindex5;
+	key->modelindex[5] = ent->s.modelindex6;
+	key->alpha = ent->s.alpha;
+#endif
+	key->skinnum = ent->s.skinnum;
+	key->frame = ent->s.frame;
+	key->effects = ent->s.effects;
+	key->renderfx = ent->s.renderfx;
+	key->hand = (int)hand->value;
+
+	if (ent->client)
+		key->event = ent->s.event;
+}
+
 void AddReflection(edict_t *ent)
 {
+	edict_t		*reflector[6];
+	reflect_cache_t	key;
 	float		roll;
 	vec3_t		forward;
+	vec3_t		ent_forward;
 	vec3_t		org;
 
-	for (int i = 0; i < 6; i++)
-	{
-		qboolean is_reflected = false;
-		for (int m = 0; m < level.num_reflectors && !is_reflected; m++)
-		{
-			edict_t *mirror = g_mirror[m];
+	if (mirror_index_dirty)
+		Reflect_BuildMirrorIndex();
 
-			if (!mirror->inuse || mirror->spawnflags & SF_REFLECT_OFF || mirror->style != i)
-				continue;
+	if (!reflect_cache)
+		return;
 
-			VectorCopy(ent->s.origin, org);
+	// Nothing we copy into the reflections has changed since the last update, so they're still valid
+	ReflectionKey(ent, &key);
+	reflect_cache_t *cache = &reflect_cache[ent - g_edicts];
+	if (!memcmp(&key, cache, sizeof(key)))
+		return;
 
-			switch(i)
-			{
-			case 0: org[2] = 2 * mirror->absmax[2] - ent->s.origin[2] - mirror->moveinfo.distance - 2; break;
-			case 1: org[2] = 2 * mirror->absmin[2] - ent->s.origin[2] + mirror->moveinfo.distance + 2; break;
-			case 2: org[0] = 2 * mirror->absmin[0] - ent->s.origin[0] + mirror->moveinfo.distance + 2; break;
-			case 3: org[0] = 2 * mirror->absmax[0] - ent->s.origin[0] - mirror->moveinfo.distance - 2; break;
-			case 4: org[1] = 2 * mirror->absmin[1] - ent->s.origin[1] + mirror->moveinfo.distance + 2; break;
-			case 5: org[1] = 2 * mirror->absmax[1] - ent->s.origin[1] - mirror->moveinfo.distance - 2; break;
-			}
+	*cache = key;
 
-			if (!WithinBBox(org, mirror)) //mxd
-				continue;
+	memset(reflector, 0, sizeof(reflector));
 
-			is_reflected = true;
-		}
+	// Pick the first active mirror of each style which can see us
+	int *list;
+	const int count = BoxGrid_Query(&mirror_grid, ent->s.origin, &list);
+
+	for (int c = 0; c < count; c++)
+	{
+		edict_t *mirror = g_mirror[list[c]];
+
+		if (reflector[mirror->style] || !mirror->inuse || mirror->spawnflags & SF_REFLECT_OFF)
+			continue;
+
+		const int axis = MirrorAxis(mirror->style);
+		VectorCopy(ent->s.origin, org);
+		org[axis] = MirrorPlane(mirror) - ent->s.origin[axis];
+
+		if (WithinBBox(org, mirror)) //mxd
+			reflector[mirror->style] = mirror;
+	}
+
+	// Side mirrors flip the facing direction, which is the same for all of them
+	if (reflector[2] || reflector[3] || reflector[4] || reflector[5])
+		AngleVectors(ent->s.angles, ent_forward, NULL, NULL);
 
-		if (is_reflected)
+	for (int i = 0; i < 6; i++)
+	{
+		if (reflector[i])
 		{
+			VectorCopy(ent->s.origin, org);
+			org[MirrorAxis(i)] = MirrorPlane(reflector[i]) - ent->s.origin[MirrorAxis(i)];
+
 			if (!ent->reflection[i])
 			{			
 				ent->reflection[i] = G_Spawn();
@@ -353,7 +568,7 @@ void AddReflection(edict_t *ent)
 
 			if (ent->client && !ent->reflection[i]->client)
 			{
-				gclient_t *cl = (gclient_t *)gi.TagMalloc(sizeof(gclient_t), TAG_LEVEL);
+				gclient_t *cl = (gclient_t *)G_TagMalloc(sizeof(gclient_t), TAG_LEVEL, MEM_REFLECT);
 				ent->reflection[i]->client = cl; 
 			}
 
@@ -393,7 +608,7 @@ void AddReflection(edict_t *ent)
 				break;
 
 			case 2: case 3:
-				AngleVectors(ent->reflection[i]->s.angles, forward, NULL, NULL);
+				VectorCopy(ent_forward, forward);
 				roll = ent->reflection[i]->s.angles[2];
 				forward[0] = -forward[0];
 				vectoangles(forward, ent->reflection[i]->s.angles);
@@ -401,7 +616,7 @@ void AddReflection(edict_t *ent)
 				break;
 
 			case 4: case 5:
-				AngleVectors(ent->reflection[i]->s.angles, forward, NULL, NULL);
+				VectorCopy(ent_forward, forward);
 				roll = ent->reflection[i]->s.angles[2];
 				forward[1] = -forward[1];
 				vectoangles(forward, ent->reflection[i]->s.angles);
@@ -437,29 +652,23 @@ void use_func_reflect(edict_t *self, edict_t *other, edict_t *activator)
 	else
 		self->spawnflags |= SF_REFLECT_OFF;
 
+	mirror_generation++;
+
 	if (!(self->spawnflags & SF_REFLECT_TOGGLE))
 		self->use = NULL;
 }
 
 void SP_func_reflect(edict_t *self)
 {
-	if (level.num_reflectors >= MAX_MIRRORS)
-	{
-		gi.dprintf("Max number of func_reflect's (%d) exceeded.\n", MAX_MIRRORS);
-		G_FreeEdict(self);
-		return;
-	}
-
 	self->class_id = ENTITY_FUNC_REFLECT;
 
 	gi.setmodel(self, self->model);
 	self->svflags = SVF_NOCLIENT;
-	g_mirror[level.num_reflectors] = self;
 
 	if (!st.lip)
 		st.lip = 2;
 
 	self->moveinfo.distance = st.lip;
 	self->use = use_func_reflect;
-	level.num_reflectors++;
-}
\ No newline at end of file
+	Reflect_AddMirror(self);
+}
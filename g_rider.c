@@ -0,0 +1,233 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_rider.c -- who is standing on what.
+// SV_Push and MoveRiders used to go through every edict looking for the ones whose groundentity was
+// the pusher. G_SetGroundEntity files an entity under its ground entity, in edict order, so the riders
+// of anything but the world can be walked directly. Every groundentity write other than NULL has to go
+// through it; writing NULL directly is fine, entities that aren't riding any more are dropped the next
+// time the list they're in is walked.
+
+#include "g_local.h"
+
+// Edict numbers, 0 for none. The world is never a rider and its riders aren't filed.
+static int	rider_first[MAX_EDICTS];	// first rider filed under each entity
+static int	rider_next[MAX_EDICTS];
+static int	rider_prev[MAX_EDICTS];
+static int	rider_ground[MAX_EDICTS];	// what it's filed under
+
+static struct
+{
+	int		filed;
+	int		walks;
+	int		dropped;	// no longer riding when their list was walked
+} rider_stats;
+
+static int Rider_Index(const edict_t *ent)
+{
+	if (!ent || !g_edicts || ent < g_edicts || ent - g_edicts >= min(game.maxentities, MAX_EDICTS))
+		return 0;
+
+	return ent - g_edicts;
+}
+
+static void Rider_Unfile(int index)
+{
+	const int ground = rider_ground[index];
+	if (!ground)
+		return;
+
+	if (rider_prev[index])
+		rider_next[rider_prev[index]] = rider_next[index];
+	else
+		rider_first[ground] = rider_next[index];
+
+	if (rider_next[index])
+		rider_prev[rider_next[index]] = rider_prev[index];
+
+	rider_ground[index] = 0;
+	rider_next[index] = 0;
+	rider_prev[index] = 0;
+}
+
+static void Rider_File(int index, int ground)
+{
+	// Keep the list in edict order
+	int prev = 0, next = rider_first[ground];
+	while (next && next < index)
+	{
+		prev = next;
+		next = rider_next[next];
+	}
+
+	rider_ground[index] = ground;
+	rider_prev[index] = prev;
+	rider_next[index] = next;
+
+	if (prev)
+		rider_next[prev] = index;
+	else
+		rider_first[ground] = index;
+
+	if (next)
+		rider_prev[next] = index;
+
+	rider_stats.filed++;
+}
+
+/*
+=================
+G_SetGroundEntity
+
+Sets what ent is standing on. Use this instead of writing anything but NULL to ent->groundentity.
+=================
+*/
+void G_SetGroundEntity(edict_t *ent, edict_t *ground)
+{
+	ent->groundentity = ground;
+
+	const int index = Rider_Index(ent);
+	if (!index)
+		return;
+
+	const int groundindex = Rider_Index(ground);
+	if (rider_ground[index] == groundindex)
+		return;
+
+	Rider_Unfile(index);
+
+	if (groundindex)
+		Rider_File(index, groundindex);
+}
+
+/*
+=================
+Rider_Next
+
+Returns the next entity after from, in edict order, whose groundentity is ground, or NULL. Starts
+over from the front of the list each time, so it's safe to change groundentities while walking.
+=================
+*/
+edict_t *Rider_Next(edict_t *ground, edict_t *from)
+{
+	const int groundindex = Rider_Index(ground);
+	if (!groundindex)
+		return NULL;
+
+	const int fromindex = Rider_Index(from);
+	rider_stats.walks++;
+
+	int index = rider_first[groundindex];
+	while (index)
+	{
+		const int next = rider_next[index];
+
+		if (g_edicts[index].groundentity != ground)
+		{
+			Rider_Unfile(index);
+			rider_stats.dropped++;
+		}
+		else if (index > fromindex)
+		{
+			return &g_edicts[index];
+		}
+
+		index = next;
+	}
+
+	return NULL;
+}
+
+/*
+=================
+Rider_Rebuild
+
+Files every entity under its groundentity. Called once a savegame's edicts have been read.
+=================
+*/
+void Rider_Rebuild(void)
+{
+	Rider_Clear();
+
+	for (int i = 1; i < min(globals.num_edicts, MAX_EDICTS); i++)
+	{
+		edict_t *ent = &g_edicts[i];
+		if (ent->inuse && ent->groundentity)
+			G_SetGroundEntity(ent, ent->groundentity);
+	}
+}
+
+/*
+=================
+Rider_Clear
+
+Forgets every rider. Must be called whenever the edict array is replaced.
+=================
+*/
+void Rider_Clear(void)
+{
+	memset(rider_first, 0, sizeof(rider_first));
+	memset(rider_next, 0, sizeof(rider_next));
+	memset(rider_prev, 0, sizeof(rider_prev));
+	memset(rider_ground, 0, sizeof(rider_ground));
+}
+
+/*
+=================
+Rider_Check
+
+Developer mode consistency check: reports and files riders whose groundentity was set without G_SetGroundEntity
+=================
+*/
+void Rider_Check(void)
+{
+	for (int i = 1; i < min(globals.num_edicts, MAX_EDICTS); i++)
+	{
+		edict_t *ent = &g_edicts[i];
+		const int ground = Rider_Index(ent->groundentity);
+
+		if (ent->inuse && ground && rider_ground[i] != ground)
+		{
+			gi.dprintf("Rider_Check: %s (%d) groundentity was set without G_SetGroundEntity\n", ent->classname, i);
+			G_SetGroundEntity(ent, ent->groundentity);
+		}
+	}
+}
+
+void Rider_Stats_f(void)
+{
+	int riders = 0, grounds = 0;
+
+	for (int i = 1; i < min(globals.num_edicts, MAX_EDICTS); i++)
+	{
+		if (rider_ground[i] && g_edicts[i].groundentity == &g_edicts[rider_ground[i]])
+			riders++;
+
+		if (rider_first[i])
+			grounds++;
+	}
+
+	safe_cprintf(NULL, PRINT_HIGH, "Riders: %d entities standing on %d others\n", riders, grounds);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d filed, %d list walks, %d dropped after stepping off\n", rider_stats.filed, rider_stats.walks, rider_stats.dropped);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&rider_stats, 0, sizeof(rider_stats));
+}
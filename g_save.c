@@ -192,9 +192,11 @@ field_t fields[] = {
 	{ "max_range", FOFS(monsterinfo.max_range), F_FLOAT, 0 },
 	{ "moreflags", FOFS(moreflags), F_INT, 0 },
 	{ "movewith", FOFS(movewith), F_LSTRING, 0 },
+	{ "movewith_child", FOFS(movewith_child), F_EDICT, 0 },
 	{ "movewith_ent", FOFS(movewith_ent), F_EDICT, 0 },
 	{ "movewith_next", FOFS(movewith_next), F_EDICT, 0 },
 	{ "movewith_offset", FOFS(movewith_offset), F_VECTOR, 0 },
+	{ "movewith_prev", FOFS(movewith_prev), F_EDICT, 0 },
 	{ "move_to", FOFS(move_to), F_LSTRING, 0 },
 	{ "muzzle", FOFS(muzzle), F_VECTOR, 0 },
 	{ "muzzle2", FOFS(muzzle2), F_VECTOR, 0 },
@@ -209,7 +211,6 @@ field_t fields[] = {
 	{ "parent_attach_angles", FOFS(parent_attach_angles), F_VECTOR, 0 },
 	{ "pitch_speed", FOFS(pitch_speed), F_FLOAT, 0 },
 	{ "powerarmor", FOFS(powerarmor), F_INT, 0 },
-	{ "prev_grenade", FOFS(prev_grenade), F_EDICT, FFL_NOSPAWN},
 	{ "prevpath", FOFS(prevpath), F_EDICT, 0 },
 	{ "radius", FOFS(radius), F_FLOAT, 0 },
 	{ "renderfx", FOFS(renderfx), F_INT, 0 },
@@ -409,6 +410,17 @@ void InitGame(void)
 #else
 	sv_maxgibs = gi.cvar("sv_maxgibs", "20", CVAR_SERVERINFO);
 #endif
+	sv_fog_bandwidth = gi.cvar("sv_fog_bandwidth", "66", 0);
+	sv_tempent_budget = gi.cvar("sv_tempent_budget", "1024", 0);
+	sv_savedelta = gi.cvar("sv_savedelta", "1", 0);
+	sv_savethread = gi.cvar("sv_savethread", "1", 0);
+	sv_monsternav = gi.cvar("sv_monsternav", "1", 0);
+	sv_thinkwheel = gi.cvar("sv_thinkwheel", "1", 0);
+	sv_maxcosmetics = gi.cvar("sv_maxcosmetics", "150", 0);
+	sv_cmdrate = gi.cvar("sv_cmdrate", "10", 0);
+	sv_cmdburst = gi.cvar("sv_cmdburst", "40", 0);
+	sv_spawnvis = gi.cvar("sv_spawnvis", "0", 0);
+	sv_freemove = gi.cvar("sv_freemove", "1", 0);
 	turn_rider = gi.cvar("turn_rider", "1", CVAR_SERVERINFO);
 	zoomrate = gi.cvar("zoomrate", "80", CVAR_ARCHIVE);
 	zoomsnap = gi.cvar("zoomsnap", "20", CVAR_ARCHIVE);
@@ -468,13 +480,13 @@ void InitGame(void)
 
 	// initialize all entities for this game
 	game.maxentities = maxentities->value;
-	g_edicts =  gi.TagMalloc(game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
+	g_edicts =  G_TagMalloc(game.maxentities * sizeof(g_edicts[0]), TAG_GAME, MEM_EDICTS);
 	globals.edicts = g_edicts;
 	globals.max_edicts = game.maxentities;
 
 	// initialize all clients for this game
 	game.maxclients = maxclients->value;
-	game.clients = gi.TagMalloc(game.maxclients * sizeof(game.clients[0]), TAG_GAME);
+	game.clients = G_TagMalloc(game.maxclients * sizeof(game.clients[0]), TAG_GAME, MEM_EDICTS);
 	globals.num_edicts = game.maxclients + 1;
 
 //ZOID
@@ -512,11 +524,65 @@ mmoveList_t mmoveList[] =
 	#include "g_mmove_list.h"
 };
 
-functionList_t *GetFunctionByAddress (const byte *adr)
+// Both lists sorted by address, so saving a game doesn't search a couple of thousand functions for every field
+#define NUM_FUNCTIONS	(sizeof(functionList) / sizeof(functionList[0]))
+#define NUM_MMOVES		(sizeof(mmoveList) / sizeof(mmoveList[0]))
+
+static functionList_t	*functionsByAddress[NUM_FUNCTIONS];
+static mmoveList_t		*mmovesByAddress[NUM_MMOVES];
+static int				numFunctionsByAddress = -1;
+static int				numMmovesByAddress;
+
+static int FunctionAddressCompare(const void *a, const void *b)
+{
+	const byte *pa = (*(functionList_t **)a)->funcPtr;
+	const byte *pb = (*(functionList_t **)b)->funcPtr;
+
+	return (pa < pb ? -1 : pa > pb);
+}
+
+static int MmoveAddressCompare(const void *a, const void *b)
 {
+	const mmove_t *pa = (*(mmoveList_t **)a)->mmovePtr;
+	const mmove_t *pb = (*(mmoveList_t **)b)->mmovePtr;
+
+	return (pa < pb ? -1 : pa > pb);
+}
+
+static void SortByAddress(void)
+{
+	numFunctionsByAddress = 0;
 	for (int i = 0; functionList[i].funcStr; i++)
-		if (functionList[i].funcPtr == adr)
-			return &functionList[i];
+		functionsByAddress[numFunctionsByAddress++] = &functionList[i];
+
+	qsort(functionsByAddress, numFunctionsByAddress, sizeof(functionsByAddress[0]), FunctionAddressCompare);
+
+	numMmovesByAddress = 0;
+	for (int i = 0; mmoveList[i].mmoveStr; i++)
+		mmovesByAddress[numMmovesByAddress++] = &mmoveList[i];
+
+	qsort(mmovesByAddress, numMmovesByAddress, sizeof(mmovesByAddress[0]), MmoveAddressCompare);
+}
+
+functionList_t *GetFunctionByAddress (const byte *adr)
+{
+	if (numFunctionsByAddress < 0)
+		SortByAddress();
+
+	int lo = 0, hi = numFunctionsByAddress - 1;
+	while (lo <= hi)
+	{
+		const int mid = (lo + hi) / 2;
+		const byte *p = functionsByAddress[mid]->funcPtr;
+
+		if (p == adr)
+			return functionsByAddress[mid];
+
+		if (p < adr)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
 
 	return NULL;
 }
@@ -532,9 +598,23 @@ byte *FindFunctionByName(char *name)
 
 mmoveList_t *GetMmoveByAddress (mmove_t *adr)
 {
-	for (int i = 0; mmoveList[i].mmoveStr; i++)
-		if (mmoveList[i].mmovePtr == adr)
-			return &mmoveList[i];
+	if (numFunctionsByAddress < 0)
+		SortByAddress();
+
+	int lo = 0, hi = numMmovesByAddress - 1;
+	while (lo <= hi)
+	{
+		const int mid = (lo + hi) / 2;
+		const mmove_t *p = mmovesByAddress[mid]->mmovePtr;
+
+		if (p == adr)
+			return mmovesByAddress[mid];
+
+		if (p < adr)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
 
 	return NULL;
 }
@@ -552,7 +632,7 @@ mmove_t *FindMmoveByName(char *name)
 
 //=========================================================
 
-void WriteField1 (FILE *f, field_t *field, byte *base)
+void WriteField1 (savebuffer_t *f, field_t *field, byte *base)
 {
 	void		*p;
 	int			len;
@@ -663,27 +743,25 @@ void WriteField1 (FILE *f, field_t *field, byte *base)
 }
 
 
-void WriteField2 (FILE *f, field_t *field, byte *base)
+// Returns the length of the data WriteField2 writes after the block for this field, and the data in *data
+static int FieldTail(field_t *field, byte *base, char **data)
 {
-	int			len;
-	void		*p;
-
 #ifdef SAVEGAME_USE_FUNCTION_TABLE
 	functionList_t *func;
 	mmoveList_t *mmove;
 #endif
 
 	if (field->flags & FFL_SPAWNTEMP)
-		return;
+		return 0;
 
-	p = (void *)(base + field->ofs);
+	void *p = (void *)(base + field->ofs);
 	switch (field->type)
 	{
 	case F_LSTRING:
 		if (*(char **)p)
 		{
-			len = strlen(*(char **)p) + 1;
-			fwrite(*(char **)p, len, 1, f);
+			*data = *(char **)p;
+			return strlen(*data) + 1;
 		}
 		break;
 
@@ -694,8 +772,8 @@ void WriteField2 (FILE *f, field_t *field, byte *base)
 			func = GetFunctionByAddress(*(byte **)p);
 			if (!func)
 				gi.error("WriteField2: function not in list, can't save game");
-			len = strlen(func->funcStr) + 1;
-			fwrite(func->funcStr, len, 1, f);
+			*data = func->funcStr;
+			return strlen(*data) + 1;
 		}
 		break;
 
@@ -705,12 +783,23 @@ void WriteField2 (FILE *f, field_t *field, byte *base)
 			mmove = GetMmoveByAddress(*(mmove_t **)p);
 			if (!mmove)
 				gi.error("WriteField2: mmove not in list, can't save game");
-			len = strlen(mmove->mmoveStr) + 1;
-			fwrite(mmove->mmoveStr, len, 1, f);
+			*data = mmove->mmoveStr;
+			return strlen(*data) + 1;
 		}
 		break;
 #endif
 	}
+
+	return 0;
+}
+
+void WriteField2 (savebuffer_t *f, field_t *field, byte *base)
+{
+	char *data;
+	const int len = FieldTail(field, base, &data);
+
+	if (len)
+		Save_Write(f, data, len);
 }
 
 void ReadField (FILE *f, field_t *field, byte *base)
@@ -742,7 +831,7 @@ void ReadField (FILE *f, field_t *field, byte *base)
 			*(char **)p = NULL;
 		else
 		{
-			*(char **)p = gi.TagMalloc(len, TAG_LEVEL);
+			*(char **)p = G_TagMalloc(len, TAG_LEVEL, MEM_STRINGS);
 			fread(*(char **)p, len, 1, f);
 		}
 		break;
@@ -847,7 +936,7 @@ WriteClient
 All pointer variables (except function pointers) must be handled specially.
 ==============
 */
-void WriteClient (FILE *f, gclient_t *client)
+void WriteClient (savebuffer_t *f, gclient_t *client)
 {
 	// All of the ints, floats, and vectors stay as they are
 	gclient_t temp = *client;
@@ -857,7 +946,7 @@ void WriteClient (FILE *f, gclient_t *client)
 		WriteField1(f, field, (byte *)&temp);
 
 	// Write the block
-	fwrite(&temp, sizeof(temp), 1, f);
+	Save_Write(f, &temp, sizeof(temp));
 
 	// Now write any allocated data following the edict
 	for (field_t *field = clientfields; field->name; field++)
@@ -896,51 +985,52 @@ A single player death will automatically restore from the last save position.
 */
 void WriteGame(char *filename, qboolean autosave)
 {
-	FILE	*f;
-	char	str[16];
+	savebuffer_t	buf;
+	char			str[16];
 
 #ifdef SAVEGAME_USE_FUNCTION_TABLE
-	char	str2[64];
+	char			str2[64];
 #endif
 
 	if (developer->value)
 		gi.dprintf("==== WriteGame ====\n");
 
+	memset(&buf, 0, sizeof(buf));
+
 	if (!autosave)
 	{
 		game.transition_ents = 0;
 		SaveClientData();
 	}
 
-	f = fopen(filename, "wb");
-	if (!f)
-		gi.error("Couldn't open %s", filename);
-
 	memset(str, 0, sizeof(str));
 	Q_strncpyz(str, __DATE__, sizeof(str));
-	fwrite(str, sizeof(str), 1, f);
+	Save_Write(&buf, str, sizeof(str));
 
 #ifdef SAVEGAME_USE_FUNCTION_TABLE
 	// use modname and save version for compatibility instead of build date
 	memset(str2, 0, sizeof(str2));
 	Q_strncpyz(str2, SAVEGAME_DLLNAME, sizeof(str2));
-	fwrite(str2, sizeof(str2), 1, f);
+	Save_Write(&buf, str2, sizeof(str2));
 
 	int ver = SAVEGAME_VERSION;
-	fwrite(&ver, sizeof(ver), 1, f);
+	Save_Write(&buf, &ver, sizeof(ver));
 #endif
 
 	//mxd. Save current gravity...
-	fwrite(&sv_gravity->integer, sizeof(sv_gravity->integer), 1, f);
+	Save_Write(&buf, &sv_gravity->integer, sizeof(sv_gravity->integer));
 
 	game.autosaved = autosave;
-	fwrite(&game, sizeof(game), 1, f);
+	Save_Write(&buf, &game, sizeof(game));
 	game.autosaved = false;
 
 	for (int i = 0; i < game.maxclients; i++)
-		WriteClient(f, &game.clients[i]);
+		WriteClient(&buf, &game.clients[i]);
 
-	fclose(f);
+	// The engine copies the save directory as soon as this returns, so the level file queued
+	// by WriteLevel has to be written too
+	Save_QueueFile(filename, &buf);
+	Save_WaitForWrites();
 }
 
 void ReadGame(char *filename)
@@ -955,6 +1045,8 @@ void ReadGame(char *filename)
 	if (developer->value)
 		gi.dprintf("==== ReadGame ====\n");
 
+	Save_WaitForWrites();
+
 	gi.FreeTags (TAG_GAME);
 
 	f = fopen(filename, "rb");
@@ -992,11 +1084,11 @@ void ReadGame(char *filename)
 	fread(&gravity, sizeof(gravity), 1, f);
 	gi.cvar_set("sv_gravity", va("%i", gravity));
 
-	g_edicts =  gi.TagMalloc(game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
+	g_edicts =  G_TagMalloc(game.maxentities * sizeof(g_edicts[0]), TAG_GAME, MEM_EDICTS);
 	globals.edicts = g_edicts;
 
 	fread(&game, sizeof(game), 1, f);
-	game.clients = gi.TagMalloc(game.maxclients * sizeof(game.clients[0]), TAG_GAME);
+	game.clients = G_TagMalloc(game.maxclients * sizeof(game.clients[0]), TAG_GAME, MEM_EDICTS);
 
 	for (int i = 0; i < game.maxclients; i++)
 		ReadClient(f, &game.clients[i]);
@@ -1014,7 +1106,7 @@ WriteEdict
 All pointer variables (except function pointers) must be handled specially.
 ==============
 */
-void WriteEdict (FILE *f, edict_t *ent)
+void WriteEdict (savebuffer_t *f, edict_t *ent)
 {
 	// All of the ints, floats, and vectors stay as they are
 	edict_t temp = *ent;
@@ -1034,7 +1126,7 @@ void WriteEdict (FILE *f, edict_t *ent)
 		WriteField1(f, field, (byte *)&temp);
 
 	// Write the block
-	fwrite(&temp, sizeof(temp), 1, f);
+	Save_Write(f, &temp, sizeof(temp));
 
 	// Now write any allocated data following the edict
 	for (field_t *field = fields; field->name; field++)
@@ -1048,7 +1140,7 @@ WriteLevelLocals
 All pointer variables (except function pointers) must be handled specially.
 ==============
 */
-void WriteLevelLocals (FILE *f)
+void WriteLevelLocals (savebuffer_t *f)
 {
 	// All of the ints, floats, and vectors stay as they are
 	level_locals_t temp = level;
@@ -1058,7 +1150,7 @@ void WriteLevelLocals (FILE *f)
 		WriteField1(f, field, (byte *)&temp);
 
 	// Write the block
-	fwrite(&temp, sizeof(temp), 1, f);
+	Save_Write(f, &temp, sizeof(temp));
 
 	// Now write any allocated data following the edict
 	for (field_t *field = levelfields; field->name; field++)
@@ -1100,6 +1192,266 @@ void ReadLevelLocals (FILE *f)
 		ReadField(f, field, (byte *)&level);
 }
 
+//==========================================================
+
+// Level files written with sv_savedelta hold only the edicts that changed since the level's baseline,
+// which is kept next to the level file as <level>.base.sav. The baseline is taken the first time the
+// level is saved, so lights, info_ entities, static brush models and the like are written once, and
+// later saves of the same level only write what moved, thought or died since, plus a list of
+// baseline edicts that were freed (tombstones).
+
+#define SAVE_DELTA_IDENT	(('V'<<24)+('L'<<16)+('D'<<8)+'G')		// little-endian "GDLV"
+#define SAVE_BASE_IDENT		(('S'<<24)+('B'<<16)+('D'<<8)+'G')		// little-endian "GDBS"
+
+typedef struct
+{
+	char	filename[MAX_OSPATH];	// level file this baseline was written for, empty if not written yet
+	int		id;						// written to both files, so a level file can't be read with another baseline
+	byte	**images;				// [game.maxentities] saved edicts, NULL if the edict wasn't saved
+	int		*sizes;
+} savebaseline_t;
+
+static savebaseline_t	save_baseline;
+
+static byte	*save_image;	// edict being compared or written
+static int	save_imagesize;
+
+/*
+=================
+Save_ClearBaseline
+
+Forgets the level baseline, its memory is in TAG_LEVEL. Called from SpawnEntities and ReadLevel.
+=================
+*/
+void Save_ClearBaseline(void)
+{
+	memset(&save_baseline, 0, sizeof(save_baseline));
+	save_image = NULL;
+	save_imagesize = 0;
+}
+
+static void Save_ImageSize(int size)
+{
+	if (size <= save_imagesize)
+		return;
+
+	byte *image = G_TagMalloc(size * 2, TAG_LEVEL, MEM_SAVE);
+	if (save_image)
+	{
+		memcpy(image, save_image, save_imagesize);
+		gi.TagFree(save_image);
+	}
+
+	save_image = image;
+	save_imagesize = size * 2;
+}
+
+static qboolean Save_IsPointer(field_t *field)
+{
+	if (field->flags & FFL_SPAWNTEMP)
+		return false;
+
+	switch (field->type)
+	{
+		case F_LSTRING:
+		case F_GSTRING:
+		case F_EDICT:
+		case F_ITEM:
+		case F_CLIENT:
+		case F_FUNCTION:
+		case F_MMOVE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+// Does what WriteEdict does, into save_image. Returns the size.
+static int Save_EdictImage(edict_t *ent)
+{
+	edict_t temp = *ent;
+
+	for (field_t *field = fields; field->name; field++)
+	{
+		WriteField1(NULL, field, (byte *)&temp);
+
+		// The length or index only fills part of a 64 bit pointer, clear the rest so it's the same every time
+		if (Save_IsPointer(field))
+		{
+			byte *p = (byte *)&temp + field->ofs;
+			const int value = *(int *)p;
+			memset(p, 0, sizeof(void *));
+			*(int *)p = value;
+		}
+	}
+
+	// gi.linkentity sets these again when the level is read, so relinking doesn't make an edict dirty.
+	// Reflection pointers aren't restored either, and ReadLevel points player edicts at game.clients.
+	if (ent - g_edicts <= game.maxclients)
+		temp.client = NULL;
+
+	temp.linkcount = 0;
+	memset(&temp.area, 0, sizeof(temp.area));
+	temp.num_clusters = 0;
+	memset(temp.clusternums, 0, sizeof(temp.clusternums));
+	temp.headnode = 0;
+	temp.areanum = 0;
+	temp.areanum2 = 0;
+	VectorClear(temp.absmin);
+	VectorClear(temp.absmax);
+	VectorClear(temp.size);
+	memset(temp.reflection, 0, sizeof(temp.reflection));
+
+	int size = sizeof(temp);
+	Save_ImageSize(size);
+	memcpy(save_image, &temp, size);
+
+	for (field_t *field = fields; field->name; field++)
+	{
+		char *data;
+		const int len = FieldTail(field, (byte *)ent, &data);
+		if (!len)
+			continue;
+
+		Save_ImageSize(size + len);
+		memcpy(save_image + size, data, len);
+		size += len;
+	}
+
+	return size;
+}
+
+static qboolean Save_IsSaved(edict_t *ent)
+{
+	// Knightmare- don't save reflections
+	return (ent->inuse && !(ent->flags & FL_REFLECT));
+}
+
+static void Save_BaselineName(char *filename, char *out)
+{
+	Q_strncpyz(out, filename, MAX_OSPATH - 9);
+
+	char *ext = strrchr(out, '.');
+	if (ext && !strchr(ext, '/') && !strchr(ext, '\\'))
+		*ext = 0;
+
+	Q_strncatz(out, ".base.sav", MAX_OSPATH);
+}
+
+static void Save_AllocBaseline(void)
+{
+	save_baseline.images = G_TagMalloc(game.maxentities * sizeof(byte *), TAG_LEVEL, MEM_SAVE);
+	save_baseline.sizes = G_TagMalloc(game.maxentities * sizeof(int), TAG_LEVEL, MEM_SAVE);
+}
+
+// Takes the current state of the level as its baseline and writes it out for level file filename
+static void Save_WriteBaseline(char *filename)
+{
+	char			name[MAX_OSPATH];
+	savebuffer_t	buf;
+
+	Save_ClearBaseline();
+	Save_AllocBaseline();
+	// Not rand(), saving shouldn't change what happens next
+	save_baseline.id = (int)time(NULL) ^ (level.framenum << 16);
+
+	memset(&buf, 0, sizeof(buf));
+
+	int ident = SAVE_BASE_IDENT;
+	Save_Write(&buf, &ident, sizeof(ident));
+
+	int size = sizeof(edict_t);
+	Save_Write(&buf, &size, sizeof(size));
+
+	auto *base = (void *)InitGame;
+	Save_Write(&buf, &base, sizeof(base));
+
+	Save_Write(&buf, &save_baseline.id, sizeof(save_baseline.id));
+
+	for (int i = 0; i < globals.num_edicts; i++)
+	{
+		edict_t *ent = &g_edicts[i];
+		if (!Save_IsSaved(ent))
+			continue;
+
+		size = Save_EdictImage(ent);
+		save_baseline.images[i] = G_TagMalloc(size, TAG_LEVEL, MEM_SAVE);
+		save_baseline.sizes[i] = size;
+		memcpy(save_baseline.images[i], save_image, size);
+
+		Save_Write(&buf, &i, sizeof(i));
+		Save_Write(&buf, save_image, size);
+	}
+
+	size = -1;
+	Save_Write(&buf, &size, sizeof(size));
+
+	Save_BaselineName(filename, name);
+	Save_QueueFile(name, &buf);
+
+	Q_strncpyz(save_baseline.filename, filename, sizeof(save_baseline.filename));
+}
+
+// Reads the baseline for level file filename into g_edicts, and keeps it for the next WriteLevel
+static void Save_ReadBaseline(char *filename, int id)
+{
+	char name[MAX_OSPATH];
+	int ident, size, entnum;
+	void *base;
+
+	Save_BaselineName(filename, name);
+	FILE *f = fopen(name, "rb");
+	if (!f)
+		gi.error("ReadLevel: couldn't open baseline %s", name);
+
+	fread(&ident, sizeof(ident), 1, f);
+	fread(&size, sizeof(size), 1, f);
+	fread(&base, sizeof(base), 1, f);
+	fread(&save_baseline.id, sizeof(save_baseline.id), 1, f);
+
+	if (ident != SAVE_BASE_IDENT || size != sizeof(edict_t) || save_baseline.id != id)
+	{
+		fclose(f);
+		gi.error("ReadLevel: %s doesn't match %s", name, filename);
+	}
+
+	Save_AllocBaseline();
+
+	while (true)
+	{
+		if (fread(&entnum, sizeof(entnum), 1, f) != 1 || entnum >= game.maxentities)
+		{
+			fclose(f);
+			gi.error("ReadLevel: failed to read baseline entnum");
+		}
+
+		if (entnum == -1)
+			break;
+
+		if (entnum >= globals.num_edicts)
+			globals.num_edicts = entnum + 1;
+
+		edict_t *ent = &g_edicts[entnum];
+		const long start = ftell(f);
+		ReadEdict(f, ent);
+
+		// Keep the edict as it was written, to compare with when the level is saved again
+		size = ftell(f) - start;
+		save_baseline.images[entnum] = G_TagMalloc(size, TAG_LEVEL, MEM_SAVE);
+		save_baseline.sizes[entnum] = size;
+		fseek(f, start, SEEK_SET);
+		fread(save_baseline.images[entnum], size, 1, f);
+
+		memset(&ent->area, 0, sizeof(ent->area));
+		gi.linkentity(ent);
+	}
+
+	fclose(f);
+
+	Q_strncpyz(save_baseline.filename, filename, sizeof(save_baseline.filename));
+}
+
 /*
 =================
 WriteLevel
@@ -1108,43 +1460,92 @@ WriteLevel
 */
 void WriteLevel(char *filename)
 {
+	int written = 0, unchanged = 0, freed = 0;
+
 	if (developer->value)
 		gi.dprintf("==== WriteLevel ====\n");
 
-	FILE *f = fopen(filename, "wb");
-	if (!f)
-		gi.error("Couldn't open %s", filename);
+	const qboolean delta = (sv_savedelta && sv_savedelta->value);
+
+	// First save of this level, or the baseline we have belongs to another file
+	if (delta && (!save_baseline.images || Q_stricmp(save_baseline.filename, filename)))
+		Save_WriteBaseline(filename);
+
+	savebuffer_t buf;
+	memset(&buf, 0, sizeof(buf));
+
+	if (delta)
+	{
+		int ident = SAVE_DELTA_IDENT;
+		Save_Write(&buf, &ident, sizeof(ident));
+	}
 
 	// write out edict size for checking
 	int size = sizeof(edict_t);
-	fwrite(&size, sizeof(size), 1, f);
+	Save_Write(&buf, &size, sizeof(size));
 
 	// write out a function pointer for checking
 	auto *base = (void *)InitGame;
-	fwrite(&base, sizeof(base), 1, f);
+	Save_Write(&buf, &base, sizeof(base));
+
+	if (delta)
+		Save_Write(&buf, &save_baseline.id, sizeof(save_baseline.id));
 
 	// write out level_locals_t
-	WriteLevelLocals(f);
+	WriteLevelLocals(&buf);
 
 	// write out all the entities
 	for (int i = 0; i < globals.num_edicts; i++)
 	{
 		edict_t *ent = &g_edicts[i];
-		if (!ent->inuse)
+		if (!Save_IsSaved(ent))
 			continue;
 
-		// Knightmare- don't save reflections
-		if (ent->flags & FL_REFLECT)
-			continue;
+		if (delta)
+		{
+			size = Save_EdictImage(ent);
+			if (size == save_baseline.sizes[i] && !memcmp(save_image, save_baseline.images[i], size))
+			{
+				unchanged++;
+				continue;
+			}
+
+			Save_Write(&buf, &i, sizeof(i));
+			Save_Write(&buf, save_image, size);
+		}
+		else
+		{
+			Save_Write(&buf, &i, sizeof(i));
+			WriteEdict(&buf, ent);
+		}
 
-		fwrite(&i, sizeof(i), 1, f);
-		WriteEdict(f, ent);
+		written++;
 	}
 
 	size = -1;
-	fwrite(&size, sizeof(size), 1, f);
+	Save_Write(&buf, &size, sizeof(size));
 
-	fclose(f);
+	// Baseline edicts that are gone
+	if (delta)
+	{
+		for (int i = 0; i < game.maxentities; i++)
+		{
+			if (save_baseline.images[i] && (i >= globals.num_edicts || !Save_IsSaved(&g_edicts[i])))
+			{
+				Save_Write(&buf, &i, sizeof(i));
+				freed++;
+			}
+		}
+
+		Save_Write(&buf, &size, sizeof(size));
+	}
+
+	if (developer->value)
+		gi.dprintf("WriteLevel: %d entities written, %d unchanged, %d freed, %d bytes\n", written, unchanged, freed, buf.size);
+
+	// Written while the engine loads the next map. SpawnEntities waits for it.
+	Save_QueueFile(filename, &buf);
+	Save_StartWrites();
 }
 
 
@@ -1168,20 +1569,42 @@ void ReadLevel(char *filename)
 	if (developer->value)
 		gi.dprintf("==== ReadLevel ====\n");
 
+	Save_WaitForWrites();
+
 	FILE *f = fopen(filename, "rb");
 	if (!f)
 		gi.error("Couldn't open %s", filename);
 
 	// free any dynamic memory allocated by loading the level base state
 	gi.FreeTags(TAG_LEVEL);
+	Reflect_ClearMirrors();
+	Fog_ClearIndex();
+	Path_ClearGraph();
+	Nav_ClearGraph();
+	Danger_Clear();
+	Cosmetic_Clear();
+	SpawnSpot_Clear();
+	Template_Clear();
+	G_ClearStrings();
+	Save_ClearBaseline();
 
 	// wipe all the entities
 	memset(g_edicts, 0, game.maxentities*sizeof(g_edicts[0]));
+	G_ClearRoles();
+	Solid_Clear();
+	Rider_Clear();
+	Think_Clear();
 	globals.num_edicts = maxclients->value+1;
 
 	// check edict size
 	int size;
 	fread(&size, sizeof(size), 1, f);
+
+	// Written with sv_savedelta, edicts that aren't in the file come from the baseline
+	const qboolean delta = (size == SAVE_DELTA_IDENT);
+	if (delta)
+		fread(&size, sizeof(size), 1, f);
+
 	if (size != sizeof(edict_t))
 	{
 		fclose(f);
@@ -1191,9 +1614,16 @@ void ReadLevel(char *filename)
 	// check function pointer base address
 	fread(&base, sizeof(base), 1, f);
 
+	int id = 0;
+	if (delta)
+		fread(&id, sizeof(id), 1, f);
+
 	// load the level locals
 	ReadLevelLocals(f);
 
+	if (delta)
+		Save_ReadBaseline(filename, id);
+
 	// load all the entities
 	while (true)
 	{
@@ -1210,6 +1640,11 @@ void ReadLevel(char *filename)
 			globals.num_edicts = entnum+1;
 
 		ent = &g_edicts[entnum];
+
+		// Changed since the baseline
+		if (ent->inuse)
+			gi.unlinkentity(ent);
+
 		ReadEdict(f, ent);
 
 		// let the server rebuild world links for this ent
@@ -1217,6 +1652,23 @@ void ReadLevel(char *filename)
 		gi.linkentity(ent);
 	}
 
+	// Baseline edicts that were freed
+	while (delta)
+	{
+		if (fread(&entnum, sizeof(entnum), 1, f) != 1 || entnum >= game.maxentities)
+		{
+			fclose(f);
+			gi.error("ReadLevel: failed to read freed entnum");
+		}
+
+		if (entnum == -1)
+			break;
+
+		ent = &g_edicts[entnum];
+		gi.unlinkentity(ent);
+		memset(ent, 0, sizeof(*ent));
+	}
+
 	fclose(f);
 
 	// mark all clients as unconnected
@@ -1237,9 +1689,19 @@ void ReadLevel(char *filename)
 
 		// fire any cross-level triggers
 		if (ent->classname && strcmp(ent->classname, "target_crosslevel_target") == 0)
-			ent->nextthink = level.time + ent->delay;
+			G_SetNextThink(ent, level.time + ent->delay);
 	}
 
+	// Entities were linked before their clients were restored
+	G_RebuildRoles();
+
+	// Their groundentities were read, not set
+	Rider_Rebuild();
+
+	// Rebuild the mirror list, it was freed along with the rest of TAG_LEVEL memory
+	if (level.num_reflectors)
+		Reflect_FindMirrors();
+
 	// DWH: Load transition entities
 	if (game.transition_ents)
 	{
@@ -0,0 +1,328 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_savewrite.c -- background savegame writes.
+// WriteGame and WriteLevel encode into memory buffers on the game thread and queue them here.
+// A writer thread writes each buffer to <file>.tmp and renames it over the file when it's done,
+// so a half written file is never left behind. On a level change the level file is written while
+// the engine loads the next map.
+// Nothing else touches the buffers, and the game thread only looks at a batch again after joining
+// the thread, so no locks are needed. SpawnEntities, ReadGame, ReadLevel, WriteGame and ShutdownGame
+// wait for pending writes, so the engine never looks for or copies a file that's still being written.
+// gi.* isn't thread safe, so the thread doesn't call it.
+
+#include "g_local.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/time.h>
+#endif
+
+#define SAVE_MAX_FILES	8
+
+typedef struct
+{
+	char			filename[MAX_OSPATH];
+	char			tempname[MAX_OSPATH];
+	FILE			*f;
+	savebuffer_t	buf;
+	qboolean		failed;
+} savefile_t;
+
+typedef struct
+{
+	savefile_t		files[SAVE_MAX_FILES];
+	int				numfiles;
+	int				msec;		// spent writing, on the writer thread
+	volatile int	done;
+} savebatch_t;
+
+static savebatch_t	save_pending;	// queued by the game thread
+static savebatch_t	save_writing;	// owned by the writer thread until it's joined
+static qboolean		save_running;
+
+#ifdef _WIN32
+static HANDLE		save_thread;
+#else
+static pthread_t	save_thread;
+#endif
+
+static struct
+{
+	int		batches;
+	int		files;
+	int		bytes;
+	int		write_msec;		// file I/O taken off the game thread
+	int		wait_msec;		// game thread waiting for the writer
+	int		failed;
+} save_stats;
+
+static int Save_Milliseconds(void)
+{
+#ifdef _WIN32
+	return (int)GetTickCount();
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (int)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+#endif
+}
+
+/*
+=================
+Save_Write
+
+Appends data to a save buffer
+=================
+*/
+void Save_Write(savebuffer_t *buf, const void *data, int size)
+{
+	if (buf->size + size > buf->maxsize)
+	{
+		buf->maxsize = max(buf->maxsize * 2, buf->size + size + 65536);
+		buf->data = realloc(buf->data, buf->maxsize);
+		if (!buf->data)
+			gi.error("Save_Write: couldn't allocate %d bytes", buf->maxsize);
+	}
+
+	memcpy(buf->data + buf->size, data, size);
+	buf->size += size;
+}
+
+// Writer thread
+static void Save_WriteBatch(savebatch_t *batch)
+{
+	const int start = Save_Milliseconds();
+
+	for (int i = 0; i < batch->numfiles; i++)
+	{
+		savefile_t *file = &batch->files[i];
+
+		if (fwrite(file->buf.data, 1, file->buf.size, file->f) != (size_t)file->buf.size)
+			file->failed = true;
+
+		if (fclose(file->f))
+			file->failed = true;
+
+		file->f = NULL;
+
+		if (file->failed)
+		{
+			remove(file->tempname);
+			continue;
+		}
+
+#ifdef _WIN32
+		if (!MoveFileEx(file->tempname, file->filename, MOVEFILE_REPLACE_EXISTING))
+			file->failed = true;
+#else
+		if (rename(file->tempname, file->filename))
+			file->failed = true;
+#endif
+	}
+
+	batch->msec = Save_Milliseconds() - start;
+	batch->done = true;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI Save_ThreadMain(LPVOID batch)
+{
+	Save_WriteBatch(batch);
+	return 0;
+}
+#else
+static void *Save_ThreadMain(void *batch)
+{
+	Save_WriteBatch(batch);
+	return NULL;
+}
+#endif
+
+// Reports what the last batch did and frees it. The writer thread has been joined, or never ran.
+static void Save_FinishBatch(qboolean threaded)
+{
+	save_running = false;
+
+	int bytes = 0;
+	for (int i = 0; i < save_writing.numfiles; i++)
+	{
+		savefile_t *file = &save_writing.files[i];
+		bytes += file->buf.size;
+
+		if (file->failed)
+		{
+			gi.dprintf("WARNING: couldn't write %s\n", file->filename);
+			save_stats.failed++;
+		}
+
+		free(file->buf.data);
+	}
+
+	save_stats.batches++;
+	save_stats.files += save_writing.numfiles;
+	save_stats.bytes += bytes;
+
+	if (threaded)
+		save_stats.write_msec += save_writing.msec;
+	else
+		save_stats.wait_msec += save_writing.msec;
+
+	if (developer && developer->value)
+		gi.dprintf("Saved %d files, %d bytes, in %d ms%s\n", save_writing.numfiles, bytes, save_writing.msec, (threaded ? " off the game thread" : ""));
+
+	memset(&save_writing, 0, sizeof(save_writing));
+}
+
+static void Save_JoinThread(void)
+{
+#ifdef _WIN32
+	WaitForSingleObject(save_thread, INFINITE);
+	CloseHandle(save_thread);
+#else
+	pthread_join(save_thread, NULL);
+#endif
+}
+
+// Waits for the batch the writer thread has
+static void Save_WaitForThread(void)
+{
+	if (!save_running)
+		return;
+
+	const int start = Save_Milliseconds();
+	Save_JoinThread();
+	save_stats.wait_msec += Save_Milliseconds() - start;
+
+	Save_FinishBatch(true);
+}
+
+/*
+=================
+Save_QueueFile
+
+Queues buf to be written to filename by the next Save_StartWrites. The buffer belongs to the writer from here on.
+The file is opened now, so a bad path is still an error for whoever asked for the save.
+=================
+*/
+void Save_QueueFile(char *filename, savebuffer_t *buf)
+{
+	if (save_pending.numfiles == SAVE_MAX_FILES)
+		Save_StartWrites();
+
+	savefile_t *file = &save_pending.files[save_pending.numfiles];
+	Q_strncpyz(file->filename, filename, sizeof(file->filename));
+	Com_sprintf(file->tempname, sizeof(file->tempname), "%s.tmp", filename);
+
+	// A pending write to the same file has to land first
+	for (int i = 0; i < save_writing.numfiles && save_running; i++)
+		if (!Q_stricmp(save_writing.files[i].filename, filename))
+			Save_WaitForThread();
+
+	file->f = fopen(file->tempname, "wb");
+	if (!file->f)
+		gi.error("Couldn't open %s", file->tempname);
+
+	file->buf = *buf;
+	memset(buf, 0, sizeof(*buf));
+	save_pending.numfiles++;
+}
+
+/*
+=================
+Save_StartWrites
+
+Hands the queued files to the writer thread, or writes them now if sv_savethread is 0
+=================
+*/
+void Save_StartWrites(void)
+{
+	if (!save_pending.numfiles)
+		return;
+
+	// One batch at a time
+	Save_WaitForThread();
+
+	save_writing = save_pending;
+	memset(&save_pending, 0, sizeof(save_pending));
+	save_running = true;
+
+	qboolean started = false;
+	if (sv_savethread && sv_savethread->value)
+	{
+#ifdef _WIN32
+		save_thread = CreateThread(NULL, 0, Save_ThreadMain, &save_writing, 0, NULL);
+		started = (save_thread != NULL);
+#else
+		started = !pthread_create(&save_thread, NULL, Save_ThreadMain, &save_writing);
+#endif
+	}
+
+	if (!started)
+	{
+		Save_WriteBatch(&save_writing);
+		Save_FinishBatch(false);
+	}
+}
+
+/*
+=================
+Save_CheckWrites
+
+Cleans up after the writer thread once it's done. Called every frame.
+=================
+*/
+void Save_CheckWrites(void)
+{
+	if (save_running && save_writing.done)
+	{
+		Save_JoinThread();
+		Save_FinishBatch(true);
+	}
+}
+
+/*
+=================
+Save_WaitForWrites
+
+Blocks until all queued files are written
+=================
+*/
+void Save_WaitForWrites(void)
+{
+	Save_StartWrites();
+	Save_WaitForThread();
+}
+
+void Save_Stats_f(void)
+{
+	safe_cprintf(NULL, PRINT_HIGH, "Savegame writes: %d batches, %d files, %d bytes\n", save_stats.batches, save_stats.files, save_stats.bytes);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d ms of file I/O on the writer thread\n", save_stats.write_msec);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d ms waited on the game thread, %d ms taken off the frame\n", save_stats.wait_msec, max(save_stats.write_msec - save_stats.wait_msec, 0));
+
+	if (save_stats.failed)
+		safe_cprintf(NULL, PRINT_HIGH, "  %d files couldn't be written\n", save_stats.failed);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&save_stats, 0, sizeof(save_stats));
+}
@@ -0,0 +1,529 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_solid.c -- lets toss physics skip traces through open space.
+// Every gib, debris chunk, rain drop and grenade used to trace its move, look up its contents and
+// ask the engine for the triggers around it, every frame, though nearly all of those moves are
+// through empty air. This keeps its own copy of the engine's area lists: every linked entity that
+// isn't SOLID_NOT, filed by the box it was linked with in a hashed grid of SOLID_CELL squares.
+// Each moving entity also keeps an open box, space its own collision model (see g_cmodel.c) says
+// has no world brush of any kind in it, which stays good for the whole level. A move that stays
+// inside its open box and passes no entity a trace could hit can't be blocked, so SV_PushEntity
+// and SV_DebrisEntity skip the trace, and skip G_TouchTriggers when no trigger is near either.
+
+#include "g_local.h"
+
+#define SOLID_CELL			256		// map units
+#define SOLID_HASH			512		// grid buckets, a power of 2
+#define SOLID_LARGE			SOLID_HASH	// bucket for anything covering more than SOLID_MAX_CELLS cells
+#define SOLID_MAX_CELLS		4
+#define SOLID_OPEN_MARGIN	32		// open boxes reach at least this far past the move
+
+#define SOLIDTYPE_NONE		0
+#define SOLIDTYPE_BLOCK		1
+#define SOLIDTYPE_TRIGGER	2
+
+static int		solid_buckets[SOLID_HASH + 1];				// first link in the bucket, -1 for none
+static int		solid_next[MAX_EDICTS * SOLID_MAX_CELLS];	// links, SOLID_MAX_CELLS per entity
+static int		solid_prev[MAX_EDICTS * SOLID_MAX_CELLS];
+static short	solid_bucket[MAX_EDICTS * SOLID_MAX_CELLS];
+static byte		solid_links[MAX_EDICTS];	// links in use
+static byte		solid_type[MAX_EDICTS];		// SOLIDTYPE_*, as linked
+static vec3_t	solid_mins[MAX_EDICTS];		// absmin and absmax as linked
+static vec3_t	solid_maxs[MAX_EDICTS];
+static int		solid_checked[MAX_EDICTS];	// solid_query it was last looked at in
+static int		solid_query;
+
+static vec3_t	open_mins[MAX_EDICTS];
+static vec3_t	open_maxs[MAX_EDICTS];
+static qboolean	open_valid[MAX_EDICTS];
+
+static struct
+{
+	int		free;		// moves that skipped the trace
+	int		traced;
+	int		triggers;	// G_TouchTriggers skipped
+	int		opened;		// open boxes found
+	int		closed;		// open box tests that hit the world
+} solid_stats;
+
+static int Solid_Index(edict_t *ent)
+{
+	if (!g_edicts || ent < g_edicts || ent - g_edicts >= min(game.maxentities, MAX_EDICTS))
+		return -1;
+
+	return ent - g_edicts;
+}
+
+static int Solid_Cell(float f)
+{
+	return (int)floorf(f / SOLID_CELL);
+}
+
+static int Solid_Hash(int x, int y)
+{
+	return (int)(((unsigned)x * 73856093u ^ (unsigned)y * 19349663u) & (SOLID_HASH - 1));
+}
+
+static void Solid_Unfile(int index)
+{
+	for (int k = 0; k < solid_links[index]; k++)
+	{
+		const int link = index * SOLID_MAX_CELLS + k;
+
+		if (solid_prev[link] >= 0)
+			solid_next[solid_prev[link]] = solid_next[link];
+		else
+			solid_buckets[solid_bucket[link]] = solid_next[link];
+
+		if (solid_next[link] >= 0)
+			solid_prev[solid_next[link]] = solid_prev[link];
+	}
+
+	solid_links[index] = 0;
+	solid_type[index] = SOLIDTYPE_NONE;
+}
+
+static void Solid_File(int index, int bucket)
+{
+	// The same bucket twice only happens when cells share a hash
+	for (int k = 0; k < solid_links[index]; k++)
+		if (solid_bucket[index * SOLID_MAX_CELLS + k] == bucket)
+			return;
+
+	const int link = index * SOLID_MAX_CELLS + solid_links[index]++;
+	solid_bucket[link] = bucket;
+	solid_prev[link] = -1;
+	solid_next[link] = solid_buckets[bucket];
+	if (solid_next[link] >= 0)
+		solid_prev[solid_next[link]] = link;
+
+	solid_buckets[bucket] = link;
+}
+
+/*
+=================
+Solid_Link
+
+Files ent the way the engine just linked it. Called after every gi.linkentity and gi.unlinkentity.
+=================
+*/
+void Solid_Link(edict_t *ent, qboolean linked)
+{
+	const int index = Solid_Index(ent);
+	if (index <= 0)
+		return;
+
+	Solid_Unfile(index);
+
+	if (!linked || !ent->inuse || ent->solid == SOLID_NOT)
+		return;
+
+	solid_type[index] = (ent->solid == SOLID_TRIGGER ? SOLIDTYPE_TRIGGER : SOLIDTYPE_BLOCK);
+	VectorCopy(ent->absmin, solid_mins[index]);
+	VectorCopy(ent->absmax, solid_maxs[index]);
+
+	const int x0 = Solid_Cell(ent->absmin[0]), x1 = Solid_Cell(ent->absmax[0]);
+	const int y0 = Solid_Cell(ent->absmin[1]), y1 = Solid_Cell(ent->absmax[1]);
+
+	if ((x1 - x0 + 1) * (y1 - y0 + 1) > SOLID_MAX_CELLS)
+	{
+		Solid_File(index, SOLID_LARGE);
+		return;
+	}
+
+	for (int x = x0; x <= x1; x++)
+		for (int y = y0; y <= y1; y++)
+			Solid_File(index, Solid_Hash(x, y));
+}
+
+// Could a trace by ent with mask hit other? The same tests SV_ClipMoveToEntities makes.
+static qboolean Solid_CanHit(edict_t *ent, edict_t *other, int mask)
+{
+	if (other->solid == SOLID_NOT || other == ent)
+		return false;
+
+	// Contents lookups don't skip brush models, so always count those
+	if (other->solid == SOLID_BSP)
+		return true;
+
+	if (other->owner == ent || ent->owner == other)
+		return false;
+
+	if (!(mask & CONTENTS_DEADMONSTER) && (other->svflags & SVF_DEADMONSTER))
+		return false;
+
+	return true;
+}
+
+static int Solid_Bucket(int bucket, edict_t *ent, const vec3_t mins, const vec3_t maxs, int mask)
+{
+	int found = 0;
+
+	for (int link = solid_buckets[bucket]; link >= 0; link = solid_next[link])
+	{
+		const int index = link / SOLID_MAX_CELLS;
+		if (solid_checked[index] == solid_query)
+			continue;
+
+		solid_checked[index] = solid_query;
+
+		// Touching counts, as it does for gi.BoxEdicts
+		if (solid_mins[index][0] > maxs[0] || solid_mins[index][1] > maxs[1] || solid_mins[index][2] > maxs[2]
+		 || solid_maxs[index][0] < mins[0] || solid_maxs[index][1] < mins[1] || solid_maxs[index][2] < mins[2])
+			continue;
+
+		edict_t *other = &g_edicts[index];
+
+		if (solid_type[index] == SOLIDTYPE_TRIGGER)
+		{
+			if (other->inuse && other->touch)
+				found |= SOLIDTYPE_TRIGGER;
+		}
+		else if (Solid_CanHit(ent, other, mask))
+		{
+			found |= SOLIDTYPE_BLOCK;
+			break;
+		}
+	}
+
+	return found;
+}
+
+// SOLIDTYPE_BLOCK if a trace by ent with mask could hit something in the box, SOLIDTYPE_TRIGGER if it could touch a trigger there
+static int Solid_Find(edict_t *ent, const vec3_t mins, const vec3_t maxs, int mask)
+{
+	solid_query++;
+
+	int found = Solid_Bucket(SOLID_LARGE, ent, mins, maxs, mask);
+
+	const int x0 = Solid_Cell(mins[0]), x1 = Solid_Cell(maxs[0]);
+	const int y0 = Solid_Cell(mins[1]), y1 = Solid_Cell(maxs[1]);
+
+	for (int x = x0; x <= x1 && !(found & SOLIDTYPE_BLOCK); x++)
+		for (int y = y0; y <= y1 && !(found & SOLIDTYPE_BLOCK); y++)
+			found |= Solid_Bucket(Solid_Hash(x, y), ent, mins, maxs, mask);
+
+	return found;
+}
+
+static qboolean Solid_InOpen(int index, const vec3_t mins, const vec3_t maxs)
+{
+	return (open_valid[index]
+		 && mins[0] >= open_mins[index][0] && mins[1] >= open_mins[index][1] && mins[2] >= open_mins[index][2]
+		 && maxs[0] <= open_maxs[index][0] && maxs[1] <= open_maxs[index][1] && maxs[2] <= open_maxs[index][2]);
+}
+
+// Makes mins, maxs grown by margin ent's open box if the world has nothing in it
+static qboolean Solid_TryOpen(int index, const vec3_t mins, const vec3_t maxs, const vec3_t margin)
+{
+	vec3_t omins, omaxs, center, bmins, bmaxs;
+	for (int i = 0; i < 3; i++)
+	{
+		omins[i] = mins[i] - margin[i];
+		omaxs[i] = maxs[i] + margin[i];
+		center[i] = (omins[i] + omaxs[i]) * 0.5f;
+		bmaxs[i] = omaxs[i] - center[i];
+		bmins[i] = omins[i] - center[i];
+	}
+
+	// Touching a brush counts as being in it
+	trace_t tr;
+	if (!CModel_Trace(center, bmins, bmaxs, center, MASK_ALL, &tr) || tr.startsolid || tr.allsolid)
+		return false;
+
+	VectorCopy(omins, open_mins[index]);
+	VectorCopy(omaxs, open_maxs[index]);
+	open_valid[index] = true;
+
+	return true;
+}
+
+// Is the box in ent's open box, or can it be given one around it?
+static qboolean Solid_Open(int index, const vec3_t mins, const vec3_t maxs, const vec3_t move)
+{
+	if (Solid_InOpen(index, mins, maxs))
+		return true;
+
+	// Room for a few more moves like this one, or failing that just this one
+	vec3_t margin;
+	for (int i = 0; i < 3; i++)
+		margin[i] = max(SOLID_OPEN_MARGIN, fabsf(move[i]) * 4);
+
+	if (Solid_TryOpen(index, mins, maxs, margin))
+	{
+		solid_stats.opened++;
+		return true;
+	}
+
+	if (Solid_TryOpen(index, mins, maxs, vec3_origin))
+	{
+		solid_stats.opened++;
+		return true;
+	}
+
+	open_valid[index] = false;
+	solid_stats.closed++;
+
+	return false;
+}
+
+static int Solid_CompareIndex(const void *a, const void *b)
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+// Adds what's in bucket and touches the box to found
+static int Solid_Gather(int bucket, const vec3_t mins, const vec3_t maxs, int *found, int count)
+{
+	for (int link = solid_buckets[bucket]; link >= 0; link = solid_next[link])
+	{
+		const int index = link / SOLID_MAX_CELLS;
+		if (solid_checked[index] == solid_query)
+			continue;
+
+		solid_checked[index] = solid_query;
+
+		if (solid_mins[index][0] > maxs[0] || solid_mins[index][1] > maxs[1] || solid_mins[index][2] > maxs[2]
+		 || solid_maxs[index][0] < mins[0] || solid_maxs[index][1] < mins[1] || solid_maxs[index][2] < mins[2])
+			continue;
+
+		found[count++] = index;
+	}
+
+	return count;
+}
+
+/*
+=================
+Solid_BoxEdicts
+
+Like gi.BoxEdicts for both area lists: fills list with the linked solid and trigger entities whose
+box touches mins, maxs, in edict order. Returns how many there are.
+=================
+*/
+int Solid_BoxEdicts(const vec3_t mins, const vec3_t maxs, edict_t **list, int maxcount)
+{
+	static int found[MAX_EDICTS];
+	int count = 0;
+
+	solid_query++;
+
+	const int x0 = Solid_Cell(mins[0]), x1 = Solid_Cell(maxs[0]);
+	const int y0 = Solid_Cell(mins[1]), y1 = Solid_Cell(maxs[1]);
+
+	if ((x1 - x0 + 1) * (y1 - y0 + 1) > SOLID_HASH)
+	{
+		// Covers more cells than there are buckets
+		for (int bucket = 0; bucket <= SOLID_HASH; bucket++)
+			count = Solid_Gather(bucket, mins, maxs, found, count);
+	}
+	else
+	{
+		count = Solid_Gather(SOLID_LARGE, mins, maxs, found, count);
+
+		for (int x = x0; x <= x1; x++)
+			for (int y = y0; y <= y1; y++)
+				count = Solid_Gather(Solid_Hash(x, y), mins, maxs, found, count);
+	}
+
+	qsort(found, count, sizeof(found[0]), Solid_CompareIndex);
+
+	count = min(count, maxcount);
+	for (int i = 0; i < count; i++)
+		list[i] = &g_edicts[found[i]];
+
+	return count;
+}
+
+/*
+=================
+Solid_FreeMove
+
+True if nothing could stop ent's box moving from start to end with mask: no world brush of any
+contents near it and no entity a trace would hit. triggers is set if it may touch a trigger on the
+way, which only matters when it returns true.
+=================
+*/
+qboolean Solid_FreeMove(edict_t *ent, const vec3_t start, const vec3_t end, int mask, qboolean *triggers)
+{
+	*triggers = true;
+
+	const int index = Solid_Index(ent);
+	if (index <= 0 || !sv_freemove || !sv_freemove->value || ent->solid == SOLID_BSP)
+	{
+		solid_stats.traced++;
+		return false;
+	}
+
+	// The swept box with the engine's own unit of slack
+	vec3_t mins, maxs, move;
+	for (int i = 0; i < 3; i++)
+	{
+		mins[i] = min(start[i], end[i]) + ent->mins[i] - 1;
+		maxs[i] = max(start[i], end[i]) + ent->maxs[i] + 1;
+	}
+
+	VectorSubtract(end, start, move);
+
+	if (!Solid_Open(index, mins, maxs, move))
+	{
+		solid_stats.traced++;
+		return false;
+	}
+
+	const int found = Solid_Find(ent, mins, maxs, mask);
+	if (found & SOLIDTYPE_BLOCK)
+	{
+		solid_stats.traced++;
+		return false;
+	}
+
+	*triggers = ((found & SOLIDTYPE_TRIGGER) != 0);
+	if (!*triggers)
+		solid_stats.triggers++;
+
+	solid_stats.free++;
+	return true;
+}
+
+/*
+=================
+Solid_FreeTrace
+
+What gi.trace returns for a move that hit nothing
+=================
+*/
+trace_t Solid_FreeTrace(const vec3_t end)
+{
+	static csurface_t nullsurface;
+	trace_t trace;
+
+	memset(&trace, 0, sizeof(trace));
+	trace.fraction = 1;
+	VectorCopy(end, trace.endpos);
+	trace.surface = &nullsurface;
+	trace.ent = g_edicts;
+
+	return trace;
+}
+
+/*
+=================
+Solid_PointContents
+
+gi.pointcontents, answered from the collision model and the filed entities when that can be
+done exactly: brush models and points right on the edge of a box still go to the engine.
+=================
+*/
+int Solid_PointContents(const vec3_t p)
+{
+	vec3_t wmins, wmaxs;
+	if (!sv_freemove || !sv_freemove->value || !CModel_WorldBounds(wmins, wmaxs))
+		return gi.pointcontents((float *)p);
+
+	int contents = CModel_PointContents(p);
+
+	solid_query++;
+	const int buckets[2] = { SOLID_LARGE, Solid_Hash(Solid_Cell(p[0]), Solid_Cell(p[1])) };
+
+	for (int b = 0; b < 2; b++)
+	{
+		for (int link = solid_buckets[buckets[b]]; link >= 0; link = solid_next[link])
+		{
+			const int index = link / SOLID_MAX_CELLS;
+			if (solid_checked[index] == solid_query || solid_type[index] != SOLIDTYPE_BLOCK)
+				continue;
+
+			solid_checked[index] = solid_query;
+
+			if (solid_mins[index][0] > p[0] || solid_mins[index][1] > p[1] || solid_mins[index][2] > p[2]
+			 || solid_maxs[index][0] < p[0] || solid_maxs[index][1] < p[1] || solid_maxs[index][2] < p[2])
+				continue;
+
+			const edict_t *other = &g_edicts[index];
+			if (other->solid == SOLID_BSP)
+				return gi.pointcontents((float *)p);
+
+			// Anything else is a box of CONTENTS_MONSTER where it is now
+			qboolean inside = true;
+			for (int i = 0; i < 3; i++)
+			{
+				const float d = p[i] - other->s.origin[i];
+				if (d < other->mins[i] - 0.1f || d > other->maxs[i] + 0.1f)
+				{
+					inside = false;
+					break;
+				}
+
+				if (d < other->mins[i] + 0.1f || d > other->maxs[i] - 0.1f)
+					return gi.pointcontents((float *)p);
+			}
+
+			if (inside)
+				contents |= CONTENTS_MONSTER;
+		}
+	}
+
+	return contents;
+}
+
+/*
+=================
+Solid_Clear
+
+Forgets every entity and open box. Must be called whenever the edict array is replaced.
+=================
+*/
+void Solid_Clear(void)
+{
+	for (int i = 0; i <= SOLID_HASH; i++)
+		solid_buckets[i] = -1;
+
+	memset(solid_links, 0, sizeof(solid_links));
+	memset(solid_type, 0, sizeof(solid_type));
+	memset(open_valid, 0, sizeof(open_valid));
+}
+
+void Solid_Stats_f(void)
+{
+	int blocking = 0, triggers = 0, large = 0;
+
+	for (int i = 1; i < MAX_EDICTS; i++)
+	{
+		if (solid_type[i] == SOLIDTYPE_BLOCK)
+			blocking++;
+		else if (solid_type[i] == SOLIDTYPE_TRIGGER)
+			triggers++;
+	}
+
+	for (int link = solid_buckets[SOLID_LARGE]; link >= 0; link = solid_next[link])
+		large++;
+
+	vec3_t wmins, wmaxs;
+	safe_cprintf(NULL, PRINT_HIGH, "Free moves: %s\n", (sv_freemove->value ? (CModel_WorldBounds(wmins, wmaxs) ? "on" : "no collision model") : "off"));
+	safe_cprintf(NULL, PRINT_HIGH, "  %d solid and %d trigger entities filed, %d of them large\n", blocking, triggers, large);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d moves skipped the trace, %d traced, %d skipped the triggers\n", solid_stats.free, solid_stats.traced, solid_stats.triggers);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d open boxes found, %d tests hit the world\n", solid_stats.opened, solid_stats.closed);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&solid_stats, 0, sizeof(solid_stats));
+}
@@ -471,54 +471,95 @@ qboolean alias_from_pak;
 
 /*
 ===============
-ED_CallSpawn
+ED_FindSpawn
 
-Finds the spawn function for the entity and calls it
+Looks up the spawn function for classname. Items are returned in item, everything else in spawn.
+Returns false if there isn't one.
 ===============
 */
-void ED_CallSpawn(edict_t *ent)
+qboolean ED_FindSpawn(char *classname, gitem_t **item, void (**spawn)(edict_t *ent))
 {
-	gitem_t	*item;
+	gitem_t	*it;
 	int		i;
 
-	// Lazarus: if this fails, edict is freed.
-	if (!ent->classname)
-	{
-		gi.dprintf("ED_CallSpawn: NULL classname\n");
-		G_FreeEdict(ent);
-		return;
-	}
-
-	// Lazarus: Preserve original angles for movewith stuff before G_SetMoveDir wipes 'em out
-	VectorCopy(ent->s.angles, ent->org_angles);
+	*item = NULL;
+	*spawn = NULL;
 
 	// check item spawn functions
-	for (i = 0, item = itemlist; i < game.num_items; i++,item++)
+	for (i = 0, it = itemlist; i < game.num_items; i++, it++)
 	{
-		if (!item->classname)
+		if (!it->classname)
 			continue;
 
-		if (!strcmp(item->classname, ent->classname))
-		{	
-			// found it
-			SpawnItem(ent, item);
-			return;
+		if (!strcmp(it->classname, classname))
+		{
+			*item = it;
+			return true;
 		}
 	}
 
 	// check normal spawn functions
 	for (spawn_t *s = spawns; s->name; s++)
 	{
-		if (!strcmp(s->name, ent->classname))
-		{	
-			// found it
-			s->spawn(ent);
-			return;
+		if (!strcmp(s->name, classname))
+		{
+			*spawn = s->spawn;
+			return true;
 		}
 	}
 
-	gi.dprintf("%s doesn't have a spawn function\n", ent->classname);
-	G_FreeEdict(ent);
+	return false;
+}
+
+/*
+===============
+ED_CallSpawnFunc
+
+Spawns ent with a spawn function found by ED_FindSpawn. If both are NULL, ent is freed.
+===============
+*/
+void ED_CallSpawnFunc(edict_t *ent, gitem_t *item, void (*spawn)(edict_t *ent))
+{
+	// Lazarus: Preserve original angles for movewith stuff before G_SetMoveDir wipes 'em out
+	VectorCopy(ent->s.angles, ent->org_angles);
+
+	if (item)
+	{
+		SpawnItem(ent, item);
+	}
+	else if (spawn)
+	{
+		spawn(ent);
+	}
+	else
+	{
+		gi.dprintf("%s doesn't have a spawn function\n", ent->classname);
+		G_FreeEdict(ent);
+	}
+}
+
+/*
+===============
+ED_CallSpawn
+
+Finds the spawn function for the entity and calls it
+===============
+*/
+void ED_CallSpawn(edict_t *ent)
+{
+	gitem_t	*item;
+	void	(*spawn)(edict_t *ent);
+
+	// Lazarus: if this fails, edict is freed.
+	if (!ent->classname)
+	{
+		gi.dprintf("ED_CallSpawn: NULL classname\n");
+		G_FreeEdict(ent);
+		return;
+	}
+
+	ED_FindSpawn(ent->classname, &item, &spawn);
+	ED_CallSpawnFunc(ent, item, spawn);
 }
 
 /*
@@ -528,8 +569,11 @@ ED_NewString
 */
 char *ED_NewString(char *string)
 {
+	char buffer[MAX_STRING_CHARS];
 	const int l = strlen(string) + 1;
-	char *newb = gi.TagMalloc(l, TAG_LEVEL);
+
+	// Decoded strings are never longer than the original
+	char *newb = (l <= sizeof(buffer) ? buffer : G_TagMalloc(l, TAG_LEVEL, MEM_STRINGS));
 	char *new_p = newb;
 
 	for (int i = 0; i < l; i++)
@@ -545,8 +589,11 @@ char *ED_NewString(char *string)
 		else
 			*new_p++ = string[i];
 	}
+
+	if (newb != buffer)
+		return newb;
 	
-	return newb;
+	return G_InternString(buffer);
 }
 
 /*
@@ -638,7 +685,7 @@ char *ReadTextFile(char *filename, int *size)
 	len = ftell(fp);
 	fseek(fp, 0, SEEK_SET);
 
-	filestring = gi.TagMalloc(len + 1, TAG_LEVEL);
+	filestring = G_TagMalloc(len + 1, TAG_LEVEL, MEM_ENTFILE);
 	if (!filestring)
 	{
 		fclose(fp);
@@ -714,7 +761,7 @@ qboolean LoadAliasFile(char *name)
 							{
 								in_pak = true;
 								fseek(fpak,pakitem.start,SEEK_SET);
-								alias_data = gi.TagMalloc(pakitem.size + 1, TAG_LEVEL);
+								alias_data = G_TagMalloc(pakitem.size + 1, TAG_LEVEL, MEM_ENTFILE);
 								if (!alias_data) {
 									fclose(fpak);
 									gi.dprintf("LoadAliasData: Memory allocation failure for entalias.dat\n");
@@ -1137,6 +1184,10 @@ void SpawnEntities(char *mapname, char *entities, char *spawnpoint)
 	if (developer->value)
 		gi.dprintf("====== SpawnEntities ========\n");
 
+	// The engine looks for a saved copy of this level as soon as we return, and it may be the
+	// level file WriteLevel has just queued
+	Save_WaitForWrites();
+
 	float skill_level = floorf(skill->value);
 	if (skill_level < 0)
 		skill_level = 0;
@@ -1151,6 +1202,10 @@ void SpawnEntities(char *mapname, char *entities, char *spawnpoint)
 
 	memset(&level, 0, sizeof(level));
 	memset(g_edicts, 0, game.maxentities * sizeof(g_edicts[0]));
+	G_ClearRoles();
+	Solid_Clear();
+	Rider_Clear();
+	Think_Clear();
 
 	// Lazarus: these are used to track model and sound indices in g_main.c:
 	max_modelindex = 0;
@@ -1159,9 +1214,25 @@ void SpawnEntities(char *mapname, char *entities, char *spawnpoint)
 	// Lazarus: last frame a gib was spawned in
 	lastgibframe = 0;
 
+	// Mirror list lives in TAG_LEVEL memory
+	Reflect_ClearMirrors();
+	Fog_ClearIndex();
+	Path_ClearGraph();
+	Nav_ClearGraph();
+	Danger_Clear();
+	Cosmetic_Clear();
+	SpawnSpot_Clear();
+	Template_Clear();
+	G_ClearStrings();
+	TempEnt_Clear();
+	Save_ClearBaseline();
+
 	strncpy(level.mapname, mapname, sizeof(level.mapname)-1);
 	strncpy(game.spawnpoint, spawnpoint, sizeof(game.spawnpoint)-1);
 
+	// World collision model for the perception checks, kept if the map didn't change
+	CModel_LoadMap(level.mapname);
+
 	// Set client fields on player ents
 	for (i=0 ; i<game.maxclients ; i++)
 		g_edicts[i+1].client = game.clients + i;
@@ -1318,40 +1389,43 @@ removeflags:
 		if (!ent->movewith || ent->movewith_ent)
 			continue;
 
-		ent->movewith_ent = G_Find(NULL, FOFS(targetname), ent->movewith);
+		edict_t *parent = G_Find(NULL, FOFS(targetname), ent->movewith);
 		
 		// Make sure that we can really "movewith" this guy. This check
 		// allows us to have movewith parent with same targetname as
 		// other entities
-		while (ent->movewith_ent &&
-			(Q_stricmp(ent->movewith_ent->classname,"func_train")     &&
-			 Q_stricmp(ent->movewith_ent->classname,"model_train")    &&
-			 Q_stricmp(ent->movewith_ent->classname,"func_door")      &&
-			 Q_stricmp(ent->movewith_ent->classname,"func_vehicle")   &&
-			 Q_stricmp(ent->movewith_ent->classname,"func_tracktrain")  ))
+		while (parent &&
+			(Q_stricmp(parent->classname,"func_train")     &&
+			 Q_stricmp(parent->classname,"model_train")    &&
+			 Q_stricmp(parent->classname,"func_door")      &&
+			 Q_stricmp(parent->classname,"func_vehicle")   &&
+			 Q_stricmp(parent->classname,"func_tracktrain")  ))
 		{
-			ent->movewith_ent = G_Find(ent->movewith_ent, FOFS(targetname), ent->movewith);
+			parent = G_Find(parent, FOFS(targetname), ent->movewith);
 		}
 		
-		if (ent->movewith_ent)
-			movewith_init (ent->movewith_ent);
+		if (parent)
+			movewith_init (parent);
 	}
 
 /*	for (i=1, ent=g_edicts+i; i < globals.num_edicts; i++, ent++)
 	{
-		gi.dprintf("%s:%s - movewith=%s, movewith_ent=%s:%s, movewith_next=%s:%s\n====================\n",
+		gi.dprintf("%s:%s - movewith=%s, movewith_ent=%s:%s, movewith_child=%s:%s\n====================\n",
 			ent->classname, (ent->targetname ? ent->targetname : "noname"),
 			(ent->movewith ? ent->movewith : "N/A"),
 			(ent->movewith_ent ? ent->movewith_ent->classname : "N/A"),
 			(ent->movewith_ent ? (ent->movewith_ent->targetname ? ent->movewith_ent->targetname : "noname") : "N/A"),
-			(ent->movewith_next ? ent->movewith_next->classname : "N/A"),
-			(ent->movewith_next ? (ent->movewith_next->targetname ? ent->movewith_next->targetname : "noname") : "N/A"));
+			(ent->movewith_child ? ent->movewith_child->classname : "N/A"),
+			(ent->movewith_child ? (ent->movewith_child->targetname ? ent->movewith_child->targetname : "noname") : "N/A"));
 
 	} */
 
 	if (game.transition_ents)
 		LoadTransitionEnts();
 
+	// Pick up entities whose roles changed without a relink
+	G_RebuildRoles();
+
 	actor_files();
 }
 
@@ -0,0 +1,407 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_spawnspot.c -- deathmatch and CTF spawn point selection.
+// Each respawn used to G_Find its way through the edicts for the spots and measure every spot
+// against every player. The spots are now listed once a level, and each keeps its range, the
+// distance to the nearest live player, and which player that is. Every few frames the players
+// that have moved or died since they were last sampled are measured against the spots: one that
+// comes closer than a spot's range becomes its nearest, and a spot whose nearest moved away is
+// measured against everyone again. Picking a spot is then a pass over its list.
+// With sv_spawnvis set, players count as nearer to the spots in their PVS.
+
+#include "g_local.h"
+
+#define SPAWNSPOT_LISTS		4
+#define SPAWNSPOT_FRAMES	2		// frames between samples
+#define SPAWNSPOT_MOVE		16		// map units a player has to move to be sampled again
+#define SPAWNSPOT_NONE		9999999	// range with nobody around
+#define SPAWNSPOT_VISIBLE	0.5		// range scale for spots in a player's PVS
+
+typedef struct
+{
+	edict_t	*ent;
+	float	range;
+	int		nearest;	// client index, -1 for none
+} spawnspot_t;
+
+typedef struct
+{
+	char		*classname;
+	spawnspot_t	*spots;
+	int			count;
+} spotlist_t;
+
+typedef struct
+{
+	vec3_t		origin;		// where it was sampled
+	qboolean	alive;
+} spotclient_t;
+
+static spotlist_t spot_lists[SPAWNSPOT_LISTS] =
+{
+	{"info_player_deathmatch"},
+	{"info_player_team1"},
+	{"info_player_team2"},
+	{"info_player_team3"}
+};
+
+static spotclient_t	spot_clients[MAX_CLIENTS];
+static qboolean		spot_built;
+static qboolean		spot_vis;		// sv_spawnvis when the ranges were measured
+static int			spot_framenum;	// last sample
+
+static struct
+{
+	int		builds;
+	int		samples;	// players measured against the spots
+	int		remeasured;	// spots measured against everyone again
+	int		selections;
+} spot_stats;
+
+static float SpawnSpot_Range(const spawnspot_t *s, const spotclient_t *c)
+{
+	vec3_t v;
+	VectorSubtract(s->ent->s.origin, c->origin, v);
+	float range = VectorLength(v);
+
+	if (spot_vis && gi.inPVS(s->ent->s.origin, (float *)c->origin))
+		range *= SPAWNSPOT_VISIBLE;
+
+	return range;
+}
+
+// Range of s from every live player
+static void SpawnSpot_Measure(spawnspot_t *s)
+{
+	s->range = SPAWNSPOT_NONE;
+	s->nearest = -1;
+
+	for (int i = 0; i < min(game.maxclients, MAX_CLIENTS); i++)
+	{
+		if (!spot_clients[i].alive)
+			continue;
+
+		const float range = SpawnSpot_Range(s, &spot_clients[i]);
+		if (range < s->range)
+		{
+			s->range = range;
+			s->nearest = i;
+		}
+	}
+
+	spot_stats.remeasured++;
+}
+
+static qboolean SpawnSpot_SampleClient(int index)
+{
+	edict_t *player = &g_edicts[index + 1];
+	spotclient_t *c = &spot_clients[index];
+
+	const qboolean alive = (player->inuse && player->health > 0);
+	if (alive)
+	{
+		vec3_t v;
+		VectorSubtract(player->s.origin, c->origin, v);
+		if (c->alive && VectorLength(v) < SPAWNSPOT_MOVE)
+			return false;
+
+		VectorCopy(player->s.origin, c->origin);
+	}
+	else if (!c->alive)
+	{
+		return false;
+	}
+
+	c->alive = alive;
+	return true;
+}
+
+// Updates the ranges after the players in moved[] have been sampled
+static void SpawnSpot_Moved(const int *moved, int nummoved)
+{
+	for (int l = 0; l < SPAWNSPOT_LISTS; l++)
+	{
+		for (int i = 0; i < spot_lists[l].count; i++)
+		{
+			spawnspot_t *s = &spot_lists[l].spots[i];
+			qboolean remeasure = false;
+
+			for (int j = 0; j < nummoved; j++)
+			{
+				const spotclient_t *c = &spot_clients[moved[j]];
+				const float range = (c->alive ? SpawnSpot_Range(s, c) : SPAWNSPOT_NONE);
+
+				if (range < s->range)
+				{
+					s->range = range;
+					s->nearest = moved[j];
+					remeasure = false;
+				}
+				else if (s->nearest == moved[j])
+				{
+					remeasure = true; // Nearest went further away
+				}
+			}
+
+			if (remeasure)
+				SpawnSpot_Measure(s);
+		}
+	}
+
+	spot_stats.samples += nummoved;
+}
+
+static void SpawnSpot_Build(void)
+{
+	spot_built = true;
+	spot_vis = (sv_spawnvis && sv_spawnvis->value);
+	spot_framenum = level.framenum;
+	spot_stats.builds++;
+
+	for (int i = 0; i < MAX_CLIENTS; i++)
+	{
+		spot_clients[i].alive = false;
+		if (i < game.maxclients)
+			SpawnSpot_SampleClient(i);
+	}
+
+	for (int l = 0; l < SPAWNSPOT_LISTS; l++)
+	{
+		spotlist_t *list = &spot_lists[l];
+		edict_t *spot = NULL;
+
+		if (list->spots)
+			gi.TagFree(list->spots);
+
+		list->count = 0;
+		while ((spot = G_Find(spot, FOFS(classname), list->classname)) != NULL)
+			list->count++;
+
+		list->spots = (list->count ? G_TagMalloc(list->count * sizeof(spawnspot_t), TAG_LEVEL, MEM_SPAWNSPOTS) : NULL);
+
+		int i = 0;
+		while ((spot = G_Find(spot, FOFS(classname), list->classname)) != NULL)
+		{
+			list->spots[i].ent = spot;
+			SpawnSpot_Measure(&list->spots[i++]);
+		}
+	}
+}
+
+// The list for classname, listed and up to date
+static spotlist_t *SpawnSpot_List(char *classname)
+{
+	if (!spot_built || spot_vis != (sv_spawnvis->value != 0))
+		SpawnSpot_Build();
+
+	for (int l = 0; l < SPAWNSPOT_LISTS; l++)
+	{
+		spotlist_t *list = &spot_lists[l];
+		if (strcmp(list->classname, classname))
+			continue;
+
+		// A spot was removed
+		for (int i = 0; i < list->count; i++)
+		{
+			if (!list->spots[i].ent->inuse || !list->spots[i].ent->classname || strcmp(list->spots[i].ent->classname, classname))
+			{
+				SpawnSpot_Build();
+				break;
+			}
+		}
+
+		spot_stats.selections++;
+		return list;
+	}
+
+	return NULL;
+}
+
+/*
+=================
+SpawnSpot_Random
+
+A random classname spot, but not one of the two nearest to players. NULL if there are none.
+=================
+*/
+edict_t *SpawnSpot_Random(char *classname)
+{
+	spotlist_t *list = SpawnSpot_List(classname);
+	if (!list || !list->count)
+		return NULL;
+
+	int count = list->count;
+	int spot1 = -1, spot2 = -1;
+
+	if (count > 2)
+	{
+		for (int i = 0; i < list->count; i++)
+		{
+			const float range = list->spots[i].range;
+			if (range >= SPAWNSPOT_NONE)
+				continue;
+
+			if (spot1 < 0 || range < list->spots[spot1].range)
+			{
+				spot2 = spot1;
+				spot1 = i;
+			}
+			else if (spot2 < 0 || range < list->spots[spot2].range)
+			{
+				spot2 = i;
+			}
+		}
+
+		if (spot1 >= 0) count--;
+		if (spot2 >= 0) count--;
+	}
+
+	int selection = rand() % count;
+	for (int i = 0; i < list->count; i++)
+	{
+		if (i == spot1 || i == spot2)
+			continue;
+
+		if (!selection--)
+			return list->spots[i].ent;
+	}
+
+	return list->spots[0].ent;
+}
+
+/*
+=================
+SpawnSpot_Farthest
+
+The classname spot furthest from the nearest player. NULL if there are none.
+=================
+*/
+edict_t *SpawnSpot_Farthest(char *classname)
+{
+	spotlist_t *list = SpawnSpot_List(classname);
+	if (!list || !list->count)
+		return NULL;
+
+	spawnspot_t *best = NULL;
+	for (int i = 0; i < list->count; i++)
+	{
+		if (list->spots[i].range > (best ? best->range : 0))
+			best = &list->spots[i];
+	}
+
+	// If there is a player just spawned on each and every spot, one of them is getting telefragged
+	return (best ? best->ent : list->spots[0].ent);
+}
+
+/*
+=================
+SpawnSpot_ClientMoved
+
+Measures ent against the spots now, rather than at the next sample. PutClientInServer calls it
+before picking a spot, so the dead player doesn't count, and after, so the next player to spawn
+this frame doesn't pick the same spot.
+=================
+*/
+void SpawnSpot_ClientMoved(edict_t *ent)
+{
+	if (!deathmatch->value || !spot_built)
+		return;
+
+	const int index = ent - g_edicts - 1;
+	if (index < 0 || index >= min(game.maxclients, MAX_CLIENTS))
+		return;
+
+	if (SpawnSpot_SampleClient(index))
+		SpawnSpot_Moved(&index, 1);
+}
+
+/*
+=================
+SpawnSpot_Update
+
+Samples the players that have moved. Called at the end of each server frame.
+=================
+*/
+void SpawnSpot_Update(void)
+{
+	if (!deathmatch->value || !spot_built || level.framenum - spot_framenum < SPAWNSPOT_FRAMES)
+		return;
+
+	spot_framenum = level.framenum;
+
+	int moved[MAX_CLIENTS];
+	int nummoved = 0;
+
+	for (int i = 0; i < min(game.maxclients, MAX_CLIENTS); i++)
+		if (SpawnSpot_SampleClient(i))
+			moved[nummoved++] = i;
+
+	if (nummoved)
+		SpawnSpot_Moved(moved, nummoved);
+}
+
+/*
+=================
+SpawnSpot_Clear
+
+Forgets the lists. Called when the edicts are replaced (level change, savegame load).
+=================
+*/
+void SpawnSpot_Clear(void)
+{
+	spot_built = false;
+
+	for (int l = 0; l < SPAWNSPOT_LISTS; l++)
+	{
+		spot_lists[l].spots = NULL;
+		spot_lists[l].count = 0;
+	}
+}
+
+void SpawnSpot_Stats_f(void)
+{
+	safe_cprintf(NULL, PRINT_HIGH, "Spawn spots:%s\n", (spot_built ? (spot_vis ? " ranges scaled by visibility" : "") : " not listed yet"));
+
+	for (int l = 0; l < SPAWNSPOT_LISTS; l++)
+	{
+		const spotlist_t *list = &spot_lists[l];
+		if (!list->count)
+			continue;
+
+		float nearest = SPAWNSPOT_NONE, farthest = 0;
+		for (int i = 0; i < list->count; i++)
+		{
+			nearest = min(nearest, list->spots[i].range);
+			farthest = max(farthest, list->spots[i].range);
+		}
+
+		if (nearest >= SPAWNSPOT_NONE)
+			safe_cprintf(NULL, PRINT_HIGH, "  %-22s %3d spots, no players\n", list->classname, list->count);
+		else
+			safe_cprintf(NULL, PRINT_HIGH, "  %-22s %3d spots, ranges %.0f to %.0f\n", list->classname, list->count, nearest, farthest);
+	}
+
+	safe_cprintf(NULL, PRINT_HIGH, "  %d builds, %d players sampled, %d spots remeasured, %d selections\n", spot_stats.builds, spot_stats.samples, spot_stats.remeasured, spot_stats.selections);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&spot_stats, 0, sizeof(spot_stats));
+}
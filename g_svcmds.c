@@ -38,81 +38,256 @@ You can add or remove addresses from the filter list with:
 addip <ip>
 removeip <ip>
 
-The ip address is specified in dot format, and any unspecified digits will match any value, so you can specify an entire class C network with "addip 192.246.40".
+The ip address is specified in CIDR notation, "addip 192.246.40.0/24", or in dot format, where any unspecified or
+trailing zero digits will match any value, so you can also specify an entire class C network with "addip 192.246.40".
 
-Removeip will only remove an address specified exactly the same way.  You cannot addip a subnet, then removeip a single host.
+Removeip will only remove a range specified exactly the same way.  You cannot addip a subnet, then removeip a single host.
 
 listip
 Prints the current list of filters.
 
 writeip
-Dumps "addip <ip>" commands to listip.cfg so it can be execed at a later date.  The filter lists are not saved and restored by default, because I beleive it would cause too much confusion.
+Writes the filters to listip.dat, and a listip.cfg that sets filterban and loads them, so it can be execed at a later date.
+The filter lists are not saved and restored by default, because I beleive it would cause too much confusion.
+
+readip [file]
+Adds the filters in a file, listip.dat by default. Files written by writeip load in one read. Anything else is read
+as a text list of addresses, one per line, with # or // comments, which is what most shared ban lists look like.
 
 filterban <0 or 1>
 
 If 1 (the default), then ip addresses matching the current list will be prohibited from entering the game. This is the default setting.
 If 0, then only addresses matching the list will be allowed. This lets you easily set up a private game, or a game that only allows players from your local network.
 
+The filters are kept in a binary trie on the address bits, so checking an address takes at most 32 steps however many
+filters there are.
 
 ==============================================================================
 */
 
+// listip.dat is IPFILE_ID, then the version and the filter count, then the filters. Numbers are most significant byte first.
+#define IPFILE_ID		"IPFL"
+#define IPFILE_VERSION	1
+#define IPFILE_HEADER	12
+#define IPFILE_RULE		5	// address, then prefix bits
+
 typedef struct
 {
-	unsigned	mask;
-	unsigned	compare;
-} ipfilter_t;
+	int			child[2];	// by the next address bit, 0 for none (nothing links to the root)
+	qboolean	rule;		// a filter ends here
+} ipnode_t;
 
-#define	MAX_IPFILTERS	1024
+typedef struct
+{
+	ipnode_t	*nodes;		// nodes[0] is the root, /0
+	int			numnodes;
+	int			maxnodes;
+	int			freenodes;	// first unused node, chained through child[0]
+	int			numrules;
+} iptrie_t;
 
-ipfilter_t	ipfilters[MAX_IPFILTERS];
-int			numipfilters;
+static iptrie_t	ipfilters;
 
-/*
-=================
-StringToFilter
-=================
-*/
-static qboolean StringToFilter(char *s, ipfilter_t *f)
+static int IPTrie_NewNode(iptrie_t *t)
 {
-	char	num[128];
-	byte	b[4];
-	byte	m[4];
-	
-	for (int i = 0; i < 4; i++)
+	int node;
+	if (t->freenodes)
 	{
-		b[i] = 0;
-		m[i] = 0;
+		node = t->freenodes;
+		t->freenodes = t->nodes[node].child[0];
 	}
-	
-	for (int i = 0; i < 4; i++)
+	else
 	{
-		if (*s < '0' || *s > '9')
+		if (t->numnodes == t->maxnodes)
 		{
-			safe_cprintf(NULL, PRINT_HIGH, "Bad filter address: %s\n", s);
-			return false;
+			t->maxnodes = max(t->maxnodes * 2, 1024);
+			t->nodes = realloc(t->nodes, t->maxnodes * sizeof(ipnode_t));
+			if (!t->nodes)
+				gi.error("IPTrie_NewNode: couldn't allocate %d nodes", t->maxnodes);
 		}
-		
-		int j = 0;
-		while (*s >= '0' && *s <= '9')
+
+		node = t->numnodes++;
+	}
+
+	memset(&t->nodes[node], 0, sizeof(ipnode_t));
+	return node;
+}
+
+// Returns false if the filter was already there
+static qboolean IPTrie_Add(iptrie_t *t, unsigned addr, int bits)
+{
+	if (!t->numnodes)
+		IPTrie_NewNode(t);
+
+	int node = 0;
+	for (int i = 0; i < bits; i++)
+	{
+		const int bit = (addr >> (31 - i)) & 1;
+		if (!t->nodes[node].child[bit])
 		{
-			num[j++] = *s++;
+			const int child = IPTrie_NewNode(t); // May move nodes
+			t->nodes[node].child[bit] = child;
 		}
 
-		num[j] = 0;
-		b[i] = atoi(num);
-		if (b[i] != 0)
-			m[i] = 255;
+		node = t->nodes[node].child[bit];
+	}
+
+	if (t->nodes[node].rule)
+		return false;
+
+	t->nodes[node].rule = true;
+	t->numrules++;
+
+	return true;
+}
+
+// Returns false if there's no such filter
+static qboolean IPTrie_Remove(iptrie_t *t, unsigned addr, int bits)
+{
+	int path[33];
+	int node = 0;
+
+	if (!t->numnodes)
+		return false;
+
+	path[0] = 0;
+	for (int i = 0; i < bits; i++)
+	{
+		node = t->nodes[node].child[(addr >> (31 - i)) & 1];
+		if (!node)
+			return false;
+
+		path[i + 1] = node;
+	}
+
+	if (!t->nodes[node].rule)
+		return false;
+
+	t->nodes[node].rule = false;
+	t->numrules--;
 
-		if (!*s)
+	// Free the branch back up to where something else needs it
+	for (int i = bits; i > 0; i--)
+	{
+		ipnode_t *n = &t->nodes[path[i]];
+		if (n->rule || n->child[0] || n->child[1])
+			break;
+
+		t->nodes[path[i - 1]].child[(addr >> (32 - i)) & 1] = 0;
+		n->child[0] = t->freenodes;
+		t->freenodes = path[i];
+	}
+
+	return true;
+}
+
+static qboolean IPTrie_Match(const iptrie_t *t, unsigned addr)
+{
+	if (!t->numnodes)
+		return false;
+
+	const ipnode_t *nodes = t->nodes;
+	int node = 0;
+	for (int i = 0; !nodes[node].rule; i++)
+	{
+		if (i == 32)
+			return false;
+
+		node = nodes[node].child[(addr >> (31 - i)) & 1];
+		if (!node)
+			return false;
+	}
+
+	return true;
+}
+
+static void IPTrie_Free(iptrie_t *t)
+{
+	free(t->nodes);
+	memset(t, 0, sizeof(*t));
+}
+
+// Calls func for every filter, in address order
+static void IPTrie_Walk(const iptrie_t *t, int node, unsigned addr, int bits, void (*func)(unsigned addr, int bits, void *data), void *data)
+{
+	const ipnode_t *n = &t->nodes[node];
+
+	if (n->rule)
+		func(addr, bits, data);
+
+	for (int bit = 0; bit < 2; bit++)
+		if (n->child[bit])
+			IPTrie_Walk(t, n->child[bit], addr | ((unsigned)bit << (31 - bits)), bits + 1, func, data);
+}
+
+static void IP_ToString(unsigned addr, int bits, char *out, int size)
+{
+	Com_sprintf(out, size, "%i.%i.%i.%i/%i", addr >> 24, (addr >> 16) & 255, (addr >> 8) & 255, addr & 255, bits);
+}
+
+/*
+=================
+StringToFilter
+
+Parses "a.b.c.d/bits", or "a.b.c.d" with trailing zero octets matching anything
+=================
+*/
+static qboolean StringToFilter(char *s, unsigned *addr, int *bits, qboolean quiet)
+{
+	char	*start = s;
+	byte	b[4] = { 0, 0, 0, 0 };
+	int		octets = 0;
+
+	while (octets < 4)
+	{
+		if (*s < '0' || *s > '9')
+			break;
+
+		int num = 0;
+		while (*s >= '0' && *s <= '9' && num < 256)
+			num = num * 10 + (*s++ - '0');
+
+		if (num > 255)
+			break;
+
+		b[octets++] = num;
+
+		if (*s != '.')
 			break;
 
 		s++;
 	}
-	
-	f->mask = *(unsigned *)m;
-	f->compare = *(unsigned *)b;
-	
+
+	*addr = (b[0] << 24) | (b[1] << 16) | (b[2] << 8) | b[3];
+
+	if (octets && *s == '/')
+	{
+		*bits = 0;
+		for (s++; *s >= '0' && *s <= '9' && *bits <= 32; s++)
+			*bits = *bits * 10 + (*s - '0');
+
+		if (*bits > 32 || s[-1] == '/')
+			octets = 0;
+		else if (*bits < 32)
+			*addr &= ~(0xffffffffu >> *bits); // The host part doesn't matter
+	}
+	else
+	{
+		// Only the digits up to the last one that isn't 0
+		*bits = 0;
+		for (int i = 0; i < octets; i++)
+			if (b[i])
+				*bits = (i + 1) * 8;
+	}
+
+	if (!octets || *s)
+	{
+		if (!quiet)
+			safe_cprintf(NULL, PRINT_HIGH, "Bad filter address: %s\n", start);
+
+		return false;
+	}
+
 	return true;
 }
 
@@ -123,7 +298,7 @@ SV_FilterPacket
 */
 qboolean SV_FilterPacket(char *from)
 {
-	byte m[4];
+	byte m[4] = { 0, 0, 0, 0 };
 
 	int i = 0;
 	char *p = from;
@@ -143,11 +318,10 @@ qboolean SV_FilterPacket(char *from)
 		i++, p++;
 	}
 
-	const unsigned in = *(unsigned *)m;
+	const unsigned in = (m[0] << 24) | (m[1] << 16) | (m[2] << 8) | m[3];
 
-	for (i = 0; i < numipfilters; i++)
-		if ((in & ipfilters[i].mask) == ipfilters[i].compare)
-			return (int)filterban->value;
+	if (IPTrie_Match(&ipfilters, in))
+		return (int)filterban->value;
 
 	return (int)!filterban->value;
 }
@@ -166,24 +340,10 @@ void SVCmd_AddIP_f(void)
 		return;
 	}
 
-	int ipfilter;
-	for (ipfilter = 0; ipfilter < numipfilters; ipfilter++)
-		if (ipfilters[ipfilter].compare == 0xffffffff)
-			break; // free spot
-
-	if (ipfilter == numipfilters)
-	{
-		if (numipfilters == MAX_IPFILTERS)
-		{
-			safe_cprintf(NULL, PRINT_HIGH, "IP filter list is full\n");
-			return;
-		}
-
-		numipfilters++;
-	}
-	
-	if (!StringToFilter(gi.argv(2), &ipfilters[ipfilter]))
-		ipfilters[ipfilter].compare = 0xffffffff;
+	unsigned addr;
+	int bits;
+	if (StringToFilter(gi.argv(2), &addr, &bits, false))
+		IPTrie_Add(&ipfilters, addr, bits);
 }
 
 /*
@@ -199,25 +359,22 @@ void SVCmd_RemoveIP_f(void)
 		return;
 	}
 
-	ipfilter_t ipfilter;
-	if (!StringToFilter(gi.argv(2), &ipfilter))
+	unsigned addr;
+	int bits;
+	if (!StringToFilter(gi.argv(2), &addr, &bits, false))
 		return;
 
-	for (int i = 0; i < numipfilters; i++)
-	{
-		if (ipfilters[i].mask == ipfilter.mask	&& ipfilters[i].compare == ipfilter.compare)
-		{
-			for (int j = i + 1; j < numipfilters; j++)
-				ipfilters[j - 1] = ipfilters[j];
-
-			numipfilters--;
-			safe_cprintf(NULL, PRINT_HIGH, "Removed.\n");
-
-			return;
-		}
-	}
+	if (IPTrie_Remove(&ipfilters, addr, bits))
+		safe_cprintf(NULL, PRINT_HIGH, "Removed.\n");
+	else
+		safe_cprintf(NULL, PRINT_HIGH, "Didn't find %s.\n", gi.argv(2));
+}
 
-	safe_cprintf(NULL, PRINT_HIGH, "Didn't find %s.\n", gi.argv(2));
+static void ListIP_Print(unsigned addr, int bits, void *data)
+{
+	char s[32];
+	IP_ToString(addr, bits, s, sizeof(s));
+	safe_cprintf(NULL, PRINT_HIGH, "%s\n", s);
 }
 
 /*
@@ -227,14 +384,43 @@ SV_ListIP_f
 */
 void SVCmd_ListIP_f(void)
 {
-	byte	b[4];
+	safe_cprintf(NULL, PRINT_HIGH, "Filter list: %d filters\n", ipfilters.numrules);
 
-	safe_cprintf(NULL, PRINT_HIGH, "Filter list:\n");
-	for (int i = 0; i < numipfilters; i++)
-	{
-		*(unsigned *)b = ipfilters[i].compare;
-		safe_cprintf(NULL, PRINT_HIGH, "%3i.%3i.%3i.%3i\n", b[0], b[1], b[2], b[3]);
-	}
+	if (ipfilters.numnodes)
+		IPTrie_Walk(&ipfilters, 0, 0, 0, ListIP_Print, NULL);
+}
+
+static void IP_GameFileName(char *file, char *name, int size)
+{
+	cvar_t *game = gi.cvar("game", "", 0);
+
+	if (!*game->string)
+		Com_sprintf(name, size, "%s/%s", GAMEVERSION, file);
+	else
+		Com_sprintf(name, size, "%s/%s", game->string, file);
+}
+
+static void IP_PutLong(byte *p, unsigned l)
+{
+	p[0] = l >> 24;
+	p[1] = l >> 16;
+	p[2] = l >> 8;
+	p[3] = l;
+}
+
+static unsigned IP_GetLong(const byte *p)
+{
+	return ((unsigned)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static void WriteIP_Rule(unsigned addr, int bits, void *data)
+{
+	byte **p = data;
+
+	IP_PutLong(*p, addr);
+	(*p)[4] = bits;
+
+	*p += IPFILE_RULE;
 }
 
 /*
@@ -245,15 +431,8 @@ SV_WriteIP_f
 void SVCmd_WriteIP_f(void)
 {
 	char	name[MAX_OSPATH];
-	byte	b[4];
-
-	cvar_t *game = gi.cvar("game", "", 0);
-
-	if (!*game->string)
-		Com_sprintf(name, sizeof(name), "%s/listip.cfg", GAMEVERSION);
-	else
-		Com_sprintf(name, sizeof(name), "%s/listip.cfg", game->string);
 
+	IP_GameFileName("listip.dat", name, sizeof(name));
 	safe_cprintf(NULL, PRINT_HIGH, "Writing %s.\n", name);
 
 	FILE *f = fopen(name, "wb");
@@ -262,16 +441,387 @@ void SVCmd_WriteIP_f(void)
 		safe_cprintf(NULL, PRINT_HIGH, "Couldn't open %s\n", name);
 		return;
 	}
-	
+
+	const int size = IPFILE_HEADER + ipfilters.numrules * IPFILE_RULE;
+	byte *buf = malloc(size);
+	if (!buf)
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "writeip: out of memory\n");
+		fclose(f);
+		return;
+	}
+
+	memcpy(buf, IPFILE_ID, 4);
+	IP_PutLong(buf + 4, IPFILE_VERSION);
+	IP_PutLong(buf + 8, ipfilters.numrules);
+
+	byte *p = buf + IPFILE_HEADER;
+	if (ipfilters.numnodes)
+		IPTrie_Walk(&ipfilters, 0, 0, 0, WriteIP_Rule, &p);
+
+	if (fwrite(buf, 1, size, f) != (size_t)size)
+		safe_cprintf(NULL, PRINT_HIGH, "Couldn't write %s\n", name);
+
+	free(buf);
+	fclose(f);
+
+	// Servers that exec listip.cfg get the filters back
+	IP_GameFileName("listip.cfg", name, sizeof(name));
+	f = fopen(name, "wb");
+	if (!f)
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "Couldn't open %s\n", name);
+		return;
+	}
+
 	fprintf(f, "set filterban %d\n", (int)filterban->value);
+	fprintf(f, "sv readip listip.dat\n");
+	fclose(f);
+}
+
+// Adds the filters in a text list. Returns how many lines weren't addresses.
+static int ReadIP_Text(char *text, int *added)
+{
+	int bad = 0;
+
+	while (*text)
+	{
+		char *line = text;
+		while (*text && *text != '\n')
+			text++;
+
+		if (*text)
+			*text++ = 0;
+
+		// Strip comments and whitespace
+		char *c = strchr(line, '#');
+		if (c)
+			*c = 0;
+
+		c = strstr(line, "//");
+		if (c)
+			*c = 0;
+
+		while (*line == ' ' || *line == '\t')
+			line++;
+
+		c = line + strlen(line);
+		while (c > line && (c[-1] == ' ' || c[-1] == '\t' || c[-1] == '\r'))
+			*--c = 0;
+
+		if (!*line)
+			continue;
+
+		unsigned addr;
+		int bits;
+		if (!StringToFilter(line, &addr, &bits, true))
+			bad++;
+		else if (IPTrie_Add(&ipfilters, addr, bits))
+			(*added)++;
+	}
+
+	return bad;
+}
+
+/*
+=================
+SVCmd_ReadIP_f
+
+sv readip [file]
+=================
+*/
+void SVCmd_ReadIP_f(void)
+{
+	char	name[MAX_OSPATH];
+
+	IP_GameFileName((gi.argc() > 2 ? gi.argv(2) : "listip.dat"), name, sizeof(name));
 
-	for (int i = 0; i < numipfilters; i++)
+	FILE *f = fopen(name, "rb");
+	if (!f)
 	{
-		*(unsigned *)b = ipfilters[i].compare;
-		fprintf (f, "sv addip %i.%i.%i.%i\n", b[0], b[1], b[2], b[3]);
+		safe_cprintf(NULL, PRINT_HIGH, "Couldn't open %s\n", name);
+		return;
 	}
-	
+
+	fseek(f, 0, SEEK_END);
+	const int size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	byte *buf = malloc(size + 1);
+	if (!buf)
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "readip: out of memory\n");
+		fclose(f);
+		return;
+	}
+
+	const int length = fread(buf, 1, size, f);
 	fclose(f);
+	buf[length] = 0;
+
+	int added = 0, bad = 0;
+	if (length >= IPFILE_HEADER && !memcmp(buf, IPFILE_ID, 4))
+	{
+		const int count = IP_GetLong(buf + 8);
+		if (IP_GetLong(buf + 4) != IPFILE_VERSION || count < 0 || count > (length - IPFILE_HEADER) / IPFILE_RULE)
+		{
+			safe_cprintf(NULL, PRINT_HIGH, "%s is not a valid filter file\n", name);
+			free(buf);
+			return;
+		}
+
+		for (byte *rule = buf + IPFILE_HEADER; rule < buf + IPFILE_HEADER + count * IPFILE_RULE; rule += IPFILE_RULE)
+		{
+			if (rule[4] > 32)
+				bad++;
+			else if (IPTrie_Add(&ipfilters, IP_GetLong(rule), rule[4]))
+				added++;
+		}
+	}
+	else
+	{
+		bad = ReadIP_Text((char *)buf, &added);
+	}
+
+	free(buf);
+
+	safe_cprintf(NULL, PRINT_HIGH, "Read %s: %d filters added, %d in all\n", name, added, ipfilters.numrules);
+	if (bad)
+		safe_cprintf(NULL, PRINT_HIGH, "  %d entries weren't addresses\n", bad);
+}
+
+// xorshift32, so the benchmark doesn't touch the game's rand() and gets all 32 bits on every platform
+static unsigned IPBench_Random(unsigned *seed)
+{
+	unsigned x = *seed;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*seed = x;
+
+	return x;
+}
+
+/*
+=================
+SVCmd_IPBench_f
+
+sv ipbench [filters]
+Times filter lookups in a trie of random filters (100000 by default) against the old mask and compare scan.
+=================
+*/
+void SVCmd_IPBench_f(void)
+{
+	int count = atoi(gi.argv(2));
+	if (count <= 0)
+		count = 100000;
+
+	const int lookups = 1000000;
+	const int scans = max(1, min(lookups, 100000000 / count)); // The scan is too slow to do them all
+
+	unsigned *masks = malloc(count * sizeof(unsigned) * 2);
+	unsigned *addrs = malloc(lookups * sizeof(unsigned));
+	if (!masks || !addrs)
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "ipbench: out of memory\n");
+		free(masks);
+		free(addrs);
+		return;
+	}
+
+	unsigned *compares = masks + count;
+	unsigned seed = 2463534242u ^ (unsigned)count; // Same filters for the same count, never 0
+	iptrie_t trie;
+	memset(&trie, 0, sizeof(trie));
+
+	// Mostly /24 and single hosts, like shared ban lists
+	for (int i = 0; i < count; i++)
+	{
+		const int r = IPBench_Random(&seed) % 10;
+		const int bits = (r < 5 ? 24 : (r < 8 ? 32 : 16 + IPBench_Random(&seed) % 17));
+		masks[i] = (bits == 32 ? 0xffffffff : ~(0xffffffffu >> bits));
+
+		compares[i] = IPBench_Random(&seed) & masks[i];
+		IPTrie_Add(&trie, compares[i], bits);
+	}
+
+	// Half of them inside a filter
+	for (int i = 0; i < lookups; i++)
+	{
+		addrs[i] = IPBench_Random(&seed);
+		if (i & 1)
+		{
+			const int j = IPBench_Random(&seed) % count;
+			addrs[i] = compares[j] | (addrs[i] & ~masks[j]);
+		}
+	}
+
+	clock_t start = clock();
+	int hits = 0;
+	for (int i = 0; i < lookups; i++)
+		hits += IPTrie_Match(&trie, addrs[i]);
+	const float trie_seconds = (float)(clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	int scan_hits = 0;
+	for (int i = 0; i < scans; i++)
+	{
+		for (int j = 0; j < count; j++)
+		{
+			if ((addrs[i] & masks[j]) == compares[j])
+			{
+				scan_hits++;
+				break;
+			}
+		}
+	}
+	const float scan_seconds = (float)(clock() - start) / CLOCKS_PER_SEC;
+
+	// Check the trie against the scan
+	int wrong = 0;
+	for (int i = 0; i < scans; i++)
+	{
+		qboolean found = false;
+		for (int j = 0; j < count && !found; j++)
+			found = ((addrs[i] & masks[j]) == compares[j]);
+
+		if (found != IPTrie_Match(&trie, addrs[i]))
+			wrong++;
+	}
+
+	safe_cprintf(NULL, PRINT_HIGH, "%d filters, %d unique, %d trie nodes (%d KB)\n", count, trie.numrules, trie.numnodes, (int)(trie.numnodes * sizeof(ipnode_t) / 1024));
+	safe_cprintf(NULL, PRINT_HIGH, "trie: %d lookups, %d matched, %.0f per second\n", lookups, hits, (trie_seconds > 0 ? lookups / trie_seconds : 0));
+	safe_cprintf(NULL, PRINT_HIGH, "scan: %d lookups, %d matched, %.0f per second\n", scans, scan_hits, (scan_seconds > 0 ? scans / scan_seconds : 0));
+
+	if (wrong)
+		safe_cprintf(NULL, PRINT_HIGH, "%d lookups disagreed!\n", wrong);
+
+	IPTrie_Free(&trie);
+	free(masks);
+	free(addrs);
+}
+
+/*
+=================
+SVCmd_VecBench_f
+
+sv vecbench [count]
+Times the batch vector functions (AngleVectorsBatch etc.) against the single vector ones.
+=================
+*/
+static float VecBench_Rate(clock_t start, int vectors)
+{
+	const float seconds = (float)(clock() - start) / CLOCKS_PER_SEC;
+	return (seconds > 0 ? vectors / seconds / 1000000 : 0);
+}
+
+static void VecBench_Print(char *name, float scalar, float batch, float error)
+{
+	safe_cprintf(NULL, PRINT_HIGH, "%-16s %7.1f %7.1f  x%.2f  max error %g\n", name, scalar, batch, (scalar > 0 ? batch / scalar : 0), error);
+}
+
+void SVCmd_VecBench_f(void)
+{
+	int count = atoi(gi.argv(2));
+	if (count <= 0)
+		count = 4096;
+
+	const int passes = max(1, 2000000 / count);
+
+	vec3_t *angles = malloc(count * sizeof(vec3_t));
+	vec3_t *out = malloc(count * sizeof(vec3_t) * 6);
+	float *dist = malloc(count * sizeof(float) * 2);
+
+	if (!angles || !out || !dist)
+	{
+		safe_cprintf(NULL, PRINT_HIGH, "vecbench: out of memory\n");
+		free(angles);
+		free(out);
+		free(dist);
+		return;
+	}
+
+	vec3_t *forward = out, *right = out + count, *up = out + count * 2;
+	vec3_t *bforward = out + count * 3, *bright = out + count * 4, *bup = out + count * 5;
+	float *bdist = dist + count;
+	vec3_t point = { 100, -200, 50 };
+	float error = 0;
+	clock_t start;
+
+	for (int i = 0; i < count; i++)
+		for (int j = 0; j < 3; j++)
+			angles[i][j] = crandom() * 720;
+
+	safe_cprintf(NULL, PRINT_HIGH, "%d vectors x %d passes, million vectors per second:\n", count, passes);
+	safe_cprintf(NULL, PRINT_HIGH, "%-16s %7s %7s\n", "", "scalar", (idsse ? "sse2" : "batch"));
+
+	// AngleVectors
+	start = clock();
+	for (int p = 0; p < passes; p++)
+		for (int i = 0; i < count; i++)
+			AngleVectors(angles[i], forward[i], right[i], up[i]);
+	const float av_scalar = VecBench_Rate(start, count * passes);
+
+	start = clock();
+	for (int p = 0; p < passes; p++)
+		AngleVectorsBatch(angles, count, bforward, bright, bup);
+	const float av_batch = VecBench_Rate(start, count * passes);
+
+	for (int i = 0; i < count * 3; i++)
+		for (int j = 0; j < 3; j++)
+			error = max(error, fabsf(out[i][j] - out[count * 3 + i][j]));
+
+	VecBench_Print("AngleVectors", av_scalar, av_batch, error);
+
+	// Distance squared, using the angle vectors as points
+	error = 0;
+	start = clock();
+	for (int p = 0; p < passes; p++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			vec3_t v;
+			VectorSubtract(angles[i], point, v);
+			dist[i] = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+		}
+	}
+	const float ds_scalar = VecBench_Rate(start, count * passes);
+
+	start = clock();
+	for (int p = 0; p < passes; p++)
+		VectorDistSquaredBatch(point, angles[0], sizeof(vec3_t), count, bdist);
+	const float ds_batch = VecBench_Rate(start, count * passes);
+
+	for (int i = 0; i < count; i++)
+		error = max(error, fabsf(dist[i] - bdist[i]));
+
+	VecBench_Print("DistSquared", ds_scalar, ds_batch, error);
+
+	// VectorNormalize
+	error = 0;
+	memcpy(forward, angles, count * sizeof(vec3_t));
+	memcpy(bforward, angles, count * sizeof(vec3_t));
+
+	start = clock();
+	for (int p = 0; p < passes; p++)
+		for (int i = 0; i < count; i++)
+			dist[i] = VectorNormalize(forward[i]);
+	const float vn_scalar = VecBench_Rate(start, count * passes);
+
+	start = clock();
+	for (int p = 0; p < passes; p++)
+		VectorNormalizeBatch(bforward, count, bdist);
+	const float vn_batch = VecBench_Rate(start, count * passes);
+
+	for (int i = 0; i < count; i++)
+		for (int j = 0; j < 3; j++)
+			error = max(error, fabsf(forward[i][j] - bforward[i][j]));
+
+	VecBench_Print("VectorNormalize", vn_scalar, vn_batch, error);
+
+	free(angles);
+	free(out);
+	free(dist);
 }
 
 /*
@@ -296,6 +846,44 @@ void ServerCommand(void)
 		SVCmd_ListIP_f();
 	else if (Q_stricmp(cmd, "writeip") == 0)
 		SVCmd_WriteIP_f();
+	else if (Q_stricmp(cmd, "readip") == 0)
+		SVCmd_ReadIP_f();
+	else if (Q_stricmp(cmd, "ipbench") == 0)
+		SVCmd_IPBench_f();
+	else if (Q_stricmp(cmd, "tempents") == 0)
+		TempEnt_Stats_f();
+	else if (Q_stricmp(cmd, "strings") == 0)
+		G_StringStats_f();
+	else if (Q_stricmp(cmd, "templates") == 0)
+		Template_Stats_f();
+	else if (Q_stricmp(cmd, "mem") == 0)
+		G_MemStats_f();
+	else if (Q_stricmp(cmd, "vecbench") == 0)
+		SVCmd_VecBench_f();
+	else if (Q_stricmp(cmd, "cmodel") == 0)
+		CModel_Stats_f();
+	else if (Q_stricmp(cmd, "saves") == 0)
+		Save_Stats_f();
+	else if (Q_stricmp(cmd, "nav") == 0)
+		Nav_Stats_f();
+	else if (Q_stricmp(cmd, "danger") == 0)
+		Danger_Stats_f();
+	else if (Q_stricmp(cmd, "think") == 0)
+		Think_Stats_f();
+	else if (Q_stricmp(cmd, "cosmetics") == 0)
+		Cosmetic_Stats_f();
+	else if (Q_stricmp(cmd, "cmdlimit") == 0)
+		CmdLimit_Stats_f();
+	else if (Q_stricmp(cmd, "cmdcost") == 0)
+		CmdLimit_Cost_f();
+	else if (Q_stricmp(cmd, "spawnspots") == 0)
+		SpawnSpot_Stats_f();
+	else if (Q_stricmp(cmd, "freemove") == 0)
+		Solid_Stats_f();
+	else if (Q_stricmp(cmd, "riders") == 0)
+		Rider_Stats_f();
+	else if (Q_stricmp(cmd, "movewith") == 0)
+		Movewith_Stats_f();
 // ACEBOT_ADD
 	else if (Q_stricmp(cmd, "acedebug") == 0)
 	{
@@ -329,6 +917,9 @@ void ServerCommand(void)
 	// Node saving
 	else if (Q_stricmp(cmd, "savenodes") == 0)
 		ACEND_SaveNodes();
+	// Node table from the map geometry
+	else if (Q_stricmp(cmd, "acegen") == 0)
+		ACEND_GenerateNodes();
 // ACEBOT_END
 	// Knightmare added- DM pause
 	else if (Q_stricmp(cmd, "dmpause") == 0)
@@ -31,16 +31,16 @@ Fire an origin based temp entity event to the clients.
 */
 void Use_Target_Tent(edict_t *self, edict_t *other, edict_t *activator)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(self->style);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(self->style);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	self->count--;
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -83,7 +83,7 @@ void Use_Target_Speaker(edict_t *ent, edict_t *other, edict_t *activator)
 		if (ent->s.sound)
 		{
 			ent->s.sound = 0;	// turn it off
-			ent->nextthink = 0;
+			G_SetNextThink(ent, 0);
 		}
 		else
 		{
@@ -113,7 +113,7 @@ void Use_Target_Speaker(edict_t *ent, edict_t *other, edict_t *activator)
 		if (!ent->count)
 		{
 			ent->think = G_FreeEdict;
-			ent->nextthink = level.time + 1;
+			G_SetNextThink(ent, level.time + 1);
 		}
 	}
 }
@@ -133,12 +133,12 @@ void SP_target_speaker(edict_t *ent)
 		// DWH: Use "message" key to store noise for speakers that change levels via trigger_transition
 		if (!strstr(st.noise, ".wav"))
 		{
-			ent->message = gi.TagMalloc(strlen(st.noise) + 5, TAG_LEVEL);
+			ent->message = G_TagMalloc(strlen(st.noise) + 5, TAG_LEVEL, MEM_STRINGS);
 			sprintf(ent->message, "%s.wav", st.noise);
 		}
 		else
 		{
-			ent->message = gi.TagMalloc(strlen(st.noise) + 1, TAG_LEVEL);
+			ent->message = G_TagMalloc(strlen(st.noise) + 1, TAG_LEVEL, MEM_STRINGS);
 			strcpy(ent->message, st.noise);
 		}
 	}
@@ -189,7 +189,7 @@ void Use_Target_Help(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -341,10 +341,10 @@ void target_explosion_explode(edict_t *self)
 {
 	const int type = (self->spawnflags & 1 ? TE_EXPLOSION1_BIG : TE_EXPLOSION1); //mxd
 	
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(type); //Knightmare- big explosion
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PHS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(type); //Knightmare- big explosion
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PHS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(type, self->s.origin);
@@ -360,7 +360,7 @@ void target_explosion_explode(edict_t *self)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -375,7 +375,7 @@ void use_target_explosion(edict_t *self, edict_t *other, edict_t *activator)
 	}
 
 	self->think = target_explosion_explode;
-	self->nextthink = level.time + self->delay;
+	G_SetNextThink(self, level.time + self->delay);
 }
 
 void SP_target_explosion(edict_t *ent)
@@ -615,13 +615,13 @@ Set "sounds" to one of the following:
 
 void use_target_splash(edict_t *self, edict_t *other, edict_t *activator)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_SPLASH);
-	gi.WriteByte(self->count);
-	gi.WritePosition(self->s.origin);
-	gi.WriteDir(self->movedir);
-	gi.WriteByte(self->sounds);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_SPLASH);
+	TempEnt_WriteByte(self->count);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_WriteDir(self->movedir);
+	TempEnt_WriteByte(self->sounds);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (self->dmg)
 		T_RadiusDamage(self, activator, self->dmg, NULL, self->dmg + 40, MOD_SPLASH, -0.5);
@@ -663,7 +663,7 @@ void use_target_spawner(edict_t *self, edict_t *other, edict_t *activator)
 	ent->flags = self->flags;
 	VectorCopy(self->s.origin, ent->s.origin);
 	VectorCopy(self->s.angles, ent->s.angles);
-	ED_CallSpawn(ent);
+	Template_CallSpawn(Template_FindSpawner(self->target), ent);
 
 	if (ent && ent->inuse) // catch spawn failure
 	{
@@ -683,7 +683,7 @@ void use_target_spawner(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -694,6 +694,7 @@ void SP_target_spawner(edict_t *self)
 
 	self->use = use_target_spawner;
 	self->svflags = SVF_NOCLIENT;
+	Template_FindSpawner(self->target);
 
 	//Knightmare- a horrendously ugly hack for the insane spawner on fact2
 	if (!Q_stricmp(level.mapname, "fact2") && VectorCompare(self->s.origin, fact2spawnpoint1))
@@ -785,10 +786,10 @@ void use_target_blaster(edict_t *self, edict_t *other, edict_t *activator)
 	else if (self->sounds == 5)
 	{
 		fire_bullet(self, start, movedir, self->dmg, 2, 0, 0, MOD_TARGET_BLASTER);
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_CHAINFIST_SMOKE);
-		gi.WritePosition(start);
-		gi.multicast(start, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_CHAINFIST_SMOKE);
+		TempEnt_WritePosition(start);
+		TempEnt_Multicast(start, MULTICAST_PVS);
 		gi.positioned_sound(start, self, CHAN_WEAPON, gi.soundindex(va("weapons/machgf%db.wav", rand() % 5 + 1)), 1, ATTN_NORM, 0);
 	}
 	else if (self->sounds == 6)
@@ -845,7 +846,7 @@ void target_blaster_think(edict_t *self)
 		{
 			use_target_blaster(self,self,self);
 			if (self->wait)
-				self->nextthink = level.time + self->wait;
+				G_SetNextThink(self, level.time + self->wait);
 
 			return;
 		}
@@ -879,7 +880,7 @@ void target_blaster_think(edict_t *self)
 		{
 			use_target_blaster(self, self, self);
 			if (self->wait)
-				self->nextthink = level.time + self->wait;
+				G_SetNextThink(self, level.time + self->wait);
 
 			return;
 		}
@@ -940,11 +941,11 @@ void target_blaster_think(edict_t *self)
 	{
 		use_target_blaster(self, self, self);
 		if (self->wait)
-			self->nextthink = level.time + self->wait;
+			G_SetNextThink(self, level.time + self->wait);
 	}
 	else if (self->wait)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -963,12 +964,12 @@ void toggle_target_blaster(edict_t *self, edict_t *other, edict_t *activator)
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 		}
 		else
 		{
 			self->spawnflags &= ~4;
-			self->nextthink = 0;
+			G_SetNextThink(self, 0);
 		}
 	}
 	else
@@ -1011,9 +1012,9 @@ void SP_target_blaster(edict_t *self)
 		self->think = target_blaster_think;
 
 		if (self->spawnflags & 4)
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 		else
-			self->nextthink = 0;
+			G_SetNextThink(self, 0);
 	}
 	else if (self->target || (self->spawnflags & SEEK_PLAYER))
 	{
@@ -1021,7 +1022,7 @@ void SP_target_blaster(edict_t *self)
 		if (self->target)
 		{
 			self->think = target_blaster_init;
-			self->nextthink = level.time + 2*FRAMETIME;
+			G_SetNextThink(self, level.time + 2*FRAMETIME);
 		}
 	}
 	else
@@ -1077,7 +1078,7 @@ void SP_target_crosslevel_target(edict_t *self)
 
 	self->svflags = SVF_NOCLIENT;
 	self->think = target_crosslevel_target_think;
-	self->nextthink = level.time + self->delay;
+	G_SetNextThink(self, level.time + self->delay);
 }
 
 //==========================================================
@@ -1107,7 +1108,7 @@ void target_laser_ps_think(edict_t *self)
 		}
 		else if (level.time >= self->endtime)
 		{
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 			return;
 		}
 	}
@@ -1161,7 +1162,7 @@ void target_laser_ps_think(edict_t *self)
 	if (!self->enemy)
 	{
 		self->svflags |= SVF_NOCLIENT;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 
 		return;
 	}
@@ -1199,13 +1200,13 @@ void target_laser_ps_think(edict_t *self)
 			if ((self->spawnflags & 0x80000000) && self->style != 3)
 			{
 				self->spawnflags &= ~0x80000000;
-				gi.WriteByte(svc_temp_entity);
-				gi.WriteByte(TE_LASER_SPARKS);
-				gi.WriteByte(count);
-				gi.WritePosition(tr.endpos);
-				gi.WriteDir(tr.plane.normal);
-				gi.WriteByte(self->s.skinnum);
-				gi.multicast(tr.endpos, MULTICAST_PVS);
+				TempEnt_Begin();
+				TempEnt_WriteByte(TE_LASER_SPARKS);
+				TempEnt_WriteByte(count);
+				TempEnt_WritePosition(tr.endpos);
+				TempEnt_WriteDir(tr.plane.normal);
+				TempEnt_WriteByte(self->s.skinnum);
+				TempEnt_Multicast(tr.endpos, MULTICAST_PVS);
 			}
 
 			break;
@@ -1216,7 +1217,7 @@ void target_laser_ps_think(edict_t *self)
 	}
 
 	VectorCopy(tr.endpos, self->s.old_origin);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void target_laser_ps_on(edict_t *self)
@@ -1240,7 +1241,7 @@ void target_laser_ps_off(edict_t *self)
 {
 	self->spawnflags &= ~1;
 	self->svflags |= SVF_NOCLIENT;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 }
 
 void target_laser_ps_use(edict_t *self, edict_t *other, edict_t *activator)
@@ -1255,7 +1256,7 @@ void target_laser_ps_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 		}
 	}
 	else
@@ -1284,7 +1285,7 @@ void target_laser_think(edict_t *self)
 		}
 		else if (level.time >= self->endtime)
 		{
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 
 			return;
 		}
@@ -1332,13 +1333,13 @@ void target_laser_think(edict_t *self)
 			if ((self->spawnflags & 0x80000000) && self->style != 3)
 			{
 				self->spawnflags &= ~0x80000000;
-				gi.WriteByte(svc_temp_entity);
-				gi.WriteByte(TE_LASER_SPARKS);
-				gi.WriteByte(count);
-				gi.WritePosition(tr.endpos);
-				gi.WriteDir(tr.plane.normal);
-				gi.WriteByte(self->s.skinnum);
-				gi.multicast(tr.endpos, MULTICAST_PVS);
+				TempEnt_Begin();
+				TempEnt_WriteByte(TE_LASER_SPARKS);
+				TempEnt_WriteByte(count);
+				TempEnt_WritePosition(tr.endpos);
+				TempEnt_WriteDir(tr.plane.normal);
+				TempEnt_WriteByte(self->s.skinnum);
+				TempEnt_Multicast(tr.endpos, MULTICAST_PVS);
 			}
 
 			break;
@@ -1349,7 +1350,7 @@ void target_laser_think(edict_t *self)
 	}
 
 	VectorCopy(tr.endpos, self->s.old_origin);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void target_laser_on(edict_t *self)
@@ -1373,7 +1374,7 @@ void target_laser_off(edict_t *self)
 {
 	self->spawnflags &= ~1;
 	self->svflags |= SVF_NOCLIENT;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 }
 
 void target_laser_use(edict_t *self, edict_t *other, edict_t *activator)
@@ -1387,7 +1388,7 @@ void target_laser_use(edict_t *self, edict_t *other, edict_t *activator)
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 		}
 	}
 	else
@@ -1497,7 +1498,7 @@ void SP_target_laser(edict_t *self)
 
 	// Let everything else get spawned before we start firing
 	self->think = target_laser_start;
-	self->nextthink = level.time + 1;
+	G_SetNextThink(self, level.time + 1);
 }
 
 //==========================================================
@@ -1537,7 +1538,7 @@ void target_lightramp_think(edict_t *self)
 	{
 		if (self->movedir[0] <= self->movedir[1] || ((self->spawnflags & LIGHTRAMP_LOOP) && (self->spawnflags & LIGHTRAMP_ACTIVE)))
 		{
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 			if (self->movedir[0] > self->movedir[1])
 			{
 				self->movedir[0] = 0;
@@ -1555,7 +1556,7 @@ void target_lightramp_think(edict_t *self)
 			if (!self->count)
 			{
 				self->think = G_FreeEdict;
-				self->nextthink = level.time + 1;
+				G_SetNextThink(self, level.time + 1);
 			}
 		}
 	}
@@ -1563,7 +1564,7 @@ void target_lightramp_think(edict_t *self)
 	{
 		if (level.time - self->timestamp < self->speed)
 		{
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 		else if (self->spawnflags & LIGHTRAMP_TOGGLE)
 		{
@@ -1575,14 +1576,14 @@ void target_lightramp_think(edict_t *self)
 			if ((self->spawnflags & LIGHTRAMP_LOOP) && (self->spawnflags & LIGHTRAMP_ACTIVE))
 			{
 				self->timestamp = level.time;
-				self->nextthink = level.time + FRAMETIME;
+				G_SetNextThink(self, level.time + FRAMETIME);
 			}
 		}
 		else if ((self->spawnflags & LIGHTRAMP_LOOP) && (self->spawnflags & LIGHTRAMP_ACTIVE))
 		{
 			// Not toggled, looping. Start sequence over
 			self->timestamp = level.time;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 		else
 		{
@@ -1590,7 +1591,7 @@ void target_lightramp_think(edict_t *self)
 			if (!self->count)
 			{
 				self->think = G_FreeEdict;
-				self->nextthink = level.time + 1;
+				G_SetNextThink(self, level.time + 1);
 			}
 		}
 	}
@@ -1745,13 +1746,13 @@ void target_earthquake_think(edict_t *self)
 	}
 
 	if (level.time < self->timestamp || (self->spawnflags & 1)) //mxd. Added "Infinite duration" flag
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void target_earthquake_use(edict_t *self, edict_t *other, edict_t *activator)
 {
 	self->timestamp = level.time + self->count;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->activator = activator;
 	self->last_move_time = 0;
 }
@@ -1925,7 +1926,7 @@ void SP_target_locator(edict_t *self)
 	}
 
 	self->think = target_locator_init;
-	self->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(self, level.time + 2 * FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -2057,7 +2058,7 @@ void use_target_anger(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -2104,7 +2105,7 @@ void SP_target_anger(edict_t *self)
 	if (self->spawnflags & 1)
 	{
 		self->think = target_anger_autotrigger;
-		self->nextthink = level.time + 1.0f + self->wait;
+		G_SetNextThink(self, level.time + 1.0f + self->wait);
 		self->activator = self;
 	}
 }
@@ -2147,7 +2148,7 @@ void use_target_monsterbattle(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -2207,15 +2208,17 @@ void ThrowRock(edict_t *self, char *modelname, float speed, const vec3_t origin,
 	chunk->attenuation = 0.5;
 	chunk->solid = SOLID_NOT;
 	chunk->think = gib_fade; // was FadeDieThink
-	chunk->nextthink = level.time + 15 + random() * 5;
+	G_SetNextThink(chunk, level.time + 15 + random() * 5);
 	chunk->s.frame = 0;
 	chunk->flags = 0;
 	chunk->classname = "debris";
+	chunk->class_id = ENTITY_DEBRIS;
 	chunk->takedamage = DAMAGE_YES;
 	chunk->die = directed_debris_die;
 	chunk->mass = mass;
 
 	gi.linkentity(chunk);
+	Cosmetic_Add(chunk);
 }
 
 void use_target_rocks(edict_t *self, edict_t *other, edict_t *activator)
@@ -2264,7 +2267,7 @@ void use_target_rocks(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 
 }
@@ -2348,7 +2351,7 @@ void use_target_rotation(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -2398,11 +2401,11 @@ TE_FORCEWALL,          37  ??
 */
 void target_effect_at(edict_t *self, edict_t *activator)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(self->style);
-	gi.WritePosition(self->s.origin);
-	gi.WriteShort(self - g_edicts);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(self->style);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_WriteShort(self - g_edicts);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 }
 
 /* Poor man's target_steam
@@ -2423,16 +2426,16 @@ void target_effect_steam(edict_t *self, edict_t *activator)
 
 	nextid++;
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(self->style);
-	gi.WriteShort(nextid);
-	gi.WriteByte(self->count);
-	gi.WritePosition(self->s.origin);
-	gi.WriteDir(self->movedir);
-	gi.WriteByte(self->sounds&0xff);
-	gi.WriteShort((int)self->speed);
-	gi.WriteLong((int)wait);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(self->style);
+	TempEnt_WriteShort(nextid);
+	TempEnt_WriteByte(self->count);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_WriteDir(self->movedir);
+	TempEnt_WriteByte(self->sounds&0xff);
+	TempEnt_WriteShort((int)self->speed);
+	TempEnt_WriteLong((int)wait);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectSteam(self->s.origin, self->movedir, self->count, self->sounds, (int)self->speed, wait, nextid);
@@ -2451,13 +2454,13 @@ moving in (movedir) direction.
 
 void target_effect_splash(edict_t *self, edict_t *activator)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(self->style);
-	gi.WriteByte(self->count);
-	gi.WritePosition(self->s.origin);
-	gi.WriteDir(self->movedir);
-	gi.WriteByte(self->sounds);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(self->style);
+	TempEnt_WriteByte(self->count);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_WriteDir(self->movedir);
+	TempEnt_WriteByte(self->sounds);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 }
 
 //======================================================
@@ -2485,8 +2488,8 @@ void target_effect_trail(edict_t *self, edict_t *activator)
 	edict_t *target = G_Find(NULL, FOFS(targetname), self->target);
 	if (!target) return;
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(self->style);
+	TempEnt_Begin();
+	TempEnt_WriteByte(self->style);
 
 	if (self->style == TE_PARASITE_ATTACK	 ||
 		self->style == TE_MEDIC_CABLE_ATTACK ||
@@ -2494,17 +2497,17 @@ void target_effect_trail(edict_t *self, edict_t *activator)
 		self->style == TE_MONSTER_HEATBEAM	 ||
 		self->style == TE_GRAPPLE_CABLE)
 	{
-		gi.WriteShort(self - g_edicts);
+		TempEnt_WriteShort(self - g_edicts);
 	}
 		
 
-	gi.WritePosition(self->s.origin);
-	gi.WritePosition(target->s.origin);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_WritePosition(target->s.origin);
 
 	if (self->style == TE_GRAPPLE_CABLE) 
-		gi.WritePosition(vec3_origin);
+		TempEnt_WritePosition(vec3_origin);
 
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 	{
@@ -2531,13 +2534,13 @@ void target_effect_lightning(edict_t *self, edict_t *activator)
 	if (!target)
 		return;
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(self->style);
-	gi.WriteShort(target - g_edicts);	// destination entity
-	gi.WriteShort(self - g_edicts);		// source entity
-	gi.WritePosition(target->s.origin);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(self->style);
+	TempEnt_WriteShort(target - g_edicts);	// destination entity
+	TempEnt_WriteShort(self - g_edicts);		// source entity
+	TempEnt_WritePosition(target->s.origin);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 }
 //===========================================================================
 /*
@@ -2566,14 +2569,14 @@ Broadcasts to all in Potentially Visible Set from vector (origin)
 
 void target_effect_sparks(edict_t *self, edict_t *activator)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(self->style);
-	gi.WritePosition(self->s.origin);
+	TempEnt_Begin();
+	TempEnt_WriteByte(self->style);
+	TempEnt_WritePosition(self->s.origin);
 
 	if (self->style != TE_CHAINFIST_SMOKE) 
-		gi.WriteDir(self->movedir);
+		TempEnt_WriteDir(self->movedir);
 
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectSparks(self->style, self->s.origin, self->movedir);
@@ -2606,10 +2609,10 @@ Potentially Hearable set from vector (origin)
 //==============================================================================
 void target_effect_explosion(edict_t *self, edict_t *activator)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(self->style);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PHS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(self->style);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PHS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(self->style, self->s.origin);
@@ -2628,13 +2631,13 @@ void target_effect_tunnel_sparks(edict_t *self, edict_t *activator)
 	for (int i = 0; i < self->count; i++)
 	{
 		origin[2] += self->speed * 0.01f * (i + random());
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(self->style);
-		gi.WriteByte(1);
-		gi.WritePosition(origin);
-		gi.WriteDir(vec3_origin);
-		gi.WriteByte(self->sounds + (rand()&7));  // color
-		gi.multicast(self->s.origin, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(self->style);
+		TempEnt_WriteByte(1);
+		TempEnt_WritePosition(origin);
+		TempEnt_WriteDir(vec3_origin);
+		TempEnt_WriteByte(self->sounds + (rand()&7));  // color
+		TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 	}
 }
 //===============================================================================
@@ -2642,11 +2645,11 @@ void target_effect_tunnel_sparks(edict_t *self, edict_t *activator)
 */
 void target_effect_widowbeam(edict_t *self, edict_t *activator)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_WIDOWBEAMOUT);
-	gi.WriteShort(20001);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_WIDOWBEAMOUT);
+	TempEnt_WriteShort(20001);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 }
 //===============================================================================
 
@@ -2657,7 +2660,7 @@ void target_effect_use(edict_t *self, edict_t *other, edict_t *activator)
 		// currently looped on - turn it off
 		self->spawnflags &= ~1;
 		self->spawnflags |= 2;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 
 		return;
 	}
@@ -2667,7 +2670,7 @@ void target_effect_use(edict_t *self, edict_t *other, edict_t *activator)
 		// currently looped off - turn it on
 		self->spawnflags &= ~2;
 		self->spawnflags |= 1;
-		self->nextthink = level.time + self->wait;
+		G_SetNextThink(self, level.time + self->wait);
 	}
 
 	if (self->spawnflags & 4)
@@ -2686,7 +2689,7 @@ void target_effect_use(edict_t *self, edict_t *other, edict_t *activator)
 void target_effect_think(edict_t *self)
 {
 	self->play(self, NULL);
-	self->nextthink = level.time + self->wait;
+	G_SetNextThink(self, level.time + self->wait);
 }
 //===============================================================================
 void SP_target_effect(edict_t *self)
@@ -2819,7 +2822,7 @@ void SP_target_effect(edict_t *self)
 	self->think = target_effect_think;
 
 	if (self->spawnflags & 1)
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 }
 
 /*=====================================================================================
@@ -2903,11 +2906,8 @@ void target_attractor_think_single(edict_t *self)
 
 	if (self->spawnflags & ATTRACTOR_MONSTER)
 	{
-		for (i = 1, ent = &g_edicts[i]; i <= globals.num_edicts; i++, ent++)
+		for (ent = G_NextRole(NULL, ROLE_MONSTER); ent; ent = G_NextRole(ent, ROLE_MONSTER))
 		{
-			if (!ent->inuse || ent->health <= 0 || !(ent->svflags & SVF_MONSTER))
-				continue;
-
 			num_targets++;
 			VectorSubtract(self->s.origin,ent->s.origin,dir);
 			dist = VectorLength(dir);
@@ -2967,7 +2967,7 @@ void target_attractor_think_single(edict_t *self)
 	if (!target)
 	{
 		if (num_targets > 0) 
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 
 		return;
 	}
@@ -3075,20 +3075,20 @@ void target_attractor_think_single(edict_t *self)
 		switch(self->sounds)
 		{
 		case 1:
-			gi.WriteByte(svc_temp_entity);
-			gi.WriteByte(TE_MEDIC_CABLE_ATTACK);
-			gi.WriteShort(self-g_edicts);
-			gi.WritePosition(self->s.origin);
-			gi.WritePosition(new_origin);
-			gi.multicast(self->s.origin, MULTICAST_PVS);
+			TempEnt_Begin();
+			TempEnt_WriteByte(TE_MEDIC_CABLE_ATTACK);
+			TempEnt_WriteShort(self-g_edicts);
+			TempEnt_WritePosition(self->s.origin);
+			TempEnt_WritePosition(new_origin);
+			TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 			break;
 
 		case 2:
-			gi.WriteByte(svc_temp_entity);
-			gi.WriteByte(TE_BFG_LASER);
-			gi.WritePosition(self->s.origin);
-			gi.WritePosition(new_origin);
-			gi.multicast(self->s.origin, MULTICAST_PVS);
+			TempEnt_Begin();
+			TempEnt_WriteByte(TE_BFG_LASER);
+			TempEnt_WritePosition(self->s.origin);
+			TempEnt_WritePosition(new_origin);
+			TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 		}
 	}
 
@@ -3101,7 +3101,7 @@ void target_attractor_think_single(edict_t *self)
 	if (!num_targets)
 		self->spawnflags &= ~ATTRACTOR_ON; // shut 'er down
 	else
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void target_attractor_think(edict_t *self)
@@ -3124,26 +3124,18 @@ void target_attractor_think(edict_t *self)
 	}
 
 	edict_t *target = NULL;
-	int ent_start = 1;
+	int roles = 0;
+
+	if (self->spawnflags & ATTRACTOR_PLAYER)
+		roles |= ROLE_CLIENT;
+	if (self->spawnflags & ATTRACTOR_MONSTER)
+		roles |= ROLE_MONSTER;
 
 	while (true)
 	{
-		if (self->spawnflags & (ATTRACTOR_PLAYER | ATTRACTOR_MONSTER)) //mxd. ATTRACTOR_PLAYER || ATTRACTOR_MONSTER --> ATTRACTOR_PLAYER | ATTRACTOR_MONSTER
+		if (roles)
 		{
-			target = NULL;
-			for (i = ent_start, ent = &g_edicts[ent_start]; i < globals.num_edicts && !target; i++, ent++)
-			{
-				if ((self->spawnflags & ATTRACTOR_PLAYER) && ent->client && ent->inuse)
-				{
-					target = ent;
-					ent_start = i + 1;
-				}
-				else if ((self->spawnflags & ATTRACTOR_MONSTER) && (ent->svflags & SVF_MONSTER) && ent->inuse)
-				{
-					target = ent;
-					ent_start = i + 1;
-				}
-			}
+			target = G_NextRole(target, roles);
 		}
 		else
 		{
@@ -3260,7 +3252,7 @@ void target_attractor_think(edict_t *self)
 	if (!num_targets)
 		self->spawnflags &= ~ATTRACTOR_ON; // shut 'er down
 	else
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void use_target_attractor(edict_t *self, edict_t *other, edict_t *activator)
@@ -3271,14 +3263,14 @@ void use_target_attractor(edict_t *self, edict_t *other, edict_t *activator)
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + 1;
+			G_SetNextThink(self, level.time + 1);
 		}
 		else
 		{
 			self->spawnflags &= ~ATTRACTOR_ON;
 			self->s.sound = 0;
 			self->target_ent  = NULL;
-			self->nextthink   = 0;
+			G_SetNextThink(self, 0);
 		}
 	}
 	else
@@ -3349,7 +3341,7 @@ void SP_target_attractor(edict_t *self)
 			self->think = target_attractor_think;
 
 		if (self->sounds)
-			self->nextthink = level.time + 2 * FRAMETIME;
+			G_SetNextThink(self, level.time + 2 * FRAMETIME);
 		else
 			self->think(self);
 	}
@@ -3378,7 +3370,7 @@ void use_target_CD(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -3463,7 +3455,7 @@ void target_monitor_off(edict_t *self)
 	{
 		self->use = NULL;
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -3477,7 +3469,7 @@ void target_monitor_move(edict_t *self)
 		if (self->wait)
 		{
 			self->think = target_monitor_off;
-			self->nextthink = self->monsterinfo.attack_finished;
+			G_SetNextThink(self, self->monsterinfo.attack_finished);
 		}
 
 		return;
@@ -3520,7 +3512,7 @@ void target_monitor_move(edict_t *self)
 	}
 
 	VectorCopy(goal, self->s.origin);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -3561,7 +3553,7 @@ void use_target_monitor(edict_t *self, edict_t *other, edict_t *activator)
 	faker->takedamage = DAMAGE_NO;	// so monsters won't attack
 	faker->flags |= FL_NOTARGET;    // ... just to make sure
 	faker->movetype = MOVETYPE_TOSS;
-	faker->groundentity = activator->groundentity;
+	G_SetGroundEntity(faker, activator->groundentity);
 	faker->viewheight = activator->viewheight;
 	faker->inuse = true;
 	faker->classname = "camplayer";
@@ -3572,13 +3564,13 @@ void use_target_monitor(edict_t *self, edict_t *other, edict_t *activator)
 	faker->health = 100000;			// invulnerable
 	faker->light_level = activator->light_level;
 	faker->think = faker_animate;
-	faker->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(faker, level.time + FRAMETIME);
 	faker->targetname = "fake_player"; //mxd. Hacky way to make it targetable from a map editor...
 	VectorCopy(activator->mins, faker->mins);
 	VectorCopy(activator->maxs, faker->maxs);
 
 	// Create a client so you can pick up items/be shot/etc while in camera
-	gclient_t *cl = (gclient_t *)gi.TagMalloc(sizeof(gclient_t), TAG_LEVEL);
+	gclient_t *cl = (gclient_t *)G_TagMalloc(sizeof(gclient_t), TAG_LEVEL, MEM_FAKECLIENT);
 	faker->client = cl; 
 	faker->target_ent = activator;
 	gi.linkentity(faker); 
@@ -3689,7 +3681,7 @@ void use_target_monitor(edict_t *self, edict_t *other, edict_t *activator)
 	else if (self->wait > 0)
 	{
 		self->think = target_monitor_off;
-		self->nextthink = level.time + self->wait;
+		G_SetNextThink(self, level.time + self->wait);
 	}
 }
 
@@ -3764,18 +3756,18 @@ void target_animate(edict_t *ent)
 		if (ent->monsterinfo.currentmove->endfunc)
 		{
 			ent->think = ent->monsterinfo.currentmove->endfunc;
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(ent, level.time + FRAMETIME);
 		}
 		else if (ent->svflags & SVF_MONSTER)
 		{
 			// Hopefully we don't get here, but if we DO then we definitely need for monsters/actors to turn their brains back on.
 			ent->think = monster_think;
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(ent, level.time + FRAMETIME);
 		}
 		else
 		{
 			ent->think = NULL;
-			ent->nextthink = 0;
+			G_SetNextThink(ent, 0);
 		}
 
 		ent->monsterinfo.currentmove = ent->monsterinfo.savemove;
@@ -3783,7 +3775,7 @@ void target_animate(edict_t *ent)
 	}
 
 	ent->s.frame++;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	gi.linkentity(ent);
 }
 
@@ -3828,7 +3820,7 @@ void target_animation_use(edict_t *self, edict_t *other, edict_t *activator)
 	target->think = target_animate;
 	target->monsterinfo.savemove = target->monsterinfo.currentmove;
 	target->monsterinfo.currentmove = self->monsterinfo.currentmove;
-	target->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(target, level.time + FRAMETIME);
 	gi.linkentity(target);
 
 	self->count--;
@@ -3955,7 +3947,7 @@ void target_failure_player_die(edict_t *player)
 	target_failure_player_die(self->target_ent);
 	self->target_ent = NULL;
 	self->think = target_failure_wipe;
-	self->nextthink = level.time + 10;
+	G_SetNextThink(self, level.time + 10);
 }*/
 
 void target_failure_fade_lights(edict_t *self)
@@ -3970,14 +3962,14 @@ void target_failure_fade_lights(edict_t *self)
 	if (self->flags)
 	{
 		self->flags--;
-		self->nextthink = level.time + 0.2;
+		G_SetNextThink(self, level.time + 0.2);
 	}
 	else
 	{
 		target_failure_player_die(self->target_ent);
 		self->target_ent = NULL;
 		self->think = target_failure_wipe;
-		self->nextthink = level.time + 10;
+		G_SetNextThink(self, level.time + 10);
 	}
 }
 
@@ -4000,7 +3992,7 @@ void use_target_failure(edict_t *self, edict_t *other, edict_t *activator)
 	//{
 		self->flags = 12;
 		self->think = target_failure_fade_lights;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	/*}
 	else
 	{
@@ -4013,7 +4005,7 @@ void use_target_failure(edict_t *self, edict_t *other, edict_t *activator)
 		activator->client->fadecolor[2] = 0;
 		activator->client->fadealpha    = 1.0;
 		self->think = target_failure_think;
-		self->nextthink = level.time + 4;
+		G_SetNextThink(self, level.time + 4);
 	}*/
 
 	activator->deadflag = DEAD_FROZEN;
@@ -4046,7 +4038,7 @@ void use_target_change(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->target)
 		return;
 
-	char *buffer = (char *)gi.TagMalloc(strlen(self->target) + 1, TAG_LEVEL);
+	char *buffer = (char *)G_TagMalloc(strlen(self->target) + 1, TAG_LEVEL, MEM_STRINGS);
 	strcpy(buffer, self->target);
 	char *newtarget = strstr(buffer, ",");
 	if (newtarget)
@@ -4200,20 +4192,7 @@ void SP_target_change(edict_t *self)
 
 void movewith_detach(edict_t *child)
 {
-	edict_t	*parent = NULL;
-
-	for (int i = 1; i < globals.num_edicts && !parent; i++)
-	{
-		edict_t *e = g_edicts + i;
-		if (e->movewith_next == child)
-			parent = e;
-	}
-
-	if (parent)
-		parent->movewith_next = child->movewith_next;
-		
-	child->movewith_next = NULL;
-	child->movewith = NULL;
+	Movewith_Detach(child);
 	child->movetype = child->org_movetype;
 
 	// if monster, give 'em a small vertical boost
@@ -4254,29 +4233,22 @@ void use_target_movewith(edict_t *self, edict_t *other, edict_t *activator)
 				if (target->movewith_ent)
 					movewith_detach(target);
 		
-				target->movewith_ent = parent;
-				VectorCopy(parent->s.angles,target->parent_attach_angles);
-
-				if (target->org_movetype < 0)
-					target->org_movetype = target->movetype;
+				Movewith_Attach(target, parent);
+				if (target->movewith_ent == parent) // Not if parent is moving with it
+				{
+					VectorCopy(parent->s.angles,target->parent_attach_angles);
 
-				if (target->movetype != MOVETYPE_NONE)
-					target->movetype = MOVETYPE_PUSH;
+					if (target->org_movetype < 0)
+						target->org_movetype = target->movetype;
 
-				VectorCopy(target->mins, target->org_mins);
-				VectorCopy(target->maxs, target->org_maxs);
-				VectorSubtract(target->s.origin, parent->s.origin, target->movewith_offset);
+					if (target->movetype != MOVETYPE_NONE)
+						target->movetype = MOVETYPE_PUSH;
 
-				edict_t *e = parent->movewith_next;
-				edict_t *previous = parent;
-				while (e)
-				{
-					previous = e;
-					e = previous->movewith_next;
+					VectorCopy(target->mins, target->org_mins);
+					VectorCopy(target->maxs, target->org_maxs);
+					VectorSubtract(target->s.origin, parent->s.origin, target->movewith_offset);
+					gi.linkentity(target);
 				}
-
-				previous->movewith_next = target;
-				gi.linkentity(target);
 			}
 
 			target = G_Find(target, FOFS(targetname), self->target);
@@ -4287,7 +4259,7 @@ void use_target_movewith(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -4408,7 +4380,7 @@ void use_target_sky(edict_t *self, edict_t *other, edict_t *activator)
 	self->count--;
 	if (!self->count) {
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -4421,7 +4393,7 @@ void SP_target_sky(edict_t *self)
 		return;
 	}
 
-	self->pathtarget = gi.TagMalloc(strlen(st.sky) + 1, TAG_LEVEL);
+	self->pathtarget = G_TagMalloc(strlen(st.sky) + 1, TAG_LEVEL, MEM_STRINGS);
 	strcpy(self->pathtarget, st.sky);
 	self->use = use_target_sky;
 }
@@ -4450,7 +4422,7 @@ void use_target_fade(edict_t *self, edict_t *other, edict_t *activator)
 	self->count--;
 	if (!self->count) {
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -4487,77 +4459,27 @@ void func_train_find(edict_t *self);
 
 void clone(edict_t *self, edict_t *other, edict_t *activator)
 {
-	edict_t *parent = G_Find(NULL, FOFS(targetname), self->source);
-	if (!parent)
+	const enttemplate_t *t = Template_FindClone(self->source);
+	if (!t)
 		return;
 
-	edict_t *child = G_Spawn();
-	child->classname = gi.TagMalloc(strlen(parent->classname) + 1, TAG_LEVEL);
-	strcpy(child->classname, parent->classname);
-	child->s.modelindex = parent->s.modelindex;
+	const edict_t *parent = &t->source;
+	edict_t *child = Template_SpawnClone(t);
 	VectorCopy(self->s.origin, child->s.origin);
-	child->svflags = parent->svflags;
-	VectorCopy(parent->mins, child->mins);
-	VectorCopy(parent->maxs, child->maxs);
-	VectorCopy(parent->size, child->size);
 
-	if (self->newtargetname && strlen(self->newtargetname))
-		child->targetname = G_CopyString(self->newtargetname);
+	if (self->newtargetname && *self->newtargetname)
+		child->targetname = self->newtargetname;
 
 	qboolean havenewteams = false;
-	if (self->team && strlen(self->team))
+	if (self->team && *self->team)
 	{
-		child->team = G_CopyString(self->team);
+		child->team = self->team;
 		havenewteams = true;
 	}
 
-	if (self->target && strlen(self->target))
-		child->target = G_CopyString(self->target);
-
-	if (parent->deathtarget && strlen(parent->deathtarget))
-		child->deathtarget = G_CopyString(parent->deathtarget);
-
-	if (parent->destroytarget && strlen(parent->destroytarget))
-		child->destroytarget = G_CopyString(parent->destroytarget);
-
-	if (parent->killtarget && strlen(parent->killtarget))
-		child->killtarget = G_CopyString(parent->killtarget);
-
-	child->solid = parent->solid;
-	child->clipmask = parent->clipmask;
-	child->movetype = parent->movetype;
-	child->mass = parent->mass;
-	child->health = parent->health;
-	child->max_health = parent->max_health;
-	child->takedamage = parent->takedamage;
-	child->dmg = parent->dmg;
-	child->sounds = parent->sounds;
-	child->speed = parent->speed;
-	child->accel = parent->accel;
-	child->decel = parent->decel;
-	child->gib_type = parent->gib_type;
-	child->noise_index = parent->noise_index;
-	child->noise_index2 = parent->noise_index2;
-	child->wait = parent->wait;
-	child->delay = parent->delay;
-	child->random = parent->random;
-	child->style = parent->style;
-	child->flags = parent->flags;
-	child->blocked = parent->blocked;
-	child->touch = parent->touch;
-	child->use = parent->use;
-	child->pain = parent->pain;
-	child->die = parent->die;
-	child->s.effects = parent->s.effects;
-#ifdef KMQUAKE2_ENGINE_MOD //Knightmare added
-	child->s.alpha = parent->s.alpha;
-#endif
-	child->s.skinnum = parent->s.skinnum;
-	child->item = parent->item;
-	child->moveinfo.sound_start = parent->moveinfo.sound_start;
-	child->moveinfo.sound_middle = parent->moveinfo.sound_middle;
-	child->moveinfo.sound_end = parent->moveinfo.sound_end;
-	VectorCopy(parent->movedir, child->movedir);
+	if (self->target && *self->target)
+		child->target = self->target;
+
 	VectorCopy(self->s.angles, child->s.angles);
 
 	if (VectorLengthSquared(child->s.angles))
@@ -4601,10 +4523,8 @@ void clone(edict_t *self, edict_t *other, edict_t *activator)
 	VectorAdd(child->s.origin, child->mins, child->absmin);
 	VectorAdd(child->s.origin, child->maxs, child->absmax);
 
-	child->spawnflags = parent->spawnflags;
-
 	// classname-specific stuff
-	if (!Q_stricmp(child->classname, "func_button"))
+	if (t->type == CLONE_BUTTON)
 	{
 		VectorCopy(child->s.origin, child->pos1);
 		child->moveinfo.distance = parent->moveinfo.distance;
@@ -4624,7 +4544,7 @@ void clone(edict_t *self, edict_t *other, edict_t *activator)
 		if (!child->targetname)
 			child->touch = button_touch;
 	}
-	else if (!Q_stricmp(child->classname, "func_door"))
+	else if (t->type == CLONE_DOOR)
 	{
 		VectorCopy(child->s.origin, child->pos1);
 		child->moveinfo.distance = parent->moveinfo.distance;
@@ -4645,9 +4565,9 @@ void clone(edict_t *self, edict_t *other, edict_t *activator)
 		else
 			child->think = Think_SpawnDoorTrigger;
 
-		child->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(child, level.time + FRAMETIME);
 	}
-	else if (!Q_stricmp(child->classname, "func_door_rotating"))
+	else if (t->type == CLONE_DOOR_ROTATING)
 	{
 		VectorClear(child->s.angles);
 		VectorCopy(parent->s.angles, child->s.angles);
@@ -4671,15 +4591,15 @@ void clone(edict_t *self, edict_t *other, edict_t *activator)
 		else
 			child->think = Think_SpawnDoorTrigger;
 
-		child->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(child, level.time + FRAMETIME);
 	}
-	else if (!Q_stricmp(child->classname, "func_rotating"))
+	else if (t->type == CLONE_ROTATING)
 	{
 		VectorClear(child->s.angles);
 		if (child->spawnflags & 1)
 			child->use(child, NULL, NULL);
 	}
-	else if (!Q_stricmp(child->classname, "func_train"))
+	else if (t->type == CLONE_TRAIN)
 	{
 		VectorClear(self->s.angles);
 		child->smooth_movement = parent->smooth_movement;
@@ -4689,7 +4609,7 @@ void clone(edict_t *self, edict_t *other, edict_t *activator)
 		child->moveinfo.speed = child->speed;
 		child->moveinfo.accel = child->moveinfo.decel = child->moveinfo.speed;
 		child->think = func_train_find;
-		child->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(child, level.time + FRAMETIME);
 
 		if (child->moveinfo.sound_middle || parent->noise_index)
 		{
@@ -4707,7 +4627,7 @@ void clone(edict_t *self, edict_t *other, edict_t *activator)
 			speaker->attenuation = child->attenuation; // was 1
 			speaker->owner = child;
 			speaker->think = Moving_Speaker_Think;
-			speaker->nextthink = level.time + 2 * FRAMETIME;
+			G_SetNextThink(speaker, level.time + 2 * FRAMETIME);
 			speaker->spawnflags = 7;       // owner must be moving to play
 
 			child->speaker = speaker;
@@ -4768,10 +4688,11 @@ void SP_target_clone(edict_t *self)
 	}
 
 	self->use = clone;
+
 	if (self->spawnflags & 1)
 	{
 		self->think = target_clone_starton;
-		self->nextthink = level.time + 2;
+		G_SetNextThink(self, level.time + 2);
 	}
 }
 
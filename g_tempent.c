@@ -0,0 +1,409 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_tempent.c -- temp entity queue.
+// svc_temp_entity messages are collected during the frame instead of being written
+// straight to the engine. Near-identical events are merged, and the queue is flushed
+// from ClientEndServerFrames, holding each client to sv_tempent_budget bytes per frame.
+// Cosmetic events (sparks, puffs, blood) are the first to go when a client is over budget.
+
+#include "g_local.h"
+
+#define TE_MAX_EVENTS	256
+#define TE_MAX_FIELDS	16
+#define TE_MERGE_DIST	8		// events closer than this are considered the same
+
+#define TEF_BYTE		0
+#define TEF_SHORT		1
+#define TEF_LONG		2
+#define TEF_POSITION	3
+#define TEF_DIR			4
+
+typedef struct
+{
+	int		kind;
+	int		value;
+	vec3_t	v;
+} tefield_t;
+
+typedef struct
+{
+	int			numfields;
+	tefield_t	fields[TE_MAX_FIELDS];
+	vec3_t		origin;
+	multicast_t	to;
+	int			size;			// approximate bytes on the wire
+	qboolean	cosmetic;		// may be dropped when a client is over budget
+} tempevent_t;
+
+static tempevent_t	te_queue[TE_MAX_EVENTS];
+static int			te_numevents;
+static tempevent_t	*te_current;	// event being written
+static qboolean		te_overflow;
+
+static int			te_clientbytes[MAX_CLIENTS];
+
+static struct
+{
+	int		queued;
+	int		merged;		// dropped as duplicates
+	int		dropped;	// not sent to a client because of its budget
+	int		multicasts;
+	int		unicasts;
+	int		bytes_saved;
+} te_stats;
+
+static const int te_fieldsize[] = { 1, 2, 4, 6, 1 };
+
+void TempEnt_Begin(void)
+{
+	if (te_numevents == TE_MAX_EVENTS)
+		TempEnt_Flush();
+
+	te_current = &te_queue[te_numevents];
+	te_current->numfields = 0;
+	te_current->size = 2;	// svc_temp_entity and type
+	te_overflow = false;
+}
+
+static tefield_t *TempEnt_AddField(int kind)
+{
+	if (!te_current)
+	{
+		gi.dprintf("TempEnt: write without TempEnt_Begin\n");
+		return NULL;
+	}
+
+	if (te_current->numfields == TE_MAX_FIELDS)
+	{
+		te_overflow = true;
+		return NULL;
+	}
+
+	tefield_t *field = &te_current->fields[te_current->numfields++];
+	field->kind = kind;
+
+	if (te_current->numfields > 1)
+		te_current->size += te_fieldsize[kind];
+
+	return field;
+}
+
+void TempEnt_WriteByte(int c)
+{
+	tefield_t *field = TempEnt_AddField(TEF_BYTE);
+	if (field)
+		field->value = c;
+}
+
+void TempEnt_WriteShort(int c)
+{
+	tefield_t *field = TempEnt_AddField(TEF_SHORT);
+	if (field)
+		field->value = c;
+}
+
+void TempEnt_WriteLong(int c)
+{
+	tefield_t *field = TempEnt_AddField(TEF_LONG);
+	if (field)
+		field->value = c;
+}
+
+void TempEnt_WritePosition(vec3_t pos)
+{
+	tefield_t *field = TempEnt_AddField(TEF_POSITION);
+	if (field)
+		VectorCopy(pos, field->v);
+}
+
+void TempEnt_WriteDir(vec3_t dir)
+{
+	tefield_t *field = TempEnt_AddField(TEF_DIR);
+	if (field)
+		VectorCopy(dir, field->v);
+}
+
+// Sparks, puffs and blood. Losing a few of these doesn't change anything.
+static qboolean TempEnt_IsCosmetic(int type)
+{
+	switch (type)
+	{
+		case TE_GUNSHOT:
+		case TE_BLOOD:
+		case TE_SHOTGUN:
+		case TE_SPARKS:
+		case TE_SPLASH:
+		case TE_BUBBLETRAIL:
+		case TE_SCREEN_SPARKS:
+		case TE_SHIELD_SPARKS:
+		case TE_BULLET_SPARKS:
+		case TE_LASER_SPARKS:
+		case TE_WELDING_SPARKS:
+		case TE_GREENBLOOD:
+		case TE_TUNNEL_SPARKS:
+		case TE_MOREBLOOD:
+		case TE_HEATBEAM_SPARKS:
+		case TE_HEATBEAM_STEAM:
+		case TE_CHAINFIST_SMOKE:
+		case TE_ELECTRIC_SPARKS:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+static qboolean TempEnt_Same(const tempevent_t *a, const tempevent_t *b)
+{
+	if (a->to != b->to || a->numfields != b->numfields)
+		return false;
+
+	for (int i = 0; i < 3; i++)
+		if (fabsf(a->origin[i] - b->origin[i]) > TE_MERGE_DIST)
+			return false;
+
+	for (int i = 0; i < a->numfields; i++)
+	{
+		const tefield_t *fa = &a->fields[i];
+		const tefield_t *fb = &b->fields[i];
+
+		if (fa->kind != fb->kind)
+			return false;
+
+		switch (fa->kind)
+		{
+			case TEF_POSITION:
+				for (int j = 0; j < 3; j++)
+					if (fabsf(fa->v[j] - fb->v[j]) > TE_MERGE_DIST)
+						return false;
+				break;
+
+			case TEF_DIR:
+				if (DotProduct(fa->v, fb->v) < 0.95f)
+					return false;
+				break;
+
+			default:
+				if (fa->value != fb->value)
+					return false;
+				break;
+		}
+	}
+
+	return true;
+}
+
+static void TempEnt_Write(const tempevent_t *ev)
+{
+	gi.WriteByte(svc_temp_entity);
+
+	for (int i = 0; i < ev->numfields; i++)
+	{
+		const tefield_t *field = &ev->fields[i];
+
+		switch (field->kind)
+		{
+			case TEF_BYTE:		gi.WriteByte(field->value);		break;
+			case TEF_SHORT:		gi.WriteShort(field->value);	break;
+			case TEF_LONG:		gi.WriteLong(field->value);		break;
+			case TEF_POSITION:	gi.WritePosition((float *)field->v);	break;
+			case TEF_DIR:		gi.WriteDir((float *)field->v);			break;
+		}
+	}
+}
+
+/*
+=================
+TempEnt_Multicast
+
+Queues the temp entity started with TempEnt_Begin. Replaces gi.multicast.
+=================
+*/
+void TempEnt_Multicast(vec3_t origin, multicast_t to)
+{
+	tempevent_t *ev = te_current;
+
+	if (!ev)
+		return;
+
+	te_current = NULL;
+
+	if (te_overflow || !ev->numfields || ev->fields[0].kind != TEF_BYTE)
+	{
+		gi.dprintf("TempEnt_Multicast: bad temp entity\n");
+		return;
+	}
+
+	VectorCopy(origin, ev->origin);
+	ev->to = to;
+	ev->cosmetic = (to < MULTICAST_ALL_R && TempEnt_IsCosmetic(ev->fields[0].value));
+
+	te_stats.queued++;
+
+	// Drop if the same thing already happened this frame (reflections, several pellets hitting the same spot, etc.)
+	if (to < MULTICAST_ALL_R)
+	{
+		for (int i = 0; i < te_numevents; i++)
+		{
+			if (TempEnt_Same(&te_queue[i], ev))
+			{
+				te_stats.merged++;
+				te_stats.bytes_saved += ev->size;
+				return;
+			}
+		}
+	}
+
+	te_numevents++;
+}
+
+// Sends ev to clients with enough budget left. Returns number of clients that didn't get it.
+static int TempEnt_Send(tempevent_t *ev, int budget)
+{
+	edict_t	*recipients[MAX_CLIENTS];
+	int		numrecipients = 0;
+	int		numallowed = 0;
+
+	// Reliable messages, or no budget: let the engine handle it
+	if (budget <= 0 || ev->to >= MULTICAST_ALL_R)
+	{
+		TempEnt_Write(ev);
+		gi.multicast(ev->origin, ev->to);
+		te_stats.multicasts++;
+
+		return 0;
+	}
+
+	for (int i = 0; i < game.maxclients; i++)
+	{
+		edict_t *ent = &g_edicts[i + 1];
+		vec3_t	viewpoint;
+
+		if (!ent->inuse || !ent->client || ent->is_bot)
+			continue;
+
+		VectorAdd(ent->s.origin, ent->client->ps.viewoffset, viewpoint);
+
+		if (ev->to == MULTICAST_PVS && !gi.inPVS(viewpoint, ev->origin))
+			continue;
+
+		if (ev->to == MULTICAST_PHS && !gi.inPHS(viewpoint, ev->origin))
+			continue;
+
+		const int clientnum = i;
+		if (!ev->cosmetic || te_clientbytes[clientnum] + ev->size <= budget)
+		{
+			te_clientbytes[clientnum] += ev->size;
+			numallowed++;
+		}
+		else
+		{
+			ent = NULL;
+		}
+
+		recipients[numrecipients++] = ent;
+	}
+
+	if (numallowed == numrecipients)
+	{
+		if (numallowed)
+		{
+			TempEnt_Write(ev);
+			gi.multicast(ev->origin, ev->to);
+			te_stats.multicasts++;
+		}
+
+		return 0;
+	}
+
+	for (int i = 0; i < numrecipients; i++)
+	{
+		if (!recipients[i])
+			continue;
+
+		TempEnt_Write(ev);
+		gi.unicast(recipients[i], false);
+		te_stats.unicasts++;
+	}
+
+	return numrecipients - numallowed;
+}
+
+/*
+=================
+TempEnt_Flush
+
+Sends queued temp entities. Called from ClientEndServerFrames.
+=================
+*/
+void TempEnt_Flush(void)
+{
+	const int budget = (sv_tempent_budget ? sv_tempent_budget->value : 0);
+
+	te_current = NULL;
+
+	if (!te_numevents)
+		return;
+
+	memset(te_clientbytes, 0, sizeof(te_clientbytes));
+
+	// Important events first, so sparks are what gets dropped
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int i = 0; i < te_numevents; i++)
+		{
+			tempevent_t *ev = &te_queue[i];
+			if (ev->cosmetic != pass)
+				continue;
+
+			const int dropped = TempEnt_Send(ev, budget);
+			te_stats.dropped += dropped;
+			te_stats.bytes_saved += dropped * ev->size;
+		}
+	}
+
+	te_numevents = 0;
+}
+
+/*
+=================
+TempEnt_Clear
+
+Discards queued temp entities (level change)
+=================
+*/
+void TempEnt_Clear(void)
+{
+	te_numevents = 0;
+	te_current = NULL;
+}
+
+void TempEnt_Stats_f(void)
+{
+	safe_cprintf(NULL, PRINT_HIGH, "Temp entities queued: %d\n", te_stats.queued);
+	safe_cprintf(NULL, PRINT_HIGH, "  merged: %d, dropped by budget: %d\n", te_stats.merged, te_stats.dropped);
+	safe_cprintf(NULL, PRINT_HIGH, "  sent: %d multicasts, %d unicasts\n", te_stats.multicasts, te_stats.unicasts);
+	safe_cprintf(NULL, PRINT_HIGH, "  ~%d bytes saved\n", te_stats.bytes_saved);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&te_stats, 0, sizeof(te_stats));
+}
@@ -0,0 +1,261 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_template.c -- entity templates for target_clone and target_spawner.
+// A target_clone template holds a copy of its source and a prototype of what a new clone looks
+// like, so cloning is a G_Spawn, a copy of the prototype and a few fixups, with the per-class
+// setup picked once. Clones always copy the source as it is when they're made, as they did before
+// templates, so a savegame load changes nothing: the template is refreshed from the live source on
+// every use, and there are no clones once the source is gone.
+// target_spawner templates remember the spawn function for their classname, so ED_CallSpawn
+// doesn't have to search the item and spawn lists every time.
+// Templates live in TAG_LEVEL memory and aren't saved. Spawner templates are made again on first use.
+
+#include "g_local.h"
+
+static enttemplate_t *templates;
+
+static struct
+{
+	int		clones;
+	int		spawners;
+	int		instances;
+} template_stats;
+
+static enttemplate_t *Template_Lookup(char *name, qboolean spawner)
+{
+	for (enttemplate_t *t = templates; t; t = t->next)
+		if (t->spawner == spawner && (t->name == name || !Q_stricmp(t->name, name)))
+			return t;
+
+	return NULL;
+}
+
+static enttemplate_t *Template_Add(char *name, qboolean spawner)
+{
+	enttemplate_t *t = G_TagMalloc(sizeof(enttemplate_t), TAG_LEVEL, MEM_TEMPLATES);
+	t->name = G_CopyString(name);
+	t->spawner = spawner;
+	t->next = templates;
+	templates = t;
+
+	return t;
+}
+
+// Copies source and works out the fields every clone of it starts with
+static void Template_MakeClone(enttemplate_t *t, edict_t *source)
+{
+	edict_t *proto = &t->proto;
+
+	memcpy(&t->source, source, sizeof(edict_t));
+
+	// Same as a fresh G_Spawn
+	memset(proto, 0, sizeof(edict_t));
+	proto->inuse = true;
+	proto->gravity = 1.0;
+	proto->org_movetype = -1;
+
+	proto->classname = source->classname;
+	proto->s.modelindex = source->s.modelindex;
+	proto->svflags = source->svflags;
+	VectorCopy(source->mins, proto->mins);
+	VectorCopy(source->maxs, proto->maxs);
+	VectorCopy(source->size, proto->size);
+
+	if (source->deathtarget && *source->deathtarget)
+		proto->deathtarget = source->deathtarget;
+
+	if (source->destroytarget && *source->destroytarget)
+		proto->destroytarget = source->destroytarget;
+
+	if (source->killtarget && *source->killtarget)
+		proto->killtarget = source->killtarget;
+
+	proto->solid = source->solid;
+	proto->clipmask = source->clipmask;
+	proto->movetype = source->movetype;
+	proto->mass = source->mass;
+	proto->health = source->health;
+	proto->max_health = source->max_health;
+	proto->takedamage = source->takedamage;
+	proto->dmg = source->dmg;
+	proto->sounds = source->sounds;
+	proto->speed = source->speed;
+	proto->accel = source->accel;
+	proto->decel = source->decel;
+	proto->gib_type = source->gib_type;
+	proto->noise_index = source->noise_index;
+	proto->noise_index2 = source->noise_index2;
+	proto->wait = source->wait;
+	proto->delay = source->delay;
+	proto->random = source->random;
+	proto->style = source->style;
+	proto->flags = source->flags;
+	proto->blocked = source->blocked;
+	proto->touch = source->touch;
+	proto->use = source->use;
+	proto->pain = source->pain;
+	proto->die = source->die;
+	proto->s.effects = source->s.effects;
+#ifdef KMQUAKE2_ENGINE_MOD //Knightmare added
+	proto->s.alpha = source->s.alpha;
+#endif
+	proto->s.skinnum = source->s.skinnum;
+	proto->item = source->item;
+	proto->moveinfo.sound_start = source->moveinfo.sound_start;
+	proto->moveinfo.sound_middle = source->moveinfo.sound_middle;
+	proto->moveinfo.sound_end = source->moveinfo.sound_end;
+	VectorCopy(source->movedir, proto->movedir);
+	proto->spawnflags = source->spawnflags;
+
+	if (!Q_stricmp(source->classname, "func_button"))
+		t->type = CLONE_BUTTON;
+	else if (!Q_stricmp(source->classname, "func_door"))
+		t->type = CLONE_DOOR;
+	else if (!Q_stricmp(source->classname, "func_door_rotating"))
+		t->type = CLONE_DOOR_ROTATING;
+	else if (!Q_stricmp(source->classname, "func_rotating"))
+		t->type = CLONE_ROTATING;
+	else if (!Q_stricmp(source->classname, "func_train"))
+		t->type = CLONE_TRAIN;
+	else
+		t->type = CLONE_OTHER;
+
+	t->ready = true;
+}
+
+/*
+=================
+Template_FindClone
+
+Returns the template for target_clone source, brought up to date with the entity as it is now.
+NULL if there's no such entity.
+=================
+*/
+const enttemplate_t *Template_FindClone(char *source)
+{
+	if (!source)
+		return NULL;
+
+	edict_t *ent = G_Find(NULL, FOFS(targetname), source);
+	if (!ent)
+		return NULL;
+
+	enttemplate_t *t = Template_Lookup(source, false);
+	if (!t)
+	{
+		t = Template_Add(source, false);
+		template_stats.clones++;
+	}
+
+	Template_MakeClone(t, ent);
+
+	return t;
+}
+
+/*
+=================
+Template_SpawnClone
+
+Spawns a copy of the template's prototype. Caller does origin, angles, names and the classname-specific setup.
+=================
+*/
+edict_t *Template_SpawnClone(const enttemplate_t *t)
+{
+	edict_t *child = G_Spawn();
+	const int number = child->s.number;
+
+	memcpy(child, &t->proto, sizeof(edict_t));
+	child->s.number = number;
+	G_UpdateRoles(child);
+
+	template_stats.instances++;
+
+	return child;
+}
+
+/*
+=================
+Template_FindSpawner
+
+Returns the template for target_spawner classname, looking up its spawn function the first time.
+=================
+*/
+const enttemplate_t *Template_FindSpawner(char *classname)
+{
+	if (!classname)
+		return NULL;
+
+	enttemplate_t *t = Template_Lookup(classname, true);
+	if (!t)
+	{
+		t = Template_Add(classname, true);
+		t->ready = ED_FindSpawn(classname, &t->item, &t->spawn);
+		template_stats.spawners++;
+	}
+
+	return t;
+}
+
+/*
+=================
+Template_CallSpawn
+
+ED_CallSpawn with the spawn function from the template
+=================
+*/
+void Template_CallSpawn(const enttemplate_t *t, edict_t *ent)
+{
+	if (!t)
+	{
+		ED_CallSpawn(ent);
+		return;
+	}
+
+	template_stats.instances++;
+	ED_CallSpawnFunc(ent, t->item, t->spawn);
+}
+
+/*
+=================
+Template_Clear
+
+Forgets all templates (level change, the memory is in TAG_LEVEL)
+=================
+*/
+void Template_Clear(void)
+{
+	templates = NULL;
+}
+
+void Template_Stats_f(void)
+{
+	int count = 0;
+	for (enttemplate_t *t = templates; t; t = t->next)
+		count++;
+
+	safe_cprintf(NULL, PRINT_HIGH, "Entity templates: %d this level\n", count);
+	safe_cprintf(NULL, PRINT_HIGH, "  made: %d clone, %d spawner\n", template_stats.clones, template_stats.spawners);
+	safe_cprintf(NULL, PRINT_HIGH, "  entities spawned from templates: %d\n", template_stats.instances);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&template_stats, 0, sizeof(template_stats));
+}
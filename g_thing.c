@@ -25,7 +25,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 edict_t *SpawnThing()
 {
 	edict_t *thing = G_Spawn();
-	thing->classname = gi.TagMalloc(6, TAG_LEVEL);
+	thing->classname = G_TagMalloc(6, TAG_LEVEL, MEM_STRINGS);
 	Q_strncpyz(thing->classname, "thing", 6);
 
 	return thing;
@@ -44,7 +44,7 @@ void thing_restore_leader(edict_t *self)
 	{
 		if (VectorCompare(monster->monsterinfo.old_leader->s.origin, self->move_origin))
 		{
-			self->nextthink = level.time + 0.5;
+			G_SetNextThink(self, level.time + 0.5);
 			return;
 		}
 
@@ -75,7 +75,7 @@ void thing_think(edict_t *self)
 
 		if (dist >= monster->size[0])
 		{
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 			return;
 		}
 	}
@@ -101,7 +101,7 @@ void thing_think(edict_t *self)
 			monster->monsterinfo.pausetime = level.time + 2;
 			monster->monsterinfo.stand(monster);
 			VectorCopy(monster->monsterinfo.old_leader->s.origin, self->move_origin);
-			self->nextthink = level.time + 2;
+			G_SetNextThink(self, level.time + 2);
 			self->think = thing_restore_leader;
 			gi.linkentity(monster);
 
@@ -176,7 +176,7 @@ void thing_think_pause(edict_t *self)
 		M_ChangeYaw(monster);
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void thing_grenade_boom(edict_t *self)
@@ -278,7 +278,7 @@ void thing_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *sur
 			if (other->monsterinfo.pausetime > 0)
 			{
 				self->think = thing_grenade_boom;
-				self->nextthink = other->monsterinfo.pausetime;
+				G_SetNextThink(self, other->monsterinfo.pausetime);
 				return;
 			}
 
@@ -329,7 +329,7 @@ void SP_thing(edict_t *self)
 
 	self->touch = thing_touch;
 	self->think = thing_think;
-	self->nextthink = level.time + 2;
+	G_SetNextThink(self, level.time + 2);
 
 	gi.linkentity(self);
 }
\ No newline at end of file
@@ -0,0 +1,392 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+Copyright (C) 2000-2002 Mr. Hyde and Mad Dog
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+// g_think.c -- which entities G_RunFrame has to visit.
+// An entity whose frame would only be an SV_RunThink that isn't due yet (nothing moves it, no prethink or
+// postthink) goes to sleep after its visit: it drops out of the awake set and is filed in a timing wheel
+// under the frame its nextthink comes due. Each frame pops that frame's wheel slot back into the awake set,
+// and G_RunFrame walks the awake set in edict order, so thinks run in the same order and on the same frames
+// as when every edict was visited. Being linked, unlinked or spawned wakes an entity up, and G_SetNextThink
+// refiles a sleeper, so every nextthink write has to go through it.
+
+#include "g_local.h"
+
+#define THINK_WORDS		((MAX_EDICTS + 31) / 32)
+
+#define THINK_NEAR		256		// one frame slots
+#define THINK_FAR		64		// THINK_NEAR frame slots
+#define THINK_LATER		(THINK_NEAR + THINK_FAR)	// slot for anything further off than that
+#define THINK_SLOTS		(THINK_LATER + 1)
+
+static unsigned	think_awake[THINK_WORDS];
+static int		think_slots[THINK_SLOTS];	// first entity filed in the slot, -1 for none
+static int		think_next[MAX_EDICTS];
+static int		think_prev[MAX_EDICTS];
+static short	think_slot[MAX_EDICTS];		// -1 when not filed
+static int		think_frame[MAX_EDICTS];	// frame it's filed under
+static int		think_framenum;				// last frame popped
+static int		think_filed;
+
+static struct
+{
+	int		frames;
+	int		visits;
+	int		sleeps;
+	int		wakes;		// by the wheel
+	int		early;		// woken by something else before their think
+} think_stats;
+
+static int Think_Index(edict_t *ent)
+{
+	if (!g_edicts || ent < g_edicts || ent - g_edicts >= min(game.maxentities, MAX_EDICTS))
+		return -1;
+
+	return ent - g_edicts;
+}
+
+static void Think_Unfile(int index)
+{
+	const int slot = think_slot[index];
+	if (slot < 0)
+		return;
+
+	if (think_prev[index] >= 0)
+		think_next[think_prev[index]] = think_next[index];
+	else
+		think_slots[slot] = think_next[index];
+
+	if (think_next[index] >= 0)
+		think_prev[think_next[index]] = think_prev[index];
+
+	think_slot[index] = -1;
+	think_filed--;
+}
+
+static void Think_File(int index, int frame)
+{
+	think_frame[index] = frame;
+
+	int slot;
+	if (frame - think_framenum < THINK_NEAR)
+		slot = frame & (THINK_NEAR - 1);
+	else if ((frame >> 8) - (think_framenum >> 8) < THINK_FAR)
+		slot = THINK_NEAR + ((frame >> 8) & (THINK_FAR - 1));
+	else
+		slot = THINK_LATER;
+
+	think_slot[index] = slot;
+	think_prev[index] = -1;
+	think_next[index] = think_slots[slot];
+	if (think_next[index] >= 0)
+		think_prev[think_next[index]] = index;
+
+	think_slots[slot] = index;
+	think_filed++;
+}
+
+static qboolean Think_IsAwake(int index)
+{
+	return (think_awake[index >> 5] & (1u << (index & 31))) != 0;
+}
+
+static void Think_SetAwake(int index)
+{
+	think_awake[index >> 5] |= 1u << (index & 31);
+}
+
+// Moves everything in slot to where it belongs now
+static void Think_Refile(int slot)
+{
+	int index = think_slots[slot];
+	think_slots[slot] = -1;
+
+	while (index >= 0)
+	{
+		const int next = think_next[index];
+		think_slot[index] = -1;
+		think_filed--;
+
+		if (think_frame[index] <= think_framenum)
+		{
+			Think_SetAwake(index);
+			think_stats.wakes++;
+		}
+		else
+		{
+			Think_File(index, think_frame[index]);
+		}
+
+		index = next;
+	}
+}
+
+// First frame SV_RunThink would run a think at nextthink. Never late, sometimes a frame early, which only costs a visit.
+// The slack covers SV_RunThink's 0.001 and float rounding, which grows with level.time.
+static int Think_Frame(float nextthink)
+{
+	return (int)ceilf((nextthink - 0.002f - nextthink * 1e-6f) * 10);
+}
+
+/*
+=================
+Think_Wake
+
+Puts ent back in the awake set. Called when it's spawned, freed, linked or unlinked.
+=================
+*/
+void Think_Wake(edict_t *ent)
+{
+	const int index = Think_Index(ent);
+	if (index < 0)
+		return;
+
+	if (think_slot[index] >= 0)
+	{
+		Think_Unfile(index);
+		think_stats.early++;
+	}
+
+	Think_SetAwake(index);
+}
+
+/*
+=================
+G_SetNextThink
+
+Sets when ent thinks next. Use this instead of writing ent->nextthink.
+=================
+*/
+void G_SetNextThink(edict_t *ent, float nextthink)
+{
+	ent->nextthink = nextthink;
+
+	const int index = Think_Index(ent);
+	if (index < 0 || Think_IsAwake(index))
+		return; // Filed when it goes to sleep
+
+	Think_Unfile(index);
+
+	if (nextthink <= 0)
+		return;
+
+	const int frame = Think_Frame(nextthink);
+	if (frame <= think_framenum)
+		Think_SetAwake(index);
+	else
+		Think_File(index, frame);
+}
+
+// Can ent skip frames until its next think?
+static qboolean Think_CanSleep(edict_t *ent)
+{
+	if ((ent->prethink || ent->postthink) || ent->movewith_ent || (ent->s.renderfx & RF_BEAM))
+		return false;
+
+	// The frame loop would update old_origin or recheck the ground
+	if (!VectorCompare(ent->s.origin, ent->s.old_origin))
+		return false;
+
+	if (ent->groundentity && (ent->groundentity != g_edicts || ent->groundentity->linkcount != ent->groundentity_linkcount))
+		return false;
+
+	switch ((int)ent->movetype)
+	{
+	case MOVETYPE_NONE:
+	case MOVETYPE_WALK:
+		return true;
+
+	// Resting on the world, SV_Physics_Toss only thinks
+	case MOVETYPE_TOSS:
+	case MOVETYPE_BOUNCE:
+	case MOVETYPE_FLY:
+	case MOVETYPE_FLYMISSILE:
+	case MOVETYPE_RAIN:
+		return (ent->groundentity != NULL);
+
+	// Same for SV_Physics_Debris, unless something knocked it upwards
+	case MOVETYPE_DEBRIS:
+		return (ent->groundentity != NULL && ent->velocity[2] <= 0);
+
+	default:
+		return false;
+	}
+}
+
+/*
+=================
+Think_Sleep
+
+Called by G_RunFrame after it's run ent. Takes ent out of the awake set if it has nothing to do until its next think.
+=================
+*/
+void Think_Sleep(edict_t *ent)
+{
+	think_stats.visits++;
+
+	const int index = Think_Index(ent);
+	if (index <= game.maxclients)
+		return; // The world and clients are always run
+
+	if (ent->inuse && (!sv_thinkwheel || !sv_thinkwheel->value || !Think_CanSleep(ent)))
+		return;
+
+	think_awake[index >> 5] &= ~(1u << (index & 31));
+
+	// Freed entities wait for G_InitEdict
+	if (!ent->inuse)
+		return;
+
+	think_stats.sleeps++;
+
+	if (ent->nextthink > 0)
+		Think_File(index, max(Think_Frame(ent->nextthink), think_framenum + 1));
+}
+
+/*
+=================
+Think_Advance
+
+Wakes the entities whose thinks come due this frame. Called at the start of G_RunFrame.
+=================
+*/
+void Think_Advance(void)
+{
+	think_stats.frames++;
+
+	while (think_framenum < level.framenum)
+	{
+		think_framenum++;
+
+		// Going into the next THINK_NEAR frames, bring those down from the far slots
+		if (!(think_framenum & (THINK_NEAR - 1)))
+		{
+			if (!((think_framenum >> 8) & (THINK_FAR - 1)))
+				Think_Refile(THINK_LATER);
+
+			Think_Refile(THINK_NEAR + ((think_framenum >> 8) & (THINK_FAR - 1)));
+		}
+
+		Think_Refile(think_framenum & (THINK_NEAR - 1));
+	}
+}
+
+/*
+=================
+Think_NextAwake
+
+Returns the next awake entity after from, or NULL. Entities spawned or woken further on are picked up as it goes.
+=================
+*/
+edict_t *Think_NextAwake(edict_t *from)
+{
+	int index = (from ? from - g_edicts + 1 : 0);
+
+	while (index < globals.num_edicts)
+	{
+		const int word = index >> 5;
+		unsigned bits = think_awake[word] & (~0u << (index & 31));
+
+		if (bits)
+		{
+			index = word << 5;
+			while (!(bits & 1))
+			{
+				bits >>= 1;
+				index++;
+			}
+
+			return (index < globals.num_edicts ? &g_edicts[index] : NULL);
+		}
+
+		index = (word + 1) << 5;
+	}
+
+	return NULL;
+}
+
+/*
+=================
+Think_Clear
+
+Wakes everything and empties the wheel. Must be called whenever the edict array is replaced.
+=================
+*/
+void Think_Clear(void)
+{
+	memset(think_awake, 0xff, sizeof(think_awake));
+	memset(think_slot, 0xff, sizeof(think_slot));
+
+	for (int i = 0; i < THINK_SLOTS; i++)
+		think_slots[i] = -1;
+
+	think_filed = 0;
+	think_framenum = level.framenum;
+}
+
+/*
+=================
+Think_Check
+
+Developer mode consistency check: reports and wakes sleepers that were changed behind the scheduler's back
+=================
+*/
+void Think_Check(void)
+{
+	for (int i = game.maxclients + 1; i < globals.num_edicts; i++)
+	{
+		if (Think_IsAwake(i))
+			continue;
+
+		edict_t *ent = &g_edicts[i];
+		if (!ent->inuse)
+			continue;
+
+		const char *problem = NULL;
+		if (!Think_CanSleep(ent))
+			problem = "can't sleep";
+		else if (ent->nextthink > 0 && (think_slot[i] < 0 || think_frame[i] > max(Think_Frame(ent->nextthink), think_framenum + 1)))
+			problem = "nextthink was set without G_SetNextThink";
+
+		if (problem)
+		{
+			gi.dprintf("Think_Check: %s (%d) %s\n", ent->classname, i, problem);
+			Think_Wake(ent);
+		}
+	}
+}
+
+void Think_Stats_f(void)
+{
+	int awake = 0;
+	for (int i = 0; i < globals.num_edicts; i++)
+		if (Think_IsAwake(i) && g_edicts[i].inuse)
+			awake++;
+
+	safe_cprintf(NULL, PRINT_HIGH, "Think scheduler: %d entities awake, %d asleep with a think filed\n", awake, think_filed);
+
+	if (think_stats.frames)
+		safe_cprintf(NULL, PRINT_HIGH, "  %d frames, %.1f entities visited per frame\n", think_stats.frames, (float)think_stats.visits / think_stats.frames);
+
+	safe_cprintf(NULL, PRINT_HIGH, "  %d went to sleep, %d woken for their think, %d woken early\n", think_stats.sleeps, think_stats.wakes, think_stats.early);
+
+	if (!Q_stricmp(gi.argv(2), "reset"))
+		memset(&think_stats, 0, sizeof(think_stats));
+}
@@ -140,6 +140,7 @@ void SP_path_track(edict_t *self)
 	}
 
 	self->class_id = ENTITY_PATH_TRACK;
+	Path_Invalidate();
 
 	self->solid = SOLID_TRIGGER;
 	self->use = path_track_use;
@@ -329,7 +330,7 @@ void trackchange_use(edict_t *self, edict_t *other, edict_t *activator)
 #endif
 
 	self->think = trackchange_done;
-	self->nextthink = level.time + time;
+	G_SetNextThink(self, level.time + time);
 
 	gi.linkentity(self);
 }
@@ -581,7 +582,7 @@ void tracktrain_think(edict_t *self)
 
 		self->spawnflags |= SF_TRACKTRAIN_DISABLED;
 		self->think = tracktrain_hide;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		VectorClear(self->velocity);
 		VectorClear(self->avelocity);
 		self->moveinfo.state = self->moveinfo.prevstate = STOP;
@@ -593,7 +594,7 @@ void tracktrain_think(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (!self->owner && (self->spawnflags & SF_TRACKTRAIN_DISABLED))
 		return;
@@ -941,9 +942,9 @@ void tracktrain_think(edict_t *self)
 				{
 					//VectorClear(self->avelocity); //TODO: mxd. Was this supposed to clear self->velocity?
 					VectorClear(self->avelocity);
-					self->nextthink = 0;
+					G_SetNextThink(self, 0);
 
-					if (self->movewith_next && self->movewith_next->movewith_ent == self)
+					if (self->movewith_child)
 						set_child_movement(self);
 
 					gi.linkentity(self);
@@ -1078,7 +1079,7 @@ void tracktrain_think(edict_t *self)
 		}
 	}
 
-	if (self->movewith_next && self->movewith_next->movewith_ent == self)
+	if (self->movewith_child)
 		set_child_movement(self);
 
 	if (time < 1.5 * FRAMETIME && !(self->spawnflags & SF_TRACKTRAIN_DISABLED))
@@ -1212,14 +1213,12 @@ qboolean is_backing_up(edict_t *train)
 	return DotProduct(forward, v_norm) < 0.0;
 }
 
-edict_t *NextPathTrack(edict_t *train, edict_t *path)
+static edict_t *NextPathTrackDir(edict_t *train, edict_t *path, const vec3_t forward)
 {
 	edict_t		*next = NULL;
-	vec3_t		forward;
 	vec3_t		to_next;
 	qboolean	in_reverse;
-
-	AngleVectors(train->s.angles, forward, NULL, NULL);
+	edict_t		**prevs;
 
 	if ((train->moveinfo.prevstate < STOP && train->moveinfo.state > STOP)
 	 || (train->moveinfo.prevstate > STOP && train->moveinfo.state < STOP))
@@ -1252,7 +1251,7 @@ edict_t *NextPathTrack(edict_t *train, edict_t *path)
 	{
 		if (path->spawnflags & SF_PATH_ALTPATH)
 		{
-			next = G_PickTarget(path->target);
+			next = Path_Target(path, false);
 			if (next)
 			{
 				VectorSubtract(next->s.origin, path->s.origin, to_next);
@@ -1279,10 +1278,11 @@ edict_t *NextPathTrack(edict_t *train, edict_t *path)
 			if (!next)
 			{
 				// Find path_track whose target or target2 is set to the current path_track
-				for (int i = maxclients->value; i < globals.num_edicts && !next; i++)
+				const int numprevs = Path_Previous(path, &prevs);
+				for (int i = 0; i < numprevs && !next; i++)
 				{
-					edict_t *e = &g_edicts[i];
-					if (!e->inuse || e == path || !e->classname || Q_stricmp(e->classname, "path_track"))
+					edict_t *e = prevs[i];
+					if (!e->inuse)
 						continue;
 					
 					if (e->target && !Q_stricmp(e->target, path->targetname))
@@ -1314,7 +1314,7 @@ edict_t *NextPathTrack(edict_t *train, edict_t *path)
 				// Finally, check this path_track's target and target2
 				if (path->target)
 				{
-					next = G_PickTarget(path->target);
+					next = Path_Target(path, false);
 					if (next)
 					{
 						VectorSubtract(next->s.origin, path->s.origin, to_next);
@@ -1330,7 +1330,7 @@ edict_t *NextPathTrack(edict_t *train, edict_t *path)
 				{
 					float dot2;
 					
-					edict_t *next2 = G_PickTarget(path->target2);
+					edict_t *next2 = Path_Target(path, true);
 					if (next2 == path)
 						next2 = NULL;
 					
@@ -1363,7 +1363,7 @@ edict_t *NextPathTrack(edict_t *train, edict_t *path)
 
 		if (path->target)
 		{
-			next = G_PickTarget(path->target);
+			next = Path_Target(path, false);
 			if (next)
 			{
 				VectorSubtract(next->s.origin, path->s.origin, to_next);
@@ -1379,7 +1379,7 @@ edict_t *NextPathTrack(edict_t *train, edict_t *path)
 		{
 			float dot2;
 
-			edict_t *next2 = G_PickTarget(path->target2);
+			edict_t *next2 = Path_Target(path, true);
 			if (next2 == path)
 				next2 = NULL;
 
@@ -1410,10 +1410,11 @@ edict_t *NextPathTrack(edict_t *train, edict_t *path)
 		if (!next)
 		{
 			// Check for path_tracks that target (or target2) this path_track.
-			for (int i = maxclients->value; i < globals.num_edicts && !next; i++)
+			const int numprevs = Path_Previous(path, &prevs);
+			for (int i = 0; i < numprevs && !next; i++)
 			{
-				edict_t *e = &g_edicts[i];
-				if (!e->inuse || e == path || !e->classname || Q_stricmp(e->classname, "path_track"))
+				edict_t *e = prevs[i];
+				if (!e->inuse)
 					continue;
 
 				if (e->target && !Q_stricmp(e->target, path->targetname))
@@ -1457,15 +1458,26 @@ edict_t *NextPathTrack(edict_t *train, edict_t *path)
 	return next;
 }
 
+edict_t *NextPathTrack(edict_t *train, edict_t *path)
+{
+	vec3_t forward;
+
+	AngleVectors(train->s.angles, forward, NULL, NULL);
+	return NextPathTrackDir(train, path, forward);
+}
+
 void LookAhead(edict_t *train, vec3_t point, float dist)
 {
 	vec3_t	v;
+	vec3_t	forward;
 	int		n = 0;
 	
 	edict_t *path = train->target_ent;
 	if (!path || dist < 0)
 		return;
 
+	AngleVectors(train->s.angles, forward, NULL, NULL);
+
 	while (dist > 0)
 	{
 		n++;
@@ -1487,7 +1499,7 @@ void LookAhead(edict_t *train, vec3_t point, float dist)
 		dist -= length;
 		VectorCopy(path->s.origin, point);
 
-		path = NextPathTrack(train, path);
+		path = NextPathTrackDir(train, path, forward);
 		if (!path)
 			return;
 	}
@@ -1545,7 +1557,7 @@ void tracktrain_turn(edict_t *self)
 	if (!train || !train->inuse)
 		return;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (train->spawnflags & (SF_TRACKTRAIN_DISABLED | SF_TRACKTRAIN_OTHERMAP))
 		return;
@@ -1707,7 +1719,7 @@ void func_tracktrain_find(edict_t *self)
 
 	ent->think = tracktrain_turn;
 	ent->enemy = self;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	VectorCopy(ent->s.origin, self->s.origin);
 	self->s.origin[2] += self->viewheight;
@@ -1717,11 +1729,11 @@ void func_tracktrain_find(edict_t *self)
 		self->solid = SOLID_NOT;
 		self->svflags |= SVF_NOCLIENT;
 		self->spawnflags |= SF_TRACKTRAIN_DISABLED;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 	else
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = tracktrain_next;
 	}
 
@@ -1763,7 +1775,7 @@ void tracktrain_use(edict_t *self, edict_t *other, edict_t *activator)
 		self->moveinfo.next_speed = 0;
 		self->s.sound = 0;
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 		self->spawnflags |= SF_TRACKTRAIN_STARTOFF;
 	}
 }
@@ -1861,7 +1873,7 @@ void SP_func_tracktrain(edict_t *self)
 
 	if (self->target)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = func_tracktrain_find;
 	}
 	else if (!(self->spawnflags & SF_TRACKTRAIN_OTHERMAP))
@@ -1878,7 +1890,7 @@ void SP_func_tracktrain(edict_t *self)
 	if (self->sounds > 0)
 	{
 		self->sounds = min(9, self->sounds);
-		self->source = gi.TagMalloc(10, TAG_LEVEL);
+		self->source = G_TagMalloc(10, TAG_LEVEL, MEM_STRINGS);
 		Com_sprintf(self->source, 10, "train/%d/", self->sounds);
 		gi.soundindex(va("%sspeed1.wav", self->source));
 		gi.soundindex(va("%sspeed2.wav", self->source));
@@ -1897,7 +1909,7 @@ void find_tracktrain(edict_t *self)
 	// This gives game a chance to put player in place before restarting train
 	if (!g_edicts[1].linkcount)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		return;
 	}
 
@@ -1937,7 +1949,7 @@ void find_tracktrain(edict_t *self)
 
 	if (train->sounds > 0)
 	{
-		train->source = gi.TagMalloc(10, TAG_LEVEL);
+		train->source = G_TagMalloc(10, TAG_LEVEL, MEM_STRINGS);
 		Com_sprintf(train->source, 10, "train/%d/", train->sounds);
 	}
 
@@ -2018,5 +2030,5 @@ void SP_info_train_start(edict_t *self)
 
 	self->class_id = ENTITY_INFO_TRAIN_START;
 	self->think = find_tracktrain;
-	self->nextthink = level.time + 1;
+	G_SetNextThink(self, level.time + 1);
 }
\ No newline at end of file
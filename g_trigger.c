@@ -44,7 +44,7 @@ void InitTrigger(edict_t *self)
 // the wait time has passed, so set back up for another activation
 void multi_wait(edict_t *ent)
 {
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 }
 
 
@@ -60,13 +60,13 @@ void multi_trigger(edict_t *ent)
 	if (ent->wait > 0)
 	{
 		ent->think = multi_wait;
-		ent->nextthink = level.time + ent->wait;
+		G_SetNextThink(ent, level.time + ent->wait);
 	}
 	else
 	{
 		// we can't just remove (self) here, because this is a touch function called while looping through area links...
 		ent->touch = NULL;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 		ent->think = G_FreeEdict;
 	}
 }
@@ -208,7 +208,7 @@ void trigger_relay_use(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 
 	G_UseTargets(self, activator);
@@ -240,7 +240,7 @@ void SP_trigger_relay(edict_t *self)
 	if (self->spawnflags & 1)
 	{
 		self->think = trigger_relay_autotrigger;
-		self->nextthink = level.time + 1.0f + self->wait;
+		G_SetNextThink(self, level.time + 1.0f + self->wait);
 		self->activator = self;
 	}
 }
@@ -350,7 +350,7 @@ void trigger_key_use(edict_t *self, edict_t *other, edict_t *activator)
 	{
 		self->use = NULL;
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		gi.linkentity(self);
 	}
 }
@@ -434,7 +434,7 @@ void trigger_counter_use(edict_t *self, edict_t *other, edict_t *activator)
 	if (self->count == 0)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -658,6 +658,7 @@ void SP_trigger_hurt(edict_t *self)
 	InitTrigger(self);
 
 	self->touch = hurt_touch;
+	self->class_id = ENTITY_TRIGGER_HURT;
 
 	if (!self->dmg)
 		self->dmg = 5;
@@ -782,7 +783,7 @@ void Use_tremor_Multi(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 	else
 	{
@@ -914,11 +915,11 @@ void trigger_inside_think(edict_t *self)
 
 		if (self->wait > 0)
 		{
-			self->nextthink = level.time + self->wait;
+			G_SetNextThink(self, level.time + self->wait);
 		}
 		else
 		{
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 			self->think = G_FreeEdict;
 		}
 
@@ -927,7 +928,7 @@ void trigger_inside_think(edict_t *self)
 		return;
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -959,7 +960,7 @@ void SP_trigger_inside(edict_t *self)
 
 	gi.setmodel(self, self->model);
 	self->think = trigger_inside_think;
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 
 	gi.linkentity(self);
 }
@@ -1034,7 +1035,7 @@ void trigger_scales_think(edict_t *self)
 		}
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
 
@@ -1055,7 +1056,7 @@ void SP_trigger_scales(edict_t *self)
 	self->solid = SOLID_TRIGGER;
 	gi.setmodel(self, self->model);
 	self->think = trigger_scales_think;
-	self->nextthink = level.time + 1.0;
+	G_SetNextThink(self, level.time + 1.0);
 	self->mass = 0;
 
 	gi.linkentity(self);
@@ -1085,13 +1086,13 @@ void trigger_bbox_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + self->delay + FRAMETIME;
+		G_SetNextThink(self, level.time + self->delay + FRAMETIME);
 		return;
 	}
 
 	if (self->wait >= 0)
 	{
-		self->nextthink = level.time + self->wait;
+		G_SetNextThink(self, level.time + self->wait);
 		self->think = trigger_bbox_reset;
 	}
 
@@ -1121,18 +1122,18 @@ void trigger_bbox_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface
 		if (!self->count)
 		{
 			self->think = G_FreeEdict;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink(self, level.time + FRAMETIME);
 		}
 		else
 		{
 			self->think = multi_wait;
-			self->nextthink = level.time + self->wait;
+			G_SetNextThink(self, level.time + self->wait);
 		}
 	}
 	else
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1142,7 +1143,7 @@ void trigger_bbox_use(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 	else
 	{
@@ -1323,13 +1324,13 @@ void trigger_look_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface
 	if (self->wait > 0)	
 	{
 		self->think = multi_wait;
-		self->nextthink = level.time + self->wait;
+		G_SetNextThink(self, level.time + self->wait);
 	}
 	else
 	{
 		// we can't just remove (self) here, because this is a touch function called while looping through area links...
 		self->touch = NULL;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->think = G_FreeEdict;
 	}
 }
@@ -1342,7 +1343,7 @@ void trigger_look_disable(edict_t *self, edict_t *other, edict_t *activator)
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 	else
 	{
@@ -1419,7 +1420,7 @@ void trigger_speaker_think(edict_t *self)
 	if (touching)
 		gi.sound(touching, CHAN_VOICE, self->noise_index, 1, ATTN_NORM, 0);
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void trigger_speaker_enable(edict_t *self, edict_t *other, edict_t *activator);
@@ -1428,7 +1429,7 @@ void trigger_speaker_disable(edict_t *self, edict_t *other, edict_t *activator)
 {
 	self->use = trigger_speaker_enable;
 	self->think = NULL;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 }
 
 void trigger_speaker_enable(edict_t *self, edict_t *other, edict_t *activator)
@@ -1459,7 +1460,7 @@ void SP_trigger_speaker(edict_t *self)
 	{
 		self->use = trigger_speaker_disable;
 		self->think = trigger_speaker_think;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{
@@ -1668,13 +1669,13 @@ int trigger_transition_ents(edict_t *changelevel, edict_t *self)
 		if (!Q_stricmp(ent->classname, "func_tracktrain") && !(ent->spawnflags & 8) && ent->targetname)
 		{
 			edict_t *e = G_Spawn();
-			e->classname = gi.TagMalloc(17, TAG_LEVEL);
+			e->classname = G_TagMalloc(17, TAG_LEVEL, MEM_STRINGS);
 			strcpy(e->classname, "info_train_start");
 
-			e->targetname = gi.TagMalloc(strlen(ent->targetname) + 1, TAG_LEVEL);
+			e->targetname = G_TagMalloc(strlen(ent->targetname) + 1, TAG_LEVEL, MEM_STRINGS);
 			strcpy(e->targetname, ent->targetname);
 
-			e->target = gi.TagMalloc(strlen(ent->target) + 1, TAG_LEVEL);
+			e->target = G_TagMalloc(strlen(ent->target) + 1, TAG_LEVEL, MEM_STRINGS);
 			strcpy(e->target, ent->target);
 
 			e->spawnflags = ent->spawnflags;
@@ -1840,7 +1841,7 @@ void touch_trigger_disguise(edict_t *trigger, edict_t *other, cplane_t *plane, c
 	trigger->count--;
 	if (trigger->count == 0)
 	{
-		trigger->nextthink = level.time + 0.1;
+		G_SetNextThink(trigger, level.time + 0.1);
 		trigger->think = G_FreeEdict;
 	}
 
@@ -1903,7 +1904,7 @@ void trigger_switch_usetargets(edict_t *ent, edict_t *activator)
 		// Create a temp object to fire at a later time
 		edict_t *t = G_Spawn();
 		t->classname = "DelayedUse";
-		t->nextthink = level.time + ent->delay;
+		G_SetNextThink(t, level.time + ent->delay);
 		t->think = trigger_switch_delay;
 		t->activator = activator;
 
@@ -2085,13 +2086,13 @@ void trigger_switch(edict_t *ent)
 	if (ent->wait > 0)
 	{
 		ent->think = multi_wait;
-		ent->nextthink = level.time + ent->wait;
+		G_SetNextThink(ent, level.time + ent->wait);
 	}
 	else
 	{
 		// We can't just remove (self) here, because this is a touch function called while looping through area links...
 		ent->touch = NULL;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 		ent->think = G_FreeEdict;
 	}
 }
@@ -685,7 +685,7 @@ void turret_breach_think(edict_t *self)
 
 	const qboolean yaw_restrict = (self->pos1[YAW] != 0 || self->pos2[YAW] != 360);
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (self->deadflag == DEAD_DEAD)
 		return;
@@ -1202,7 +1202,7 @@ void turret_breach_finish_init(edict_t *self)
 	else
 	{
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 }
 
@@ -1314,13 +1314,13 @@ void turret_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage
 				temp->solid = SOLID_NOT;
 				temp->svflags = SVF_NOCLIENT;
 				temp->think = turret_die_temp_think;
-				temp->nextthink = level.time + 2 * FRAMETIME;
+				G_SetNextThink(temp, level.time + 2 * FRAMETIME);
 				temp->destroytarget = self->destroytarget;
 				temp->target_ent = attacker;
 				gi.linkentity(temp);
 			}
 
-			self->nextthink = 0;
+			G_SetNextThink(self, 0);
 			gi.linkentity(self);
 		}
 
@@ -1362,13 +1362,13 @@ void toggle_turret_breach(edict_t *self, edict_t *other, edict_t *activator)
 		}
 
 		self->think = NULL;
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 	}
 	else
 	{
 		self->spawnflags &= ~SF_TURRET_INACTIVE;
 		self->think = turret_breach_think;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -1533,7 +1533,7 @@ void SP_turret_breach(edict_t *self)
 	self->blocked = turret_blocked;
 
 	self->think = turret_breach_finish_init;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	// Lazarus: Added so monsters will attack turrets that fire at them
 	self->monsterinfo.aiflags |= AI_GOOD_GUY;
@@ -1594,7 +1594,7 @@ void SP_turret_base(edict_t *self)
 	// DWH
 	self->s.angles[PITCH] = self->s.angles[ROLL] = 0;
 	self->think = turret_base_finish;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	gi.linkentity(self);
 }
@@ -1654,7 +1654,7 @@ void turret_driver_think(edict_t *self)
 	vec3_t	dir;
 	float	reaction_time;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	//ed - yaay, turrets will kill monsters and stuff now.
 	if (self->enemy && (!self->enemy->inuse || self->enemy->health <= 0))
@@ -1740,7 +1740,7 @@ void turret_driver_link(edict_t *self)
 	if (!(self->spawnflags & SF_TURRETDRIVER_REMOTE_DRIVER))
 	{
 		self->think = turret_driver_think;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->target_ent->teammaster->owner = self;
 		VectorCopy(self->target_ent->s.angles, self->s.angles);
 	}
@@ -1802,6 +1802,7 @@ void SP_turret_driver(edict_t *self)
 	level.total_monsters++;
 
 	self->svflags |= SVF_MONSTER;
+	G_UpdateRoles(self);
 	self->s.renderfx |= RF_FRAMELERP;
 	self->takedamage = DAMAGE_AIM;
 	self->use = monster_use;
@@ -1817,7 +1818,7 @@ void SP_turret_driver(edict_t *self)
 	}
 
 	self->think = turret_driver_link;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (self->spawnflags & SF_TURRETDRIVER_REMOTE_DRIVER)
 	{
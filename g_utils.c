@@ -63,7 +63,8 @@ edict_t *G_Find(edict_t *from, int fieldofs, char *match)
 		if (!s)
 			continue;
 
-		if (!Q_stricmp(s, match))
+		// Interned strings with the same text share a pointer
+		if (s == match || !Q_stricmp(s, match))
 			return from;
 	}
 
@@ -177,7 +178,7 @@ void G_UseTargets(edict_t *ent, edict_t *activator)
 		// create a temp object to fire at a later time
 		edict_t *t = G_Spawn();
 		t->classname = "DelayedUse";
-		t->nextthink = level.time + ent->delay;
+		G_SetNextThink(t, level.time + ent->delay);
 		t->think = Think_Delay;
 		t->activator = activator;
 
@@ -406,11 +407,10 @@ void vectoangles(vec3_t value1, vec3_t angles)
 }
 
 
+// Returns a shared copy of in, see G_InternString
 char *G_CopyString(char *in)
 {
-	char *out = gi.TagMalloc(strlen(in) + 1, TAG_LEVEL);
-	strcpy(out, in);
-	return out;
+	return G_InternString(in);
 }
 
 
@@ -421,6 +421,9 @@ void G_InitEdict(edict_t *e)
 	e->gravity = 1.0;
 	e->s.number = e - g_edicts;
 	e->org_movetype = -1;
+
+	G_UpdateRoles(e);
+	Think_Wake(e);
 }
 
 /*
@@ -468,21 +471,8 @@ Marks the edict as free
 */
 void G_FreeEdict(edict_t *ed)
 {
-	// Lazarus - if part of a movewith chain, remove from the chain and repair broken links
-	if (ed->movewith)
-	{
-		edict_t	*parent = NULL;
-
-		for (int i = 1; i < globals.num_edicts && !parent; i++)
-		{
-			edict_t *e = g_edicts + i;
-			if (e->movewith_next == ed)
-				parent = e;
-		}
-
-		if (parent)
-			parent->movewith_next = ed->movewith_next;
-	}
+	// Lazarus - if part of a movewith hierarchy, take it and its children out
+	Movewith_Free(ed);
 
 	gi.unlinkentity(ed); // unlink from world
 
@@ -501,6 +491,8 @@ void G_FreeEdict(edict_t *ed)
 		ed->flash->classname = "freed";
 		ed->flash->freetime = level.time;
 		ed->flash->inuse = false;
+		G_UpdateRoles(ed->flash);
+		Think_Wake(ed->flash);
 	}
 
 	// Lazarus: reflections
@@ -511,6 +503,9 @@ void G_FreeEdict(edict_t *ed)
 	ed->classname = "freed";
 	ed->freetime = level.time;
 	ed->inuse = false;
+
+	G_UpdateRoles(ed);
+	Think_Wake(ed);
 }
 
 /*
@@ -804,7 +799,7 @@ void G_UseTarget(edict_t *ent, edict_t *activator, edict_t *target)
 		// Create a temp object to fire at a later time
 		edict_t *t = G_Spawn();
 		t->classname = "DelayedUse";
-		t->nextthink = level.time + ent->delay;
+		G_SetNextThink(t, level.time + ent->delay);
 		t->think = Think_Delay_Single;
 		t->activator = activator;
 		t->target_ent = target;
@@ -915,4 +910,478 @@ void my_bprintf(int printlevel, char *fmt, ...)
 
 		safe_cprintf(cl_ent, printlevel, bigbuffer);
 	}
-}
\ No newline at end of file
+}
+/*
+====================
+BoxGrid_Build
+
+Bins a set of static boxes into a coarse XY grid, so point queries only have to look at the boxes
+filed in a single cell. Boxes with mins[0] > maxs[0] are left out. Cell lists keep the boxes in index order.
+====================
+*/
+#define BOXGRID_CELL	256		// Minimum cell size, in map units
+#define BOXGRID_MAXDIM	64		// Maximum number of cells along either axis
+
+void BoxGrid_Build(boxgrid_t *grid, int count, vec3_t *mins, vec3_t *maxs, int tag)
+{
+	vec3_t	bmins, bmaxs;
+
+	BoxGrid_Free(grid);
+
+	ClearBounds(bmins, bmaxs);
+	for (int i = 0; i < count; i++)
+	{
+		if (mins[i][0] > maxs[i][0])
+			continue;
+
+		AddPointToBounds(mins[i], bmins, bmaxs);
+		AddPointToBounds(maxs[i], bmins, bmaxs);
+	}
+
+	if (bmins[0] > bmaxs[0])
+		return; // Nothing to index
+
+	grid->cellsize = BOXGRID_CELL;
+	for (int i = 0; i < 2; i++)
+		grid->cellsize = max(grid->cellsize, (bmaxs[i] - bmins[i]) / BOXGRID_MAXDIM);
+
+	for (int i = 0; i < 2; i++)
+		grid->size[i] = (int)((bmaxs[i] - bmins[i]) / grid->cellsize) + 1;
+
+	VectorCopy(bmins, grid->origin);
+
+	const int numcells = grid->size[0] * grid->size[1];
+	grid->start = G_TagMalloc((numcells + 1) * sizeof(int), tag, MEM_GRID);
+
+	// Count pass, then fill pass
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (mins[i][0] > maxs[i][0])
+				continue;
+
+			const int x1 = (int)((mins[i][0] - grid->origin[0]) / grid->cellsize);
+			const int x2 = (int)((maxs[i][0] - grid->origin[0]) / grid->cellsize);
+			const int y1 = (int)((mins[i][1] - grid->origin[1]) / grid->cellsize);
+			const int y2 = (int)((maxs[i][1] - grid->origin[1]) / grid->cellsize);
+
+			for (int y = y1; y <= y2; y++)
+			{
+				for (int x = x1; x <= x2; x++)
+				{
+					const int cell = y * grid->size[0] + x;
+					if (pass == 0)
+						grid->start[cell + 1]++;
+					else
+						grid->list[grid->start[cell + 1]++] = i;
+				}
+			}
+		}
+
+		if (pass == 0)
+		{
+			// Prefix sums. After the fill pass, start[cell + 1] is back to the end of the cell
+			for (int c = 0; c < numcells; c++)
+				grid->start[c + 1] += grid->start[c];
+
+			grid->list = G_TagMalloc(max(1, grid->start[numcells]) * sizeof(int), tag, MEM_GRID);
+
+			for (int c = numcells; c > 0; c--)
+				grid->start[c] = grid->start[c - 1];
+		}
+	}
+}
+
+void BoxGrid_Free(boxgrid_t *grid)
+{
+	if (grid->start)
+		gi.TagFree(grid->start);
+	if (grid->list)
+		gi.TagFree(grid->list);
+
+	memset(grid, 0, sizeof(*grid));
+}
+
+/*
+====================
+BoxGrid_Query
+
+Returns the number of boxes filed in the cell containing point, and sets *list to their indices
+====================
+*/
+int BoxGrid_Query(boxgrid_t *grid, const vec3_t point, int **list)
+{
+	*list = NULL;
+
+	if (!grid->start || point[0] < grid->origin[0] || point[1] < grid->origin[1])
+		return 0;
+
+	const int x = (int)((point[0] - grid->origin[0]) / grid->cellsize);
+	const int y = (int)((point[1] - grid->origin[1]) / grid->cellsize);
+
+	if (x >= grid->size[0] || y >= grid->size[1])
+		return 0;
+
+	const int cell = y * grid->size[0] + x;
+	*list = grid->list + grid->start[cell];
+
+	return grid->start[cell + 1] - grid->start[cell];
+}
+
+/*
+=================
+Entity role registries
+
+Bitsets of the entities that are clients, monsters, pushers, items, dangers or cosmetics, so code that
+only cares about those doesn't have to walk the whole edict array. Membership is
+updated when an entity is linked, unlinked, spawned or freed (see G_UpdateRoles).
+Iterating a registry visits entities in edict order, same as a full scan would.
+=================
+*/
+
+#define NUM_ROLES		6
+#define ROLE_WORDS		((MAX_EDICTS + 31) / 32)
+
+static unsigned	role_bits[NUM_ROLES][ROLE_WORDS];
+static int		role_count[NUM_ROLES];
+static int		role_changes[NUM_ROLES];	// entities joining or leaving, never reset
+static byte		ent_roles[MAX_EDICTS];
+
+static int G_EntityRoles(edict_t *ent)
+{
+	if (!ent->inuse)
+		return 0;
+
+	int roles = 0;
+	const int index = ent - g_edicts;
+
+	if (index >= 1 && index <= game.maxclients && ent->client)
+		roles |= ROLE_CLIENT;
+
+	if ((ent->svflags & SVF_MONSTER) && !(ent->svflags & SVF_DEADMONSTER) && ent->deadflag == DEAD_NO)
+		roles |= ROLE_MONSTER;
+
+	if (ent->movetype == MOVETYPE_PUSH)
+		roles |= ROLE_PUSHER;
+
+	if (ent->item && !ent->client && !(ent->svflags & SVF_MONSTER))
+		roles |= ROLE_ITEM;
+
+	switch (ent->class_id)
+	{
+	case ENTITY_GRENADE:
+	case ENTITY_HANDGRENADE:
+	case ENTITY_ROCKET:
+	case ENTITY_BFG:
+		roles |= ROLE_DANGER;
+		break;
+
+	case ENTITY_TRIGGER_HURT:
+		if (ent->solid != SOLID_NOT && ent->dmg > 0)
+			roles |= ROLE_DANGER;
+		break;
+
+	case ENTITY_GIB:
+	case ENTITY_GIBHEAD:
+	case ENTITY_DEBRIS:
+		if (!ent->client && !(ent->svflags & SVF_MONSTER))
+			roles |= ROLE_COSMETIC;
+		break;
+
+	case ENTITY_LEAF:
+		if (!(ent->svflags & SVF_NOCLIENT))	// not waiting in its target_precipitation's chain
+			roles |= ROLE_COSMETIC;
+		break;
+
+	default:
+		break;
+	}
+
+	return roles;
+}
+
+static void G_SetRoles(int index, int roles)
+{
+	const int changed = ent_roles[index] ^ roles;
+	if (!changed)
+		return;
+
+	for (int r = 0; r < NUM_ROLES; r++)
+	{
+		if (!(changed & (1 << r)))
+			continue;
+
+		role_changes[r]++;
+
+		if (roles & (1 << r))
+		{
+			role_bits[r][index >> 5] |= 1u << (index & 31);
+			role_count[r]++;
+		}
+		else
+		{
+			role_bits[r][index >> 5] &= ~(1u << (index & 31));
+			role_count[r]--;
+		}
+	}
+
+	ent_roles[index] = roles;
+}
+
+/*
+=================
+G_UpdateRoles
+
+Call after changing anything that decides an entity's roles (inuse, svflags SVF_MONSTER or SVF_DEADMONSTER, deadflag, movetype, item)
+=================
+*/
+void G_UpdateRoles(edict_t *ent)
+{
+	if (!g_edicts || ent < g_edicts || ent - g_edicts >= min(game.maxentities, MAX_EDICTS))
+		return;
+
+	G_SetRoles(ent - g_edicts, G_EntityRoles(ent));
+}
+
+/*
+=================
+G_ClearRoles
+
+Must be called whenever the edict array is cleared
+=================
+*/
+void G_ClearRoles(void)
+{
+	memset(role_bits, 0, sizeof(role_bits));
+	memset(role_count, 0, sizeof(role_count));
+	memset(ent_roles, 0, sizeof(ent_roles));
+}
+
+void G_RebuildRoles(void)
+{
+	G_ClearRoles();
+
+	for (int i = 0; i < globals.num_edicts; i++)
+		G_SetRoles(i, G_EntityRoles(&g_edicts[i]));
+}
+
+/*
+=================
+G_NextRole
+
+Returns the next entity after from that has any of roles, or NULL. Works like G_Find:
+	for (ent = G_NextRole(NULL, ROLE_MONSTER); ent; ent = G_NextRole(ent, ROLE_MONSTER))
+=================
+*/
+edict_t *G_NextRole(edict_t *from, int roles)
+{
+	int index = (from ? from - g_edicts + 1 : 0);
+
+	while (index < globals.num_edicts)
+	{
+		const int word = index >> 5;
+		unsigned bits = 0;
+
+		for (int r = 0; r < NUM_ROLES; r++)
+			if (roles & (1 << r))
+				bits |= role_bits[r][word];
+
+		bits &= ~0u << (index & 31);
+
+		if (bits)
+		{
+			index = word << 5;
+			while (!(bits & 1))
+			{
+				bits >>= 1;
+				index++;
+			}
+
+			return (index < globals.num_edicts ? &g_edicts[index] : NULL);
+		}
+
+		index = (word + 1) << 5;
+	}
+
+	return NULL;
+}
+
+int G_RoleCount(int role)
+{
+	for (int r = 0; r < NUM_ROLES; r++)
+		if (role == (1 << r))
+			return role_count[r];
+
+	return 0;
+}
+
+// Goes up whenever an entity joins or leaves the registry, so callers can tell when something they built from it is out of date
+int G_RoleChanges(int role)
+{
+	for (int r = 0; r < NUM_ROLES; r++)
+		if (role == (1 << r))
+			return role_changes[r];
+
+	return 0;
+}
+
+/*
+=================
+G_CheckRoles
+
+Developer mode consistency check: reports and fixes entities whose registry membership is out of date
+=================
+*/
+void G_CheckRoles(void)
+{
+	static const char *names[NUM_ROLES] = { "client", "monster", "pusher", "item", "danger", "cosmetic" };
+
+	for (int i = 0; i < min(game.maxentities, MAX_EDICTS); i++)
+	{
+		const int roles = (i < globals.num_edicts ? G_EntityRoles(&g_edicts[i]) : 0);
+		const int changed = ent_roles[i] ^ roles;
+
+		if (!changed)
+			continue;
+
+		for (int r = 0; r < NUM_ROLES; r++)
+			if (changed & (1 << r))
+				gi.dprintf("G_CheckRoles: %s (%d) should%s be in %s registry\n", g_edicts[i].classname, i, ((roles & (1 << r)) ? "" : " not"), names[r]);
+
+		G_SetRoles(i, roles);
+	}
+}
+
+/*
+=================
+Entity string arena
+
+Level lifetime strings (ED_NewString, G_CopyString) are stored once per distinct
+value in TAG_LEVEL blocks, bump allocated. Entities with the same classname or
+targetname share the same pointer, so G_Find can often skip the string compare.
+Interned strings must never be modified or freed; copy them first if needed.
+=================
+*/
+
+#define STR_BLOCK_SIZE		8192
+#define STR_HASH_SIZE		2048
+#define STR_ALIGN			(sizeof(void *) - 1)
+
+typedef struct strentry_s
+{
+	struct strentry_s	*next;
+	unsigned			hash;
+	int					len;
+	char				str[1];
+} strentry_t;
+
+static strentry_t	*str_hash[STR_HASH_SIZE];
+static byte			*str_block;
+static int			str_blockused;
+
+static struct
+{
+	int		requests;
+	int		unique;
+	int		allocs;		// TagMalloc calls made
+	int		bytes_requested;
+	int		bytes_stored;
+	int		bytes_reserved;	// including block slack and entry headers
+} str_stats;
+
+static unsigned G_StringHash(const char *s, int *len)
+{
+	unsigned hash = 5381;
+	const char *start = s;
+
+	for (; *s; s++)
+		hash = hash * 33 + (byte)*s;
+
+	*len = s - start;
+	return hash;
+}
+
+static void *G_StringAlloc(int size)
+{
+	size = (size + STR_ALIGN) & ~STR_ALIGN;
+
+	// Big strings (long messages) get their own allocation
+	if (size > STR_BLOCK_SIZE / 4)
+	{
+		str_stats.allocs++;
+		str_stats.bytes_reserved += size;
+		return G_TagMalloc(size, TAG_LEVEL, MEM_STRINGS);
+	}
+
+	if (!str_block || str_blockused + size > STR_BLOCK_SIZE)
+	{
+		str_block = G_TagMalloc(STR_BLOCK_SIZE, TAG_LEVEL, MEM_STRINGS);
+		str_blockused = 0;
+		str_stats.allocs++;
+		str_stats.bytes_reserved += STR_BLOCK_SIZE;
+	}
+
+	void *p = str_block + str_blockused;
+	str_blockused += size;
+
+	return p;
+}
+
+/*
+=================
+G_InternString
+
+Returns a level lifetime copy of string, shared with every other identical string
+=================
+*/
+char *G_InternString(const char *string)
+{
+	int len;
+	const unsigned hash = G_StringHash(string, &len);
+	strentry_t **bucket = &str_hash[hash & (STR_HASH_SIZE - 1)];
+
+	str_stats.requests++;
+	str_stats.bytes_requested += len + 1;
+
+	for (strentry_t *e = *bucket; e; e = e->next)
+		if (e->hash == hash && e->len == len && !memcmp(e->str, string, len))
+			return e->str;
+
+	strentry_t *e = G_StringAlloc(sizeof(strentry_t) + len);
+	e->hash = hash;
+	e->len = len;
+	memcpy(e->str, string, len + 1);
+	e->next = *bucket;
+	*bucket = e;
+
+	str_stats.unique++;
+	str_stats.bytes_stored += len + 1;
+
+	return e->str;
+}
+
+/*
+=================
+G_ClearStrings
+
+Forgets all interned strings. Called after TAG_LEVEL memory is freed.
+=================
+*/
+void G_ClearStrings(void)
+{
+	memset(str_hash, 0, sizeof(str_hash));
+	memset(&str_stats, 0, sizeof(str_stats));
+	str_block = NULL;
+	str_blockused = 0;
+}
+
+void G_StringStats_f(void)
+{
+	const int header = G_TagOverhead();
+	const int saved = (str_stats.bytes_requested + str_stats.requests * header) - (str_stats.bytes_reserved + str_stats.allocs * header);
+
+	safe_cprintf(NULL, PRINT_HIGH, "Entity strings: %d requested, %d unique\n", str_stats.requests, str_stats.unique);
+	safe_cprintf(NULL, PRINT_HIGH, "  %d bytes requested, %d stored, %d reserved in %d allocations\n", str_stats.bytes_requested, str_stats.bytes_stored, str_stats.bytes_reserved, str_stats.allocs);
+	safe_cprintf(NULL, PRINT_HIGH, "  ~%d bytes and %d allocations saved\n", saved, str_stats.requests - str_stats.allocs);
+}
@@ -265,7 +265,7 @@ void vehicle_think(edict_t *self)
 	float newspeed;
 	vec3_t forward, left, f1, l1, v;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	VectorCopy(self->oldvelocity, v);
 	v[2] = 0;
@@ -458,7 +458,7 @@ void vehicle_think(edict_t *self)
 		}
 	}
 
-	if (self->movewith_next && self->movewith_next->movewith_ent == self)
+	if (self->movewith_child)
 		set_child_movement(self);
 }
 
@@ -506,7 +506,7 @@ void SP_func_vehicle(edict_t *self)
 	self->blocked = vehicle_blocked;
 	self->touch = vehicle_touch;
 	self->think = vehicle_think;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->noise_index = gi.soundindex("engine/engine.wav");
 	self->noise_index2 = gi.soundindex("engine/idle.wav");
 
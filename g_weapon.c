@@ -135,7 +135,7 @@ mxd. Tracers
 void tracer_touch(edict_t* self, edict_t* other, cplane_t* p, csurface_t* s)
 {
 	self->solid = SOLID_NOT;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->think = G_FreeEdict;
 	gi.linkentity(self);
 }
@@ -192,128 +192,116 @@ void fire_tracer(vec3_t start, vec3_t dir, const int type)
 fire_lead
 
 This is an internal support routine used for bullet/pellet based weapons.
+The helpers below are shared with fire_shotgun, which traces all of its pellets in one pass.
 =================
 */
-void fire_lead(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick, int te_impact, int hspread, int vspread, int mod)
+
+#define LEAD_NONE		0	// pellet hit nothing, or sky
+#define LEAD_DAMAGE		1	// pellet hit something that takes damage
+#define LEAD_IMPACT		2	// pellet hit a wall
+
+// Checks that the muzzle isn't inside a wall and sets up aim basis.
+// Returns false if self->s.origin -> start is blocked, in which case tr is the blocking trace.
+static qboolean fire_lead_setup(edict_t *self, vec3_t start, vec3_t aimdir, vec3_t forward, vec3_t right, vec3_t up, trace_t *tr)
+{
+	vec3_t dir;
+
+	*tr = gi.trace(self->s.origin, NULL, NULL, start, self, MASK_SHOT);
+	if (tr->fraction < 1.0)
+		return false;
+
+	vectoangles(aimdir, dir);
+	AngleVectors(dir, forward, right, up);
+
+	return true;
+}
+
+// Traces a single pellet, including water splash and bubble trail. end is set to the aim point (for tracers).
+static void fire_lead_trace(edict_t *self, vec3_t start, vec3_t forward, vec3_t right, vec3_t up, int hspread, int vspread, qboolean start_in_water, trace_t *result, vec3_t end)
 {
 	vec3_t		dir;
-	vec3_t		forward, right, up;
-	vec3_t		end;
 	vec3_t		water_start;
 	qboolean	water = false;
 	int			content_mask = MASK_SHOT | MASK_WATER;
 
-	trace_t tr = gi.trace(self->s.origin, NULL, NULL, start, self, MASK_SHOT);
-	if (!(tr.fraction < 1.0))
+	float r = crandom() * hspread;
+	float u = crandom() * vspread;
+	VectorMA(start, 8192, forward, end);
+	VectorMA(end, r, right, end);
+	VectorMA(end, u, up, end);
+
+	if (start_in_water)
 	{
-		vectoangles(aimdir, dir);
-		AngleVectors(dir, forward, right, up);
+		water = true;
+		VectorCopy(start, water_start);
+		content_mask &= ~MASK_WATER;
+	}
 
-		float r = crandom() * hspread;
-		float u = crandom() * vspread;
-		VectorMA(start, 8192, forward, end);
-		VectorMA(end, r, right, end);
-		VectorMA(end, u, up, end);
+	trace_t tr = gi.trace(start, NULL, NULL, end, self, content_mask);
 
-		if (gi.pointcontents(start) & MASK_WATER)
-		{
-			water = true;
-			VectorCopy(start, water_start);
-			content_mask &= ~MASK_WATER;
-		}
+	// see if we hit water
+	if (tr.contents & MASK_WATER)
+	{
+		int color;
 
-		tr = gi.trace(start, NULL, NULL, end, self, content_mask);
+		water = true;
+		VectorCopy(tr.endpos, water_start);
 
-		// see if we hit water
-		if (tr.contents & MASK_WATER)
+		if (!VectorCompare(start, tr.endpos))
 		{
-			int color;
-
-			water = true;
-			VectorCopy(tr.endpos, water_start);
-
-			if (!VectorCompare(start, tr.endpos))
+			if (tr.ent->svflags & SVF_MUD)
 			{
-				if (tr.ent->svflags & SVF_MUD)
-				{
+				color = SPLASH_BROWN_WATER;
+			}
+			else if (tr.contents & CONTENTS_WATER)
+			{
+				if (strcmp(tr.surface->name, "*brwater") == 0)
 					color = SPLASH_BROWN_WATER;
-				}
-				else if (tr.contents & CONTENTS_WATER)
-				{
-					if (strcmp(tr.surface->name, "*brwater") == 0)
-						color = SPLASH_BROWN_WATER;
-					else
-						color = SPLASH_BLUE_WATER;
-				}
-				else if (tr.contents & CONTENTS_SLIME)
-				{
-					color = SPLASH_SLIME;
-				}
-				else if (tr.contents & CONTENTS_LAVA)
-				{
-					color = SPLASH_LAVA;
-				}
 				else
-				{
-					color = SPLASH_UNKNOWN;
-				}
-
-				if (color != SPLASH_UNKNOWN)
-				{
-					gi.WriteByte(svc_temp_entity);
-					gi.WriteByte(TE_SPLASH);
-					gi.WriteByte(8);
-					gi.WritePosition(tr.endpos);
-					gi.WriteDir(tr.plane.normal);
-					gi.WriteByte(color);
-					gi.multicast(tr.endpos, MULTICAST_PVS);
-				}
-
-				// change bullet's course when it enters water
-				VectorSubtract(end, start, dir);
-				vectoangles(dir, dir);
-				AngleVectors(dir, forward, right, up);
-				r = crandom() * hspread * 2;
-				u = crandom() * vspread * 2;
-				VectorMA(water_start, 8192, forward, end);
-				VectorMA(end, r, right, end);
-				VectorMA(end, u, up, end);
+					color = SPLASH_BLUE_WATER;
 			}
-
-			// re-trace ignoring water this time
-			tr = gi.trace(water_start, NULL, NULL, end, self, MASK_SHOT);
-		}
-	}
-
-	// send gun puff / flash
-	if (!(tr.surface && (tr.surface->flags & SURF_SKY)))
-	{
-		if (tr.fraction < 1.0)
-		{
-			if (tr.ent->takedamage)
+			else if (tr.contents & CONTENTS_SLIME)
 			{
-				T_Damage(tr.ent, self, self, aimdir, tr.endpos, tr.plane.normal, damage, kick, DAMAGE_BULLET, mod);
+				color = SPLASH_SLIME;
+			}
+			else if (tr.contents & CONTENTS_LAVA)
+			{
+				color = SPLASH_LAVA;
 			}
 			else
 			{
-				if (strncmp (tr.surface->name, "sky", 3) != 0)
-				{
-					gi.WriteByte(svc_temp_entity);
-					gi.WriteByte(te_impact);
-					gi.WritePosition(tr.endpos);
-					gi.WriteDir(tr.plane.normal);
-					gi.multicast(tr.endpos, MULTICAST_PVS);
-
-					if (level.num_reflectors)
-						ReflectSparks(te_impact,tr.endpos,tr.plane.normal);
+				color = SPLASH_UNKNOWN;
+			}
 
-					if (self->client)
-						PlayerNoise(self, tr.endpos, PNOISE_IMPACT);
-				}
+			if (color != SPLASH_UNKNOWN)
+			{
+				TempEnt_Begin();
+				TempEnt_WriteByte(TE_SPLASH);
+				TempEnt_WriteByte(8);
+				TempEnt_WritePosition(tr.endpos);
+				TempEnt_WriteDir(tr.plane.normal);
+				TempEnt_WriteByte(color);
+				TempEnt_Multicast(tr.endpos, MULTICAST_PVS);
 			}
+
+			// change bullet's course when it enters water
+			vec3_t wforward, wright, wup;
+			VectorSubtract(end, start, dir);
+			vectoangles(dir, dir);
+			AngleVectors(dir, wforward, wright, wup);
+			r = crandom() * hspread * 2;
+			u = crandom() * vspread * 2;
+			VectorMA(water_start, 8192, wforward, end);
+			VectorMA(end, r, wright, end);
+			VectorMA(end, u, wup, end);
 		}
+
+		// re-trace ignoring water this time
+		tr = gi.trace(water_start, NULL, NULL, end, self, MASK_SHOT);
 	}
 
+	*result = tr;
+
 	// if went through water, determine where the end and make a bubble trail
 	if (water)
 	{
@@ -330,14 +318,47 @@ void fire_lead(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick,
 		VectorAdd(water_start, tr.endpos, pos);
 		VectorScale(pos, 0.5, pos);
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_BUBBLETRAIL);
-		gi.WritePosition(water_start);
-		gi.WritePosition(tr.endpos);
-		gi.multicast(pos, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_BUBBLETRAIL);
+		TempEnt_WritePosition(water_start);
+		TempEnt_WritePosition(tr.endpos);
+		TempEnt_Multicast(pos, MULTICAST_PVS);
 	}
+}
+
+static int fire_lead_result(trace_t *tr)
+{
+	if ((tr->surface && (tr->surface->flags & SURF_SKY)) || tr->fraction == 1.0)
+		return LEAD_NONE;
+
+	if (tr->ent->takedamage)
+		return LEAD_DAMAGE;
+
+	if (strncmp(tr->surface->name, "sky", 3) != 0)
+		return LEAD_IMPACT;
+
+	return LEAD_NONE;
+}
+
+// send gun puff / flash
+static void fire_lead_impact(edict_t *self, vec3_t pos, vec3_t normal, int te_impact)
+{
+	TempEnt_Begin();
+	TempEnt_WriteByte(te_impact);
+	TempEnt_WritePosition(pos);
+	TempEnt_WriteDir(normal);
+	TempEnt_Multicast(pos, MULTICAST_PVS);
+
+	if (level.num_reflectors)
+		ReflectSparks(te_impact, pos, normal);
+
+	if (self->client)
+		PlayerNoise(self, pos, PNOISE_IMPACT);
+}
 
-	//mxd. Spawn tracer...
+//mxd. Spawn tracer...
+static void fire_lead_tracer(edict_t *self, vec3_t start, vec3_t end, int te_impact, int mod)
+{
 	vec3_t tracer_dir, tracer_start;
 	VectorCopy(start, tracer_start);
 	
@@ -369,6 +390,31 @@ void fire_lead(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick,
 	fire_tracer(tracer_start, tracer_dir, te_impact);
 }
 
+void fire_lead(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick, int te_impact, int hspread, int vspread, int mod)
+{
+	vec3_t		forward, right, up;
+	vec3_t		end;
+	trace_t		tr;
+
+	if (fire_lead_setup(self, start, aimdir, forward, right, up, &tr))
+		fire_lead_trace(self, start, forward, right, up, hspread, vspread, (gi.pointcontents(start) & MASK_WATER), &tr, end);
+	else
+		VectorMA(start, 8192, aimdir, end);
+
+	switch (fire_lead_result(&tr))
+	{
+		case LEAD_DAMAGE:
+			T_Damage(tr.ent, self, self, aimdir, tr.endpos, tr.plane.normal, damage, kick, DAMAGE_BULLET, mod);
+			break;
+
+		case LEAD_IMPACT:
+			fire_lead_impact(self, tr.endpos, tr.plane.normal, te_impact);
+			break;
+	}
+
+	fire_lead_tracer(self, start, end, te_impact, mod);
+}
+
 
 /*
 =================
@@ -390,10 +436,90 @@ fire_shotgun
 Shoots shotgun pellets.  Used by shotgun and super shotgun.
 =================
 */
+#define MAX_PELLET_HITS		32
+#define PELLET_MERGE_DIST	12		// wall impacts closer than this are sent as one temp entity
+
+typedef struct
+{
+	edict_t		*ent;		// damaged entity, NULL for wall impacts
+	vec3_t		pos;
+	vec3_t		normal;
+	int			count;		// number of pellets
+} pellet_hit_t;
+
+static void fire_shotgun_flush(edict_t *self, vec3_t aimdir, int damage, int kick, int mod, pellet_hit_t *hits, int numhits)
+{
+	for (int i = 0; i < numhits; i++)
+	{
+		pellet_hit_t *hit = &hits[i];
+
+		if (!hit->ent)
+			fire_lead_impact(self, hit->pos, hit->normal, TE_SHOTGUN);
+		else if (hit->ent->inuse && hit->ent->takedamage) // may have been freed by earlier damage
+			T_Damage(hit->ent, self, self, aimdir, hit->pos, hit->normal, damage * hit->count, kick * hit->count, DAMAGE_BULLET, mod);
+	}
+}
+
 void fire_shotgun(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick, int hspread, int vspread, int count, int mod)
 {
+	pellet_hit_t	hits[MAX_PELLET_HITS];
+	int				numhits = 0;
+	vec3_t			forward, right, up;
+	vec3_t			end;
+	trace_t			tr;
+
+	// Muzzle check, aim basis and water test are the same for all pellets
+	const qboolean clear = fire_lead_setup(self, start, aimdir, forward, right, up, &tr);
+	const qboolean in_water = (clear && (gi.pointcontents(start) & MASK_WATER));
+
+	if (!clear)
+		VectorMA(start, 8192, aimdir, end);
+
 	for (int i = 0; i < count; i++)
-		fire_lead(self, start, aimdir, damage, kick, TE_SHOTGUN, hspread, vspread, mod);
+	{
+		if (clear)
+			fire_lead_trace(self, start, forward, right, up, hspread, vspread, in_water, &tr, end);
+
+		const int result = fire_lead_result(&tr);
+		if (result != LEAD_NONE)
+		{
+			// Damage is accumulated per victim, wall impacts close to each other are merged
+			edict_t *victim = (result == LEAD_DAMAGE ? tr.ent : NULL);
+			pellet_hit_t *hit = NULL;
+
+			for (int j = 0; j < numhits && !hit; j++)
+			{
+				if (hits[j].ent != victim)
+					continue;
+
+				vec3_t delta;
+				VectorSubtract(hits[j].pos, tr.endpos, delta);
+				if (victim || (VectorLengthSquared(delta) < PELLET_MERGE_DIST * PELLET_MERGE_DIST && DotProduct(hits[j].normal, tr.plane.normal) > 0.9f))
+					hit = &hits[j];
+			}
+
+			if (!hit)
+			{
+				if (numhits == MAX_PELLET_HITS)
+				{
+					fire_shotgun_flush(self, aimdir, damage, kick, mod, hits, numhits);
+					numhits = 0;
+				}
+
+				hit = &hits[numhits++];
+				hit->ent = victim;
+				hit->count = 0;
+				VectorCopy(tr.endpos, hit->pos);
+				VectorCopy(tr.plane.normal, hit->normal);
+			}
+
+			hit->count++;
+		}
+
+		fire_lead_tracer(self, start, end, TE_SHOTGUN, mod);
+	}
+
+	fire_shotgun_flush(self, aimdir, damage, kick, mod, hits, numhits);
 }
 
 
@@ -441,16 +567,16 @@ void blaster_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *s
 		else //standard yellow
 			tempevent = TE_BLASTER;
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(tempevent);
-		gi.WritePosition(self->s.origin);
+		TempEnt_Begin();
+		TempEnt_WriteByte(tempevent);
+		TempEnt_WritePosition(self->s.origin);
 
 		if (!plane)
-			gi.WriteDir(vec3_origin);
+			TempEnt_WriteDir(vec3_origin);
 		else
-			gi.WriteDir(plane->normal);
+			TempEnt_WriteDir(plane->normal);
 
-		gi.multicast(self->s.origin, MULTICAST_PVS);
+		TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 		if (level.num_reflectors)
 		{
@@ -502,7 +628,7 @@ void fire_blaster(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed
 
 	bolt->owner = self;
 	bolt->touch = blaster_touch;
-	bolt->nextthink = level.time + 2;
+	G_SetNextThink(bolt, level.time + 2);
 	bolt->think = G_FreeEdict;
 	bolt->dmg = damage;
 	bolt->classname = "bolt";
@@ -528,13 +654,13 @@ void bolt_delayed_start(edict_t *bolt)
 	if (g_edicts[1].linkcount)
 	{
 		VectorScale(bolt->movedir,bolt->moveinfo.speed,bolt->velocity);
-		bolt->nextthink = level.time + 2;
+		G_SetNextThink(bolt, level.time + 2);
 		bolt->think = G_FreeEdict;
 		gi.linkentity(bolt);
 	}
 	else
 	{
-		bolt->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(bolt, level.time + FRAMETIME);
 	}
 }
 
@@ -548,7 +674,7 @@ void SP_bolt(edict_t *bolt)
 	bolt->moveinfo.speed = VectorLength(bolt->velocity);
 	VectorClear(bolt->velocity);
 	bolt->think = bolt_delayed_start;
-	bolt->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(bolt, level.time + FRAMETIME);
 
 	gi.linkentity(bolt);
 }
@@ -560,35 +686,38 @@ fire_grenade
 =================
 */
 
-// Lazarus additions: next_grenade and prev_grenade linked lists facilitate checking
-// for grenades near monsters, so that monsters can evade w/o bogging down the game
+// Lazarus: monsters evade live grenades on the ground. Nearby grenades come from the danger registry
+// (g_danger.c), so this doesn't bog down the game however many monsters and grenades there are.
 
 void Grenade_Evade(edict_t *monster)
 {
 	vec3_t	grenade_vec;
 	vec3_t	forward;
 	vec3_t	pos, best_pos;
+	edict_t	*list[DANGER_LIST_MAX];
 
 	// We assume on entry here that monster is alive and that he's not already
 	// AI_CHASE_THING
-	edict_t *grenade = world->next_grenade;
+	const int num = Danger_Find(monster->s.origin, 0, DANGER_GRENADE, list, DANGER_LIST_MAX);
+	edict_t *grenade = NULL;
 	float grenade_dist = 0.0f; //mxd
-	while (grenade)
+	for (int i = 0; i < num; i++)
 	{
 		// we only care about grenades on the ground
-		if (grenade->inuse && grenade->groundentity)
+		if (!list[i]->groundentity)
+			continue;
+
+		// if it ain't in the PVS, it can't hurt us (I think?)
+		if (gi.inPVS(list[i]->s.origin, monster->s.origin))
 		{
-			// if it ain't in the PVS, it can't hurt us (I think?)
-			if (gi.inPVS(grenade->s.origin, monster->s.origin))
+			VectorSubtract(list[i]->s.origin, monster->s.origin, grenade_vec);
+			grenade_dist = VectorNormalize(grenade_vec);
+			if (grenade_dist <= list[i]->dmg_radius)
 			{
-				VectorSubtract(grenade->s.origin, monster->s.origin, grenade_vec);
-				grenade_dist = VectorNormalize(grenade_vec);
-				if (grenade_dist <= grenade->dmg_radius)
-					break;
+				grenade = list[i];
+				break;
 			}
 		}
-
-		grenade = grenade->next_grenade;
 	}
 
 	if (!grenade || grenade_dist == 0.0f) //mxd. +grenade_dist check
@@ -614,6 +743,10 @@ void Grenade_Evade(edict_t *monster)
 			if (tr.fraction < 1.0)
 				continue;
 
+			// Out of the frying pan...
+			if (Danger_Find(tr.endpos, 0, DANGER_HURT, list, 1))
+				continue;
+
 			best_r = r;
 			best_yaw = yaw;
 			VectorCopy(tr.endpos, best_pos);
@@ -636,35 +769,12 @@ void Grenade_Evade(edict_t *monster)
 	}
 }
 
-void Grenade_Add_To_Chain(edict_t *grenade)
-{
-	edict_t *ancestor = world;
-	while (ancestor->next_grenade && ancestor->next_grenade->inuse)
-		ancestor = ancestor->next_grenade;
-
-	ancestor->next_grenade = grenade;
-	grenade->prev_grenade = ancestor;
-}
-
-void Grenade_Remove_From_Chain(edict_t *grenade)
-{
-	if (grenade->prev_grenade)
-	{
-		// "prev_grenade" should always be valid for other than player-thrown grenades that explode in player's hand
-		grenade->prev_grenade->next_grenade = grenade->next_grenade;
-		if (grenade->next_grenade)
-			grenade->next_grenade->prev_grenade = grenade->prev_grenade;
-	}
-}
-
 void Grenade_Explode(edict_t *ent)
 {
 	vec3_t		origin;
 	int			mod;
 	int			type;
 
-	Grenade_Remove_From_Chain(ent);
-
 	if (ent->owner && ent->owner->client)
 		PlayerNoise(ent->owner, ent->s.origin, PNOISE_IMPACT);
 
@@ -693,7 +803,7 @@ void Grenade_Explode(edict_t *ent)
 	T_RadiusDamage(ent, ent->owner, ent->dmg, ent->enemy, ent->dmg_radius, mod, -0.5);
 
 	VectorMA(ent->s.origin, -0.02, ent->velocity, origin);
-	gi.WriteByte(svc_temp_entity);
+	TempEnt_Begin();
 
 	if (ent->waterlevel)
 	{
@@ -709,10 +819,10 @@ void Grenade_Explode(edict_t *ent)
 		else
 			type = TE_ROCKET_EXPLOSION;
 	}
-	gi.WriteByte(type);
+	TempEnt_WriteByte(type);
 
-	gi.WritePosition(origin);
-	gi.multicast(ent->s.origin, MULTICAST_PHS);
+	TempEnt_WritePosition(origin);
+	TempEnt_Multicast(ent->s.origin, MULTICAST_PHS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(type, origin);
@@ -727,7 +837,6 @@ void Grenade_Touch(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *su
 
 	if (surf && (surf->flags & SURF_SKY))
 	{
-		Grenade_Remove_From_Chain(ent);
 		G_FreeEdict(ent);
 		return;
 	}
@@ -781,7 +890,6 @@ void ContactGrenade_Touch(edict_t *ent, edict_t *other, cplane_t *plane, csurfac
 
 	if (surf && (surf->flags & SURF_SKY))
 	{
-		Grenade_Remove_From_Chain(ent);
 		G_FreeEdict(ent);
 		return;
 	}
@@ -833,15 +941,13 @@ void fire_grenade(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int sp
 	else
 		grenade->touch = Grenade_Touch;
 
-	grenade->nextthink = level.time + timer;
+	G_SetNextThink(grenade, level.time + timer);
 	grenade->think = Grenade_Explode;
 	grenade->dmg = damage;
 	grenade->dmg_radius = damage_radius;
 	grenade->classname = "grenade";
 	grenade->class_id = ENTITY_GRENADE; //mxd
 
-	Grenade_Add_To_Chain(grenade);
-
 	gi.linkentity(grenade);
 }
 
@@ -875,7 +981,7 @@ void fire_grenade2(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int s
 	grenade->s.modelindex = gi.modelindex("models/objects/grenade2/tris.md2");
 	grenade->owner = self;
 	grenade->touch = Grenade_Touch;
-	grenade->nextthink = level.time + timer;
+	G_SetNextThink(grenade, level.time + timer);
 	grenade->think = Grenade_Explode;
 	grenade->dmg = damage;
 	grenade->dmg_radius = damage_radius;
@@ -896,7 +1002,6 @@ void fire_grenade2(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int s
 	else
 	{
 		gi.sound(self, CHAN_WEAPON, gi.soundindex("weapons/hgrent1a.wav"), 1, ATTN_NORM, 0);
-		Grenade_Add_To_Chain(grenade);
 		gi.linkentity(grenade);
 	}
 }
@@ -910,13 +1015,13 @@ void grenade_delayed_start(edict_t *grenade)
 	{
 		VectorScale(grenade->movedir, grenade->moveinfo.speed, grenade->velocity);
 		grenade->movetype = MOVETYPE_BOUNCE;
-		grenade->nextthink = level.time + 2.5;
+		G_SetNextThink(grenade, level.time + 2.5);
 		grenade->think = Grenade_Explode;
 		gi.linkentity(grenade);
 	}
 	else
 	{
-		grenade->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(grenade, level.time + FRAMETIME);
 	}
 }
 
@@ -935,12 +1040,12 @@ void SP_grenade(edict_t *grenade)
 		grenade->moveinfo.speed = VectorLength(grenade->velocity);
 		VectorClear(grenade->velocity);
 		grenade->think = grenade_delayed_start;
-		grenade->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(grenade, level.time + FRAMETIME);
 	}
 	else
 	{
 		grenade->movetype = MOVETYPE_BOUNCE;
-		grenade->nextthink = level.time + 2.5;
+		G_SetNextThink(grenade, level.time + 2.5);
 		grenade->think = Grenade_Explode;
 	}
 
@@ -953,7 +1058,7 @@ void handgrenade_delayed_start(edict_t *grenade)
 	{
 		VectorScale(grenade->movedir, grenade->moveinfo.speed, grenade->velocity);
 		grenade->movetype = MOVETYPE_BOUNCE;
-		grenade->nextthink = level.time + 2.5;
+		G_SetNextThink(grenade, level.time + 2.5);
 		grenade->think = Grenade_Explode;
 
 		if (grenade->owner)
@@ -963,7 +1068,7 @@ void handgrenade_delayed_start(edict_t *grenade)
 	}
 	else
 	{
-		grenade->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(grenade, level.time + FRAMETIME);
 	}
 }
 
@@ -981,12 +1086,12 @@ void SP_handgrenade(edict_t *grenade)
 		grenade->moveinfo.speed = VectorLength(grenade->velocity);
 		VectorClear(grenade->velocity);
 		grenade->think = handgrenade_delayed_start;
-		grenade->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(grenade, level.time + FRAMETIME);
 	}
 	else
 	{
 		grenade->movetype = MOVETYPE_BOUNCE;
-		grenade->nextthink = level.time + 2.5;
+		G_SetNextThink(grenade, level.time + 2.5);
 		grenade->think = Grenade_Explode;
 	}
 
@@ -1046,7 +1151,7 @@ void homing_think(edict_t *self)
 		}
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 /*
@@ -1058,7 +1163,7 @@ fire_rocket
 
 void Rocket_Evade(edict_t *rocket, vec3_t dir, float speed)
 {
-	edict_t	*ent = NULL;
+	edict_t	*ent;
 	vec3_t	hitpoint;
 	vec3_t	forward, pos, best_pos;
 	vec3_t	rocket_vec, vec;
@@ -1071,9 +1176,16 @@ void Rocket_Evade(edict_t *rocket, vec3_t dir, float speed)
 	const float dist = VectorLength(vec);
 	const float time = dist / speed;
 
-	while ((ent = findradius(ent, hitpoint, rocket->dmg_radius)) != NULL)
+	// Same test as findradius, but only monsters are looked at
+	for (ent = G_NextRole(NULL, ROLE_MONSTER); ent; ent = G_NextRole(ent, ROLE_MONSTER))
 	{
-		if (!ent->inuse || !(ent->svflags & SVF_MONSTER) || !ent->takedamage || ent->health <= 0 || rocket->owner == ent)
+		if (ent->solid == SOLID_NOT || !ent->takedamage || rocket->owner == ent)
+			continue;
+
+		for (int j = 0; j < 3; j++)
+			vec[j] = hitpoint[j] - (ent->s.origin[j] + (ent->mins[j] + ent->maxs[j]) * 0.5f);
+
+		if (VectorLength(vec) > rocket->dmg_radius)
 			continue;
 
 		if (!ent->monsterinfo.run)	// takes care of turret_driver
@@ -1177,11 +1289,11 @@ void rocket_touch(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *sur
 	else
 		T_RadiusDamage(ent, ent->owner, ent->radius_dmg, other, ent->dmg_radius, MOD_R_SPLASH, -0.5);
 
-	gi.WriteByte(svc_temp_entity);
+	TempEnt_Begin();
 	const int type = (ent->waterlevel ? TE_ROCKET_EXPLOSION_WATER : TE_ROCKET_EXPLOSION);
-	gi.WriteByte(type);
-	gi.WritePosition(origin);
-	gi.multicast(ent->s.origin, MULTICAST_PHS);
+	TempEnt_WriteByte(type);
+	TempEnt_WritePosition(origin);
+	TempEnt_Multicast(ent->s.origin, MULTICAST_PHS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(type, origin);
@@ -1201,11 +1313,11 @@ void rocket_explode(edict_t *ent)
 
 	T_RadiusDamage(ent, ent->owner, ent->radius_dmg, NULL, ent->dmg_radius, MOD_R_SPLASH, -0.5);
 
-	gi.WriteByte(svc_temp_entity);
+	TempEnt_Begin();
 	const int type = (ent->waterlevel ? TE_ROCKET_EXPLOSION_WATER : TE_ROCKET_EXPLOSION);
-	gi.WriteByte(type);
-	gi.WritePosition(origin);
-	gi.multicast(ent->s.origin, MULTICAST_PVS);
+	TempEnt_WriteByte(type);
+	TempEnt_WritePosition(origin);
+	TempEnt_Multicast(ent->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(type, origin);
@@ -1216,7 +1328,7 @@ void rocket_explode(edict_t *ent)
 void rocket_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, vec3_t point)
 {
 	self->takedamage = DAMAGE_NO;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->think = rocket_explode;
 }
 
@@ -1275,7 +1387,8 @@ void fire_rocket(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed,
 
 		rocket->enemy = home_target;
 		rocket->classname = "homing rocket";
-		rocket->nextthink = level.time + FRAMETIME;
+		rocket->class_id = ENTITY_ROCKET;
+		G_SetNextThink(rocket, level.time + FRAMETIME);
 		rocket->think = homing_think;
 		rocket->starttime = level.time + 0.3; // play homing sound on 3rd frame
 		rocket->endtime = level.time + 8000.0 / speed; //mxd. 8000 -> 8000.0
@@ -1288,7 +1401,8 @@ void fire_rocket(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed,
 	else
 	{
 		rocket->classname = "rocket";
-		rocket->nextthink = level.time + 8000.0 / speed; //mxd. 8000 -> 8000.0
+		rocket->class_id = ENTITY_ROCKET;
+		G_SetNextThink(rocket, level.time + 8000.0 / speed); //mxd. 8000 -> 8000.0
 		rocket->think = G_FreeEdict;
 
 		Rocket_Evade(rocket, dir, speed);
@@ -1303,13 +1417,13 @@ void rocket_delayed_start(edict_t *rocket)
 	if (g_edicts[1].linkcount)
 	{
 		VectorScale(rocket->movedir, rocket->moveinfo.speed, rocket->velocity);
-		rocket->nextthink = level.time + 8000.0 / rocket->moveinfo.speed;
+		G_SetNextThink(rocket, level.time + 8000.0 / rocket->moveinfo.speed);
 		rocket->think = G_FreeEdict;
 		gi.linkentity(rocket);
 	}
 	else
 	{
-		rocket->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(rocket, level.time + FRAMETIME);
 	}
 }
 
@@ -1332,12 +1446,12 @@ void SP_rocket(edict_t *rocket)
 	{
 		VectorClear(rocket->velocity);
 		rocket->think = rocket_delayed_start;
-		rocket->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(rocket, level.time + FRAMETIME);
 	}
 	else
 	{
 		rocket->think = G_FreeEdict;
-		rocket->nextthink = level.time + 8000.0 / rocket->moveinfo.speed;
+		G_SetNextThink(rocket, level.time + 8000.0 / rocket->moveinfo.speed);
 	}
 
 	gi.linkentity(rocket);
@@ -1396,22 +1510,22 @@ void fire_rail(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick)
 	}
 
 	// send gun puff / flash
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(tempevent);
-	gi.WritePosition(start);
-	gi.WritePosition(tr.endpos);
-	gi.multicast(self->s.origin, MULTICAST_PHS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(tempevent);
+	TempEnt_WritePosition(start);
+	TempEnt_WritePosition(tr.endpos);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PHS);
 
 	if (level.num_reflectors)
 		ReflectTrail(tempevent, start, tr.endpos);
 
 	if (water)
 	{
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(tempevent);
-		gi.WritePosition(start);
-		gi.WritePosition(tr.endpos);
-		gi.multicast(tr.endpos, MULTICAST_PHS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(tempevent);
+		TempEnt_WritePosition(start);
+		TempEnt_WritePosition(tr.endpos);
+		TempEnt_Multicast(tr.endpos, MULTICAST_PHS);
 	}
 
 	if (self->client)
@@ -1445,10 +1559,10 @@ void bfg_explode(edict_t *self)
 			if (ent == self->owner)
 				points = points * 0.5;
 
-			gi.WriteByte(svc_temp_entity);
-			gi.WriteByte(TE_BFG_EXPLOSION);
-			gi.WritePosition(ent->s.origin);
-			gi.multicast(ent->s.origin, MULTICAST_PHS);
+			TempEnt_Begin();
+			TempEnt_WriteByte(TE_BFG_EXPLOSION);
+			TempEnt_WritePosition(ent->s.origin);
+			TempEnt_Multicast(ent->s.origin, MULTICAST_PHS);
 
 			if (level.num_reflectors)
 				ReflectExplosion(TE_BFG_EXPLOSION, ent->s.origin);
@@ -1457,7 +1571,7 @@ void bfg_explode(edict_t *self)
 		}
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->s.frame++;
 	if (self->s.frame == 5)
 		self->think = G_FreeEdict;
@@ -1493,13 +1607,13 @@ void bfg_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *surf)
 	self->s.sound = 0;
 	self->s.effects &= ~EF_ANIM_ALLFAST;
 	self->think = bfg_explode;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->enemy = other;
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_BFG_BIGEXPLOSION);
-	gi.WritePosition(self->s.origin);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_BFG_BIGEXPLOSION);
+	TempEnt_WritePosition(self->s.origin);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(TE_BFG_BIGEXPLOSION, self->s.origin);
@@ -1554,13 +1668,13 @@ void bfg_think(edict_t *self)
 			// if we hit something that's not a monster or player we're done
 			if (!(tr.ent->svflags & SVF_MONSTER) && !tr.ent->client)
 			{
-				gi.WriteByte(svc_temp_entity);
-				gi.WriteByte(TE_LASER_SPARKS);
-				gi.WriteByte(4);
-				gi.WritePosition(tr.endpos);
-				gi.WriteDir(tr.plane.normal);
-				gi.WriteByte(self->s.skinnum);
-				gi.multicast(tr.endpos, MULTICAST_PVS);
+				TempEnt_Begin();
+				TempEnt_WriteByte(TE_LASER_SPARKS);
+				TempEnt_WriteByte(4);
+				TempEnt_WritePosition(tr.endpos);
+				TempEnt_WriteDir(tr.plane.normal);
+				TempEnt_WriteByte(self->s.skinnum);
+				TempEnt_Multicast(tr.endpos, MULTICAST_PVS);
 
 				break;
 			}
@@ -1569,17 +1683,17 @@ void bfg_think(edict_t *self)
 			VectorCopy(tr.endpos, start);
 		}
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_BFG_LASER);
-		gi.WritePosition(self->s.origin);
-		gi.WritePosition(tr.endpos);
-		gi.multicast(self->s.origin, MULTICAST_PHS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_BFG_LASER);
+		TempEnt_WritePosition(self->s.origin);
+		TempEnt_WritePosition(tr.endpos);
+		TempEnt_Multicast(self->s.origin, MULTICAST_PHS);
 
 		if (level.num_reflectors)
 			ReflectTrail(TE_BFG_LASER, self->s.origin, tr.endpos);
 	}
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 
@@ -1599,15 +1713,16 @@ void fire_bfg(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, fl
 	bfg->s.modelindex = gi.modelindex("sprites/s_bfg1.sp2");
 	bfg->owner = self;
 	bfg->touch = bfg_touch;
-	bfg->nextthink = level.time + 8000.0 / speed; //mxd. 8000 -> 8000.0
+	G_SetNextThink(bfg, level.time + 8000.0 / speed); //mxd. 8000 -> 8000.0
 	bfg->think = G_FreeEdict;
 	bfg->radius_dmg = damage;
 	bfg->dmg_radius = damage_radius;
 	bfg->classname = "bfg blast";
+	bfg->class_id = ENTITY_BFG;
 	bfg->s.sound = gi.soundindex("weapons/bfg__l1a.wav");
 
 	bfg->think = bfg_think;
-	bfg->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(bfg, level.time + FRAMETIME);
 	bfg->teammaster = bfg;
 	bfg->teamchain = NULL;
 
@@ -243,7 +243,9 @@ ENTITY_HANDGRENADE,
 ENTITY_ROCKET,
 ENTITY_CHASECAM,
 ENTITY_CAMPLAYER,
-ENTITY_PLAYER_NOISE
+ENTITY_PLAYER_NOISE,
+ENTITY_BFG,
+ENTITY_LEAF
 } entity_id;
 
 
@@ -25,7 +25,6 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 //
 #include "g_local.h"
 #include "m_actor.h"
-#include "pak.h"
 
 static char wavname[NUM_ACTOR_SOUNDS][32] = 
 { "jump1.wav",
@@ -635,7 +634,7 @@ void actor_dead(edict_t *self)
 	VectorSet(self->maxs, 16, 16, -8);
 	self->movetype = MOVETYPE_TOSS;
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 	M_FlyCheck (self);
 
@@ -643,7 +642,7 @@ void actor_dead(edict_t *self)
 	if (world->effects & FX_WORLDSPAWN_CORPSEFADE)
 	{
 		self->think = FadeDieSink;
-		self->nextthink = level.time + corpse_fadetime->value;
+		G_SetNextThink(self, level.time + corpse_fadetime->value);
 	}
 }
 
@@ -1292,12 +1291,18 @@ void SP_misc_actor(edict_t *self)
 	if (self->usermodel)
 	{
 		char *p = strstr(self->usermodel, "/tris.md2");
-		if (p) 
-			*p = 0;
+		if (p)
+		{
+			// usermodel may be shared with other entities, strip the copy
+			const int len = p - self->usermodel;
+			p = G_TagMalloc(len + 1, TAG_LEVEL, MEM_ACTOR);
+			memcpy(p, self->usermodel, len);
+			self->usermodel = p;
+		}
 	}
 	else
 	{
-		self->usermodel = gi.TagMalloc(5, TAG_LEVEL);
+		self->usermodel = G_TagMalloc(5, TAG_LEVEL, MEM_ACTOR);
 		Q_strncpyz(self->usermodel, "male", 5);
 	}
 
@@ -1755,7 +1760,7 @@ void target_actor_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface
 	if (!self->count)
 	{
 		self->think = G_FreeEdict;
-		self->nextthink = level.time + 1;
+		G_SetNextThink(self, level.time + 1);
 	}
 }
 
@@ -1795,60 +1800,37 @@ void SP_target_actor(edict_t *self)
 qboolean InPak(char *basedir, char *gamedir, char *filename)
 {
 #ifdef KMQUAKE2_ENGINE_MOD // *.pak/pk3 support
-	char *file_data;
-	const int file_size = gi.LoadFile(filename, (void **)&file_data);
-
-	if (file_data)
-		gi.FreeFile(file_data);
-
-	if (file_size > 2)
+	if (FS_EngineFileExists(filename))
 		return true;
 #endif
 
 	// Search paks in game folder
-	char pakfile[256];
-	pak_header_t pakheader;
-	pak_item_t pakitem;
-	qboolean found = false;
+	return (FS_FindFile(basedir, gamedir, filename, FS_PAK) != NULL);
+}
+
+// Looks for filename in game folder, baseq2 and cddir (minimal installation), both as an external file and in paks
+static qboolean ActorFileExists(char *filename)
+{
+	cvar_t *basedir = gi.cvar("basedir", "", 0);
+	cvar_t *cddir = gi.cvar("cddir", "", 0);
+	cvar_t *gamedir = gi.cvar("gamedir", "", 0);
 
-	for (int k = 9; k >= 0 && !found; k--)
+	if (strlen(gamedir->string))
 	{
-		strncpy(pakfile, basedir, sizeof(pakfile));
-		if (strlen(gamedir))
-		{
-			strcat(pakfile, "/");
-			strcat(pakfile, gamedir);
-		}
+		if (FS_FindFile(basedir->string, gamedir->string, filename, FS_LOOSE) || InPak(basedir->string, gamedir->string, filename))
+			return true;
+	}
 
-		strcat(pakfile, va("/pak%d.pak", k));
-		FILE *f = fopen(pakfile, "rb");
-		if (f != NULL)
-		{
-			const int num = fread(&pakheader, 1, sizeof(pak_header_t), f);
-			if (num >= sizeof(pak_header_t))
-			{
-				if (pakheader.id[0] == 'P' &&
-					pakheader.id[1] == 'A' &&
-					pakheader.id[2] == 'C' &&
-					pakheader.id[3] == 'K')
-				{
-					const int numitems = pakheader.dsize / sizeof(pak_item_t);
-					fseek(f, pakheader.dstart, SEEK_SET);
-					for (int kk = 0; kk < numitems && !found; kk++)
-					{
-						fread(&pakitem, 1, sizeof(pak_item_t), f);
-
-						if (!Q_stricmp(pakitem.name, filename))
-							found = true;
-					}
-				}
-			}
+	if (FS_FindFile(basedir->string, "baseq2", filename, FS_LOOSE) || InPak(basedir->string, "baseq2", filename))
+		return true;
 
-			fclose(f);
-		}
+	if (strlen(cddir->string))
+	{
+		if (FS_FindFile(cddir->string, "baseq2", filename, FS_LOOSE) || InPak(cddir->string, "baseq2", filename))
+			return true;
 	}
 
-	return found;
+	return false;
 }
 
 typedef struct
@@ -1862,18 +1844,12 @@ void actor_files()
 	char			filename[256];
 	int				w_match[2];
 	int				num_actors = 0;
-	actorlist		actors[MAX_EDICTS];
 	edict_t			*e0;
-	FILE			*f;
 
 	if (deathmatch->value)
 		return;
 
-	cvar_t *basedir = gi.cvar("basedir", "", 0);
-	cvar_t *cddir = gi.cvar("cddir", "", 0);
-	cvar_t *gamedir = gi.cvar("gamedir", "", 0);
-
-	memset(&actors, 0, MAX_EDICTS * sizeof(actorlist));
+	actorlist *actors = G_TagMalloc(globals.num_edicts * sizeof(actorlist), TAG_LEVEL, MEM_ACTOR);
 
 	for (int i = game.maxclients + 1; i < globals.num_edicts; i++)
 	{
@@ -1948,78 +1924,14 @@ void actor_files()
 				if (e->actor_sound_index[j])
 					continue;
 
-				// If it's NOT a custom model, start by looking in game folder
-				if (strlen(gamedir->string))
-				{
-					Com_sprintf(filename, sizeof(filename), "%s/%s/sound/%s%s", basedir->string, gamedir->string, path, wavname[j]);
-					f = fopen(filename,"r");
-					if (f)
-					{
-						fclose(f);
-						strncpy(filename, path, sizeof(filename));
-						strcat(filename, wavname[j]);
-						e->actor_sound_index[j] = gi.soundindex(filename);
-						continue;
-					}
-					
-					// Search paks in game folder
-					Com_sprintf(filename, sizeof(filename), "sound/%s%s",path,wavname[j]);
-					if (InPak(basedir->string,gamedir->string,filename))
-					{
-						strncpy(filename, path, sizeof(filename));
-						strcat(filename, wavname[j]);
-						e->actor_sound_index[j] = gi.soundindex(filename);
-						continue;
-					}
-				}
-				
-				// Search in baseq2 for external file
-				Com_sprintf(filename, sizeof(filename), "%s/baseq2/sound/%s%s", basedir->string, path, wavname[j]);
-				f = fopen(filename,"r");
-				if (f)
-				{
-					fclose(f);
-					strncpy(filename, path, sizeof(filename));
-					strcat(filename, wavname[j]);
-					e->actor_sound_index[j] = gi.soundindex(filename);
-					continue;
-				}
-				
-				// Search paks in baseq2
 				Com_sprintf(filename, sizeof(filename), "sound/%s%s", path, wavname[j]);
-				if (InPak(basedir->string, "baseq2", filename))
+				if (ActorFileExists(filename))
 				{
-					strncpy(filename, path, sizeof(filename));
-					strcat(filename, wavname[j]);
+					Com_sprintf(filename, sizeof(filename), "%s%s", path, wavname[j]);
 					e->actor_sound_index[j] = gi.soundindex(filename);
 					continue;
 				}
 
-				if (strlen(cddir->string))
-				{
-					// Search in cddir (minimal installation)
-					Com_sprintf(filename, sizeof(filename), "%s/baseq2/sound/%s%s",cddir->string,path,wavname[j]);
-					f = fopen(filename,"r");
-					if (f)
-					{
-						fclose(f);
-						strncpy(filename, path, sizeof(filename));
-						strcat(filename, wavname[j]);
-						e->actor_sound_index[j] = gi.soundindex(filename);
-						continue;
-					}
-					
-					// Search paks in baseq2
-					Com_sprintf(filename, sizeof(filename), "sound/%s%s", path, wavname[j]);
-					if (InPak(cddir->string, "baseq2", filename))
-					{
-						strncpy(filename, path, sizeof(filename));
-						strcat(filename, wavname[j]);
-						e->actor_sound_index[j] = gi.soundindex(filename);
-						continue;
-					}
-				}
-
 				// If sound is STILL not found, use normal male sounds
 				Com_sprintf(filename, sizeof(filename), "player/male/%s",wavname[j]);
 				e->actor_sound_index[j] = gi.soundindex(filename);
@@ -2062,123 +1974,21 @@ void actor_files()
 				default:strcat(filename, "w_blaster.md2");		break;
 			}
 
-			if (strlen(gamedir->string))
-			{
-				// Start in game folder
-				Com_sprintf(path, sizeof(path), "%s/%s/%s",basedir->string,gamedir->string,filename);
-				f = fopen(path,"r");
-				if (f)
-				{
-					fclose(f);
-					e->actor_model_index[k] = gi.modelindex(filename);
-					continue;
-				}
-				
-				// Search pak files in gamedir
-				if (InPak(basedir->string,gamedir->string,filename))
-				{
-					e->actor_model_index[k] = gi.modelindex(filename);
-					continue;
-				}
-			}
-				
-			// Search in baseq2 for external file
-			Com_sprintf(path, sizeof(path), "%s/baseq2/%s",basedir->string,filename);
-			f = fopen(path,"r");
-			if (f)
-			{
-				fclose(f);
-				e->actor_model_index[k] = gi.modelindex(filename);
-				continue;
-			}
-			
-			// Search paks in baseq2
-			if (InPak(basedir->string,"baseq2",filename))
+			if (ActorFileExists(filename))
 			{
 				e->actor_model_index[k] = gi.modelindex(filename);
 				continue;
 			}
 
-			if (strlen(cddir->string))
-			{
-				// Search CD for minimal installations
-				Com_sprintf(path, sizeof(path), "%s/baseq2/%s",cddir->string,filename);
-				f = fopen(path,"r");
-				if (f)
-				{
-					fclose(f);
-					e->actor_model_index[k] = gi.modelindex(filename);
-					continue;
-				}
-				
-				// Search paks in baseq2
-				if (InPak(cddir->string, "baseq2", filename))
-				{
-					e->actor_model_index[k] = gi.modelindex(filename);
-					continue;
-				}
-			}
-
 			// If sound is STILL not found, start the fuck over and look for weapon.md2
 			Com_sprintf(filename, sizeof(filename), "players/%s/weapon.md2", e->usermodel);
 
-			if (strlen(gamedir->string))
-			{
-				// Start in game folder
-				Com_sprintf(path, sizeof(path), "%s/%s/%s", basedir->string, gamedir->string, filename);
-				f = fopen(path, "r");
-				if (f)
-				{
-					fclose(f);
-					e->actor_model_index[k] = gi.modelindex(filename);
-					continue;
-				}
-				
-				// Search pak files in gamedir
-				if (InPak(basedir->string, gamedir->string, filename))
-				{
-					e->actor_model_index[k] = gi.modelindex(filename);
-					continue;
-				}
-			}
-				
-			// Search in baseq2 for external file
-			Com_sprintf(path, sizeof(path), "%s/baseq2/%s", basedir->string, filename);
-			f = fopen(path,"r");
-			if (f)
-			{
-				fclose(f);
-				e->actor_model_index[k] = gi.modelindex(filename);
-				continue;
-			}
-			
-			// Search paks in baseq2
-			if (InPak(basedir->string,"baseq2",filename))
+			if (ActorFileExists(filename))
 			{
 				e->actor_model_index[k] = gi.modelindex(filename);
 				continue;
 			}
 
-			if (strlen(cddir->string))
-			{
-				// Search CD for minimal installations
-				Com_sprintf(path, sizeof(path), "%s/baseq2/%s", cddir->string, filename);
-				f = fopen(path, "r");
-				if (f)
-				{
-					fclose(f);
-					e->actor_model_index[k] = gi.modelindex(filename);
-					continue;
-				}
-				
-				// Search paks in baseq2
-				if (InPak(cddir->string, "baseq2", filename))
-				{
-					e->actor_model_index[k] = gi.modelindex(filename);
-					continue;
-				}
-			}
-
 			// And if it's STILL not found, use 
 			Com_sprintf(filename, sizeof(filename), "players/male/weapon.md2");
 			e->actor_model_index[k] = gi.modelindex(filename);
@@ -2191,6 +2001,8 @@ void actor_files()
 
 		gi.linkentity(e);
 	}
+
+	gi.TagFree(actors);
 }
 
 void actor_moveit(edict_t *player, edict_t *actor)
@@ -38,7 +38,7 @@ void muzzleflash_think(edict_t *flash)
 		else
 			flash->s.effects &= ~EF_HYPERBLASTER;
 
-		flash->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(flash, level.time + FRAMETIME);
 	}
 
 	gi.linkentity(flash);
@@ -46,11 +46,11 @@ void muzzleflash_think(edict_t *flash)
 
 void TraceAimPoint(vec3_t start,vec3_t target)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_DEBUGTRAIL);
-	gi.WritePosition(start);
-	gi.WritePosition(target);
-	gi.multicast(start, MULTICAST_ALL);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_DEBUGTRAIL);
+	TempEnt_WritePosition(start);
+	TempEnt_WritePosition(target);
+	TempEnt_Multicast(start, MULTICAST_ALL);
 }
 
 void ActorTarget(edict_t *self, vec3_t target)
@@ -215,10 +215,10 @@ void actorShotgun(edict_t *self)
 
 	fire_shotgun(self, start, forward, 4, 8, DEFAULT_SHOTGUN_HSPREAD, DEFAULT_SHOTGUN_VSPREAD, DEFAULT_SHOTGUN_COUNT, MOD_SHOTGUN);
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_CHAINFIST_SMOKE);
-	gi.WritePosition(start);
-	gi.multicast(start, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_CHAINFIST_SMOKE);
+	TempEnt_WritePosition(start);
+	TempEnt_Multicast(start, MULTICAST_PVS);
 	gi.positioned_sound(start, self, CHAN_WEAPON, gi.soundindex("weapons/shotgf1b.wav"), 1, ATTN_NORM, 0);
 
 	if (self->flash)
@@ -274,10 +274,10 @@ void actorSuperShotgun(edict_t *self)
 
 	fire_shotgun(self, start, forward, 6, 12, DEFAULT_SHOTGUN_HSPREAD, DEFAULT_SHOTGUN_VSPREAD, DEFAULT_SSHOTGUN_COUNT / 2, MOD_SSHOTGUN);
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_CHAINFIST_SMOKE);
-	gi.WritePosition(start);
-	gi.multicast(start, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_CHAINFIST_SMOKE);
+	TempEnt_WritePosition(start);
+	TempEnt_Multicast(start, MULTICAST_PVS);
 	gi.positioned_sound(start, self, CHAN_WEAPON, gi.soundindex("weapons/sshotf1b.wav"), 1, ATTN_NORM, 0);
 
 	if (self->flash)
@@ -314,10 +314,10 @@ void actorMachineGun(edict_t *self)
 	const int damage = (self->monsterinfo.aiflags & AI_TWO_GUNS ? 2 : 4);
 	fire_bullet(self, start, forward, damage, 2, DEFAULT_BULLET_HSPREAD, DEFAULT_BULLET_VSPREAD, MOD_MACHINEGUN);
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_CHAINFIST_SMOKE);
-	gi.WritePosition(start);
-	gi.multicast(start, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_CHAINFIST_SMOKE);
+	TempEnt_WritePosition(start);
+	TempEnt_Multicast(start, MULTICAST_PVS);
 	gi.positioned_sound(start, self, CHAN_WEAPON, gi.soundindex(va("weapons/machgf%db.wav", self->actor_gunframe % 5 + 1)), 1, ATTN_NORM, 0);
 
 	if (self->flash)
@@ -340,10 +340,10 @@ void actorMachineGun(edict_t *self)
 
 		fire_bullet(self, start, forward, damage, 2, DEFAULT_BULLET_HSPREAD, DEFAULT_BULLET_VSPREAD, MOD_MACHINEGUN);
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_CHAINFIST_SMOKE);
-		gi.WritePosition(start);
-		gi.multicast(start, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_CHAINFIST_SMOKE);
+		TempEnt_WritePosition(start);
+		TempEnt_Multicast(start, MULTICAST_PVS);
 	}
 }
 
@@ -395,10 +395,10 @@ void actorChaingun(edict_t *self)
 	for (int i = 0; i < shots; i++)
 		fire_bullet(self, start, forward, damage, 2, DEFAULT_BULLET_HSPREAD, DEFAULT_BULLET_VSPREAD, MOD_CHAINGUN);
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_CHAINFIST_SMOKE);
-	gi.WritePosition(start);
-	gi.multicast(start, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_CHAINFIST_SMOKE);
+	TempEnt_WritePosition(start);
+	TempEnt_Multicast(start, MULTICAST_PVS);
 	gi.positioned_sound(start, self, CHAN_WEAPON, gi.soundindex(va("weapons/machgf%db.wav", self->actor_gunframe % 5 + 1)), 1, ATTN_NORM, 0);
 
 	if (self->flash)
@@ -422,10 +422,10 @@ void actorChaingun(edict_t *self)
 		for (int i = 0; i < shots; i++)
 			fire_bullet(self, start, forward, damage, 2, DEFAULT_BULLET_HSPREAD, DEFAULT_BULLET_VSPREAD, MOD_CHAINGUN);
 
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_CHAINFIST_SMOKE);
-		gi.WritePosition(start);
-		gi.multicast(start, MULTICAST_PVS);
+		TempEnt_Begin();
+		TempEnt_WriteByte(TE_CHAINFIST_SMOKE);
+		TempEnt_WritePosition(start);
+		TempEnt_Multicast(start, MULTICAST_PVS);
 	}
 }
 
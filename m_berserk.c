@@ -345,7 +345,7 @@ void berserk_dead(edict_t *self)
 	VectorSet(self->maxs, 16, 16, -8);
 	self->movetype = MOVETYPE_TOSS;
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 	M_FlyCheck(self);
 
@@ -353,7 +353,7 @@ void berserk_dead(edict_t *self)
 	if (world->effects & FX_WORLDSPAWN_CORPSEFADE)
 	{
 		self->think = FadeDieSink;
-		self->nextthink = level.time + corpse_fadetime->value;
+		G_SetNextThink(self, level.time + corpse_fadetime->value);
 	}
 }
 
@@ -32,10 +32,10 @@ boss3
 
 void Use_Boss3(edict_t *ent, edict_t *other, edict_t *activator)
 {
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_BOSSTPORT);
-	gi.WritePosition(ent->s.origin);
-	gi.multicast(ent->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_BOSSTPORT);
+	TempEnt_WritePosition(ent->s.origin);
+	TempEnt_Multicast(ent->s.origin, MULTICAST_PVS);
 	G_FreeEdict(ent);
 }
 
@@ -45,7 +45,7 @@ void Think_Boss3Stand(edict_t *ent)
 		ent->s.frame = FRAME_stand201;
 	else
 		ent->s.frame++;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*QUAKED monster_boss3_stand (1 .5 0) (-32 -32 0) (32 32 90)
@@ -73,6 +73,6 @@ void SP_monster_boss3_stand(edict_t *self)
 
 	self->use = Use_Boss3;
 	self->think = Think_Boss3Stand;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	gi.linkentity(self);
 }
@@ -584,7 +584,7 @@ void jorg_dead(edict_t *self)
 	VectorSet(self->mins, -60, -60, 0);
 	VectorSet(self->maxs, 60, 60, 72);
 	self->movetype = MOVETYPE_TOSS;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 	M_FlyCheck (self);
 
@@ -625,12 +625,12 @@ void makron_torso_think(edict_t *self)
 {
 	if (++self->s.frame < 365)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else
 	{		
 		self->s.frame = 346;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -667,7 +667,7 @@ void makron_torso(edict_t *ent)
 	ent->s.frame = 346;
 	ent->s.modelindex = gi.modelindex("models/monsters/boss3/rider/tris.md2");
 	ent->think = makron_torso_think;
-	ent->nextthink = level.time + 2 * FRAMETIME;
+	G_SetNextThink(ent, level.time + 2 * FRAMETIME);
 	ent->s.sound = gi.soundindex("makron/spine.wav");
 	gi.linkentity(ent);
 }
@@ -686,7 +686,7 @@ void makron_dead(edict_t *self)
 	VectorSet(self->maxs,  48,  48, 32);
 	self->movetype = MOVETYPE_TOSS;
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 	M_FlyCheck(self);
 }
@@ -934,7 +934,7 @@ Jorg is just about dead, so set up to launch Makron out
 void MakronToss(edict_t *self)
 {
 	edict_t *ent = G_Spawn();
-	ent->nextthink = level.time + 0.8f;
+	G_SetNextThink(ent, level.time + 0.8f);
 	ent->think = MakronSpawn;
 	ent->target = self->target;
 
@@ -547,13 +547,13 @@ void floater_zap(edict_t *self)
 	gi.sound(self, CHAN_WEAPON, sound_attack2, 1, ATTN_NORM, 0);
 
 	//FIXME use the flash, Luke
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_SPLASH);
-	gi.WriteByte(32);
-	gi.WritePosition(origin);
-	gi.WriteDir(dir);
-	gi.WriteByte(1); //sparks
-	gi.multicast(origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_SPLASH);
+	TempEnt_WriteByte(32);
+	TempEnt_WritePosition(origin);
+	TempEnt_WriteDir(dir);
+	TempEnt_WriteByte(1); //sparks
+	TempEnt_Multicast(origin, MULTICAST_PVS);
 
 	T_Damage(self->enemy, self, self, dir, self->enemy->s.origin, vec3_origin, 5 + rand() % 6, -10, DAMAGE_ENERGY, MOD_UNKNOWN);
 }
@@ -608,7 +608,7 @@ void floater_dead(edict_t *self)
 	VectorSet(self->maxs, 16, 16, -8);
 	self->movetype = MOVETYPE_TOSS;
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 }
 
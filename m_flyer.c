@@ -731,7 +731,7 @@ void fake_flyer_sparks(edict_t *self)
 	vec3_t dir = { crandom(), crandom(), crandom() };
 	M_SpawnEffect(self, TE_ELECTRIC_SPARKS, vec3_origin, dir);
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void flyer_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, vec3_t point)
@@ -765,7 +765,7 @@ void flyer_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage,
 		g->dmg = kick;
 		g->touch = fake_flyer_touch;
 		g->think = fake_flyer_sparks;
-		g->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(g, level.time + FRAMETIME);
 
 		// Set clipping and size, so we can SMACK into other monsters (and player)
 		g->solid = SOLID_BBOX;
@@ -801,10 +801,10 @@ qboolean flyer_blocked(edict_t *self, float dist)
 			vec3_t origin;
 
 			VectorMA(self->s.origin, -0.02, self->velocity, origin);
-			gi.WriteByte(svc_temp_entity);
-			gi.WriteByte(TE_ROCKET_EXPLOSION);
-			gi.WritePosition(origin);
-			gi.multicast(self->s.origin, MULTICAST_PHS);
+			TempEnt_Begin();
+			TempEnt_WriteByte(TE_ROCKET_EXPLOSION);
+			TempEnt_WritePosition(origin);
+			TempEnt_Multicast(self->s.origin, MULTICAST_PHS);
 
 			G_FreeEdict(self);
 		}
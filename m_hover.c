@@ -555,7 +555,7 @@ void hover_spawn_gibs(edict_t *self, int damage)
 void hover_deadthink(edict_t *self)
 {
 	if (!self->groundentity && level.time < self->timestamp)
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	else
 		hover_spawn_gibs(self, 200); //mxd
 }
@@ -614,7 +614,7 @@ void hover_dead(edict_t *self)
 	VectorSet(self->maxs, 16, 16, -8);
 	self->movetype = MOVETYPE_TOSS;
 	self->think = hover_deadthink;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 	self->timestamp = level.time + 15;
 	gi.linkentity(self);
 }
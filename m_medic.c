@@ -61,7 +61,7 @@ void medic_deadmonster_think(edict_t *self)
 				VectorSubtract(medic->s.origin,deadmonster->s.origin,dir);
 				if (VectorLength(dir) < 64)
 				{
-					self->nextthink = level.time + 1.0;
+					G_SetNextThink(self, level.time + 1.0);
 					return;
 				}
 			}
@@ -91,7 +91,7 @@ void cleanupHeal(edict_t *self, qboolean change_frame)
 		temp->svflags = SVF_NOCLIENT;
 		temp->target_ent = self->enemy;
 		temp->think = medic_deadmonster_think;
-		temp->nextthink = level.time + 2.0;
+		G_SetNextThink(temp, level.time + 2.0);
 		gi.linkentity(temp);
 
 		M_SetEffects(self->enemy);
@@ -135,7 +135,7 @@ void abortHeal(edict_t *self, qboolean mark)
 			temp->monsterinfo.badMedic2 = self;
 
 		temp->think = DeleteBadMedic;
-		temp->nextthink = level.time + 60;
+		G_SetNextThink(temp, level.time + 60);
 	}
 
 	// Clean up self
@@ -655,7 +655,7 @@ void medic_dead(edict_t *self)
 	VectorSet(self->maxs, 16, 16, -8);
 	self->movetype = MOVETYPE_TOSS;
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 	M_FlyCheck(self);
 
@@ -663,7 +663,7 @@ void medic_dead(edict_t *self)
 	if (world->effects & FX_WORLDSPAWN_CORPSEFADE)
 	{
 		self->think = FadeDieSink;
-		self->nextthink = level.time + corpse_fadetime->value;
+		G_SetNextThink(self, level.time + corpse_fadetime->value);
 	}
 }
 
@@ -993,7 +993,7 @@ void medic_cable_attack(edict_t *self)
 
 		if (self->enemy->think)
 		{
-			self->enemy->nextthink = level.time;
+			G_SetNextThink(self->enemy, level.time);
 			self->enemy->think(self->enemy);
 		}
 
@@ -1035,12 +1035,12 @@ void medic_cable_attack(edict_t *self)
 	VectorNormalize(f);
 	VectorMA(start, 16, f, start);
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_MEDIC_CABLE_ATTACK);
-	gi.WriteShort(self - g_edicts);
-	gi.WritePosition(start);
-	gi.WritePosition(end);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_MEDIC_CABLE_ATTACK);
+	TempEnt_WriteShort(self - g_edicts);
+	TempEnt_WritePosition(start);
+	TempEnt_WritePosition(end);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 }
 
 void medic_hook_retract(edict_t *self)
@@ -509,7 +509,7 @@ qboolean SV_movestep(edict_t *ent, vec3_t move, qboolean relink)
 	if (ent->flags & FL_PARTIALGROUND)
 		ent->flags &= ~FL_PARTIALGROUND;
 
-	ent->groundentity = trace.ent;
+	G_SetGroundEntity(ent, trace.ent);
 	if (trace.ent)
 		ent->groundentity_linkcount = trace.ent->linkcount;
 
@@ -880,6 +880,11 @@ void M_MoveToGoal(edict_t *ent, float dist)
 	if (ent->enemy && !(ent->monsterinfo.aiflags & AI_CHASE_THING) && SV_CloseEnough(ent, ent->enemy, dist))
 		return;
 
+	// Follow the navigation graph while the goal is out of sight
+	float yaw;
+	if (ent->inuse && Nav_ChaseYaw(ent, goal, dist, &yaw) && SV_StepDirection(ent, yaw, dist))
+		return;
+
 	// Bump around...
 	if (ent->inuse && ((rand() & 3) == 1 || !SV_StepDirection(ent, ent->ideal_yaw, dist)))
 		SV_NewChaseDir(ent, goal, dist);
@@ -550,7 +550,7 @@ void mutant_dead(edict_t *self)
 	//          will cause us to come back here over and over and over
 	//          until flies ARE set or monster is gibbed.
 	//          This line fixes that:
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 
 	VectorSet(self->mins, -16, -16, -24);
 	VectorSet(self->maxs, 16, 16, -8);
@@ -563,7 +563,7 @@ void mutant_dead(edict_t *self)
 	if (world->effects & FX_WORLDSPAWN_CORPSEFADE)
 	{
 		self->think = FadeDieSink;
-		self->nextthink = level.time + corpse_fadetime->value;
+		G_SetNextThink(self, level.time + corpse_fadetime->value);
 	}
 
 }
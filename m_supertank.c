@@ -598,7 +598,7 @@ void supertank_dead(edict_t *self)
 	VectorSet(self->maxs, 60, 60, 72);
 	self->movetype = MOVETYPE_TOSS;
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 }
 
@@ -657,15 +657,15 @@ void BossExplode(edict_t *self)
 		return;
 	}
 
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_EXPLOSION1);
-	gi.WritePosition(org);
-	gi.multicast(self->s.origin, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_EXPLOSION1);
+	TempEnt_WritePosition(org);
+	TempEnt_Multicast(self->s.origin, MULTICAST_PVS);
 
 	if (level.num_reflectors)
 		ReflectExplosion(TE_EXPLOSION1, self->s.origin);
 
-	self->nextthink = level.time + 0.1;
+	G_SetNextThink(self, level.time + 0.1);
 }
 
 
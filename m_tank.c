@@ -845,7 +845,7 @@ void tank_dead(edict_t *self)
 	VectorSet(self->maxs, 16, 16, -0);
 	self->movetype = MOVETYPE_TOSS;
 	self->svflags |= SVF_DEADMONSTER;
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 	gi.linkentity(self);
 	M_FlyCheck(self);
 
@@ -853,7 +853,7 @@ void tank_dead(edict_t *self)
 	if (world->effects & FX_WORLDSPAWN_CORPSEFADE)
 	{
 		self->think = FadeDieSink;
-		self->nextthink = level.time + corpse_fadetime->value;
+		G_SetNextThink(self, level.time + corpse_fadetime->value);
 	}
 }
 
@@ -1001,10 +1001,10 @@ void tank_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage,
 	ThrowGibEx(self, "models/objects/gibs/tank/arm_left.md2", damage, GIB_METALLIC, pos, normal, NULL, NULL);
 
 	//mxd. Spawn a small explosion...
-	gi.WriteByte(svc_temp_entity);
-	gi.WriteByte(TE_EXPLOSION1);
-	gi.WritePosition(pos);
-	gi.multicast(pos, MULTICAST_PVS);
+	TempEnt_Begin();
+	TempEnt_WriteByte(TE_EXPLOSION1);
+	TempEnt_WritePosition(pos);
+	TempEnt_Multicast(pos, MULTICAST_PVS);
 }
 
 
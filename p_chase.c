@@ -137,7 +137,7 @@ void ChasecamTrack(edict_t *ent)
 	vec3_t spot1, spot2, dir;
 	vec3_t forward, right, up,angles;
 
-	ent->nextthink = level.time + 0.1f;
+	G_SetNextThink(ent, level.time + 0.1f);
 
 	// Get the CLIENT's angle, and break it down into direction vectors, of forward, right, and up. VERY useful
 	VectorCopy(ent->owner->client->v_angle, angles);
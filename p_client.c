@@ -112,7 +112,7 @@ void SP_info_player_start(edict_t *self)
 	{
 		// invoke one of our gross, ugly, disgusting hacks
 		self->think = SP_CreateCoopSpots;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -159,7 +159,7 @@ void SP_info_player_coop(edict_t *self)
 	{
 		// invoke one of our gross, ugly, disgusting hacks
 		self->think = SP_FixCoopSpots;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -734,7 +734,7 @@ void TossClientWeapon(edict_t *self)
 		drop->spawnflags |= DROPPED_PLAYER_ITEM;
 
 		drop->touch = Touch_Item;
-		drop->nextthink = level.time + (self->client->quad_framenum - level.framenum) * FRAMETIME;
+		G_SetNextThink(drop, level.time + (self->client->quad_framenum - level.framenum) * FRAMETIME);
 		drop->think = G_FreeEdict;
 	}
 }
@@ -1239,35 +1239,6 @@ SelectSpawnPoint
 =======================================================================
 */
 
-/*
-================
-PlayersRangeFromSpot
-
-Returns the distance to the nearest player from the given spot
-================
-*/
-float PlayersRangeFromSpot(edict_t *spot)
-{
-	float bestplayerdistance = 9999999;
-
-	for (int n = 1; n <= maxclients->value; n++)
-	{
-		edict_t *player = &g_edicts[n];
-
-		if (!player->inuse || player->health <= 0)
-			continue;
-
-		vec3_t v;
-		VectorSubtract(spot->s.origin, player->s.origin, v);
-		const float playerdistance = VectorLength(v);
-
-		if (playerdistance < bestplayerdistance)
-			bestplayerdistance = playerdistance;
-	}
-
-	return bestplayerdistance;
-}
-
 /*
 ================
 SelectRandomDeathmatchSpawnPoint
@@ -1277,59 +1248,7 @@ go to a random point, but NOT the two points closest to other players
 */
 edict_t *SelectRandomDeathmatchSpawnPoint(void)
 {
-	int	count = 0;
-
-	edict_t *spot = NULL;
-	edict_t *spot1 = NULL;
-	edict_t *spot2 = NULL;
-
-	float range1 = 99999;
-	float range2 = 99999;
-
-	while ((spot = G_Find(spot, FOFS(classname), "info_player_deathmatch")) != NULL)
-	{
-		count++;
-		const float range = PlayersRangeFromSpot(spot);
-		if (range < range1)
-		{
-			range1 = range;
-			spot1 = spot;
-		}
-		else if (range < range2)
-		{
-			range2 = range;
-			spot2 = spot;
-		}
-	}
-
-	if (!count)
-		return NULL;
-
-	if (count <= 2)
-	{
-		spot1 = spot2 = NULL;
-	}
-	// Lazarus: This is wrong. If there is no spot1 or spot2, all spots should
-	// be valid.
-//	else
-//		count -= 2;
-	else
-	{
-		if (spot1) count--;
-		if (spot2) count--;
-	}
-
-	int selection = rand() % count;
-
-	spot = NULL;
-	do
-	{
-		spot = G_Find(spot, FOFS(classname), "info_player_deathmatch");
-		if (spot == spot1 || spot == spot2)
-			selection++;
-	} while (selection--);
-
-	return spot;
+	return SpawnSpot_Random("info_player_deathmatch");
 }
 
 /*
@@ -1340,27 +1259,7 @@ SelectFarthestDeathmatchSpawnPoint
 */
 edict_t *SelectFarthestDeathmatchSpawnPoint(void)
 {
-	edict_t *spot = NULL;
-	edict_t *bestspot = NULL;
-	float bestdistance = 0;
-
-	while ((spot = G_Find(spot, FOFS(classname), "info_player_deathmatch")) != NULL)
-	{
-		const float bestplayerdistance = PlayersRangeFromSpot(spot);
-		if (bestplayerdistance > bestdistance)
-		{
-			bestspot = spot;
-			bestdistance = bestplayerdistance;
-		}
-	}
-
-	if (bestspot)
-		return bestspot;
-
-	// if there is a player just spawned on each and every start spot we have no choice to turn one into a telefrag meltdown
-	spot = G_Find(NULL, FOFS(classname), "info_player_deathmatch");
-
-	return spot;
+	return SpawnSpot_Farthest("info_player_deathmatch");
 }
 
 edict_t *SelectDeathmatchSpawnPoint(void)
@@ -1465,7 +1364,7 @@ void SelectSpawnPoint(edict_t *ent, vec3_t origin, vec3_t angles, int *style, in
 		if (!spot->count)
 		{
 			spot->think = G_FreeEdict;
-			spot->nextthink = level.time + 1;
+			G_SetNextThink(spot, level.time + 1);
 		}
 	}
 }
@@ -1708,6 +1607,7 @@ void PutClientInServer(edict_t *ent)
 	client_respawn_t	resp;
 
 	// find a spawn point. Do it before setting health back up, so farthest ranging doesn't count this client
+	SpawnSpot_ClientMoved(ent);
 	SelectSpawnPoint(ent, spawn_origin, spawn_angles, &spawn_style, &spawn_health);
 
 	const int index = ent - g_edicts - 1;
@@ -1917,6 +1817,7 @@ void PutClientInServer(edict_t *ent)
 
 	//if (!KillBox(ent)) { /* could't spawn in? */ } 
 	KillBox(ent); //mxd
+	SpawnSpot_ClientMoved(ent);
 
 //ZOID
 	if (ctf->value && CTFStartClient(ent))
@@ -2037,7 +1938,7 @@ void ClientBegin(edict_t *ent)
 		return;
 	}
 
-	Fog_Off();
+	Fog_Off(ent);
 
 	stuffcmd(ent,"alias +zoomin zoomin;alias -zoomin zoominstop\n");
 	stuffcmd(ent,"alias +zoomout zoomout;alias -zoomout zoomoutstop\n");
@@ -2269,6 +2170,7 @@ qboolean ClientConnect(edict_t *ent, char *userinfo)
 
 	ent->svflags = 0; // make sure we start with known default
 	ent->client->pers.connected = true;
+	CmdLimit_Connect(ent);
 
 	return true;
 }
@@ -2323,6 +2225,7 @@ void ClientDisconnect(edict_t *ent)
 	ent->solid = SOLID_NOT;
 	ent->inuse = false;
 	ent->classname = "disconnected";
+	G_UpdateRoles(ent);
 	ent->client->pers.connected = false;
 
 	if (ent->client->spycam)
@@ -3356,7 +3259,7 @@ void ClientThink(edict_t *ent, usercmd_t *ucmd)
 
 		ent->waterlevel = pm.waterlevel;
 		ent->watertype = pm.watertype;
-		ent->groundentity = pm.groundentity;
+		G_SetGroundEntity(ent, pm.groundentity);
 
 		if (pm.groundentity)
 			ent->groundentity_linkcount = pm.groundentity->linkcount;
@@ -3364,7 +3267,7 @@ void ClientThink(edict_t *ent, usercmd_t *ucmd)
 		// Lazarus - lie about ground when driving a vehicle. Pmove apparently doesn't think the ground can be "owned"
 		if (ent->vehicle && !ent->groundentity)
 		{
-			ent->groundentity = ent->vehicle;
+			G_SetGroundEntity(ent, ent->vehicle);
 			ent->groundentity_linkcount = ent->vehicle->linkcount;
 		}
 
@@ -38,7 +38,7 @@ pmenuhnd_t *PMenu_Open(edict_t *ent, pmenu_t *entries, int cur, int num, void *a
 		PMenu_Close(ent);
 	}
 
-	pmenuhnd_t *hnd = gi.TagMalloc(sizeof(*hnd), TAG_LEVEL);
+	pmenuhnd_t *hnd = G_TagMalloc(sizeof(*hnd), TAG_LEVEL, MEM_TEXT);
 
 	hnd->arg = arg;
 	hnd->entries = entries;
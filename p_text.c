@@ -255,7 +255,7 @@ void Do_Text_Display(edict_t *activator, int flags, char *message)
 	char sound[64];
 	byte *temp_buffer;
 
-	texthnd_t *hnd = gi.TagMalloc(sizeof(*hnd), TAG_LEVEL);
+	texthnd_t *hnd = G_TagMalloc(sizeof(*hnd), TAG_LEVEL, MEM_TEXT);
 	
 	// If a file, open and read it
 	if (flags & 1)
@@ -274,7 +274,7 @@ void Do_Text_Display(edict_t *activator, int flags, char *message)
 		}
 
 		hnd->allocated = textsize + 128; // add some slop for additional control characters
-		hnd->buffer = gi.TagMalloc(hnd->allocated, TAG_LEVEL);
+		hnd->buffer = G_TagMalloc(hnd->allocated, TAG_LEVEL, MEM_TEXT);
 		if (!hnd->buffer)
 		{
 			gi.dprintf("Memory allocation failure on target_text\n");
@@ -336,7 +336,7 @@ void Do_Text_Display(edict_t *activator, int flags, char *message)
 								in_pak = true;
 								fseek(f,pakitem.start,SEEK_SET);
 								hnd->allocated = pakitem.size + 128;  // add some slop for additional control characters
-								hnd->buffer = gi.TagMalloc(hnd->allocated, TAG_LEVEL);
+								hnd->buffer = G_TagMalloc(hnd->allocated, TAG_LEVEL, MEM_TEXT);
 								if (!hnd->buffer)
 								{
 									fclose(f);
@@ -370,7 +370,7 @@ void Do_Text_Display(edict_t *activator, int flags, char *message)
 			L = ftell (f);
 			fseek(f,0,SEEK_SET);
 			hnd->allocated = L+128;
-			hnd->buffer = gi.TagMalloc(hnd->allocated, TAG_LEVEL);
+			hnd->buffer = G_TagMalloc(hnd->allocated, TAG_LEVEL, MEM_TEXT);
 			if (!hnd->buffer)
 			{
 				gi.dprintf("Memory allocation failure on target_text\n");
@@ -394,7 +394,7 @@ void Do_Text_Display(edict_t *activator, int flags, char *message)
 	{
 		const int len = strlen(message);
 		hnd->allocated = len + 128;
-		hnd->buffer = gi.TagMalloc(hnd->allocated, TAG_LEVEL);
+		hnd->buffer = G_TagMalloc(hnd->allocated, TAG_LEVEL, MEM_TEXT);
 		if (!hnd->buffer)
 		{
 			gi.dprintf("Memory allocation failure\n");
@@ -576,7 +576,7 @@ void Do_Text_Display(edict_t *activator, int flags, char *message)
 					{
 						hnd->allocated += 128;
 						temp_buffer = hnd->buffer;
-						hnd->buffer = gi.TagMalloc(hnd->allocated, TAG_LEVEL);
+						hnd->buffer = G_TagMalloc(hnd->allocated, TAG_LEVEL, MEM_TEXT);
 
 						if (!hnd->buffer)
 						{
@@ -620,7 +620,7 @@ void Do_Text_Display(edict_t *activator, int flags, char *message)
 			{
 				hnd->allocated += 128;
 				temp_buffer = hnd->buffer;
-				hnd->buffer = gi.TagMalloc(hnd->allocated, TAG_LEVEL);
+				hnd->buffer = G_TagMalloc(hnd->allocated, TAG_LEVEL, MEM_TEXT);
 
 				if (!hnd->buffer)
 				{
@@ -658,7 +658,7 @@ void Do_Text_Display(edict_t *activator, int flags, char *message)
 			{
 				hnd->allocated += 128;
 				temp_buffer = hnd->buffer;
-				hnd->buffer = gi.TagMalloc(hnd->allocated, TAG_LEVEL);
+				hnd->buffer = G_TagMalloc(hnd->allocated, TAG_LEVEL, MEM_TEXT);
 
 				if (!hnd->buffer)
 				{
@@ -1015,11 +1015,11 @@ void G_SetClientEffects(edict_t *ent)
 
 			VectorCopy(tr.endpos, end);
 
-			gi.WriteByte(svc_temp_entity);
-			gi.WriteByte(TE_FLASHLIGHT);
-			gi.WritePosition(end);
-			gi.WriteShort(ent - g_edicts);
-			gi.multicast(end, MULTICAST_PVS);
+			TempEnt_Begin();
+			TempEnt_WriteByte(TE_FLASHLIGHT);
+			TempEnt_WritePosition(end);
+			TempEnt_WriteShort(ent - g_edicts);
+			TempEnt_Multicast(end, MULTICAST_PVS);
 		}
 	}
 }
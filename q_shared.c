@@ -26,6 +26,10 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "../win32/winquake.h"
 #endif
 
+#if idsse
+#include <emmintrin.h>
+#endif
+
 vec2_t vec2_origin = { 0, 0 };
 vec3_t vec3_origin = { 0, 0, 0 };
 vec4_t vec4_origin = { 0, 0, 0, 0 };
@@ -88,20 +92,18 @@ void RotatePointAroundVector(vec3_t dst, const vec3_t dir, const vec3_t point, f
 
 void AngleVectors(const vec3_t angles, vec3_t forward, vec3_t right, vec3_t up)
 {
-	static float sr, sp, sy, cr, cp, cy; // static to help MS compiler fp bugs
-
 	if (!angles)
 		return;
 
 	float angle = angles[YAW] * (M_PI2 / 360);
-	sy = sinf(angle);
-	cy = cosf(angle);
+	const float sy = sinf(angle);
+	const float cy = cosf(angle);
 	angle = angles[PITCH] * (M_PI2 / 360);
-	sp = sinf(angle);
-	cp = cosf(angle);
+	const float sp = sinf(angle);
+	const float cp = cosf(angle);
 	angle = angles[ROLL] * (M_PI2 / 360);
-	sr = sinf(angle);
-	cr = cosf(angle);
+	const float sr = sinf(angle);
+	const float cr = cosf(angle);
 
 	if (forward)
 	{
@@ -790,6 +792,215 @@ int Q_log2(int val)
 	return answer;
 }
 
+/*
+=============================================================================
+
+BATCH VECTOR MATH
+
+Versions of AngleVectors, distance and VectorNormalize that work on arrays.
+With SSE2 four vectors are done at once, otherwise they just loop.
+
+=============================================================================
+*/
+
+#if idsse
+
+// sin and cos of 4 angles (in radians) at once. Cephes sinf/cosf polynomials, accurate for |x| < 8192.
+static void SinCos4(__m128 x, __m128 *s, __m128 *c)
+{
+	const __m128 signmask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	__m128 sign_s = _mm_and_ps(x, signmask);
+	x = _mm_andnot_ps(signmask, x);
+
+	// Octant, rounded up to even
+	__m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f))); // 4 / pi
+	j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+	const __m128 y = _mm_cvtepi32_ps(j);
+
+	// Octants 2 and 6 swap sin and cos, 4 and 6 flip signs
+	const __m128i bit2 = _mm_and_si128(j, _mm_set1_epi32(2));
+	const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(bit2, _mm_set1_epi32(2)));
+	const __m128 flip = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+	sign_s = _mm_xor_ps(sign_s, flip);
+	const __m128 sign_c = _mm_xor_ps(flip, _mm_castsi128_ps(_mm_slli_epi32(bit2, 30)));
+
+	// Extended precision x - y * pi / 4
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+	const __m128 z = _mm_mul_ps(x, x);
+
+	__m128 pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+	pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(4.166664568298827e-2f));
+	pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+	pc = _mm_add_ps(_mm_sub_ps(pc, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+	__m128 ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+	ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(-1.6666654611e-1f));
+	ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), x), x);
+
+	*s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, pc), _mm_andnot_ps(swap, ps)), sign_s);
+	*c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, ps), _mm_andnot_ps(swap, pc)), sign_c);
+}
+
+#define LOAD4(v, i, n)	_mm_set_ps(v[(i) + 3][n], v[(i) + 2][n], v[(i) + 1][n], v[(i)][n])
+
+static void Store4(vec3_t *out, int n, __m128 x, __m128 y, __m128 z)
+{
+	float fx[4], fy[4], fz[4];
+
+	_mm_storeu_ps(fx, x);
+	_mm_storeu_ps(fy, y);
+	_mm_storeu_ps(fz, z);
+
+	for (int i = 0; i < 4; i++)
+	{
+		out[n + i][0] = fx[i];
+		out[n + i][1] = fy[i];
+		out[n + i][2] = fz[i];
+	}
+}
+
+#endif // idsse
+
+/*
+=================
+AngleVectorsBatch
+
+AngleVectors for count angles. Any of forward, right and up can be NULL.
+=================
+*/
+void AngleVectorsBatch(const vec3_t *angles, int count, vec3_t *forward, vec3_t *right, vec3_t *up)
+{
+	int i = 0;
+
+#if idsse
+	const __m128 scale = _mm_set1_ps(M_PI2 / 360);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 sp, cp, sy, cy, sr, cr;
+
+		SinCos4(_mm_mul_ps(LOAD4(angles, i, PITCH), scale), &sp, &cp);
+		SinCos4(_mm_mul_ps(LOAD4(angles, i, YAW), scale), &sy, &cy);
+		SinCos4(_mm_mul_ps(LOAD4(angles, i, ROLL), scale), &sr, &cr);
+
+		if (forward)
+			Store4(forward, i, _mm_mul_ps(cp, cy), _mm_mul_ps(cp, sy), _mm_sub_ps(_mm_setzero_ps(), sp));
+
+		if (right)
+		{
+			const __m128 srsp = _mm_mul_ps(sr, sp);
+			Store4(right, i,
+				_mm_sub_ps(_mm_mul_ps(cr, sy), _mm_mul_ps(srsp, cy)),
+				_mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(_mm_mul_ps(srsp, sy), _mm_mul_ps(cr, cy))),
+				_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(sr, cp)));
+		}
+
+		if (up)
+		{
+			const __m128 crsp = _mm_mul_ps(cr, sp);
+			Store4(up, i,
+				_mm_add_ps(_mm_mul_ps(crsp, cy), _mm_mul_ps(sr, sy)),
+				_mm_sub_ps(_mm_mul_ps(crsp, sy), _mm_mul_ps(sr, cy)),
+				_mm_mul_ps(cr, cp));
+		}
+	}
+#endif
+
+	for (; i < count; i++)
+		AngleVectors(angles[i], (forward ? forward[i] : NULL), (right ? right[i] : NULL), (up ? up[i] : NULL));
+}
+
+/*
+=================
+VectorDistSquaredBatch
+
+Squared distance from point to count origins. origins points to the first origin,
+stride is the size in bytes of the struct holding them (sizeof(vec3_t) for a plain array).
+=================
+*/
+void VectorDistSquaredBatch(const vec3_t point, const float *origins, int stride, int count, float *out)
+{
+	const byte *o = (const byte *)origins;
+	int i = 0;
+
+#define ORIGIN(n)	((const float *)(o + (n) * stride))
+
+#if idsse
+	const __m128 px = _mm_set1_ps(point[0]);
+	const __m128 py = _mm_set1_ps(point[1]);
+	const __m128 pz = _mm_set1_ps(point[2]);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const float *o0 = ORIGIN(i), *o1 = ORIGIN(i + 1), *o2 = ORIGIN(i + 2), *o3 = ORIGIN(i + 3);
+
+		const __m128 dx = _mm_sub_ps(_mm_set_ps(o3[0], o2[0], o1[0], o0[0]), px);
+		const __m128 dy = _mm_sub_ps(_mm_set_ps(o3[1], o2[1], o1[1], o0[1]), py);
+		const __m128 dz = _mm_sub_ps(_mm_set_ps(o3[2], o2[2], o1[2], o0[2]), pz);
+
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		const float *v = ORIGIN(i);
+		const float dx = v[0] - point[0];
+		const float dy = v[1] - point[1];
+		const float dz = v[2] - point[2];
+
+		out[i] = dx * dx + dy * dy + dz * dz;
+	}
+
+#undef ORIGIN
+}
+
+/*
+=================
+VectorNormalizeBatch
+
+VectorNormalize for count vectors. Lengths are stored in lengths, unless it's NULL.
+=================
+*/
+void VectorNormalizeBatch(vec3_t *v, int count, float *lengths)
+{
+	int i = 0;
+
+#if idsse
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 x = LOAD4(v, i, 0);
+		const __m128 y = LOAD4(v, i, 1);
+		const __m128 z = LOAD4(v, i, 2);
+
+		const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+		const __m128 ilength = _mm_div_ps(_mm_set1_ps(1.0f), length);
+		const __m128 valid = _mm_cmpneq_ps(length, _mm_setzero_ps()); // zero length vectors are left alone
+
+		Store4(v, i,
+			_mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(x, ilength)), _mm_andnot_ps(valid, x)),
+			_mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(y, ilength)), _mm_andnot_ps(valid, y)),
+			_mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(z, ilength)), _mm_andnot_ps(valid, z)));
+
+		if (lengths)
+			_mm_storeu_ps(lengths + i, length);
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		const float length = VectorNormalize(v[i]);
+		if (lengths)
+			lengths[i] = length;
+	}
+}
+
+#if idsse
+#undef LOAD4
+#endif
+
 /*
 =================
 VectorRotate
@@ -55,6 +55,13 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define idaxp	0
 #endif
 
+// SSE2 batch vector math (AngleVectorsBatch etc.)
+#if (defined _M_X64 || defined __x86_64__ || defined __SSE2__ || (defined _M_IX86_FP && _M_IX86_FP >= 2)) && !defined C_ONLY
+#define idsse	1
+#else
+#define idsse	0
+#endif
+
 #if defined(__APPLE__) || defined(MACOSX)
 #undef true
 #undef false
@@ -347,6 +354,11 @@ void VectorScale(const vec3_t in, vec_t scale, vec3_t out);
 int Q_log2(int val);
 float Q_rsqrt(float in);	// From Q2E
 
+// Batch versions, for loops over many vectors. Same results as the single vector functions (give or take rounding).
+void AngleVectorsBatch(const vec3_t *angles, int count, vec3_t *forward, vec3_t *right, vec3_t *up);
+void VectorDistSquaredBatch(const vec3_t point, const float *origins, int stride, int count, float *out);
+void VectorNormalizeBatch(vec3_t *v, int count, float *lengths);
+
 // From Q2E
 void VectorRotate(const vec3_t v, const vec3_t matrix[3], vec3_t out);
 void AnglesToAxis(const vec3_t angles, vec3_t axis[3]);